@@ -42,6 +42,13 @@ public:
   // NOLINTNEXTLINE(readability-identifier-naming)
   [[nodiscard]] static std::string MetaDataKind() { return "psr.id"; }
 
+  /// Stores the label/ tag with which IRNormalizationPass annotates the
+  /// instructions it synthesized with the ID of their original instruction.
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  [[nodiscard]] static std::string OriginMetaDataKind() {
+    return "psr.origin.id";
+  }
+
   /// Specifies the directory in which important configuration files are
   /// located.
   // NOLINTNEXTLINE(readability-identifier-naming)
@@ -22,6 +22,8 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SpecialSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/InterMonoSolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
@@ -30,6 +32,7 @@
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Utils/EnumFlags.h"
+#include "phasar/Utils/Logger.h"
 #include "phasar/Utils/Soundness.h"
 
 namespace psr {
@@ -51,6 +54,7 @@ enum class AnalysisControllerEmitterOptions : uint32_t {
   EmitPTAAsDot = (1 << 12),
   EmitPTAAsJson = (1 << 13),
   EmitStatisticsAsJson = (1 << 14),
+  EmitESGAsTrace = (1 << 15),
 };
 
 class AnalysisController {
@@ -71,6 +75,8 @@ private:
   IFDSIDESolverConfig SolverConfig;
   [[maybe_unused]] Soundness SoundnessLevel;
   [[maybe_unused]] bool AutoGlobalSupport;
+  SummaryLibrary LibrarySummaries;
+  DataFlowAnalysisType CurrentDataFlowAnalysis = DataFlowAnalysisType::None;
 
   ///
   /// \brief The maximum length of the CallStrings used in the InterMonoSolver
@@ -99,6 +105,7 @@ private:
   void executeIDEXTaint();
   void executeIDEOpenSSLTS();
   void executeIDECSTDIOTS();
+  void executeIDEMultiTS();
   void executeIDELinearConst();
   void executeIDESolverTest();
   void executeIDEIIA();
@@ -119,14 +126,31 @@ private:
 
   template <typename AnalysisTy, bool WithConfig = false>
   void executeIFDSAnalysis() {
+    loadSummaryLibrary<IFDSSolver_P<AnalysisTy>>();
     executeAnalysis<IFDSSolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
   }
 
   template <typename AnalysisTy, bool WithConfig = false>
   void executeIDEAnalysis() {
+    loadSummaryLibrary<IDESolver_P<AnalysisTy>>();
     executeAnalysis<IDESolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
   }
 
+  /// Hands the library summaries of the analysis that is about to run to the
+  /// solver.
+  template <class Solver_P> void loadSummaryLibrary() {
+    if (LibrarySummaries.empty()) {
+      return;
+    }
+    [[maybe_unused]] auto NumSummaries =
+        SpecialSummaries<typename Solver_P::d_t, typename Solver_P::l_t>::
+            getInstance()
+                .loadSummaryLibrary(LibrarySummaries,
+                                    toString(CurrentDataFlowAnalysis));
+    PHASAR_LOG_LEVEL(INFO, "Loaded " << NumSummaries << " library summaries for "
+                                     << CurrentDataFlowAnalysis);
+  }
+
   template <class Solver_P, typename AnalysisTy, bool WithConfig>
   void executeAnalysis() {
     if constexpr (WithConfig) {
@@ -136,6 +160,7 @@ private:
           !AnalysisConfigPath.empty()
               ? TaintConfig(IRDB, parseTaintConfig(AnalysisConfigPath))
               : TaintConfig(IRDB);
+      ICF.setTaintRoles(Config);
       WholeProgramAnalysis<Solver_P, AnalysisTy> WPA(
           SolverConfig, IRDB, &Config, EntryPoints, &PT, &ICF, &TH);
       WPA.solve();
@@ -182,6 +207,24 @@ private:
         WPA.dumpResults(llvm::outs());
       }
     }
+    if (EmitterOptions & AnalysisControllerEmitterOptions::EmitESGAsTrace) {
+      // The trace is binary, so never dump it to stdout. Without a result
+      // directory, it goes to the working directory instead.
+      if (!ResultDirectory.empty()) {
+        if (auto OFS = openFileStream("/psr-esg.trace")) {
+          WPA.emitESGAsTrace(*OFS);
+        }
+      } else {
+        std::error_code EC;
+        llvm::raw_fd_ostream OFS("psr-esg.trace", EC);
+        if (EC) {
+          llvm::errs() << "Failed to open file: psr-esg.trace\n"
+                       << EC.message() << '\n';
+        } else {
+          WPA.emitESGAsTrace(OFS);
+        }
+      }
+    }
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitESGAsDot) {
       llvm::outs()
           << "Front-end support for 'EmitESGAsDot' to be implemented\n";
@@ -200,7 +243,9 @@ public:
                      IFDSIDESolverConfig SolverConfig,
                      const std::string &ProjectID = "default-phasar-project",
                      const std::string &OutDirectory = "",
-                     const nlohmann::json &PrecomputedPointsToInfo = {});
+                     const nlohmann::json &PrecomputedPointsToInfo = {},
+                     SummaryLibrary LibrarySummaries = {},
+                     unsigned FieldSensitivityDepth = 0);
 
   ~AnalysisController() = default;
 
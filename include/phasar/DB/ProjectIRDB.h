@@ -22,6 +22,7 @@
 #include "llvm/Passes/PassBuilder.h"
 
 #include "nlohmann/json.hpp"
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionAnalysisCache.h"
 #include "phasar/Utils/EnumFlags.h"
 
 namespace llvm {
@@ -29,12 +30,19 @@ class Value;
 class Instruction;
 class Type;
 class Function;
+class GlobalValue;
 class GlobalVariable;
 } // namespace llvm
 
 namespace psr {
 
-enum class IRDBOptions : uint32_t { NONE = 0, WPA = (1 << 0), OWNS = (1 << 1) };
+enum class IRDBOptions : uint32_t {
+  NONE = 0,
+  WPA = (1 << 0),
+  OWNS = (1 << 1),
+  /// Shrink the IR using the IRNormalizationPass
+  NORMALIZE = (1 << 2)
+};
 
 /**
  * This class owns the LLVM IR code of the project under analysis and some
@@ -59,8 +67,20 @@ private:
   std::vector<std::unique_ptr<llvm::LLVMContext>> Contexts;
   // Contains all modules that correspond to a project and owns them
   std::map<std::string, std::unique_ptr<llvm::Module>> Modules;
+  // Contains the functions phasar synthesizes for a module, e.g. the model of
+  // the C runtime's global ctors and dtors, such that the module itself is
+  // never modified. There is one such module per analyzed module and key,
+  // e.g. per set of entry points. These modules are always owned.
+  std::map<std::pair<const llvm::Module *, std::string>,
+           std::unique_ptr<llvm::Module>>
+      SyntheticModules;
+  // The synthetic modules in the order of their creation, such that the
+  // lookup of their functions by name does not depend on pointer values
+  std::vector<const llvm::Module *> SyntheticModulesInOrder;
   // Maps an id to its corresponding instruction
   std::map<std::size_t, llvm::Instruction *> IDInstructionMapping;
+  // Shares the function analyses, e.g. dominator trees, among all analyses
+  std::unique_ptr<LLVMFunctionAnalysisCache> AnalysisCache;
   size_t NumGlobals = 0;
   size_t NumberCallsites = 0;
   nlohmann::json StatsJson;
@@ -100,6 +120,35 @@ public:
   void insertModule(llvm::Module *M);
   void insertFunction(llvm::Function *F);
 
+  /// Returns the module that holds the functions phasar synthesizes for M
+  /// under the given Key, e.g. for a set of entry points. It is created on
+  /// first use, shares M's context, data layout and target triple, and lives
+  /// as long as the IRDB. It refers to the globals of M through declarations
+  /// only, see resolveSyntheticDeclaration(). Functions that are added to it
+  /// must be registered using insertFunction(); their definitions are found by
+  /// getFunction() and getAllFunctions(). If several synthetic modules define
+  /// a function of the same name, the lookup by name returns the one of the
+  /// synthetic module that has been created first.
+  llvm::Module *getOrCreateSyntheticModule(const llvm::Module &M,
+                                           llvm::StringRef Key);
+  /// Returns the module that holds the functions phasar synthesized for M
+  /// under the given Key, or nullptr if there is none.
+  [[nodiscard]] llvm::Module *getSyntheticModule(const llvm::Module &M,
+                                                 llvm::StringRef Key) const;
+  /// True if M holds functions that phasar synthesized
+  [[nodiscard]] bool isSyntheticModule(const llvm::Module *M) const;
+  /// Returns the definition of the global that GV declares if GV is a
+  /// declaration in a synthetic module, and GV itself otherwise.
+  [[nodiscard]] const llvm::GlobalValue *
+  resolveSyntheticDeclaration(const llvm::GlobalValue *GV) const;
+
+  /// Returns the cache of the function analyses, e.g. dominator trees, of the
+  /// functions in this IRDB. It is invalidated whenever the IRDB changes the
+  /// IR; whoever else changes it has to invalidate it as well.
+  [[nodiscard]] LLVMFunctionAnalysisCache &getAnalysisCache() const {
+    return *AnalysisCache;
+  }
+
   // add WPA support by providing a fat completely linked module
   void linkForWPA();
   // get a completely linked module for the WPA_MODE
@@ -188,6 +237,11 @@ public:
 
   [[nodiscard]] static std::size_t getInstructionID(const llvm::Instruction *I);
 
+  /// Returns the ID of the original instruction that I has been synthesized
+  /// for by the IRNormalizationPass, or I's own ID otherwise.
+  [[nodiscard]] static std::size_t
+  getOriginalInstructionID(const llvm::Instruction *I);
+
   void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const;
 
   void print() const;
@@ -0,0 +1,328 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_PARALLELWHOLEPROGRAMANALYSIS_H_
+#define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_PARALLELWHOLEPROGRAMANALYSIS_H_
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/CallGraphAnalysisType.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFunctionSideEffects.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMThreadSafePointsToSet.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/Utils/Table.h"
+#include "phasar/Utils/TypeTraits.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// The parallel mode of WholeProgramAnalysis for programs with many
+/// independent entry points, e.g. request handlers or exported APIs.
+///
+/// The initial seeds are partitioned by entry point: each entry point gets its
+/// own problem instance, which only seeds that entry point, and its own solver.
+/// The solvers run on a thread pool and share the read-only helper analyses:
+/// the type hierarchy, the ICFG, the points-to information (through a frozen
+/// LLVMThreadSafePointsToSet), the loaded SpecialSummaries and, if
+/// IFDSIDESolverConfig::inferIdentitySummaries() is set, the mod/ref summaries
+/// of the callees (see LLVMFunctionSideEffects), which are computed once for
+/// all solvers. The jump functions and end summaries are not shared, since
+/// they belong to the problem instance of their solver.
+///
+/// After solving, the values that the solvers computed are merged by the
+/// problem's join into a single table, which getSolverResults() provides.
+/// Problem-specific findings, such as the leaks of a taint analysis, remain
+/// per partition and are reported by emitTextReport().
+///
+/// The flow and edge functions of the problem must not modify state that is
+/// shared by several problem instances without synchronization.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class ParallelWholeProgramAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+  static_assert(
+      std::is_same_v<typename Setup::PointerAnalysisTy, LLVMPointsToSet>,
+      "Parallel solving requires LLVMPointsToSet as pointer analysis!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using l_t = typename Solver::l_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  struct Partition {
+    std::string EntryPoint;
+    std::unique_ptr<ProblemDescription> Problem;
+    std::unique_ptr<Solver> DataFlowSolver;
+  };
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  LLVMThreadSafePointsToSet SharedPointerInfo;
+  std::set<std::string> EntryPoints;
+  ConfigurationTy *Config = nullptr;
+  IFDSIDESolverConfig SolverConfig;
+  std::vector<Partition> Partitions;
+  Table<n_t, d_t, l_t> MergedResults;
+
+public:
+  ParallelWholeProgramAnalysis(IFDSIDESolverConfig SolverConfig,
+                               ProjectIRDB &IRDB,
+                               llvm::ArrayRef<std::string> EntryPoints = {},
+                               PointerAnalysisTy *PointerInfo = nullptr,
+                               CallGraphAnalysisTy *CallGraph = nullptr,
+                               TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            &IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        SharedPointerInfo(*this->PointerInfo),
+        EntryPoints(EntryPoints.begin(), EntryPoints.end()),
+        SolverConfig(SolverConfig) {
+    createPartitions();
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ParallelWholeProgramAnalysis(IFDSIDESolverConfig SolverConfig,
+                               ProjectIRDB &IRDB, ConfigurationTy *Config,
+                               llvm::ArrayRef<std::string> EntryPoints = {},
+                               PointerAnalysisTy *PointerInfo = nullptr,
+                               CallGraphAnalysisTy *CallGraph = nullptr,
+                               TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            &IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        SharedPointerInfo(*this->PointerInfo),
+        EntryPoints(EntryPoints.begin(), EntryPoints.end()), Config(Config),
+        SolverConfig(SolverConfig) {
+    createPartitions();
+  }
+
+  ParallelWholeProgramAnalysis(const ParallelWholeProgramAnalysis &) = delete;
+  ParallelWholeProgramAnalysis(ParallelWholeProgramAnalysis &&) = delete;
+  ParallelWholeProgramAnalysis &
+  operator=(ParallelWholeProgramAnalysis &) = delete;
+  ParallelWholeProgramAnalysis &
+  operator=(ParallelWholeProgramAnalysis &&) = delete;
+
+  ~ParallelWholeProgramAnalysis() = default;
+
+  /// Solves all partitions using at most NumThreads threads; 0 uses one thread
+  /// per hardware thread. Afterwards, the merged results are available.
+  void solve(unsigned NumThreads = 0) {
+    {
+      llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+      std::vector<std::shared_future<void>> Tasks;
+      Tasks.reserve(Partitions.size());
+      for (auto &P : Partitions) {
+        Tasks.push_back(Pool.async([&P] { P.DataFlowSolver->solve(); }));
+      }
+      Pool.wait();
+      // Rethrow the first exception that a solver has thrown, if any
+      for (auto &Task : Tasks) {
+        Task.get();
+      }
+    }
+    mergeResults();
+  }
+
+  void operator()() { solve(); }
+
+  [[nodiscard]] size_t getNumPartitions() const noexcept {
+    return Partitions.size();
+  }
+
+  [[nodiscard]] const std::string &getEntryPoint(size_t Idx) const {
+    return Partitions[Idx].EntryPoint;
+  }
+
+  [[nodiscard]] ProblemDescription &getProblem(size_t Idx) {
+    return *Partitions[Idx].Problem;
+  }
+
+  [[nodiscard]] Solver &getSolver(size_t Idx) {
+    return *Partitions[Idx].DataFlowSolver;
+  }
+
+  /// Returns the joined results of all partitions
+  [[nodiscard]] SolverResults<n_t, d_t, l_t> getSolverResults() {
+    return SolverResults<n_t, d_t, l_t>(
+        MergedResults, Partitions.front().Problem->getZeroValue());
+  }
+
+  [[nodiscard]] l_t resultAt(n_t Stmt, d_t Value) {
+    return getSolverResults().resultAt(Stmt, Value);
+  }
+
+  [[nodiscard]] std::unordered_map<d_t, l_t> resultsAt(n_t Stmt,
+                                                       bool StripZero = false) {
+    return getSolverResults().resultsAt(Stmt, StripZero);
+  }
+
+  void emitTextReport(llvm::raw_ostream &OS = llvm::outs()) {
+    for (auto &P : Partitions) {
+      OS << "\n===== Entry point: " << P.EntryPoint << " =====\n";
+      P.DataFlowSolver->emitTextReport(OS);
+    }
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+private:
+  /// Creates one problem instance and solver per entry point. "__ALL__" stands
+  /// for all function definitions, like in the problems' initialSeeds().
+  void createPartitions() {
+    std::vector<std::string> PartitionEntryPoints;
+    if (EntryPoints.size() == 1 && EntryPoints.count("__ALL__")) {
+      for (const auto *F : IRDB.getAllFunctions()) {
+        if (!F->isDeclaration()) {
+          PartitionEntryPoints.push_back(F->getName().str());
+        }
+      }
+    } else {
+      PartitionEntryPoints.assign(EntryPoints.begin(), EntryPoints.end());
+    }
+    if (PartitionEntryPoints.empty()) {
+      llvm::report_fatal_error(
+          "ParallelWholeProgramAnalysis requires at least one entry point");
+    }
+    if constexpr (!std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      if (Config == nullptr) {
+        llvm::report_fatal_error("The analysis requires a configuration");
+      }
+    }
+
+    // The points-to sets are computed lazily otherwise, which may change the
+    // sets of global variables while other solvers read them
+    SharedPointerInfo.freeze(IRDB);
+
+    std::shared_ptr<const LLVMFunctionSideEffects> InferredSummaries;
+    if (SolverConfig.inferIdentitySummaries()) {
+      InferredSummaries =
+          std::make_shared<const LLVMFunctionSideEffects>(*CallGraph);
+    }
+
+    Partitions.reserve(PartitionEntryPoints.size());
+    for (auto &EntryPoint : PartitionEntryPoints) {
+      auto &P = Partitions.emplace_back();
+      P.EntryPoint = std::move(EntryPoint);
+      std::set<std::string> PartitionEntry{P.EntryPoint};
+      if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+        P.Problem = std::make_unique<ProblemDescription>(
+            &IRDB, TypeHierarchy.get(), CallGraph.get(), &SharedPointerInfo,
+            std::move(PartitionEntry));
+      } else {
+        P.Problem = std::make_unique<ProblemDescription>(
+            &IRDB, TypeHierarchy.get(), CallGraph.get(), &SharedPointerInfo,
+            *Config, std::move(PartitionEntry));
+      }
+      // The solver reads its configuration on construction
+      if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
+        P.Problem->setIFDSIDESolverConfig(SolverConfig);
+      }
+      P.DataFlowSolver = std::make_unique<Solver>(*P.Problem);
+      if (InferredSummaries) {
+        P.DataFlowSolver->setInferredSummaries(InferredSummaries);
+      }
+    }
+  }
+
+  void mergeResults() {
+    MergedResults.clear();
+    for (auto &P : Partitions) {
+      for (const auto &Cell :
+           P.DataFlowSolver->getSolverResults().getAllResultEntries()) {
+        auto &Row = MergedResults.row(Cell.getRowKey());
+        auto [It, Inserted] =
+            Row.try_emplace(Cell.getColumnKey(), Cell.getValue());
+        if (!Inserted) {
+          It->second = join(It->second, Cell.getValue());
+        }
+      }
+    }
+  }
+
+  l_t join(l_t Lhs, l_t Rhs) {
+    if constexpr (std::is_same_v<l_t, BinaryDomain>) {
+      // IFDS problems have no join of their own, use the one of their IDE
+      // transformation (see IFDSToIDETabulationProblem)
+      if (Lhs == BinaryDomain::TOP && Rhs == BinaryDomain::TOP) {
+        return BinaryDomain::TOP;
+      }
+      return BinaryDomain::BOTTOM;
+    } else {
+      return Partitions.front().Problem->join(std::move(Lhs), std::move(Rhs));
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
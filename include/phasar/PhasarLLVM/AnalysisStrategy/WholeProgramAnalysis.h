@@ -25,6 +25,15 @@
 
 namespace psr {
 
+namespace detail {
+template <typename T, typename = void>
+struct has_emitESGAsTrace : std::false_type {}; // NOLINT
+template <typename T>
+struct has_emitESGAsTrace< // NOLINT
+    T, std::void_t<decltype(std::declval<T &>().emitESGAsTrace(
+           std::declval<llvm::raw_ostream &>()))>> : std::true_type {};
+} // namespace detail
+
 template <typename Solver, typename ProblemDescription,
           typename Setup = psr::DefaultAnalysisSetup>
 class WholeProgramAnalysis {
@@ -176,6 +185,14 @@ public:
     // }
   }
 
+  void emitESGAsTrace(llvm::raw_ostream &OS) {
+    if constexpr (detail::has_emitESGAsTrace<Solver>::value) {
+      DataFlowSolver.emitESGAsTrace(OS);
+    } else {
+      llvm::errs() << "The selected solver cannot emit an ESG trace\n";
+    }
+  }
+
   void releaseAllHelperAnalyses() {
     releasePointerInformation();
     releaseCallGraph();
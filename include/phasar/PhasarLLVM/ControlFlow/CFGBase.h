@@ -114,6 +114,14 @@ public:
   getSpecialMemberFunctionType(ByConstRef<f_t> Fun) const {
     return self().getSpecialMemberFunctionTypeImpl(Fun);
   }
+  /// Returns the classification of the given function, e.g. whether it is a
+  /// declaration or allocates heap memory. NOTE: This function is typically
+  /// called at every call-site and should therefore be answered from a
+  /// precomputed table
+  [[nodiscard]] decltype(auto)
+  getFunctionAttributes(ByConstRef<f_t> Fun) const {
+    return self().getFunctionAttributesImpl(Fun);
+  }
   [[nodiscard]] decltype(auto) getStatementId(ByConstRef<n_t> Inst) const {
     static_assert(is_string_like_v<decltype(self().getStatementIdImpl(Inst))>);
     return self().getStatementIdImpl(Inst);
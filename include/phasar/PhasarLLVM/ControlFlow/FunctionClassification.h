@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_FUNCTIONCLASSIFICATION_H
+#define PHASAR_PHASARLLVM_CONTROLFLOW_FUNCTIONCLASSIFICATION_H
+
+#include "phasar/PhasarLLVM/ControlFlow/SpecialMemberFunctionType.h"
+#include "phasar/Utils/EnumFlags.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringSet.h"
+
+#include <cstdint>
+
+namespace llvm {
+class Function;
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/// The properties of a function that flow functions commonly check at call
+/// sites. Can be combined as bit-flags.
+enum class FunctionClass : uint16_t {
+  None = 0,
+  /// The function has no body in the analyzed IR
+  Declaration = (1 << 0),
+  /// The function is an LLVM intrinsic, e.g. llvm.memcpy
+  LLVMIntrinsic = (1 << 1),
+  /// The function is one of PhasarConfig's special functions, e.g. a glibc
+  /// function
+  SpecialFunction = (1 << 2),
+  /// The function allocates heap memory, e.g. malloc or operator new
+  HeapAllocating = (1 << 3),
+  /// At least one parameter of the function is a taint source
+  TaintSource = (1 << 4),
+  /// At least one parameter of the function is a taint sink
+  TaintSink = (1 << 5),
+  /// At least one parameter of the function is sanitized by the function
+  TaintSanitizer = (1 << 6),
+  AnyTaintRole = TaintSource | TaintSink | TaintSanitizer,
+};
+
+struct FunctionAttributes {
+  FunctionClass Classes = FunctionClass::None;
+  SpecialMemberFunctionType SpecialMemberKind = SpecialMemberFunctionType::None;
+
+  [[nodiscard]] bool is(FunctionClass Class) const noexcept {
+    return bool(Classes & Class);
+  }
+  [[nodiscard]] bool isDeclaration() const noexcept {
+    return is(FunctionClass::Declaration);
+  }
+  [[nodiscard]] bool isLLVMIntrinsic() const noexcept {
+    return is(FunctionClass::LLVMIntrinsic);
+  }
+  [[nodiscard]] bool isSpecialFunction() const noexcept {
+    return is(FunctionClass::SpecialFunction);
+  }
+  [[nodiscard]] bool isHeapAllocating() const noexcept {
+    return is(FunctionClass::HeapAllocating);
+  }
+  [[nodiscard]] bool isSpecialMemberFunction() const noexcept {
+    return SpecialMemberKind != SpecialMemberFunctionType::None;
+  }
+  [[nodiscard]] bool hasTaintRole() const noexcept {
+    return is(FunctionClass::AnyTaintRole);
+  }
+
+  friend bool operator==(const FunctionAttributes &Lhs,
+                         const FunctionAttributes &Rhs) noexcept {
+    return Lhs.Classes == Rhs.Classes &&
+           Lhs.SpecialMemberKind == Rhs.SpecialMemberKind;
+  }
+  friend bool operator!=(const FunctionAttributes &Lhs,
+                         const FunctionAttributes &Rhs) noexcept {
+    return !(Lhs == Rhs);
+  }
+};
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                              const FunctionAttributes &Attrs);
+
+/// Classifies all functions of a ProjectIRDB once, such that flow functions
+/// can check the properties of a callee with a single lookup instead of
+/// matching its name at every call site and for every data-flow fact.
+///
+/// The LLVMBasedICFG builds a classification of its IRDB, which is available
+/// through CFGBase::getFunctionAttributes(). Taint roles depend on the taint
+/// configuration and are added via LLVMBasedICFG::setTaintRoles().
+class LLVMFunctionClassification {
+public:
+  LLVMFunctionClassification();
+  explicit LLVMFunctionClassification(const ProjectIRDB &IRDB);
+
+  /// Classifies all functions of IRDB
+  void classify(const ProjectIRDB &IRDB);
+  /// Classifies F, e.g. after it has been added to the IR, and returns its
+  /// attributes. Taint roles of F are kept.
+  const FunctionAttributes &classify(const llvm::Function *F);
+
+  /// Returns the attributes of F or nullptr if F has not been classified.
+  [[nodiscard]] const FunctionAttributes *
+  lookup(const llvm::Function *F) const {
+    auto It = Attributes.find(F);
+    return It != Attributes.end() ? &It->second : nullptr;
+  }
+
+  /// Returns the attributes of F. Computes them on-the-fly if F has not been
+  /// classified, which is as slow as classifying by name at the call site.
+  [[nodiscard]] FunctionAttributes getAttributes(const llvm::Function *F) const;
+
+  /// Adds the classes computed by Classifier to all classified functions.
+  void addFunctionClasses(
+      llvm::function_ref<FunctionClass(const llvm::Function *)> Classifier);
+  /// Removes Classes from all classified functions, e.g. the taint roles of a
+  /// previous taint configuration.
+  void removeFunctionClasses(FunctionClass Classes);
+
+  [[nodiscard]] size_t size() const noexcept { return Attributes.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Attributes.empty(); }
+
+  [[nodiscard]] static bool isHeapAllocatingFunction(const llvm::Function *F);
+  [[nodiscard]] static SpecialMemberFunctionType
+  getSpecialMemberFunctionType(const llvm::Function *F);
+
+private:
+  [[nodiscard]] FunctionAttributes
+  computeAttributes(const llvm::Function *F) const;
+
+  llvm::DenseMap<const llvm::Function *, FunctionAttributes> Attributes;
+  /// A snapshot of PhasarConfig::specialFunctionNames()
+  llvm::StringSet<> SpecialFunctionNames;
+};
+
+} // namespace psr
+
+#endif // PHASAR_PHASARLLVM_CONTROLFLOW_FUNCTIONCLASSIFICATION_H
@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDCFG_H_
 
 #include "phasar/PhasarLLVM/ControlFlow/CFGBase.h"
+#include "phasar/PhasarLLVM/ControlFlow/FunctionClassification.h"
 
 #include "nlohmann/json.hpp"
 
@@ -48,11 +49,25 @@ public:
     return IgnoreDbgInstructions;
   }
 
+  /// Answers the function checks of this CFG, e.g.
+  /// isHeapAllocatingFunction(), from the given precomputed classification
+  /// instead of matching the function names. Functions that are not contained
+  /// in FunClasses are still classified on-the-fly.
+  void setFunctionClassification(
+      const LLVMFunctionClassification *FunClasses) noexcept {
+    this->FunClasses = FunClasses;
+  }
+  [[nodiscard]] const LLVMFunctionClassification *
+  getFunctionClassification() const noexcept {
+    return FunClasses;
+  }
+
 protected:
   LLVMBasedCFGImpl(bool IgnoreDbgInstructions = true) noexcept
       : IgnoreDbgInstructions(IgnoreDbgInstructions) {}
 
   bool IgnoreDbgInstructions = false;
+  const LLVMFunctionClassification *FunClasses = nullptr;
 
   [[nodiscard]] f_t getFunctionOfImpl(n_t Inst) const noexcept;
   [[nodiscard]] llvm::SmallVector<n_t, 2> getPredsOfImpl(n_t Inst) const;
@@ -84,6 +99,7 @@ protected:
   }
   [[nodiscard]] SpecialMemberFunctionType
   getSpecialMemberFunctionTypeImpl(f_t Fun) const;
+  [[nodiscard]] FunctionAttributes getFunctionAttributesImpl(f_t Fun) const;
   [[nodiscard]] std::string getStatementIdImpl(n_t Inst) const;
   [[nodiscard]] auto getFunctionNameImpl(f_t Fun) const {
     return Fun->getName();
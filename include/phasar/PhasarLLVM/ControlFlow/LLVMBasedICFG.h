@@ -18,6 +18,7 @@
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDICFG_H_
 
 #include "phasar/PhasarLLVM/ControlFlow/CFGBase.h"
+#include "phasar/PhasarLLVM/ControlFlow/FunctionClassification.h"
 #include "phasar/PhasarLLVM/ControlFlow/ICFGBase.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/CallGraphAnalysisType.h"
@@ -52,6 +53,7 @@ class ProjectIRDB;
 class LLVMPointsToInfo;
 class ProjectIRDB;
 class LLVMTypeHierarchy;
+class TaintConfig;
 
 class LLVMBasedICFG;
 template <> struct CFGTraits<LLVMBasedICFG> : CFGTraits<LLVMBasedCFG> {};
@@ -119,6 +121,29 @@ public:
   /// Gets the underlying IRDB
   [[nodiscard]] ProjectIRDB *getIRDB() const noexcept { return IRDB; }
 
+  /// Adds the classes computed by Classifier to the precomputed classification
+  /// of all functions in the IRDB.
+  void addFunctionClasses(
+      llvm::function_ref<FunctionClass(const llvm::Function *)> Classifier) {
+    FunctionClasses.addFunctionClasses(Classifier);
+    TaintRolesOf = nullptr;
+  }
+  /// Removes Classes from the precomputed classification of all functions
+  void removeFunctionClasses(FunctionClass Classes) {
+    FunctionClasses.removeFunctionClasses(Classes);
+    TaintRolesOf = nullptr;
+  }
+  /// Replaces the taint roles in the precomputed classification by the ones
+  /// given by Config, see TaintConfig::getTaintRole(). Taint analyses that
+  /// are configured by Config then look up the roles of their callees instead
+  /// of scanning the callee's parameters at every call site.
+  void setTaintRoles(const TaintConfig &Config);
+  /// Returns true if the taint roles in the precomputed classification have
+  /// been set from Config.
+  [[nodiscard]] bool hasTaintRolesOf(const TaintConfig &Config) const noexcept {
+    return TaintRolesOf == &Config;
+  }
+
   using CFGBase::print;
   using ICFGBase::print;
 
@@ -141,8 +166,14 @@ private:
   void printImpl(llvm::raw_ostream &OS) const;
   [[nodiscard]] nlohmann::json getAsJsonImpl() const;
 
+  /// Builds a function that calls the global ctors of M, the user entry
+  /// points and the global dtors of M in the order of the C runtime. The model
+  /// is built into the IRDB's synthetic module for M and the given entry
+  /// points, so M is not modified and the models of other ICFGs stay intact.
+  /// A model that has already been built for the same entry points is
+  /// reused.
   [[nodiscard]] llvm::Function *buildCRuntimeGlobalCtorsDtorsModel(
-      llvm::Module &M, llvm::ArrayRef<llvm::Function *> UserEntryPoints);
+      const llvm::Module &M, llvm::ArrayRef<llvm::Function *> UserEntryPoints);
 
   // -------------------- Utilities --------------------
 
@@ -174,7 +205,13 @@ private:
   llvm::SmallVector<const llvm::Function *, 0> VertexFunctions;
 
   ProjectIRDB *IRDB = nullptr;
+  // The synthetic module that holds the model of the global ctors and dtors
+  // this ICFG has been built with, if any
+  const llvm::Module *GlobalModelModule = nullptr;
   MaybeUniquePtr<LLVMTypeHierarchy, true> TH;
+  LLVMFunctionClassification FunctionClasses;
+  // The taint configuration the taint roles in FunctionClasses stem from
+  const TaintConfig *TaintRolesOf = nullptr;
 };
 } // namespace psr
 
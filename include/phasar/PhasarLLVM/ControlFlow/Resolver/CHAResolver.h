@@ -17,11 +17,17 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_CHARESOLVER_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_CHARESOLVER_H_
 
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h"
 
 namespace llvm {
 class CallBase;
 class Function;
+class StructType;
 } // namespace llvm
 
 namespace psr {
@@ -34,6 +40,28 @@ public:
   FunctionSetTy resolveVirtualCall(const llvm::CallBase *CallSite) override;
 
   [[nodiscard]] std::string str() const override;
+
+protected:
+  /// A (receiver type, vtable index) pair that identifies a virtual call
+  using VirtualCallKeyTy = std::pair<const llvm::StructType *, unsigned>;
+  /// The non-pure-virtual targets of a virtual call together with the
+  /// (sub-)type whose vtable provides them
+  using DispatchTableTy = llvm::SmallVector<
+      std::pair<const llvm::StructType *, const llvm::Function *>, 4>;
+
+  /**
+   * Returns the dispatch table of a call to the vtable entry VtableIndex on a
+   * receiver of type ReceiverTy, considering ReceiverTy and all its subtypes.
+   * Many call sites share the same receiver type and vtable index, so the
+   * table is computed only once per pair.
+   */
+  const DispatchTableTy &getDispatchTable(const llvm::StructType *ReceiverTy,
+                                          unsigned VtableIndex,
+                                          const llvm::CallBase *CallSite);
+
+private:
+  llvm::DenseMap<VirtualCallKeyTy, DispatchTableTy> DispatchTables;
+  llvm::DenseMap<VirtualCallKeyTy, FunctionSetTy> PossibleCalleesCache;
 };
 } // namespace psr
 
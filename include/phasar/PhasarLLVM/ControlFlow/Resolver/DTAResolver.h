@@ -22,13 +22,18 @@
 // To switch the TypeGraph
 //#include "phasar/PhasarLLVM/Pointer/TypeGraphs/LazyTypeGraph.h"
 
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+
 #include <string>
+#include <utility>
 
 namespace llvm {
 class Instruction;
 class CallBase;
 class Function;
 class BitCastInst;
+class StructType;
 } // namespace llvm
 
 namespace psr {
@@ -39,6 +44,13 @@ public:
 
 protected:
   TypeGraph_t TypeGraph;
+  /// The ids of the sub-types of a receiver type in TypeGraph, together with
+  /// the number of types in TypeGraph when they were computed
+  llvm::DenseMap<const llvm::StructType *, std::pair<size_t, llvm::BitVector>>
+      SubTypeIds;
+
+  /// Returns the ids of ReceiverType and its sub-types in TypeGraph
+  const llvm::BitVector &getSubTypeIds(const llvm::StructType *ReceiverType);
 
   /**
    * An heuristic that return true if the bitcast instruction is interesting to
@@ -17,6 +17,9 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_RTARESOLVER_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_RTARESOLVER_H_
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h"
 
 namespace llvm {
@@ -35,6 +38,11 @@ public:
   FunctionSetTy resolveVirtualCall(const llvm::CallBase *CallSite) override;
 
   [[nodiscard]] std::string str() const override;
+
+private:
+  /// The struct types that are allocated in the IRDB
+  llvm::DenseSet<const llvm::StructType *> AllocatedStructTypes;
+  llvm::DenseMap<VirtualCallKeyTy, FunctionSetTy> PossibleCallTargetsCache;
 };
 } // namespace psr
 
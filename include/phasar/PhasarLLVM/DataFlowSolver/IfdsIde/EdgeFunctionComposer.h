@@ -12,7 +12,14 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 
+#include "llvm/ADT/Hashing.h"
+
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace psr {
 
@@ -22,13 +29,23 @@ namespace psr {
  *  F -> G -> otherFunction
  * i.e. F is computed before G, G is computed before otherFunction.
  *
+ * Internally, the composition is kept as a flattened sequence of the edge
+ * functions it consists of: nested composers are inlined and edge identities
+ * are dropped, so that computeTarget() is a loop over a contiguous array
+ * rather than a walk over a tree of composers. Identical sequences are
+ * hash-consed, i.e. shared between all composers that consist of the very
+ * same edge functions. Analyses may pass a normalizer to the constructor to
+ * simplify the sequence further, e.g. by merging adjacent functions that can
+ * be composed in closed form. The sequence is computed once on construction
+ * and never changes afterwards, so composers can be shared between threads.
+ *
  * Note that an own implementation for the join function is required, since
  * this varies between different analyses, and is not implemented by this
  * class.
  * It is also advised to provide a more precise compose function, which is able
  * to reduce the result of the composition, rather than using the default
  * implementation. By default, an explicit composition is used. Such a function
- * definition can grow unduly large.
+ * definition can grow unduly large, unless makeComposer() is provided.
  */
 template <typename L>
 class EdgeFunctionComposer
@@ -36,11 +53,64 @@ class EdgeFunctionComposer
       public std::enable_shared_from_this<EdgeFunctionComposer<L>> {
 public:
   using typename EdgeFunction<L>::EdgeFunctionPtrType;
+  /// The composed edge functions in the order they are applied
+  using SequenceTy = std::vector<EdgeFunctionPtrType>;
+  using SequencePtrType = std::shared_ptr<const SequenceTy>;
+  /// Simplifies a flattened sequence of edge functions in place
+  using NormalizerTy = void (*)(SequenceTy &);
 
 private:
   // For debug purpose only
   const unsigned EFComposerId;
-  static inline unsigned CurrEFComposerId = 0; // NOLINT
+  static inline std::atomic<unsigned> CurrEFComposerId{0}; // NOLINT
+
+  SequencePtrType Sequence;
+
+  static void appendFlattened(SequenceTy &Seq, const EdgeFunctionPtrType &EF) {
+    if (dynamic_cast<EdgeIdentity<L> *>(EF.get())) {
+      return;
+    }
+    if (auto *EFC = dynamic_cast<EdgeFunctionComposer<L> *>(EF.get())) {
+      Seq.insert(Seq.end(), EFC->Sequence->begin(), EFC->Sequence->end());
+      return;
+    }
+    Seq.push_back(EF);
+  }
+
+  /// Returns the sequence that consists of the same edge functions as Seq if
+  /// there is one already, or Seq otherwise
+  static SequencePtrType intern(SequenceTy Seq) {
+    static std::mutex Mtx;
+    static std::unordered_multimap<size_t, std::weak_ptr<const SequenceTy>>
+        Sequences;
+    static size_t PruneThreshold = 1024;
+
+    size_t Hash = 0;
+    for (const auto &EF : Seq) {
+      Hash = llvm::hash_combine(Hash, EF.get());
+    }
+
+    std::lock_guard Lock(Mtx);
+    auto [Begin, End] = Sequences.equal_range(Hash);
+    for (auto It = Begin; It != End; ++It) {
+      // The elements of a live sequence are kept alive by it, so their
+      // addresses cannot have been reused
+      if (auto Existing = It->second.lock();
+          Existing && std::equal(Existing->begin(), Existing->end(),
+                                 Seq.begin(), Seq.end())) {
+        return Existing;
+      }
+    }
+    if (Sequences.size() >= PruneThreshold) {
+      for (auto It = Sequences.begin(); It != Sequences.end();) {
+        It = It->second.expired() ? Sequences.erase(It) : std::next(It);
+      }
+      PruneThreshold = std::max<size_t>(1024, 2 * Sequences.size());
+    }
+    auto Ret = std::make_shared<const SequenceTy>(std::move(Seq));
+    Sequences.emplace(Hash, Ret);
+    return Ret;
+  }
 
 protected:
   /// First edge function
@@ -48,23 +118,54 @@ protected:
   /// Second edge function
   EdgeFunctionPtrType G;
 
+  /// Hook for analyses to create a composer of their own type for F followed
+  /// by G. If provided, composeWith() creates a single new composer whose
+  /// sequence extends this one, instead of re-composing F and G recursively.
+  [[nodiscard]] virtual EdgeFunctionPtrType
+  makeComposer(EdgeFunctionPtrType /*F*/, EdgeFunctionPtrType /*G*/) const {
+    return nullptr;
+  }
+
 public:
-  EdgeFunctionComposer(EdgeFunctionPtrType &F, EdgeFunctionPtrType &G)
-      : EFComposerId(++CurrEFComposerId), F(F), G(G) {}
+  /// Composes F and G. If given, Normalize simplifies the flattened sequence,
+  /// e.g. by merging adjacent functions or by dropping the functions before a
+  /// constant function.
+  EdgeFunctionComposer(EdgeFunctionPtrType F, EdgeFunctionPtrType G,
+                       NormalizerTy Normalize = nullptr)
+      : EFComposerId(++CurrEFComposerId), F(std::move(F)), G(std::move(G)) {
+    SequenceTy Seq;
+    appendFlattened(Seq, this->F);
+    appendFlattened(Seq, this->G);
+    if (Normalize) {
+      Normalize(Seq);
+    }
+    Sequence = intern(std::move(Seq));
+  }
 
   ~EdgeFunctionComposer() override = default;
 
+  /// Returns the flattened and normalized sequence of the composed edge
+  /// functions
+  [[nodiscard]] const SequencePtrType &getSequence() const noexcept {
+    return Sequence;
+  }
+
   /**
    * Target value computation is implemented as
    *     G(F(source))
+   * by applying the flattened sequence of edge functions in order.
    */
-  L computeTarget(L Source) override {
-    return G->computeTarget(F->computeTarget(Source));
+  L computeTarget(L Source) final {
+    for (const auto &EF : *getSequence()) {
+      Source = EF->computeTarget(std::move(Source));
+    }
+    return Source;
   }
 
   /**
    * Function composition is implemented as an explicit composition, i.e.
    *     (secondFunction * G) * F = EFC(F, EFC(G , otherFunction))
+   * or, if makeComposer() is provided, as EFC(EFC(F, G), otherFunction).
    *
    * However, it is advised to immediately reduce the resulting edge function
    * by providing an own implementation of this function.
@@ -76,6 +177,9 @@ public:
     if (auto *AB = dynamic_cast<AllBottom<L> *>(SecondFunction.get())) {
       return this->shared_from_this();
     }
+    if (auto EFC = makeComposer(this->shared_from_this(), SecondFunction)) {
+      return EFC;
+    }
     return F->composeWith(G->composeWith(SecondFunction));
   }
 
@@ -85,7 +189,14 @@ public:
   bool equal_to // NOLINT - would break too many client analyses
       (EdgeFunctionPtrType Other) const override {
     if (auto EFC = dynamic_cast<EdgeFunctionComposer<L> *>(Other.get())) {
-      return F->equal_to(EFC->F) && G->equal_to(EFC->G);
+      const auto &Seq = getSequence();
+      const auto &OtherSeq = EFC->getSequence();
+      return Seq == OtherSeq ||
+             std::equal(Seq->begin(), Seq->end(), OtherSeq->begin(),
+                        OtherSeq->end(),
+                        [](const auto &EF1, const auto &EF2) {
+                          return EF1 == EF2 || EF1->equal_to(EF2);
+                        });
     }
     return false;
   }
@@ -181,6 +181,18 @@ public:
   FlowEdgeFunctionCache &
   operator=(FlowEdgeFunctionCache &&FEFC) noexcept = default;
 
+  /// Removes all cached flow and edge functions.
+  void clear() {
+    NormalFunctionCache.clear();
+    CallFlowFunctionCache.clear();
+    ReturnFlowFunctionCache.clear();
+    CallToRetFlowFunctionCache.clear();
+    CallEdgeFunctionCache.clear();
+    ReturnEdgeFunctionCache.clear();
+    CallToRetEdgeFunctionCache.clear();
+    SummaryEdgeFunctionCache.clear();
+  }
+
   FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) {
     PAMM_GET_INSTANCE;
     IF_LOG_ENABLED(
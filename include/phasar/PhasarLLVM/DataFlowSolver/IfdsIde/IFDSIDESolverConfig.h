@@ -35,6 +35,11 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  InferIdentitySummaries = 64,
+  AdaptivePrecision = 128,
+  SpillJumpFunctions = 256,
+  CompressFactClasses = 512,
+  SolveWithBitVectors = 1024,
 
   All = ~0U
 };
@@ -55,6 +60,34 @@ struct IFDSIDESolverConfig {
   [[nodiscard]] bool recordEdges() const;
   [[nodiscard]] bool emitESG() const;
   [[nodiscard]] bool computePersistedSummaries() const;
+  /// Skip callees that cannot affect pointer-typed data-flow facts, based on
+  /// a mod/ref pre-analysis over the call-graph (see LLVMFunctionSideEffects).
+  /// Callees that only write through their pointer arguments are treated as
+  /// kill-only, i.e. the facts passed to them are solely handled by the
+  /// call-to-return flow function.
+  [[nodiscard]] bool inferIdentitySummaries() const;
+  /// Coarsen the data-flow facts (see IFDSTabulationProblem::coarsenFact())
+  /// in functions in which the number of facts per node or per function
+  /// exceeds the fact limits. Trades precision for guaranteed completion on
+  /// outlier inputs.
+  [[nodiscard]] bool adaptivePrecision() const;
+  [[nodiscard]] size_t maxFactsPerNode() const;
+  [[nodiscard]] size_t maxFactsPerFunction() const;
+  /// Move the jump functions of the least recently used functions to a
+  /// temporary file once more than maxResidentJumpFunctions() of them are held
+  /// in memory (see JumpFunctions::enableSpilling()).
+  [[nodiscard]] bool spillJumpFunctions() const;
+  [[nodiscard]] size_t maxResidentJumpFunctions() const;
+  /// Propagate facts that are generated together and are preserved alike by
+  /// the normal flow functions as a single representative fact with a set of
+  /// members, instead of one path edge per fact. Classes split at call sites
+  /// and exits and whenever a member's flow diverges from the representative.
+  /// Has no effect if adaptivePrecision() is set.
+  [[nodiscard]] bool compressFactClasses() const;
+  /// Solve problems that provide a dedicated bit-vector solver (currently
+  /// IFDSUninitializedVariables::solveWithBitVectors()) with that solver
+  /// instead of the IFDS/IDE solver.
+  [[nodiscard]] bool solveWithBitVectors() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
@@ -62,6 +95,13 @@ struct IFDSIDESolverConfig {
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
   void setComputePersistedSummaries(bool Set = true);
+  void setInferIdentitySummaries(bool Set = true);
+  void setAdaptivePrecision(bool Set = true);
+  void setFactLimits(size_t MaxPerNode, size_t MaxPerFunction);
+  void setSpillJumpFunctions(bool Set = true);
+  void setMaxResidentJumpFunctions(size_t MaxResident);
+  void setCompressFactClasses(bool Set = true);
+  void setSolveWithBitVectors(bool Set = true);
 
   void setConfig(SolverConfigOptions Opt);
 
@@ -72,6 +112,9 @@ private:
   SolverConfigOptions Options = SolverConfigOptions::AutoAddZero |
                                 SolverConfigOptions::ComputeValues |
                                 SolverConfigOptions::RecordEdges;
+  size_t MaxFactsPerNode = 1000;
+  size_t MaxFactsPerFunction = 100000;
+  size_t MaxResidentJumpFunctions = 1000000;
 };
 
 } // namespace psr
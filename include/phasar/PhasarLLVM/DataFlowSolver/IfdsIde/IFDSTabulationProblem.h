@@ -90,6 +90,15 @@ public:
   /// statements to initial analysis facts.
   [[nodiscard]] virtual InitialSeeds<n_t, d_t, l_t> initialSeeds() = 0;
 
+  /// Returns a fact that over-approximates Fact at a coarser precision, e.g.
+  /// by collapsing an access path towards its base, or Fact itself if it
+  /// cannot be coarsened any further. Used by the solver if
+  /// IFDSIDESolverConfig::adaptivePrecision() is set; Level starts at 1 and
+  /// grows each time a function exceeds the (doubled) fact limits again.
+  [[nodiscard]] virtual d_t coarsenFact(d_t Fact, unsigned /*Level*/) {
+    return Fact;
+  }
+
   /// Returns the special tautological lambda (or zero) fact.
   [[nodiscard]] d_t getZeroValue() const { return ZeroValue; }
 
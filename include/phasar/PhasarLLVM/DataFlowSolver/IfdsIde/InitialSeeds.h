@@ -76,7 +76,7 @@ public:
 
     auto printNode = [&](auto &&Node) { // NOLINT
       if constexpr (std::is_same_v<const llvm::Instruction *, N>) {
-        OS << llvmIRToString(Node);
+        OS << llvmIRToStringRef(Node);
       } else {
         OS << Node;
       }
@@ -84,7 +84,7 @@ public:
 
     auto printFact = [&](auto &&Node) { // NOLINT
       if constexpr (std::is_same_v<const llvm::Value *, D>) {
-        OS << llvmIRToString(Node);
+        OS << llvmIRToStringRef(Node);
       } else {
         OS << Node;
       }
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_LLVMFUNCTIONSIDEEFFECTS_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_LLVMFUNCTIONSIDEEFFECTS_H
+
+#include <cstdint>
+#include <string>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "phasar/Utils/EnumFlags.h"
+
+namespace llvm {
+class CallBase;
+class Function;
+class Value;
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMBasedICFG;
+
+/// Side effects of a function on memory that is visible to its callers, i.e.
+/// everything but the function's own stack frame. The effects of all
+/// (transitive) callees are included.
+enum class FunctionSideEffects : uint8_t {
+  None = 0,
+  ReadsMemory = 1,
+  WritesMemory = 2,
+  /// Takes the address of a mutable global variable or obtains a pointer of
+  /// unknown origin from a callee
+  UsesGlobals = 4,
+  /// Stores a pointer into caller-visible memory or converts it to an integer
+  CapturesPointer = 8,
+  ReturnsPointer = 16,
+  /// Calls an external function without memory attributes or an unresolved
+  /// indirect call
+  Unknown = 32,
+};
+
+enum class InferredSummaryKind {
+  /// The function needs to be analyzed
+  None,
+  /// Pointer-typed facts are neither modified, nor aliased, nor created by the
+  /// function, so they hold unchanged after the call
+  Identity,
+  /// The function only writes through its pointer arguments and never reads
+  /// caller-visible memory, so it can only invalidate the facts passed to it
+  KillOnly,
+};
+
+/// How a single data-flow fact that holds at a call-site is affected by a
+/// callee with an inferred summary.
+enum class InferredFactEffect {
+  /// No summary applies; the solver must descend into the callee
+  Unknown,
+  /// The fact holds at the return-site
+  Preserve,
+  /// The callee does not propagate the fact; only the call-to-return flow
+  /// decides whether it holds at the return-site
+  Kill,
+};
+
+std::string toString(InferredSummaryKind Kind);
+
+/// Computes the side effects of all functions in the given ICFG bottom-up over
+/// its call-graph and classifies them into functions that are irrelevant for
+/// pointer-typed data-flow facts (see InferredSummaryKind). The IDE solver uses
+/// this pre-analysis to skip callees if
+/// IFDSIDESolverConfig::inferIdentitySummaries() is enabled.
+class LLVMFunctionSideEffects {
+public:
+  explicit LLVMFunctionSideEffects(const LLVMBasedICFG &ICF);
+
+  [[nodiscard]] FunctionSideEffects
+  getSideEffects(const llvm::Function *F) const;
+
+  /// Only functions with a body are classified; declarations are handled by
+  /// the call-to-return flow functions anyway.
+  [[nodiscard]] InferredSummaryKind
+  getSummaryKind(const llvm::Function *F) const;
+
+  /// Decides whether the given fact can bypass Callee at the call-site CS.
+  /// Only pointer-typed facts are summarized; the zero fact always has to
+  /// enter the callee, as the facts it generates there may be reported. If the
+  /// call's result is used, facts that may flow into it still require the
+  /// callee to be analyzed. The same holds for kill-only callees that receive
+  /// a pointer that may point into the fact without being the fact itself.
+  [[nodiscard]] InferredFactEffect getFactEffect(const llvm::CallBase *CS,
+                                                 const llvm::Function *Callee,
+                                                 const llvm::Value *Fact,
+                                                 bool IsZero) const;
+
+  void print(llvm::raw_ostream &OS) const;
+
+private:
+  llvm::DenseMap<const llvm::Function *, FunctionSideEffects> Effects;
+};
+
+} // namespace psr
+
+#endif
@@ -120,6 +120,8 @@ protected:
                        const AbstractMemoryLocationImpl *To);
   const AbstractMemoryLocationImpl *
   limitImpl(const AbstractMemoryLocationImpl *AML);
+  const AbstractMemoryLocationImpl *
+  coarsenImpl(const AbstractMemoryLocationImpl *AML, unsigned NumDroppedOffs);
 
 public:
   AbstractMemoryLocationFactoryBase(size_t InitialCapacity);
@@ -205,6 +207,14 @@ public:
                    const AbstractMemoryLocation &To) {
     return {withTransferFromImpl(AML.operator->(), To.operator->())};
   }
+
+  /// Over-approximates AML by dropping up to NumDroppedOffs trailing offsets,
+  /// keeping at least the first one, and by exhausting its lifetime. Used to
+  /// trade precision for performance when the number of facts explodes.
+  [[nodiscard]] AbstractMemoryLocation
+  coarsen(const AbstractMemoryLocation &AML, unsigned NumDroppedOffs) {
+    return {coarsenImpl(AML.operator->(), NumDroppedOffs)};
+  }
 };
 
 } // namespace psr
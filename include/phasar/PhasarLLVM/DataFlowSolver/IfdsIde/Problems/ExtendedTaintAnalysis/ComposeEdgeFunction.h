@@ -10,11 +10,16 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_EXTENDEDTAINTANALYSIS_COMPOSEEDGEFUNCTION_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_EXTENDEDTAINTANALYSIS_COMPOSEEDGEFUNCTION_H
 
+#include <vector>
+
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/ExtendedTaintAnalysis/XTaintEdgeFunctionBase.h"
 
 namespace psr::XTaint {
 class ComposeEdgeFunction : public EdgeFunctionBase {
   EdgeFunctionPtrType F, G;
+  /// F and G flattened into the functions they consist of, without
+  /// identities, in the order they are applied
+  std::vector<EdgeFunctionPtrType> Sequence;
 
 public:
   ComposeEdgeFunction(BasicBlockOrdering &BBO, EdgeFunctionPtrType F,
@@ -183,15 +183,25 @@ private:
 public:
   /// Constructor. If EntryPoints is empty, use the TaintAPI functions as
   /// entrypoints.
+  /// The dominator trees are taken from the IRDB's analysis cache.
+  IDEExtendedTaintAnalysis(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+                           const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
+                           const TaintConfig *TSF,
+                           std::set<std::string> EntryPoints, unsigned Bound,
+                           bool DisableStrongUpdates)
+      : IDEExtendedTaintAnalysis(
+            IRDB, TH, ICF, PT, TSF, std::move(EntryPoints), Bound,
+            DisableStrongUpdates,
+            IRDB->getAnalysisCache().getDominatorTreeGetter()) {}
+
   /// The GetDomTree parameter can be used to inject a custom DominatorTree
   /// analysis or the results from a LLVM pass computing dominator trees
-  template <typename GetDomTree = DefaultDominatorTreeAnalysis>
+  template <typename GetDomTree>
   IDEExtendedTaintAnalysis(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
                            const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
                            const TaintConfig *TSF,
                            std::set<std::string> EntryPoints, unsigned Bound,
-                           bool DisableStrongUpdates,
-                           GetDomTree &&GDT = DefaultDominatorTreeAnalysis{})
+                           bool DisableStrongUpdates, GetDomTree &&GDT)
       : base_t(IRDB, TH, ICF, PT, std::move(EntryPoints)), AnalysisBase(TSF),
         BBO(std::forward<GetDomTree>(GDT)),
         FactFactory(IRDB->getNumInstructions()),
@@ -254,6 +264,10 @@ public:
 
   [[nodiscard]] bool isZeroValue(d_t Fact) const override;
 
+  /// Drops the last Level offsets of Fact (see
+  /// AbstractMemoryLocationFactory::coarsen())
+  [[nodiscard]] d_t coarsenFact(d_t Fact, unsigned Level) override;
+
   EdgeFunctionPtrType allTopFunction() override;
 
   // JoinLattice
@@ -343,12 +357,19 @@ public:
 template <unsigned BOUND = 3, bool USE_STRONG_UPDATES = true>
 class IDEExtendedTaintAnalysis : public XTaint::IDEExtendedTaintAnalysis {
 public:
-  template <typename GetDomTree = DefaultDominatorTreeAnalysis>
   IDEExtendedTaintAnalysis(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
                            const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
                            const TaintConfig &TSF,
-                           std::set<std::string> EntryPoints = {},
-                           GetDomTree &&GDT = DefaultDominatorTreeAnalysis{})
+                           std::set<std::string> EntryPoints = {})
+      : XTaint::IDEExtendedTaintAnalysis(IRDB, TH, ICF, PT, &TSF,
+                                         std::move(EntryPoints), BOUND,
+                                         !USE_STRONG_UPDATES) {}
+
+  template <typename GetDomTree>
+  IDEExtendedTaintAnalysis(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+                           const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
+                           const TaintConfig &TSF,
+                           std::set<std::string> EntryPoints, GetDomTree &&GDT)
       : XTaint::IDEExtendedTaintAnalysis(IRDB, TH, ICF, PT, &TSF, EntryPoints,
                                          BOUND, !USE_STRONG_UPDATES,
                                          std::forward<GetDomTree>(GDT)) {}
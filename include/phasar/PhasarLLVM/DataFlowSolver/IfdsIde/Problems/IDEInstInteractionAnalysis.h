@@ -1593,11 +1593,11 @@ public:
   // Provide functionalities for printing things and emitting text reports.
 
   void printNode(llvm::raw_ostream &OS, n_t n) const override {
-    OS << llvmIRToString(n);
+    OS << llvmIRToStringRef(n);
   }
 
   void printDataFlowFact(llvm::raw_ostream &OS, d_t FlowFact) const override {
-    OS << llvmIRToString(FlowFact);
+    OS << llvmIRToStringRef(FlowFact);
   }
 
   void printFunction(llvm::raw_ostream &OS, f_t Fun) const override {
@@ -17,6 +17,7 @@
 
 #include "llvm/Support/raw_ostream.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -43,10 +44,12 @@ class LLVMPointsToInfo;
 class IDELinearConstantAnalysis
     : public IDETabulationProblem<IDELinearConstantAnalysisDomain> {
 private:
-  // For debug purpose only
-  static unsigned CurrGenConstantId; // NOLINT
-  static unsigned CurrLCAIDId;       // NOLINT
-  static unsigned CurrBinaryId;      // NOLINT
+  // For debug purpose only; atomic, since several instances of the analysis
+  // may be solved in parallel
+  static std::atomic<unsigned> CurrGenConstantId; // NOLINT
+  static std::atomic<unsigned> CurrLCAIDId;       // NOLINT
+  static std::atomic<unsigned> CurrBinaryId;      // NOLINT
+  static std::atomic<unsigned> CurrLinearId;      // NOLINT
 
 public:
   using IDETabProblemType =
@@ -99,7 +102,7 @@ public:
       }
       OS << "\nCorresponding IR Instructions:\n";
       for (const auto *Ir : IRTrace) {
-        OS << "  " << llvmIRToString(Ir) << '\n';
+        OS << "  " << llvmIRToStringRef(Ir) << '\n';
       }
       return OS.str();
     }
@@ -168,13 +171,22 @@ public:
   public:
     LCAEdgeFunctionComposer(std::shared_ptr<EdgeFunction<l_t>> F,
                             std::shared_ptr<EdgeFunction<l_t>> G)
-        : EdgeFunctionComposer<l_t>(F, G){};
+        : EdgeFunctionComposer<l_t>(F, G, &normalize){};
 
     std::shared_ptr<EdgeFunction<l_t>>
     composeWith(std::shared_ptr<EdgeFunction<l_t>> SecondFunction) override;
 
     std::shared_ptr<EdgeFunction<l_t>>
     joinWith(std::shared_ptr<EdgeFunction<l_t>> OtherFunction) override;
+
+  protected:
+    /// Drops identities and everything before a constant function and merges
+    /// adjacent functions that compose in closed form
+    static void normalize(SequenceTy &Seq);
+
+    [[nodiscard]] std::shared_ptr<EdgeFunction<l_t>>
+    makeComposer(std::shared_ptr<EdgeFunction<l_t>> F,
+                 std::shared_ptr<EdgeFunction<l_t>> G) const override;
   };
 
   class GenConstant : public EdgeFunction<l_t>,
@@ -220,6 +232,45 @@ public:
     void print(llvm::raw_ostream &OS, bool IsForDebug = false) const override;
   };
 
+  /// The linear function x -> Factor * x + Offset with Factor != 0.
+  ///
+  /// Additions, subtractions and multiplications with a constant operand are
+  /// represented in this form, so that chains of them are composed into a
+  /// single function instead of a chain of LCAEdgeFunctionComposers. Like
+  /// BinOp, it maps all values that are not an integer to BOTTOM, and
+  /// overflows yield BOTTOM (or the all-bottom function when composing).
+  class LCALinear : public EdgeFunction<l_t>,
+                    public std::enable_shared_from_this<LCALinear> {
+  private:
+    const unsigned LinearId;
+    const int64_t Factor;
+    const int64_t Offset;
+
+  public:
+    LCALinear(int64_t Factor, int64_t Offset);
+
+    /// Returns the linear function that computes the binary operation Op
+    /// with the constant Const as the left (ConstIsLeft) or right operand, or
+    /// nullptr if the operation is not linear in the other operand.
+    static std::shared_ptr<LCALinear> create(unsigned Op, int64_t Const,
+                                             bool ConstIsLeft);
+
+    [[nodiscard]] int64_t getFactor() const noexcept { return Factor; }
+    [[nodiscard]] int64_t getOffset() const noexcept { return Offset; }
+
+    l_t computeTarget(l_t Source) override;
+
+    std::shared_ptr<EdgeFunction<l_t>>
+    composeWith(std::shared_ptr<EdgeFunction<l_t>> SecondFunction) override;
+
+    std::shared_ptr<EdgeFunction<l_t>>
+    joinWith(std::shared_ptr<EdgeFunction<l_t>> OtherFunction) override;
+
+    bool equal_to(std::shared_ptr<EdgeFunction<l_t>> Other) const override;
+
+    void print(llvm::raw_ostream &OS, bool IsForDebug = false) const override;
+  };
+
   class BinOp : public EdgeFunction<l_t>,
                 public std::enable_shared_from_this<BinOp> {
   private:
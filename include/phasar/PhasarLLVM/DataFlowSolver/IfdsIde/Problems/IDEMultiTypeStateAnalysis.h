@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_IDEMULTITYPESTATEANALYSIS_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_IDEMULTITYPESTATEANALYSIS_H
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CompiledTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateFlowFunctions.h"
+#include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+
+#include "llvm/ADT/SmallVector.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Instruction;
+class Function;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMBasedICFG;
+class LLVMTypeHierarchy;
+class LLVMPointsToInfo;
+
+struct IDEMultiTypeStateAnalysisDomain : public LLVMAnalysisDomainDefault {
+  /// One state per type state description, in the order of the descriptions
+  using l_t = llvm::SmallVector<TypeStateDescription::State, 4>;
+};
+
+/**
+ * Checks several type state descriptions (protocols) in a single IDE pass.
+ *
+ * The data-flow facts and flow functions are shared by all protocols: a value
+ * is tracked if its type matches the type of interest of any description, so
+ * the alias and relevant-alloca queries are computed once instead of once per
+ * protocol. The value of a fact is a vector that holds the state of each
+ * protocol; a protocol whose type does not match the fact stays at its top()
+ * state. The lattice is the product of the per-protocol lattices of
+ * IDETypeStateAnalysis, and the edge functions apply one compiled transition
+ * per protocol.
+ */
+class IDEMultiTypeStateAnalysis
+    : public IDETabulationProblem<IDEMultiTypeStateAnalysisDomain> {
+public:
+  using IDETabProblemType =
+      IDETabulationProblem<IDEMultiTypeStateAnalysisDomain>;
+  using typename IDETabProblemType::d_t;
+  using typename IDETabProblemType::f_t;
+  using typename IDETabProblemType::i_t;
+  using typename IDETabProblemType::l_t;
+  using typename IDETabProblemType::n_t;
+  using typename IDETabProblemType::t_t;
+  using typename IDETabProblemType::v_t;
+
+  using ConfigurationTy = std::vector<const TypeStateDescription *>;
+
+  using TransitionId = CompiledTypeStateDescription::TransitionId;
+
+  const l_t TOP;
+  const l_t BOTTOM;
+
+  IDEMultiTypeStateAnalysis(const ProjectIRDB *IRDB,
+                            const LLVMTypeHierarchy *TH,
+                            const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
+                            const ConfigurationTy &TSDs,
+                            std::set<std::string> EntryPoints = {"main"});
+
+  ~IDEMultiTypeStateAnalysis() override = default;
+
+  [[nodiscard]] size_t getNumDescriptions() const noexcept {
+    return CTSDs.size();
+  }
+
+  [[nodiscard]] const TypeStateDescription &
+  getDescription(size_t Desc) const {
+    return CTSDs[Desc]->getDescription();
+  }
+
+  // start formulating our analysis by specifying the parts required for IFDS
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override;
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t DestFun) override;
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitStmt, n_t RetSite) override;
+
+  FlowFunctionPtrType
+  getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                           llvm::ArrayRef<f_t> Callees) override;
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t CallSite,
+                                             f_t DestFun) override;
+
+  InitialSeeds<n_t, d_t, l_t> initialSeeds() override;
+
+  [[nodiscard]] d_t createZeroValue() const override;
+
+  [[nodiscard]] bool isZeroValue(d_t Fact) const override;
+
+  // in addition provide specifications for the IDE parts
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  getNormalEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
+                        d_t SuccNode) override;
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  getCallEdgeFunction(n_t CallSite, d_t SrcNode, f_t DestinationFunction,
+                      d_t DestNode) override;
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  getReturnEdgeFunction(n_t CallSite, f_t CalleeFunction, n_t ExitInst,
+                        d_t ExitNode, n_t RetSite, d_t RetNode) override;
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  getCallToRetEdgeFunction(n_t CallSite, d_t CallNode, n_t RetSite,
+                           d_t RetSiteNode,
+                           llvm::ArrayRef<f_t> Callees) override;
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  getSummaryEdgeFunction(n_t CallSite, d_t CallNode, n_t RetSite,
+                         d_t RetSiteNode) override;
+
+  l_t topElement() override;
+
+  l_t bottomElement() override;
+
+  /**
+   * Joins the states of each protocol separately, using the one-level lattice
+   * of IDETypeStateAnalysis.
+   */
+  l_t join(l_t Lhs, l_t Rhs) override;
+
+  std::shared_ptr<EdgeFunction<l_t>> allTopFunction() override;
+
+  void printNode(llvm::raw_ostream &OS, n_t Stmt) const override;
+
+  void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override;
+
+  void printFunction(llvm::raw_ostream &OS, f_t Func) const override;
+
+  void printEdgeFact(llvm::raw_ostream &OS, l_t L) const override;
+
+  void emitTextReport(const SolverResults<n_t, d_t, l_t> &SR,
+                      llvm::raw_ostream &OS = llvm::outs()) override;
+
+  /// Applies one interned transition of the respective compiled type state
+  /// description to each component of the state vector.
+  class MultiTSEdgeFunction
+      : public EdgeFunction<l_t>,
+        public std::enable_shared_from_this<MultiTSEdgeFunction> {
+  protected:
+    IDEMultiTypeStateAnalysis &Problem;
+    llvm::SmallVector<TransitionId, 4> Transitions;
+
+  public:
+    MultiTSEdgeFunction(IDEMultiTypeStateAnalysis &Problem,
+                        llvm::SmallVector<TransitionId, 4> Transitions)
+        : Problem(Problem), Transitions(std::move(Transitions)) {}
+
+    [[nodiscard]] llvm::ArrayRef<TransitionId> getTransitions() const noexcept {
+      return Transitions;
+    }
+
+    l_t computeTarget(l_t Source) override;
+
+    std::shared_ptr<EdgeFunction<l_t>>
+    composeWith(std::shared_ptr<EdgeFunction<l_t>> SecondFunction) override;
+
+    std::shared_ptr<EdgeFunction<l_t>>
+    joinWith(std::shared_ptr<EdgeFunction<l_t>> OtherFunction) override;
+
+    bool equal_to(std::shared_ptr<EdgeFunction<l_t>> Other) const override;
+
+    void print(llvm::raw_ostream &OS, bool IsForDebug = false) const override;
+  };
+
+private:
+  /// Returns the edge function that applies Transitions, or EdgeIdentity if
+  /// all of them are identities.
+  std::shared_ptr<EdgeFunction<l_t>>
+  getTransitionFunction(llvm::SmallVector<TransitionId, 4> Transitions);
+
+  std::vector<std::unique_ptr<CompiledTypeStateDescription>> CTSDs;
+  TypeStateFlowFunctions Flow;
+  llvm::SmallVector<TransitionId, 4> Identities;
+  llvm::SmallVector<TransitionId, 4> TopConstants;
+  llvm::SmallVector<TransitionId, 4> BottomConstants;
+};
+
+} // namespace psr
+
+#endif
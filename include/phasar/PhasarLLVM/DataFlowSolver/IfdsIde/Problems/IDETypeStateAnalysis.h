@@ -12,7 +12,9 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CompiledTypeStateDescription.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateFlowFunctions.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
 
@@ -23,6 +25,7 @@
 #include <set>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace llvm {
 class CallBase;
@@ -57,46 +60,6 @@ public:
 
 private:
   const TypeStateDescription &TSD;
-  std::map<const llvm::Value *, LLVMPointsToInfo::PointsToSetTy> PointsToCache;
-  std::map<const llvm::Value *, std::set<const llvm::Value *>>
-      RelevantAllocaCache;
-
-  /**
-   * @brief Returns all alloca's that are (indirect) aliases of V.
-   *
-   * Currently PhASAR's points-to information does not include alloca
-   * instructions, since alloca instructions, i.e. memory locations, are of
-   * type T* for a target type T. Thus they do not alias directly. Therefore,
-   * for each alias of V we collect related alloca instructions by checking
-   * load and store instructions for used alloca's.
-   */
-  std::set<d_t> getRelevantAllocas(d_t V);
-
-  /**
-   * @brief Returns whole-module aliases of V.
-   *
-   * This function retrieves whole-module points-to information. We store
-   * already computed points-to information in a cache to prevent expensive
-   * recomputation since the whole module points-to graph can be huge. This
-   * might become unnecessary once PhASAR's PointsToGraph starts using a cache
-   * itself.
-   */
-  std::set<d_t> getWMPointsToSet(d_t V);
-
-  /**
-   * @brief Provides whole module aliases and relevant alloca's of V.
-   */
-  std::set<d_t> getWMAliasesAndAllocas(d_t V);
-
-  /**
-   * @brief Provides local aliases and relevant alloca's of V.
-   */
-  std::set<d_t> getLocalAliasesAndAllocas(d_t V, const std::string &Fname);
-
-  /**
-   * @brief Checks if the type machtes the type of interest.
-   */
-  bool hasMatchingType(d_t V);
 
 public:
   const l_t TOP;
@@ -189,25 +152,45 @@ public:
   public:
     TSEdgeFunctionComposer(std::shared_ptr<EdgeFunction<l_t>> F,
                            std::shared_ptr<EdgeFunction<l_t>> G, l_t Bot)
-        : EdgeFunctionComposer<l_t>(F, G), BotElement(Bot) {}
+        : EdgeFunctionComposer<l_t>(F, G, &normalize), BotElement(Bot) {}
 
     std::shared_ptr<EdgeFunction<l_t>>
     joinWith(std::shared_ptr<EdgeFunction<l_t>> OtherFunction) override;
+
+  protected:
+    /// Drops everything before a constant function and merges adjacent
+    /// transitions into a single transition
+    static void normalize(SequenceTy &Seq);
+
+    [[nodiscard]] std::shared_ptr<EdgeFunction<l_t>>
+    makeComposer(std::shared_ptr<EdgeFunction<l_t>> F,
+                 std::shared_ptr<EdgeFunction<l_t>> G) const override;
   };
 
+  /// Applies an interned transition table of the compiled type state
+  /// description. Transitions compose into transitions, so a chain of API
+  /// calls is represented by a single table.
   class TSEdgeFunction : public EdgeFunction<l_t>,
                          public std::enable_shared_from_this<TSEdgeFunction> {
   protected:
-    const TypeStateDescription &TSD;
-    // Do not use a reference here, since LLVM's StringRef's (obtained by str())
-    // might turn to nullptr for whatever reason...
-    const std::string Token;
-    const llvm::CallBase *CallSite;
+    IDETypeStateAnalysis &Problem;
+    CompiledTypeStateDescription::TransitionId Transition;
 
   public:
-    TSEdgeFunction(const TypeStateDescription &TSD, const std::string &Tok,
-                   const llvm::CallBase *CB)
-        : TSD(TSD), Token(Tok), CallSite(CB){};
+    TSEdgeFunction(IDETypeStateAnalysis &Problem,
+                   CompiledTypeStateDescription::TransitionId T)
+        : Problem(Problem), Transition(T) {}
+
+    [[nodiscard]] CompiledTypeStateDescription::TransitionId
+    getTransition() const noexcept {
+      return Transition;
+    }
+
+    /// True if this transition and Other compose into a single transition
+    [[nodiscard]] bool
+    composesWith(const TSEdgeFunction &Other) const noexcept {
+      return &Problem == &Other.Problem;
+    }
 
     l_t computeTarget(l_t Source) override;
 
@@ -241,6 +224,15 @@ public:
 
     void print(llvm::raw_ostream &OS, bool IsForDebug = false) const override;
   };
+
+private:
+  /// Returns the interned edge function of the transition T
+  std::shared_ptr<EdgeFunction<l_t>>
+  getTransitionFunction(CompiledTypeStateDescription::TransitionId T);
+
+  CompiledTypeStateDescription CTSD;
+  TypeStateFlowFunctions Flow;
+  std::vector<std::shared_ptr<TSEdgeFunction>> TransitionFunctions;
 };
 
 } // namespace psr
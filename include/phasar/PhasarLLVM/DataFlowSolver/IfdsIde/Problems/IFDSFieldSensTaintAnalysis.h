@@ -91,16 +91,21 @@ public:
     return LLVMZeroValue::getInstance()->isLLVMZeroValue(EV.getValue());
   }
 
+  /// Shortens the memory location sequence of Fact by up to Level parts,
+  /// collapsing field accesses towards their base.
+  [[nodiscard]] ExtendedValue coarsenFact(ExtendedValue Fact,
+                                          unsigned Level) override;
+
   void printNode(llvm::raw_ostream &OS,
                  const llvm::Instruction *Stmt) const override {
-    OS << llvmIRToString(Stmt);
+    OS << llvmIRToStringRef(Stmt);
   }
 
   void printDataFlowFact(llvm::raw_ostream &OS,
                          ExtendedValue EV) const override {
-    OS << llvmIRToString(EV.getValue()) << "\n";
+    OS << llvmIRToStringRef(EV.getValue()) << "\n";
     for (const auto *MemLocationPart : EV.getMemLocationSeq()) {
-      OS << "A:\t" << llvmIRToString(MemLocationPart) << "\n";
+      OS << "A:\t" << llvmIRToStringRef(MemLocationPart) << "\n";
     }
     if (!EV.getEndOfTaintedBlockLabel().empty()) {
       OS << "L:\t" << EV.getEndOfTaintedBlockLabel() << "\n";
@@ -108,7 +113,7 @@ public:
     if (EV.isVarArg()) {
       OS << "VT:\t" << EV.isVarArgTemplate() << "\n";
       for (const auto *VAListMemLocationPart : EV.getVaListMemLocationSeq()) {
-        OS << "VLA:\t" << llvmIRToString(VAListMemLocationPart) << "\n";
+        OS << "VLA:\t" << llvmIRToStringRef(VAListMemLocationPart) << "\n";
       }
       OS << "VI:\t" << EV.getVarArgIndex() << "\n";
       OS << "CI:\t" << EV.getCurrentVarArgIndex() << "\n";
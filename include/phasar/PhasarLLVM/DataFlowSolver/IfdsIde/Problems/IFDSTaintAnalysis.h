@@ -48,6 +48,9 @@ class IFDSTaintAnalysis
 private:
   const TaintConfig &Config;
 
+  /// Returns the taint roles of Callee. They are looked up in the function
+  /// classification of the ICFG if it holds the roles of Config.
+  [[nodiscard]] FunctionClass getTaintRole(const llvm::Function *Callee) const;
   bool isSourceCall(const llvm::CallBase *CB,
                     const llvm::Function *Callee) const;
   bool isSinkCall(const llvm::CallBase *CB, const llvm::Function *Callee) const;
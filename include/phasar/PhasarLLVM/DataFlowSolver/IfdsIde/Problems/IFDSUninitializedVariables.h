@@ -88,6 +88,15 @@ public:
 
   [[nodiscard]] const std::map<n_t, std::set<d_t>> &getAllUndefUses() const;
 
+  /// Computes the uses of uninitialized values without the IFDSSolver.
+  ///
+  /// Each function is analyzed with one bit vector of data-flow facts per
+  /// instruction. Calls are resolved using summaries that map each fact at
+  /// the entry of the callee, i.e. the zero value or a formal parameter, to
+  /// the facts that are returned to the caller. The uses found are the same
+  /// as the ones found by solving this problem with the IFDSSolver.
+  void solveWithBitVectors();
+
   std::vector<UninitResult> aggregateResults();
 };
 
@@ -13,6 +13,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
 
@@ -67,6 +68,8 @@ public:
   getFactoryParamIdx(const std::string &F) const override;
   [[nodiscard]] std::string
   stateToString(TypeStateDescription::State S) const override;
+  [[nodiscard]] std::vector<TypeStateDescription::State>
+  getStates() const override;
   [[nodiscard]] TypeStateDescription::State bottom() const override;
   [[nodiscard]] TypeStateDescription::State top() const override;
   [[nodiscard]] TypeStateDescription::State uninit() const override;
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_COMPILEDTYPESTATEDESCRIPTION_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_COMPILEDTYPESTATEDESCRIPTION_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
+
+namespace llvm {
+class CallBase;
+class Function;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/**
+ * A TypeStateDescription compiled against the functions of an IRDB.
+ *
+ * The string based queries of the description are answered once per
+ * llvm::Function: each API function is assigned a token id and the indices of
+ * its consumed parameters. The finite state machine is compiled into dense
+ * transition tables that map the index of every state (see
+ * TypeStateDescription::getStates()) to the index of its successor state.
+ * Since transitions may depend on the call site (e.g. for the OpenSSL
+ * descriptions), the transition table of an API call is computed once per call
+ * site. Transition tables are interned, i.e. two transitions are equal iff
+ * their ids are equal, and composing them costs O(|S|) once.
+ *
+ * The table of a transition maps top() to the successor of uninit(), the same
+ * way IDETypeStateAnalysis treats a transition that is applied to top().
+ */
+class CompiledTypeStateDescription {
+public:
+  using State = TypeStateDescription::State;
+  /// Dense index of a state
+  using StateId = unsigned;
+  using TokenId = unsigned;
+  /// Identifies an interned transition table
+  using TransitionId = unsigned;
+
+  struct FunctionInfo {
+    TokenId Token = 0;
+    bool IsAPI = false;
+    bool IsFactory = false;
+    bool IsConsuming = false;
+    /// Sorted indices of the consumed parameters
+    llvm::SmallVector<int, 2> ConsumerParamIdx;
+  };
+
+  /// Compiles TSD for all functions of IRDB. Functions that are not part of
+  /// IRDB are compiled on their first query.
+  CompiledTypeStateDescription(const TypeStateDescription &TSD,
+                               const ProjectIRDB &IRDB);
+
+  [[nodiscard]] const TypeStateDescription &getDescription() const noexcept {
+    return TSD;
+  }
+
+  [[nodiscard]] const FunctionInfo &getFunctionInfo(const llvm::Function *F);
+
+  [[nodiscard]] bool isAPIFunction(const llvm::Function *F) {
+    return getFunctionInfo(F).IsAPI;
+  }
+  [[nodiscard]] bool isFactoryFunction(const llvm::Function *F) {
+    return getFunctionInfo(F).IsFactory;
+  }
+  [[nodiscard]] bool isConsumingFunction(const llvm::Function *F) {
+    return getFunctionInfo(F).IsConsuming;
+  }
+
+  /// Returns the demangled name of the API function(s) that Tok stands for
+  [[nodiscard]] llvm::StringRef getTokenName(TokenId Tok) const {
+    return TokenNames[Tok];
+  }
+
+  [[nodiscard]] size_t getNumStates() const noexcept { return States.size(); }
+  [[nodiscard]] State getState(StateId Id) const { return States[Id]; }
+
+  /// Returns the transition that the API function F applies at CallSite
+  [[nodiscard]] TransitionId getTransition(const llvm::CallBase *CallSite,
+                                           const llvm::Function *F);
+
+  /// Returns the transition that leaves every state unchanged
+  [[nodiscard]] TransitionId getIdentity();
+
+  /// Returns the transition that maps every state to S
+  [[nodiscard]] TransitionId getConstant(State S);
+
+  /// Returns the transition that first applies First and then Second
+  [[nodiscard]] TransitionId compose(TransitionId First, TransitionId Second);
+
+  [[nodiscard]] llvm::ArrayRef<StateId> getTable(TransitionId T) const {
+    return Tables[T];
+  }
+
+  /// Applies the transition T to S; states that are unknown to the
+  /// description are mapped to bottom().
+  [[nodiscard]] State apply(TransitionId T, State S) const;
+
+  /// Returns the state that the API function F yields for S at CallSite
+  [[nodiscard]] State getNextState(const llvm::CallBase *CallSite,
+                                   const llvm::Function *F, State S) {
+    return apply(getTransition(CallSite, F), S);
+  }
+
+private:
+  [[nodiscard]] TransitionId intern(std::vector<StateId> Table);
+
+  const TypeStateDescription &TSD;
+
+  std::vector<State> States;
+  llvm::DenseMap<State, StateId> StateIds;
+  StateId Bottom = 0;
+
+  llvm::DenseMap<const llvm::Function *, FunctionInfo> Functions;
+  llvm::StringMap<TokenId> TokenIds;
+  std::vector<std::string> TokenNames;
+
+  std::vector<std::vector<StateId>> Tables;
+  std::map<std::vector<StateId>, TransitionId> TableIds;
+  llvm::DenseMap<std::pair<const llvm::CallBase *, TokenId>, TransitionId>
+      CallSiteTransitions;
+  llvm::DenseMap<std::pair<TransitionId, TransitionId>, TransitionId>
+      Compositions;
+};
+
+} // namespace psr
+
+#endif
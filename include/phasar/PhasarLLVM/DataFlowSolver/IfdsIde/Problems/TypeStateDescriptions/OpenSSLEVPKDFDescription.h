@@ -13,6 +13,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
 
@@ -71,6 +72,8 @@ public:
 
   [[nodiscard]] std::string
   stateToString(TypeStateDescription::State S) const override;
+  [[nodiscard]] std::vector<TypeStateDescription::State>
+  getStates() const override;
 
   [[nodiscard]] TypeStateDescription::State bottom() const override;
 
@@ -12,6 +12,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "llvm/IR/InstrTypes.h"
 
@@ -56,6 +57,13 @@ struct TypeStateDescription {
   [[nodiscard]] virtual std::set<int>
   getFactoryParamIdx(const std::string &F) const = 0;
   [[nodiscard]] virtual std::string stateToString(State S) const = 0;
+
+  /**
+   * Returns all states of the finite state machine including top() and
+   * bottom(). The IDETypeStateAnalysis compiles the state machine into dense
+   * transition tables over these states.
+   */
+  [[nodiscard]] virtual std::vector<State> getStates() const = 0;
   [[nodiscard]] virtual State bottom() const = 0;
   [[nodiscard]] virtual State top() const = 0;
 
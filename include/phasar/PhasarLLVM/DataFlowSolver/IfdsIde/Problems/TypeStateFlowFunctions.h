@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_TYPESTATEFLOWFUNCTIONS_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_TYPESTATEFLOWFUNCTIONS_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+
+namespace llvm {
+class Function;
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+class CompiledTypeStateDescription;
+
+/**
+ * The flow functions of the type state analyses together with the alias and
+ * alloca queries they rely on.
+ *
+ * The flow functions track all values whose type matches the type of
+ * interest of at least one of the given type state descriptions, so a single
+ * instance, and a single alias and alloca cache, can be shared by all
+ * protocols that are checked at once (see IDEMultiTypeStateAnalysis).
+ */
+class TypeStateFlowFunctions {
+public:
+  using d_t = const llvm::Value *;
+  using n_t = const llvm::Instruction *;
+  using f_t = const llvm::Function *;
+  using FlowFunctionPtrType = std::shared_ptr<FlowFunction<d_t>>;
+
+  TypeStateFlowFunctions(
+      LLVMPointsToInfo *PT,
+      std::vector<CompiledTypeStateDescription *> Descriptions);
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr);
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t DestFun);
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitStmt);
+
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite,
+                                               llvm::ArrayRef<f_t> Callees);
+
+  /**
+   * @brief Returns all alloca's that are (indirect) aliases of V.
+   *
+   * Currently PhASAR's points-to information does not include alloca
+   * instructions, since alloca instructions, i.e. memory locations, are of
+   * type T* for a target type T. Thus they do not alias directly. Therefore,
+   * for each alias of V we collect related alloca instructions by checking
+   * load and store instructions for used alloca's.
+   */
+  std::set<d_t> getRelevantAllocas(d_t V);
+
+  /**
+   * @brief Returns whole-module aliases of V.
+   *
+   * This function retrieves whole-module points-to information. We store
+   * already computed points-to information in a cache to prevent expensive
+   * recomputation since the whole module points-to graph can be huge. This
+   * might become unnecessary once PhASAR's PointsToGraph starts using a cache
+   * itself.
+   */
+  std::set<d_t> getWMPointsToSet(d_t V);
+
+  /**
+   * @brief Provides whole module aliases and relevant alloca's of V.
+   */
+  std::set<d_t> getWMAliasesAndAllocas(d_t V);
+
+  /**
+   * @brief Provides local aliases and relevant alloca's of V.
+   */
+  std::set<d_t> getLocalAliasesAndAllocas(d_t V);
+
+  /**
+   * @brief Checks if the type of V matches the type of interest of any of
+   * the descriptions.
+   */
+  bool hasMatchingType(d_t V);
+
+  /**
+   * @brief Checks if the type of V matches the type of interest of the
+   * description with the index Desc.
+   */
+  bool hasMatchingType(d_t V, unsigned Desc);
+
+  /// Checks if F belongs to the API of any of the descriptions
+  bool isAPIFunction(f_t F);
+
+  /// Checks if F is a factory function of any of the descriptions
+  bool isFactoryFunction(f_t F);
+
+private:
+  LLVMPointsToInfo *PT;
+  std::vector<CompiledTypeStateDescription *> Descriptions;
+  std::vector<std::string> TypeNamesOfInterest;
+  std::map<const llvm::Value *, LLVMPointsToInfo::PointsToSetTy> PointsToCache;
+  std::map<const llvm::Value *, std::set<const llvm::Value *>>
+      RelevantAllocaCache;
+};
+
+} // namespace psr
+
+#endif
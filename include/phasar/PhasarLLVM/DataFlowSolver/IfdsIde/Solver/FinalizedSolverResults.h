@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_FINALIZEDSOLVERRESULTS_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_FINALIZEDSOLVERRESULTS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/PhasarLLVM/Utils/ByRef.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/// A read-only copy of the values computed by an IDE solver that is optimized
+/// for queries. All (fact, value) pairs are stored in one contiguous array,
+/// grouped by function and statement in the order given by the ICFG, such
+/// that the results at a statement are an allocation-free view into that
+/// array. Within a statement, the zero fact (if present) comes first and the
+/// remaining facts are sorted.
+///
+/// Unlike SolverResults, FinalizedSolverResults does not refer to the
+/// solver's tables, which can therefore be released once the results are
+/// finalized, see IDESolver::finalizeResults().
+template <typename N, typename D, typename L, typename F>
+class FinalizedSolverResults {
+public:
+  using EntryTy = std::pair<D, L>;
+
+  struct StatementEntry {
+    N Stmt;
+    uint32_t Begin;
+    uint32_t End;
+  };
+
+  struct FunctionEntry {
+    F Fun;
+    uint32_t Begin;
+    uint32_t End;
+  };
+
+  FinalizedSolverResults() = default;
+
+  /// Collects the values in Results, e.g. an IDE solver's value table, and
+  /// groups them according to the functions and instructions in ICF.
+  template <typename ICFGTy>
+  FinalizedSolverResults(const Table<N, D, L> &Results, ByConstRef<D> ZeroValue,
+                         const ICFGTy &ICF)
+      : ZeroValue(ZeroValue) {
+    // Order the statements by function and by their position within the
+    // function, so that all results of a function are adjacent
+    llvm::DenseMap<N, std::pair<uint32_t, uint32_t>> Order;
+    llvm::DenseMap<F, uint32_t> FunOrder;
+    for (const auto &Fun : ICF.getAllFunctions()) {
+      auto FunIdx = uint32_t(FunOrder.size());
+      if (!FunOrder.try_emplace(Fun, FunIdx).second) {
+        continue;
+      }
+      uint32_t InstIdx = 0;
+      for (const auto &Inst : ICF.getAllInstructionsOf(Fun)) {
+        Order.try_emplace(Inst, FunIdx, InstIdx++);
+      }
+    }
+
+    struct Cell {
+      std::pair<uint32_t, uint32_t> Pos;
+      N Stmt;
+      const D *Fact;
+      const L *Value;
+    };
+    std::vector<Cell> Cells;
+    Results.foreachCell([&](const N &Stmt, const D &Fact, const L &Value) {
+      auto It = Order.find(Stmt);
+      if (It == Order.end()) {
+        // Not reachable from the ICFG's functions, so append the statement
+        // to its function
+        auto Fun = ICF.getFunctionOf(Stmt);
+        auto FunIt = FunOrder.try_emplace(Fun, uint32_t(FunOrder.size())).first;
+        It = Order
+                 .try_emplace(Stmt, FunIt->second,
+                              std::numeric_limits<uint32_t>::max() -
+                                  uint32_t(Order.size()))
+                 .first;
+      }
+      Cells.push_back({It->second, Stmt, &Fact, &Value});
+    });
+
+    std::sort(Cells.begin(), Cells.end(),
+              [this](const Cell &Lhs, const Cell &Rhs) {
+                if (Lhs.Pos != Rhs.Pos) {
+                  return Lhs.Pos < Rhs.Pos;
+                }
+                bool LhsZero = *Lhs.Fact == this->ZeroValue;
+                bool RhsZero = *Rhs.Fact == this->ZeroValue;
+                if (LhsZero != RhsZero) {
+                  return LhsZero;
+                }
+                return std::less<D>{}(*Lhs.Fact, *Rhs.Fact);
+              });
+
+    Entries.reserve(Cells.size());
+    llvm::SmallVector<F, 0> FunsByIdx(FunOrder.size());
+    for (const auto &[Fun, Idx] : FunOrder) {
+      FunsByIdx[Idx] = Fun;
+    }
+    for (const auto &C : Cells) {
+      if (Statements.empty() || Statements.back().Stmt != C.Stmt) {
+        auto FunIdx = C.Pos.first;
+        if (Functions.empty() || Functions.back().Fun != FunsByIdx[FunIdx]) {
+          FunctionIndex[FunsByIdx[FunIdx]] = uint32_t(Functions.size());
+          Functions.push_back({FunsByIdx[FunIdx], uint32_t(Statements.size()),
+                               uint32_t(Statements.size())});
+        }
+        StatementIndex[C.Stmt] = uint32_t(Statements.size());
+        Statements.push_back(
+            {C.Stmt, uint32_t(Entries.size()), uint32_t(Entries.size())});
+        ++Functions.back().End;
+      }
+      Entries.emplace_back(*C.Fact, *C.Value);
+      ++Statements.back().End;
+    }
+  }
+
+  /// Returns the (fact, value) pairs at Stmt. The view remains valid as long
+  /// as this object is alive.
+  [[nodiscard]] llvm::ArrayRef<EntryTy> resultsAt(ByConstRef<N> Stmt,
+                                                  bool StripZero = false) const {
+    auto It = StatementIndex.find(Stmt);
+    if (It == StatementIndex.end()) {
+      return {};
+    }
+    return entriesOf(Statements[It->second], StripZero);
+  }
+
+  /// Returns the results at Stmt while respecting LLVM's SSA semantics, i.e.
+  /// the results at the successor instruction for value-producing
+  /// instructions (see IDESolver::resultsAtInLLVMSSA()).
+  template <typename NTy = N,
+            typename = std::enable_if_t<
+                std::is_same_v<NTy, const llvm::Instruction *>>>
+  [[nodiscard]] llvm::ArrayRef<EntryTy>
+  resultsAtInLLVMSSA(NTy Stmt, bool StripZero = false) const {
+    if (Stmt->getType()->isVoidTy()) {
+      return resultsAt(Stmt, StripZero);
+    }
+    assert(Stmt->getNextNode() && "Expected to find a valid successor node!");
+    return resultsAt(Stmt->getNextNode(), StripZero);
+  }
+
+  /// Returns the facts that hold at Stmt, e.g. for IFDS problems.
+  [[nodiscard]] auto factsAt(ByConstRef<N> Stmt, bool StripZero = false) const {
+    return llvm::map_range(resultsAt(Stmt, StripZero),
+                           [](const EntryTy &Entry) -> const D & {
+                             return Entry.first;
+                           });
+  }
+
+  /// Returns the value of Fact at Stmt, or nullptr if Fact does not hold at
+  /// Stmt.
+  [[nodiscard]] const L *findResultAt(ByConstRef<N> Stmt,
+                                      ByConstRef<D> Fact) const {
+    auto Results = resultsAt(Stmt);
+    if (!Results.empty() && Results.front().first == ZeroValue) {
+      if (Fact == ZeroValue) {
+        return &Results.front().second;
+      }
+      Results = Results.drop_front();
+    }
+    // std::less<D> is only required to be a weak order, so check all
+    // equivalent facts
+    auto [Begin, End] = std::equal_range(
+        Results.begin(), Results.end(), Fact,
+        [](const auto &Lhs, const auto &Rhs) {
+          return std::less<D>{}(factOf(Lhs), factOf(Rhs));
+        });
+    auto It = std::find_if(Begin, End, [&Fact](const EntryTy &Entry) {
+      return Entry.first == Fact;
+    });
+    return It != End ? &It->second : nullptr;
+  }
+
+  /// Returns the value of Fact at Stmt, or a default-constructed value if
+  /// Fact does not hold at Stmt.
+  [[nodiscard]] L resultAt(ByConstRef<N> Stmt, ByConstRef<D> Fact) const {
+    const auto *Ret = findResultAt(Stmt, Fact);
+    return Ret ? *Ret : L{};
+  }
+
+  [[nodiscard]] bool holdsAt(ByConstRef<N> Stmt, ByConstRef<D> Fact) const {
+    return findResultAt(Stmt, Fact) != nullptr;
+  }
+
+  /// Calls Handler(Stmt, Results) for each statement with results, grouped
+  /// by function.
+  template <typename HandlerFn>
+  void foreachStatement(HandlerFn Handler, bool StripZero = false) const {
+    for (const auto &Stmt : Statements) {
+      std::invoke(Handler, Stmt.Stmt, entriesOf(Stmt, StripZero));
+    }
+  }
+
+  /// Calls Handler(Stmt, Results) for each statement of Fun with results.
+  template <typename HandlerFn>
+  void foreachStatementOf(ByConstRef<F> Fun, HandlerFn Handler,
+                          bool StripZero = false) const {
+    for (const auto &Stmt : statementsOf(Fun)) {
+      std::invoke(Handler, Stmt.Stmt, entriesOf(Stmt, StripZero));
+    }
+  }
+
+  /// Returns the functions that contain statements with results.
+  [[nodiscard]] llvm::ArrayRef<FunctionEntry> functions() const {
+    return Functions;
+  }
+
+  /// Returns the statements of Fun that have results.
+  [[nodiscard]] llvm::ArrayRef<StatementEntry>
+  statementsOf(ByConstRef<F> Fun) const {
+    auto It = FunctionIndex.find(Fun);
+    if (It == FunctionIndex.end()) {
+      return {};
+    }
+    const auto &Entry = Functions[It->second];
+    return llvm::makeArrayRef(Statements).slice(Entry.Begin,
+                                                Entry.End - Entry.Begin);
+  }
+
+  /// Returns all statements that have results.
+  [[nodiscard]] llvm::ArrayRef<StatementEntry> statements() const {
+    return Statements;
+  }
+
+  /// Returns the number of (statement, fact) pairs.
+  [[nodiscard]] size_t size() const { return Entries.size(); }
+  [[nodiscard]] bool empty() const { return Entries.empty(); }
+
+  [[nodiscard]] ByConstRef<D> getZeroValue() const { return ZeroValue; }
+
+private:
+  [[nodiscard]] llvm::ArrayRef<EntryTy>
+  entriesOf(const StatementEntry &Stmt, bool StripZero) const {
+    auto Ret = llvm::makeArrayRef(Entries).slice(Stmt.Begin,
+                                                 Stmt.End - Stmt.Begin);
+    if (StripZero && !Ret.empty() && Ret.front().first == ZeroValue) {
+      return Ret.drop_front();
+    }
+    return Ret;
+  }
+
+  static const D &factOf(const EntryTy &Entry) { return Entry.first; }
+  static const D &factOf(const D &Fact) { return Fact; }
+
+  D ZeroValue{};
+  std::vector<EntryTy> Entries;
+  std::vector<StatementEntry> Statements;
+  std::vector<FunctionEntry> Functions;
+  llvm::DenseMap<N, uint32_t> StatementIndex;
+  llvm::DenseMap<F, uint32_t> FunctionIndex;
+};
+
+} // namespace psr
+
+#endif
@@ -26,11 +26,13 @@
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
@@ -41,14 +43,19 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFunctionSideEffects.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FinalizedSolverResults.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JoinHandlingNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LinkedNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SpecialSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+#include "phasar/PhasarLLVM/Utils/ESGTrace.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
@@ -99,13 +106,26 @@ public:
   using t_t = typename AnalysisDomainTy::t_t;
   using v_t = typename AnalysisDomainTy::v_t;
 
+  /// Records that the solver started coarsening the facts of a function,
+  /// because the number of facts at Node or in Function exceeded the fact
+  /// limits (see IFDSIDESolverConfig::adaptivePrecision()).
+  struct CoarseningEvent {
+    n_t Node;
+    f_t Function;
+    unsigned Level;
+    size_t NumFactsAtNode;
+    size_t NumFactsInFunction;
+  };
+
   IDESolver(IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()),
         ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
         CachedFlowEdgeFunctions(Problem), AllTop(Problem.allTopFunction()),
         JumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
             AllTop, IDEProblem)),
-        Seeds(Problem.initialSeeds()) {}
+        Seeds(Problem.initialSeeds()) {
+    initJumpFunctionSpilling();
+  }
 
   IDESolver(const IDESolver &) = delete;
   IDESolver &operator=(const IDESolver &) = delete;
@@ -158,6 +178,11 @@ public:
     REG_COUNTER("Value Computation", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("InferredSummary Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("LibrarySummary Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Coarsened facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Fact class members", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Fact class splits", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
@@ -183,6 +208,12 @@ public:
       STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
     }
     PHASAR_LOG_LEVEL(INFO, "Problem solved");
+    if (!CoarseningEvents.empty()) {
+      PHASAR_LOG_LEVEL(WARNING, "Coarsened " << NumCoarsenedFacts
+                                             << " facts after "
+                                             << CoarseningEvents.size()
+                                             << " coarsening events");
+    }
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       computeAndPrintStatistics();
     }
@@ -279,6 +310,72 @@ public:
     return Result;
   }
 
+  /// Returns a read-only copy of the computed values that is optimized for
+  /// queries (see FinalizedSolverResults). If ReleaseSolverTables is set,
+  /// the solver's tables are freed afterwards and the solver's own result
+  /// accessors return empty results.
+  [[nodiscard]] FinalizedSolverResults<n_t, d_t, l_t, f_t>
+  finalizeResults(bool ReleaseSolverTables = false) {
+    FinalizedSolverResults<n_t, d_t, l_t, f_t> Results(ValTab, ZeroValue,
+                                                       *ICF);
+    if (ReleaseSolverTables) {
+      releaseSolverTables();
+    }
+    return Results;
+  }
+
+  /// Frees the jump functions, summaries, caches and the computed values.
+  /// Afterwards, the solver cannot be queried or solve again.
+  void releaseSolverTables() {
+    JumpFn->clear();
+    CachedFlowEdgeFunctions.clear();
+    ComputedIntraPathEdges.clear();
+    ComputedInterPathEdges.clear();
+    IntermediateEdgeFunctions.clear();
+    EndsummaryTab.clear();
+    IncomingTab.clear();
+    UnbalancedRetSites.clear();
+    ValTab.clear();
+    FSummaryReuse.clear();
+    FactClasses.clear();
+    NumFactsAtNode.clear();
+    NumFactsInFunction.clear();
+    CoarseningLevels.clear();
+  }
+
+  /// Returns the events at which the solver decreased the precision of a
+  /// function's facts; empty unless adaptive precision is enabled.
+  [[nodiscard]] const std::vector<CoarseningEvent> &
+  getCoarseningEvents() const {
+    return CoarseningEvents;
+  }
+
+  /// Returns how many facts have been replaced by coarser ones.
+  [[nodiscard]] size_t getNumCoarsenedFacts() const {
+    return NumCoarsenedFacts;
+  }
+
+  /// Returns how many facts have joined a fact class as a member, instead of
+  /// being propagated on their own.
+  [[nodiscard]] size_t getNumFactClassMembers() const {
+    return NumFactClassMembers;
+  }
+
+  /// Returns how many members have been split off their fact class.
+  [[nodiscard]] size_t getNumFactClassSplits() const {
+    return NumFactClassSplits;
+  }
+
+  /// Returns how often jump functions have been spilled to disk and read
+  /// back; zero unless spilling is enabled.
+  [[nodiscard]] size_t getNumJumpFunctionSpills() const {
+    return JumpFn->getNumSpills();
+  }
+
+  [[nodiscard]] size_t getNumJumpFunctionFaults() const {
+    return JumpFn->getNumFaults();
+  }
+
   virtual void emitTextReport(llvm::raw_ostream &OS = llvm::outs()) {
     IDEProblem.emitTextReport(getSolverResults(), OS);
   }
@@ -374,6 +471,15 @@ public:
     }
   }
 
+  /// Lets the solver use a precomputed mod/ref pre-analysis for
+  /// SolverConfig.inferIdentitySummaries() instead of computing its own, e.g.
+  /// one that is shared by several solvers over the same ICFG. Summaries must
+  /// have been computed on the solver's ICFG.
+  void setInferredSummaries(
+      std::shared_ptr<const LLVMFunctionSideEffects> Summaries) {
+    InferredSummaries = std::move(Summaries);
+  }
+
   SolverResults<n_t, d_t, l_t> getSolverResults() {
     return SolverResults<n_t, d_t, l_t>(this->ValTab,
                                         IDEProblem.getZeroValue());
@@ -418,6 +524,27 @@ protected:
 
   std::map<std::pair<n_t, d_t>, size_t> FSummaryReuse;
 
+  // members of the fact classes if SolverConfig.compressFactClasses() is set:
+  // (node, source fact) -> representative -> members
+  Table<n_t, d_t, std::map<d_t, Container>> FactClasses;
+
+  // computed on first use if SolverConfig.inferIdentitySummaries() is set,
+  // unless it has been provided by setInferredSummaries()
+  std::shared_ptr<const LLVMFunctionSideEffects> InferredSummaries;
+
+  // bookkeeping for SolverConfig.adaptivePrecision(): the number of distinct
+  // facts per node and of (node, fact) pairs per function, and the current
+  // coarsening level of each function
+  std::map<n_t, size_t> NumFactsAtNode;
+  std::map<f_t, size_t> NumFactsInFunction;
+  std::map<f_t, unsigned> CoarseningLevels;
+  std::vector<CoarseningEvent> CoarseningEvents;
+  size_t NumCoarsenedFacts = 0;
+
+  // statistics of SolverConfig.compressFactClasses()
+  size_t NumFactClassMembers = 0;
+  size_t NumFactClassSplits = 0;
+
   // When transforming an IFDSTabulationProblem into an IDETabulationProblem,
   // we need to allocate dynamically, otherwise the objects lifetime runs out
   // - as a modifiable r-value reference created here that should be stored in
@@ -437,7 +564,16 @@ protected:
         AllTop(IDEProblem.allTopFunction()),
         JumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
             AllTop, IDEProblem)),
-        Seeds(IDEProblem.initialSeeds()) {}
+        Seeds(IDEProblem.initialSeeds()) {
+    initJumpFunctionSpilling();
+  }
+
+  /// Lets the jump functions be spilled to disk if requested by SolverConfig.
+  void initJumpFunctionSpilling() {
+    if (SolverConfig.spillJumpFunctions()) {
+      JumpFn->enableSpilling(ICF, SolverConfig.maxResidentJumpFunctions());
+    }
+  }
 
   /// Lines 13-20 of the algorithm; processing a call site in the caller's
   /// context.
@@ -484,6 +620,30 @@ protected:
       // check if a special summary for the called procedure exists
       FlowFunctionPtrType SpecialSum =
           CachedFlowEdgeFunctions.getSummaryFlowFunction(n, SCalledProcN);
+      // if a loaded summary library covers the callee, do not descend into it
+      if (!SpecialSum &&
+          applyLibrarySummary(n, SCalledProcN, d1, d2, f, ReturnSiteNs)) {
+        continue;
+      }
+      // if the callee cannot affect d2, do not descend into it
+      if (!SpecialSum && SolverConfig.inferIdentitySummaries()) {
+        auto Effect = getInferredFactEffect(n, SCalledProcN, d2);
+        if (Effect != InferredFactEffect::Unknown) {
+          PHASAR_LOG_LEVEL(DEBUG, "Apply inferred summary of '"
+                                      << ICF->getFunctionName(SCalledProcN)
+                                      << "'");
+          INC_COUNTER("InferredSummary Application", 1,
+                      PAMM_SEVERITY_LEVEL::Full);
+          if (Effect == InferredFactEffect::Preserve) {
+            for (n_t ReturnSiteN : ReturnSiteNs) {
+              saveEdges(n, ReturnSiteN, d2, Container{d2}, false);
+              propagate(d1, ReturnSiteN, d2, f, n, false);
+            }
+          }
+          // Killed facts are solely handled by the call-to-return flow
+          continue;
+        }
+      }
       // if a special summary is available, treat this as a normal flow
       // and use the summary flow and edge functions
       if (SpecialSum) {
@@ -616,6 +776,11 @@ protected:
         }
       }
     }
+    // facts that are overwritten by all (summarized) callees do not survive
+    // the call
+    if (isKilledByLibrarySummaries(n, Callees, d2)) {
+      return;
+    }
     // line 17-19 of Naeem/Lhotak/Rodriguez
     // process intra-procedural flows along call-to-return flow functions
     for (n_t ReturnSiteN : ReturnSiteNs) {
@@ -628,6 +793,8 @@ protected:
       ADD_TO_HISTOGRAM("Data-flow facts", returnFacts.size(), 1,
                        PAMM_SEVERITY_LEVEL::Full);
       saveEdges(n, ReturnSiteN, d2, ReturnFacts, false);
+      // facts that are generated together may form fact classes
+      std::vector<std::pair<d_t, EdgeFunctionPtrType>> Targets;
       for (d_t d3 : ReturnFacts) {
         EdgeFunctionPtrType EdgeFnE =
             CachedFlowEdgeFunctions.getCallToRetEdgeFunction(n, d2, ReturnSiteN,
@@ -643,8 +810,15 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG, "Compose: " << EdgeFnE->str() << " * "
                                             << f->str() << " = "
                                             << fPrime->str());
+        if (isFactClassCompressionEnabled()) {
+          Targets.emplace_back(d3, std::move(fPrime));
+          continue;
+        }
         propagate(d1, ReturnSiteN, d3, fPrime, n, false);
       }
+      if (!Targets.empty()) {
+        propagateTargets(d1, ReturnSiteN, d2, {}, Targets);
+      }
     }
   }
 
@@ -661,6 +835,11 @@ protected:
     n_t n = Edge.getTarget();
     d_t d2 = Edge.factAtTarget();
     EdgeFunctionPtrType f = jumpFunction(Edge);
+    if (isFactClassCompressionEnabled()) {
+      processNormalFlowOfFactClass(d1, n, d2, f, getFactClassMembers(n, d1, d2),
+                                   /*OnlyMembers*/ false);
+      return;
+    }
     for (const auto nPrime : ICF->getSuccsOf(n)) {
       FlowFunctionPtrType FlowFunc =
           CachedFlowEdgeFunctions.getNormalFlowFunction(n, nPrime);
@@ -686,11 +865,210 @@ protected:
     }
   }
 
+  [[nodiscard]] bool isFactClassCompressionEnabled() const {
+    return SolverConfig.compressFactClasses() &&
+           !SolverConfig.adaptivePrecision();
+  }
+
+  /// Fact classes end at call sites and exits, as the call and return flow
+  /// functions map the facts between different scopes.
+  [[nodiscard]] bool canHoldFactClass(n_t Stmt) const {
+    return !ICF->isCallSite(Stmt) && !ICF->isExitInst(Stmt) &&
+           !ICF->isStartPoint(Stmt);
+  }
+
+  /// Returns the facts that are represented by Rep at Stmt, i.e. that share
+  /// Rep's path edge from SourceVal and its jump function.
+  container_type getFactClassMembers(n_t Stmt, d_t SourceVal, d_t Rep) {
+    if (!FactClasses.contains(Stmt, SourceVal)) {
+      return {};
+    }
+    const auto &Classes = FactClasses.get(Stmt, SourceVal);
+    if (auto It = Classes.find(Rep); It != Classes.end()) {
+      return It->second;
+    }
+    return {};
+  }
+
+  /// The normal flow of the representative d2 and its Members at n. A member
+  /// stays in the class at the successor iff both the representative and the
+  /// member are preserved with equal edge functions; otherwise, it is split
+  /// off and propagated on its own. If OnlyMembers is set, the
+  /// representative's own flow has been processed before and only the
+  /// (newly added) Members are processed.
+  void processNormalFlowOfFactClass(d_t d1, n_t n, d_t d2,
+                                    const EdgeFunctionPtrType &f,
+                                    const container_type &Members,
+                                    bool OnlyMembers) {
+    PAMM_GET_INSTANCE;
+    for (const auto nPrime : ICF->getSuccsOf(n)) {
+      FlowFunctionPtrType FlowFunc =
+          CachedFlowEdgeFunctions.getNormalFlowFunction(n, nPrime);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      const container_type Res = computeNormalFlowFunction(FlowFunc, d1, d2);
+      EdgeFunctionPtrType PreservingFn;
+      if (Res.size() == 1 && *Res.begin() == d2) {
+        PreservingFn =
+            CachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, nPrime, d2);
+      }
+      container_type Staying;
+      for (d_t Member : Members) {
+        const container_type MemberRes =
+            computeNormalFlowFunction(FlowFunc, d1, Member);
+        saveEdges(n, nPrime, Member, MemberRes, false);
+        if (PreservingFn && MemberRes.size() == 1 &&
+            *MemberRes.begin() == Member &&
+            CachedFlowEdgeFunctions
+                .getNormalEdgeFunction(n, Member, nPrime, Member)
+                ->equal_to(PreservingFn)) {
+          Staying.insert(Member);
+          continue;
+        }
+        INC_COUNTER("Fact class splits", 1, PAMM_SEVERITY_LEVEL::Full);
+        ++NumFactClassSplits;
+        propagateNormalFlowTargets(d1, n, Member, f, nPrime, MemberRes, {});
+      }
+      if (!OnlyMembers) {
+        ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
+                         PAMM_SEVERITY_LEVEL::Full);
+        saveEdges(n, nPrime, d2, Res, false);
+        propagateNormalFlowTargets(d1, n, d2, f, nPrime, Res, Staying);
+      } else if (!Staying.empty()) {
+        propagateFactClass(d1, nPrime, d2, f->composeWith(PreservingFn),
+                           Staying);
+      }
+    }
+  }
+
+  /// Propagates the targets Res of the normal flow of d2 from n to nPrime,
+  /// see propagateTargets().
+  void propagateNormalFlowTargets(d_t d1, n_t n, d_t d2,
+                                  const EdgeFunctionPtrType &f, n_t nPrime,
+                                  const container_type &Res,
+                                  const container_type &Staying) {
+    PAMM_GET_INSTANCE;
+    std::vector<std::pair<d_t, EdgeFunctionPtrType>> Targets;
+    for (d_t d3 : Res) {
+      EdgeFunctionPtrType g =
+          CachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, nPrime, d3);
+      PHASAR_LOG_LEVEL(DEBUG, "Queried Normal Edge Function: " << g->str());
+      EdgeFunctionPtrType fPrime = f->composeWith(g);
+      if (SolverConfig.emitESG()) {
+        IntermediateEdgeFunctions[std::make_tuple(n, d2, nPrime, d3)]
+            .push_back(g);
+      }
+      PHASAR_LOG_LEVEL(DEBUG, "Compose: " << g->str() << " * " << f->str()
+                                          << " = " << fPrime->str());
+      INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      Targets.emplace_back(d3, std::move(fPrime));
+    }
+    propagateTargets(d1, nPrime, d2, Staying, Targets);
+  }
+
+  /// Propagates the facts that flow from d2 to Target along with their
+  /// composed jump functions. If d2 is preserved, it keeps the members
+  /// Staying. The other target facts whose jump functions are equal form a
+  /// new fact class that is represented by its first fact.
+  void propagateTargets(
+      d_t d1, n_t Target, d_t d2, const container_type &Staying,
+      const std::vector<std::pair<d_t, EdgeFunctionPtrType>> &Targets) {
+    struct FactClass {
+      EdgeFunctionPtrType JumpFn;
+      d_t Rep;
+      container_type Members;
+    };
+    std::vector<FactClass> NewClasses;
+    for (const auto &[d3, fPrime] : Targets) {
+      if (d3 == d2) {
+        propagateFactClass(d1, Target, d3, fPrime, Staying);
+        continue;
+      }
+      if (IDEProblem.isZeroValue(d3)) {
+        propagate(d1, Target, d3, fPrime, nullptr, false);
+        continue;
+      }
+      auto It = std::find_if(NewClasses.begin(), NewClasses.end(),
+                             [&fPrime = fPrime](const FactClass &Class) {
+                               return Class.JumpFn->equal_to(fPrime);
+                             });
+      if (It == NewClasses.end()) {
+        NewClasses.push_back({fPrime, d3, {}});
+      } else {
+        It->Members.insert(d3);
+      }
+    }
+    for (const auto &Class : NewClasses) {
+      propagateFactClass(d1, Target, Class.Rep, Class.JumpFn, Class.Members);
+    }
+  }
+
+  /// Propagates the representative Rep together with its Members, which all
+  /// have the jump function f from (SP, d1) to Target. The members share the
+  /// path edge and jump function of Rep as long as Rep's jump function is f.
+  /// Whenever propagate() widens Rep's jump function, it splits the previous
+  /// members off with their previous jump function.
+  void propagateFactClass(d_t d1, n_t Target, d_t Rep,
+                          const EdgeFunctionPtrType &f,
+                          const container_type &Members) {
+    propagate(d1, Target, Rep, f, nullptr, false);
+    if (Members.empty()) {
+      return;
+    }
+    EdgeFunctionPtrType JumpFnE =
+        jumpFunction(PathEdge<n_t, d_t>(d1, Target, Rep));
+    if (!canHoldFactClass(Target) || !f->equal_to(JumpFnE)) {
+      for (d_t Member : Members) {
+        propagate(d1, Target, Member, f, nullptr, false);
+      }
+      return;
+    }
+    PAMM_GET_INSTANCE;
+    auto &Class = FactClasses.get(Target, d1)[Rep];
+    container_type NewMembers;
+    for (d_t Member : Members) {
+      if (Class.insert(Member).second) {
+        NewMembers.insert(Member);
+      }
+    }
+    if (!NewMembers.empty()) {
+      INC_COUNTER("Fact class members", NewMembers.size(),
+                  PAMM_SEVERITY_LEVEL::Full);
+      NumFactClassMembers += NewMembers.size();
+      processNormalFlowOfFactClass(d1, Target, Rep, JumpFnE, NewMembers,
+                                   /*OnlyMembers*/ true);
+    }
+  }
+
+  /// Splits the members off the fact class of Rep at Target, whose jump
+  /// function from (SP, d1) is about to be widened. The members keep Rep's
+  /// previous jump function JumpFnE and are propagated on their own.
+  void splitFactClass(d_t d1, n_t Target, d_t Rep,
+                      const EdgeFunctionPtrType &JumpFnE) {
+    if (!FactClasses.contains(Target, d1)) {
+      return;
+    }
+    auto &Classes = FactClasses.get(Target, d1);
+    auto It = Classes.find(Rep);
+    if (It == Classes.end()) {
+      return;
+    }
+    container_type Previous = std::move(It->second);
+    Classes.erase(It);
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Fact class splits", Previous.size(),
+                PAMM_SEVERITY_LEVEL::Full);
+    NumFactClassSplits += Previous.size();
+    for (d_t Member : Previous) {
+      propagate(d1, Target, Member, JumpFnE, nullptr, false);
+    }
+  }
+
   void propagateValueAtStart(const std::pair<n_t, d_t> NAndD, n_t Stmt) {
     PAMM_GET_INSTANCE;
     d_t Fact = NAndD.second;
     f_t Func = ICF->getFunctionOf(Stmt);
     for (const n_t CallSite : ICF->getCallsFromWithin(Func)) {
+      auto Pin = JumpFn->pin(CallSite);
       auto LookupResults = JumpFn->forwardLookup(Fact, CallSite);
       if (!LookupResults) {
         continue;
@@ -873,9 +1251,14 @@ protected:
           d_t d = SourceValTargetValAndFunction.getColumnKey();
           EdgeFunctionPtrType fPrime = SourceValTargetValAndFunction.getValue();
           l_t TargetVal = val(SP, dPrime);
-          setVal(n, d,
-                 IDEProblem.join(val(n, d),
-                                 fPrime->computeTarget(std::move(TargetVal))));
+          l_t Value = fPrime->computeTarget(std::move(TargetVal));
+          // the members of d's fact class share its jump function
+          if (isFactClassCompressionEnabled()) {
+            for (d_t Member : getFactClassMembers(n, dPrime, d)) {
+              setVal(n, Member, IDEProblem.join(val(n, Member), Value));
+            }
+          }
+          setVal(n, d, IDEProblem.join(val(n, d), std::move(Value)));
           INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
         }
       }
@@ -1057,6 +1440,8 @@ protected:
             PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime->str());
             // for each jump function coming into the call, propagate to
             // return site using the composed function
+            // keep the caller's jump functions in memory while propagating
+            auto Pin = JumpFn->pin(c);
             auto RevLookupResult = JumpFn->reverseLookup(c, d4);
             if (RevLookupResult) {
               for (size_t I = 0; I < RevLookupResult->get().size(); ++I) {
@@ -1179,6 +1564,100 @@ protected:
     return SummaryFlowFunction->computeTargets(d2);
   }
 
+  /// Queries the mod/ref pre-analysis whether the call-site abstraction d2
+  /// can bypass the given callee. Summaries are only inferred for LLVM-based
+  /// analyses whose data-flow facts are llvm::Values.
+  InferredFactEffect getInferredFactEffect(n_t CallSite, f_t Callee, d_t d2) {
+    if constexpr (std::is_same_v<i_t, LLVMBasedICFG> &&
+                  std::is_convertible_v<d_t, const llvm::Value *>) {
+      if (!InferredSummaries) {
+        InferredSummaries =
+            std::make_shared<const LLVMFunctionSideEffects>(*ICF);
+      }
+      return InferredSummaries->getFactEffect(
+          llvm::cast<llvm::CallBase>(CallSite), Callee, d2,
+          IDEProblem.isZeroValue(d2));
+    } else {
+      return InferredFactEffect::Unknown;
+    }
+  }
+
+  /// Propagates d2 across the call-site if the summary library that has been
+  /// loaded into SpecialSummaries contains a summary of the callee. Library
+  /// summaries are only applied for LLVM-based analyses whose data-flow facts
+  /// are llvm::Values. Returns false if the solver must descend into the
+  /// callee.
+  template <typename ReturnSitesTy>
+  bool applyLibrarySummary(n_t CallSite, f_t Callee, d_t d1, d_t d2,
+                           const EdgeFunctionPtrType &f,
+                           const ReturnSitesTy &ReturnSiteNs) {
+    if constexpr (std::is_same_v<f_t, const llvm::Function *> &&
+                  std::is_same_v<d_t, const llvm::Value *>) {
+      const auto *Summary =
+          SpecialSummaries<d_t, l_t>::getInstance().getLibrarySummary(Callee);
+      if (!Summary) {
+        return false;
+      }
+      PAMM_GET_INSTANCE;
+      PHASAR_LOG_LEVEL(DEBUG, "Apply library summary of '"
+                                  << ICF->getFunctionName(Callee) << "'");
+      INC_COUNTER("LibrarySummary Application", 1, PAMM_SEVERITY_LEVEL::Full);
+      llvm::SmallVector<std::pair<const llvm::Value *, SummaryEdgeKind>, 4>
+          Targets;
+      Summary->computeTargets(llvm::cast<llvm::CallBase>(CallSite), d2,
+                              IDEProblem.isZeroValue(d2), Targets);
+      container_type Res;
+      for (const auto &Target : Targets) {
+        Res.insert(Target.first);
+      }
+      for (n_t ReturnSiteN : ReturnSiteNs) {
+        saveEdges(CallSite, ReturnSiteN, d2, Res, false);
+        for (const auto &[d3, Kind] : Targets) {
+          propagate(d1, ReturnSiteN, d3,
+                    f->composeWith(getLibrarySummaryEdgeFunction(Kind)),
+                    CallSite, false);
+        }
+      }
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  /// Returns true if all callees are covered by the loaded summary library
+  /// and each of them kills d2.
+  template <typename CalleesTy>
+  bool isKilledByLibrarySummaries(n_t CallSite, const CalleesTy &Callees,
+                                  d_t d2) {
+    if constexpr (std::is_same_v<f_t, const llvm::Function *> &&
+                  std::is_same_v<d_t, const llvm::Value *>) {
+      const auto &Summaries = SpecialSummaries<d_t, l_t>::getInstance();
+      if (!Summaries.hasLibrarySummaries() || Callees.empty() ||
+          IDEProblem.isZeroValue(d2)) {
+        return false;
+      }
+      return llvm::all_of(Callees, [&Summaries, CallSite, d2](f_t Callee) {
+        const auto *Summary = Summaries.getLibrarySummary(Callee);
+        return Summary &&
+               Summary->kills(llvm::cast<llvm::CallBase>(CallSite), d2);
+      });
+    } else {
+      return false;
+    }
+  }
+
+  EdgeFunctionPtrType getLibrarySummaryEdgeFunction(SummaryEdgeKind Kind) {
+    switch (Kind) {
+    case SummaryEdgeKind::Identity:
+      return EdgeIdentity<l_t>::getInstance();
+    case SummaryEdgeKind::AllTop:
+      return AllTop;
+    case SummaryEdgeKind::AllBottom:
+      return std::make_shared<AllBottom<l_t>>(IDEProblem.bottomElement());
+    }
+    llvm_unreachable("All SummaryEdgeKinds should be handled in the switch");
+  }
+
   /// Computes the call flow function for the given call-site abstraction
   /// @param callFlowFunction The call flow function to compute
   /// @param d1 The abstraction at the current method's start node.
@@ -1242,6 +1721,9 @@ protected:
                  n_t /*RelatedCallSite*/,
                  /* deliberately exposed to clients */
                  bool /*IsUnbalancedReturn*/) {
+    if (SolverConfig.adaptivePrecision()) {
+      TargetVal = adaptPrecision(Target, std::move(TargetVal));
+    }
     PHASAR_LOG_LEVEL(DEBUG, "Propagate flow");
     PHASAR_LOG_LEVEL(DEBUG,
                      "Source value  : " << IDEProblem.DtoString(SourceVal));
@@ -1281,6 +1763,11 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG, ' '));
     if (NewFunction) {
       JumpFn->addFunction(SourceVal, Target, TargetVal, fPrime);
+      // The members of TargetVal's fact class do not share the widened jump
+      // function, regardless of which flow widened it
+      if (isFactClassCompressionEnabled()) {
+        splitFactClass(SourceVal, Target, TargetVal, JumpFnE);
+      }
       const PathEdge<n_t, d_t> Edge(SourceVal, Target, TargetVal);
       PathEdgeCount++;
       pathEdgeProcessingTask(Edge);
@@ -1301,6 +1788,47 @@ protected:
     }
   }
 
+  /// Counts the new fact TargetVal at Target and returns the fact to be
+  /// propagated instead, which is coarser than TargetVal once Target's
+  /// function has exceeded the fact limits. Each further coarsening level
+  /// doubles the limits. Facts at start points are never coarsened, as they
+  /// must match the facts used to look up summaries and incoming edges.
+  d_t adaptPrecision(n_t Target, d_t TargetVal) {
+    if (IDEProblem.isZeroValue(TargetVal) || ICF->isStartPoint(Target)) {
+      return TargetVal;
+    }
+    auto Fun = ICF->getFunctionOf(Target);
+    auto &Level = CoarseningLevels[Fun];
+    auto &FactsAtNode = NumFactsAtNode[Target];
+    auto &FactsInFunction = NumFactsInFunction[Fun];
+    if (FactsAtNode >= (SolverConfig.maxFactsPerNode() << Level) ||
+        FactsInFunction >= (SolverConfig.maxFactsPerFunction() << Level)) {
+      ++Level;
+      CoarseningEvents.push_back(
+          {Target, Fun, Level, FactsAtNode, FactsInFunction});
+      PHASAR_LOG_LEVEL(WARNING, "Coarsen facts in "
+                                    << ICF->getFunctionName(Fun)
+                                    << " to level " << Level << " at "
+                                    << IDEProblem.NtoString(Target) << " ("
+                                    << FactsAtNode << " facts at node, "
+                                    << FactsInFunction << " in function)");
+    }
+    if (Level) {
+      d_t Coarse = IDEProblem.coarsenFact(TargetVal, Level);
+      if (!(Coarse == TargetVal)) {
+        PAMM_GET_INSTANCE;
+        INC_COUNTER("Coarsened facts", 1, PAMM_SEVERITY_LEVEL::Core);
+        ++NumCoarsenedFacts;
+        TargetVal = std::move(Coarse);
+      }
+    }
+    if (!JumpFn->reverseLookup(Target, TargetVal)) {
+      ++FactsAtNode;
+      ++FactsInFunction;
+    }
+    return TargetVal;
+  }
+
   l_t joinValueAt(n_t /*Unit*/, d_t /*Fact*/, l_t Curr, l_t NewVal) {
     return IDEProblem.join(std::move(Curr), std::move(NewVal));
   }
@@ -1841,6 +2369,88 @@ public:
     OS << G;
   }
 
+  /// Emits the recorded exploded super-graph in the compact binary ESG trace
+  /// format (see ESGTrace.h). In contrast to emitESGAsDot() no graph is
+  /// materialized in memory; functions, nodes and facts are rendered to
+  /// strings only once. The trace can be sliced and rendered offline using the
+  /// phasar-esg-viewer tool. Requires the solver to record edges; edge
+  /// function labels are only available if emitESG() is set in addition.
+  void emitESGAsTrace(llvm::raw_ostream &OS) {
+    PHASAR_LOG_LEVEL(DEBUG, "Emit Exploded super-graph (ESG) as binary trace");
+    ESGTraceWriter Writer(OS);
+    std::unordered_map<f_t, uint32_t> FunctionIds;
+    std::unordered_map<n_t, uint32_t> NodeIds;
+    std::unordered_map<d_t, uint32_t> FactIds;
+    std::unordered_map<std::string, uint32_t> EdgeFunctionLabelIds;
+
+    auto getNodeId = [&](n_t N) {
+      auto [It, Inserted] = NodeIds.try_emplace(N, 0);
+      if (Inserted) {
+        f_t Fun = ICF->getFunctionOf(N);
+        auto [FunIt, FunInserted] = FunctionIds.try_emplace(Fun, 0);
+        if (FunInserted) {
+          FunIt->second = Writer.addFunction(ICF->getFunctionName(Fun));
+        }
+        It->second = Writer.addNode(FunIt->second, ICF->getStatementId(N),
+                                    IDEProblem.NtoString(N));
+      }
+      return It->second;
+    };
+    auto getFactId = [&](d_t D) {
+      auto [It, Inserted] = FactIds.try_emplace(D, 0);
+      if (Inserted) {
+        It->second = Writer.addFact(IDEProblem.DtoString(D),
+                                    IDEProblem.isZeroValue(D));
+      }
+      return It->second;
+    };
+    auto getEdgeFunctionLabelId = [&](n_t N1, d_t D1, n_t N2, d_t D2) {
+      auto Search =
+          IntermediateEdgeFunctions.find(std::make_tuple(N1, D1, N2, D2));
+      if (Search == IntermediateEdgeFunctions.end() ||
+          Search->second.empty()) {
+        return ESGTraceEdge::NoLabel;
+      }
+      std::string Label;
+      for (const auto &EF : Search->second) {
+        if (!Label.empty()) {
+          Label += ", ";
+        }
+        Label += EF->str();
+      }
+      auto [It, Inserted] = EdgeFunctionLabelIds.try_emplace(Label, 0);
+      if (Inserted) {
+        It->second = Writer.addEdgeFunctionLabel(It->first);
+      }
+      return It->second;
+    };
+    auto emitEdges = [&](const Table<n_t, n_t, std::map<d_t, Container>> &Tab,
+                         bool InterP) {
+      Tab.foreachCell([&](n_t N1, n_t N2, const auto &D1ToD2Set) {
+        for (const auto &[D1, D2Set] : D1ToD2Set) {
+          for (const auto &D2 : D2Set) {
+            ESGTraceEdge Edge;
+            Edge.FromNode = getNodeId(N1);
+            Edge.FromFact = getFactId(D1);
+            Edge.ToNode = getNodeId(N2);
+            Edge.ToFact = getFactId(D2);
+            Edge.EdgeFunctionLabel = getEdgeFunctionLabelId(N1, D1, N2, D2);
+            Edge.IsInterProcedural = InterP;
+            Writer.addEdge(Edge);
+          }
+        }
+      });
+    };
+
+    emitEdges(ComputedIntraPathEdges, false);
+    emitEdges(ComputedInterPathEdges, true);
+    OS.flush();
+    PHASAR_LOG_LEVEL(DEBUG, "Emitted " << Writer.getNumEdges()
+                                      << " ESG edges for " << NodeIds.size()
+                                      << " nodes and " << FactIds.size()
+                                      << " facts");
+  }
+
   /// @brief: Allows less-than comparison based on the statement ID.
   struct StmtLess {
     const i_t *ICF;
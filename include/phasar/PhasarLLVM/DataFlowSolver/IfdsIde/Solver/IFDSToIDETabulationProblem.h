@@ -14,6 +14,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
@@ -73,6 +74,7 @@ public:
             IFDSProblem.getEntryPoints()),
         Problem(IFDSProblem) {
     this->ZeroValue = Problem.createZeroValue();
+    this->setIFDSIDESolverConfig(IFDSProblem.getIFDSIDESolverConfig());
   }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
@@ -111,6 +113,10 @@ public:
     return Problem.isZeroValue(Fact);
   }
 
+  [[nodiscard]] d_t coarsenFact(d_t Fact, unsigned Level) override {
+    return Problem.coarsenFact(std::move(Fact), Level);
+  }
+
   BinaryDomain topElement() override { return BinaryDomain::TOP; }
 
   BinaryDomain bottomElement() override { return BinaryDomain::BOTTOM; }
@@ -17,18 +17,27 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_JUMPFUNCTIONS_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_JUMPFUNCTIONS_H
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <list>
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/ErrorHandling.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
+#include "phasar/Utils/SpillFile.h"
 #include "phasar/Utils/Table.h"
 
 namespace psr {
@@ -43,6 +52,8 @@ public:
   using l_t = typename AnalysisDomainTy::l_t;
   using d_t = typename AnalysisDomainTy::d_t;
   using n_t = typename AnalysisDomainTy::n_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using i_t = typename AnalysisDomainTy::i_t;
 
   using EdgeFunctionType = EdgeFunction<l_t>;
   using EdgeFunctionPtrType = std::shared_ptr<EdgeFunctionType>;
@@ -68,6 +79,54 @@ protected:
   std::unordered_map<n_t, Table<d_t, d_t, EdgeFunctionPtrType>>
       NonEmptyLookupByTargetNode;
 
+private:
+  /// The jump functions whose target nodes belong to the same function
+  struct SpillPartition {
+    std::unordered_set<n_t> Targets;
+    size_t NumResident = 0;
+    unsigned Pins = 0;
+    bool Spilled = false;
+    /// Whether the partition changed since it was last written to Slice
+    bool Dirty = true;
+    std::optional<SpillFile::Slice> Slice;
+    /// The pooled edge functions that Slice refers to
+    std::unordered_set<uint32_t> EdgeFunctionIds;
+    typename std::list<f_t>::iterator LRUPos;
+  };
+
+  /// A spilled jump function. Edge functions are not serializable in general,
+  /// thus they are referred to by their index in SpillState::EdgeFunctions.
+  struct SpillRecord {
+    d_t SourceVal;
+    n_t Target;
+    d_t TargetVal;
+    uint32_t EdgeFunctionId;
+  };
+
+  struct SpillState {
+    SpillState(const i_t *ICF, size_t MaxResident)
+        : ICF(ICF), MaxResident(MaxResident) {}
+
+    const i_t *ICF;
+    size_t MaxResident;
+    size_t NumResident = 0;
+    size_t NumSpills = 0;
+    size_t NumFaults = 0;
+    SpillFile File{"phasar-jump-functions"};
+    std::unordered_map<f_t, SpillPartition> Partitions;
+    /// The resident partitions, most recently used first
+    std::list<f_t> LRU;
+    /// The pool of spilled edge functions. An edge function is dropped from
+    /// the pool as soon as no slice refers to it anymore and its index is
+    /// reused.
+    std::vector<EdgeFunctionPtrType> EdgeFunctions;
+    std::vector<size_t> EdgeFunctionRefs;
+    std::vector<uint32_t> FreeEdgeFunctionIds;
+    std::unordered_map<const EdgeFunctionType *, uint32_t> EdgeFunctionIds;
+  };
+
+  std::unique_ptr<SpillState> Spill;
+
 public:
   JumpFunctions(
       EdgeFunctionPtrType Alltop,
@@ -76,11 +135,92 @@ public:
 
   ~JumpFunctions() = default;
 
-  JumpFunctions(const JumpFunctions &JFs) = default;
-  JumpFunctions &operator=(const JumpFunctions &JFs) = default;
+  JumpFunctions(const JumpFunctions &JFs) = delete;
+  JumpFunctions &operator=(const JumpFunctions &JFs) = delete;
   JumpFunctions(JumpFunctions &&JFs) noexcept = default;
   JumpFunctions &operator=(JumpFunctions &&JFs) noexcept = default;
 
+  /**
+   * Enables the out-of-core mode: the jump functions are partitioned by the
+   * function of their target node, and whenever more than MaxResident jump
+   * functions are held in memory, the least recently used partitions are
+   * moved to a temporary spill file. Spilled partitions are read back on
+   * their next access.
+   *
+   * The spill file refers to the data-flow facts and nodes by value and to
+   * the edge functions by their index in a pool of the spilled edge
+   * functions, so spilling saves memory mostly for problems that share their
+   * edge functions, such as IFDS problems.
+   */
+  void enableSpilling(const i_t *ICF, size_t MaxResident) {
+    if constexpr (std::is_trivially_copyable_v<d_t> &&
+                  std::is_trivially_copyable_v<n_t>) {
+      Spill = std::make_unique<SpillState>(ICF, MaxResident);
+      for (auto &[Target, Tab] : NonEmptyLookupByTargetNode) {
+        auto &Partition = touch(Target);
+        Partition.Targets.insert(Target);
+        Tab.foreachCell([&](d_t /*SourceVal*/, d_t /*TargetVal*/,
+                            const EdgeFunctionPtrType & /*EdgeFunc*/) {
+          ++Partition.NumResident;
+          ++Spill->NumResident;
+        });
+      }
+    } else {
+      llvm::report_fatal_error("Spilling jump functions requires trivially "
+                               "copyable data-flow facts and nodes");
+    }
+  }
+
+  [[nodiscard]] bool isSpillingEnabled() const noexcept {
+    return Spill != nullptr;
+  }
+
+  /// Returns the number of partitions that have been written to the spill
+  /// file so far
+  [[nodiscard]] size_t getNumSpills() const noexcept {
+    return Spill ? Spill->NumSpills : 0;
+  }
+
+  /// Returns the number of partitions that have been read back from the
+  /// spill file so far
+  [[nodiscard]] size_t getNumFaults() const noexcept {
+    return Spill ? Spill->NumFaults : 0;
+  }
+
+  /// Keeps the jump functions of the function of a target node in memory
+  /// while the guard is alive, so that references obtained from
+  /// reverseLookup(), forwardLookup() or lookupByTarget() stay valid.
+  class PinGuard {
+  public:
+    PinGuard() noexcept = default;
+    explicit PinGuard(SpillPartition *Partition) noexcept
+        : Partition(Partition) {
+      if (Partition) {
+        ++Partition->Pins;
+      }
+    }
+    ~PinGuard() {
+      if (Partition) {
+        --Partition->Pins;
+      }
+    }
+    PinGuard(const PinGuard &) = delete;
+    PinGuard &operator=(const PinGuard &) = delete;
+    PinGuard(PinGuard &&Other) noexcept
+        : Partition(std::exchange(Other.Partition, nullptr)) {}
+    PinGuard &operator=(PinGuard &&) = delete;
+
+  private:
+    SpillPartition *Partition = nullptr;
+  };
+
+  [[nodiscard]] PinGuard pin(n_t Target) {
+    if (!Spill) {
+      return {};
+    }
+    return PinGuard(&access(Target));
+  }
+
   /**
    * Records a jump function. The source statement is implicit.
    * @see PathEdge
@@ -99,6 +239,25 @@ public:
       return;
     }
 
+    SpillPartition *Partition = Spill ? &access(Target) : nullptr;
+    bool IsNew = insertFunction(SourceVal, Target, TargetVal, EdgeFunc);
+    if (Partition) {
+      Partition->Dirty = true;
+      Partition->Targets.insert(Target);
+      if (IsNew) {
+        ++Partition->NumResident;
+        ++Spill->NumResident;
+        enforceResidentBudget(Partition);
+      }
+    }
+    PHASAR_LOG_LEVEL(DEBUG, "End adding new jump function");
+  }
+
+private:
+  /// Inserts the jump function into all lookup tables and returns whether it
+  /// was not present before
+  bool insertFunction(d_t SourceVal, n_t Target, d_t TargetVal,
+                      EdgeFunctionPtrType EdgeFunc) {
     auto &SourceValToFunc = NonEmptyReverseLookup.get(Target, TargetVal);
     if (auto Find = std::find_if(
             SourceValToFunc.begin(), SourceValToFunc.end(),
@@ -129,10 +288,164 @@ public:
 
     // V Table::insert(R r, C c, V v) always overrides (see
     // comments above)
-    NonEmptyLookupByTargetNode[Target].insert(SourceVal, TargetVal, EdgeFunc);
-    PHASAR_LOG_LEVEL(DEBUG, "End adding new jump function");
+    auto &ByTarget = NonEmptyLookupByTargetNode[Target];
+    bool IsNew = !ByTarget.contains(SourceVal, TargetVal);
+    ByTarget.insert(SourceVal, TargetVal, std::move(EdgeFunc));
+    return IsNew;
+  }
+
+  /// Marks the partition of Target as most recently used and reads it back
+  /// from the spill file if necessary
+  SpillPartition &access(n_t Target) {
+    auto &Partition = touch(Target);
+    if (Partition.Spilled) {
+      faultIn(Spill->ICF->getFunctionOf(Target), Partition);
+      enforceResidentBudget(&Partition);
+    }
+    return Partition;
+  }
+
+  SpillPartition &touch(n_t Target) {
+    auto Fun = Spill->ICF->getFunctionOf(Target);
+    auto [It, Inserted] = Spill->Partitions.try_emplace(Fun);
+    auto &Partition = It->second;
+    if (Inserted) {
+      Partition.LRUPos = Spill->LRU.insert(Spill->LRU.begin(), Fun);
+    } else if (!Partition.Spilled) {
+      Spill->LRU.splice(Spill->LRU.begin(), Spill->LRU, Partition.LRUPos);
+    }
+    return Partition;
   }
 
+  /// Spills the least recently used partitions until at most MaxResident
+  /// jump functions are held in memory. Neither Current nor pinned partitions
+  /// are spilled.
+  void enforceResidentBudget(SpillPartition *Current) {
+    auto It = Spill->LRU.end();
+    while (Spill->NumResident > Spill->MaxResident &&
+           It != Spill->LRU.begin()) {
+      --It;
+      auto &Partition = Spill->Partitions[*It];
+      if (&Partition == Current || Partition.Pins || !Partition.NumResident) {
+        continue;
+      }
+      // spillOut() removes It from the LRU list
+      auto Next = std::next(It);
+      spillOut(Partition);
+      It = Next;
+    }
+  }
+
+  void spillOut(SpillPartition &Partition) {
+    if (Partition.Dirty || !Partition.Slice) {
+      std::string Buffer;
+      Buffer.reserve(Partition.NumResident * sizeof(SpillRecord));
+      std::unordered_set<uint32_t> EdgeFunctionIds;
+      for (auto Target : Partition.Targets) {
+        NonEmptyLookupByTargetNode[Target].foreachCell(
+            [&](d_t SourceVal, d_t TargetVal,
+                const EdgeFunctionPtrType &EdgeFunc) {
+              SpillRecord Record{SourceVal, Target, TargetVal,
+                                 poolEdgeFunction(EdgeFunc, EdgeFunctionIds)};
+              Buffer.append(reinterpret_cast<const char *>(&Record),
+                            sizeof(Record));
+            });
+      }
+      // The old slice is superseded, release the edge functions it refers to
+      // only after the new slice holds on to the shared ones. Its range in the
+      // spill file is reused for the new slice if that fits.
+      releaseEdgeFunctions(Partition.EdgeFunctionIds);
+      Partition.EdgeFunctionIds = std::move(EdgeFunctionIds);
+      if (Partition.Slice) {
+        Spill->File.release(*Partition.Slice);
+      }
+      Partition.Slice = Spill->File.append(Buffer);
+      ++Spill->NumSpills;
+    }
+    for (auto Target : Partition.Targets) {
+      NonEmptyLookupByTargetNode[Target].foreachCell(
+          [&](d_t SourceVal, d_t /*TargetVal*/,
+              const EdgeFunctionPtrType & /*EdgeFunc*/) {
+            auto &Row = NonEmptyForwardLookup.row(SourceVal);
+            Row.erase(Target);
+            if (Row.empty()) {
+              NonEmptyForwardLookup.remove(SourceVal);
+            }
+          });
+      NonEmptyReverseLookup.remove(Target);
+      NonEmptyLookupByTargetNode.erase(Target);
+    }
+    Spill->NumResident -= Partition.NumResident;
+    Partition.NumResident = 0;
+    Partition.Spilled = true;
+    Partition.Dirty = false;
+    Spill->LRU.erase(Partition.LRUPos);
+  }
+
+  /// Returns the index of EdgeFunc in the pool of spilled edge functions and
+  /// records it in SliceIds, once per slice.
+  uint32_t poolEdgeFunction(const EdgeFunctionPtrType &EdgeFunc,
+                            std::unordered_set<uint32_t> &SliceIds) {
+    auto [IdIt, Inserted] =
+        Spill->EdgeFunctionIds.try_emplace(EdgeFunc.get(), 0);
+    if (Inserted) {
+      if (Spill->FreeEdgeFunctionIds.empty()) {
+        IdIt->second = Spill->EdgeFunctions.size();
+        Spill->EdgeFunctions.push_back(EdgeFunc);
+        Spill->EdgeFunctionRefs.push_back(0);
+      } else {
+        IdIt->second = Spill->FreeEdgeFunctionIds.back();
+        Spill->FreeEdgeFunctionIds.pop_back();
+        Spill->EdgeFunctions[IdIt->second] = EdgeFunc;
+      }
+    }
+    if (SliceIds.insert(IdIt->second).second) {
+      ++Spill->EdgeFunctionRefs[IdIt->second];
+    }
+    return IdIt->second;
+  }
+
+  void releaseEdgeFunctions(const std::unordered_set<uint32_t> &SliceIds) {
+    for (auto Id : SliceIds) {
+      if (--Spill->EdgeFunctionRefs[Id] == 0) {
+        Spill->EdgeFunctionIds.erase(Spill->EdgeFunctions[Id].get());
+        Spill->EdgeFunctions[Id] = nullptr;
+        Spill->FreeEdgeFunctionIds.push_back(Id);
+      }
+    }
+  }
+
+  void faultIn(f_t Fun, SpillPartition &Partition) {
+    auto Buffer = Spill->File.read(*Partition.Slice);
+    const char *Data = Buffer->getBufferStart();
+    size_t NumRecords = Buffer->getBufferSize() / sizeof(SpillRecord);
+    for (size_t I = 0; I < NumRecords; ++I) {
+      SpillRecord Record;
+      std::memcpy(&Record, Data + I * sizeof(SpillRecord), sizeof(Record));
+      insertFunction(Record.SourceVal, Record.Target, Record.TargetVal,
+                     Spill->EdgeFunctions[Record.EdgeFunctionId]);
+    }
+    ++Spill->NumFaults;
+    Spill->NumResident += NumRecords;
+    Partition.NumResident = NumRecords;
+    Partition.Spilled = false;
+    Partition.LRUPos = Spill->LRU.insert(Spill->LRU.begin(), Fun);
+  }
+
+  /// Reads all spilled partitions back, e.g. before printing the tables
+  void faultInAll() {
+    if (!Spill) {
+      return;
+    }
+    for (auto &[Fun, Partition] : Spill->Partitions) {
+      if (Partition.Spilled) {
+        faultIn(Fun, Partition);
+      }
+    }
+  }
+
+public:
+
   /**
    * Returns, for a given target statement and value all associated
    * source values, and for each the associated edge function.
@@ -141,6 +454,9 @@ public:
   std::optional<std::reference_wrapper<
       llvm::SmallVectorImpl<std::pair<d_t, EdgeFunctionPtrType>>>>
   reverseLookup(n_t Target, d_t TargetVal) {
+    if (Spill) {
+      access(Target);
+    }
     if (!NonEmptyReverseLookup.contains(Target, TargetVal)) {
       return std::nullopt;
     }
@@ -155,6 +471,9 @@ public:
   std::optional<std::reference_wrapper<
       llvm::SmallVectorImpl<std::pair<d_t, EdgeFunctionPtrType>>>>
   forwardLookup(d_t SourceVal, n_t Target) {
+    if (Spill) {
+      access(Target);
+    }
     if (!NonEmptyForwardLookup.contains(SourceVal, Target)) {
       return std::nullopt;
     }
@@ -168,6 +487,9 @@ public:
    * (sourceVal,targetVal,edgeFunction).
    */
   Table<d_t, d_t, EdgeFunctionPtrType> &lookupByTarget(n_t Target) {
+    if (Spill) {
+      access(Target);
+    }
     return NonEmptyLookupByTargetNode[Target];
   }
 
@@ -178,6 +500,7 @@ public:
    * there anyway.
    */
   bool removeFunction(d_t SourceVal, n_t Target, d_t TargetVal) {
+    SpillPartition *Partition = Spill ? &access(Target) : nullptr;
     auto &SourceValToFunc = NonEmptyReverseLookup.get(Target, TargetVal);
     if (auto Find = std::find_if(
             SourceValToFunc.begin(), SourceValToFunc.end(),
@@ -196,7 +519,29 @@ public:
         Find != TargetValToFunc.end()) {
       TargetValToFunc.erase(Find);
     }
-    return NonEmptyLookupByTargetNode.erase(Target);
+    auto ByTargetIt = NonEmptyLookupByTargetNode.find(Target);
+    if (ByTargetIt == NonEmptyLookupByTargetNode.end() ||
+        !ByTargetIt->second.contains(SourceVal, TargetVal)) {
+      return false;
+    }
+    auto &ByTarget = ByTargetIt->second;
+    ByTarget.remove(SourceVal, TargetVal);
+    if (ByTarget.row(SourceVal).empty()) {
+      ByTarget.remove(SourceVal);
+    }
+    bool TargetIsEmpty = ByTarget.empty();
+    if (TargetIsEmpty) {
+      NonEmptyLookupByTargetNode.erase(ByTargetIt);
+    }
+    if (Partition) {
+      --Partition->NumResident;
+      --Spill->NumResident;
+      Partition->Dirty = true;
+      if (TargetIsEmpty) {
+        Partition->Targets.erase(Target);
+      }
+    }
+    return true;
   }
 
   /**
@@ -206,9 +551,24 @@ public:
     NonEmptyReverseLookup.clear();
     NonEmptyForwardLookup.clear();
     NonEmptyLookupByTargetNode.clear();
+    if (Spill) {
+      for (const auto &[Fun, Partition] : Spill->Partitions) {
+        if (Partition.Slice) {
+          Spill->File.release(*Partition.Slice);
+        }
+      }
+      Spill->Partitions.clear();
+      Spill->LRU.clear();
+      Spill->EdgeFunctions.clear();
+      Spill->EdgeFunctionRefs.clear();
+      Spill->FreeEdgeFunctionIds.clear();
+      Spill->EdgeFunctionIds.clear();
+      Spill->NumResident = 0;
+    }
   }
 
   void printJumpFunctions(llvm::raw_ostream &OS) {
+    faultInAll();
     OS << "\n******************************************************";
     OS << "\n*              Print all Jump Functions              *";
     OS << "\n******************************************************\n";
@@ -225,6 +585,7 @@ public:
   }
 
   void printNonEmptyReverseLookup(llvm::raw_ostream &OS) {
+    faultInAll();
     OS << "DUMP nonEmptyReverseLookup\nTable<N, D, std::unordered_map<D, "
           "EdgeFunctionPtrType>>\n";
     auto CellVec = NonEmptyReverseLookup.cellVec();
@@ -240,6 +601,7 @@ public:
   }
 
   void printNonEmptyForwardLookup(llvm::raw_ostream &OS) {
+    faultInAll();
     OS << "DUMP nonEmptyForwardLookup\nTable<D, N, std::unordered_map<D, "
           "EdgeFunctionPtrType>>\n";
     auto CellVec = NonEmptyForwardLookup.cellVec();
@@ -255,6 +617,7 @@ public:
   }
 
   void printNonEmptyLookupByTargetNode(llvm::raw_ostream &OS) {
+    faultInAll();
     OS << "DUMP nonEmptyLookupByTargetNode\nstd::unordered_map<N, Table<D, D, "
           "EdgeFunctionPtrType>>\n";
     for (auto Node : NonEmptyLookupByTargetNode) {
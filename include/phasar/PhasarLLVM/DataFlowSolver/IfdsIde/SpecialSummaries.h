@@ -26,6 +26,7 @@
 #include "phasar/Config/Configuration.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
 #include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
 #include "phasar/Utils/IO.h" // readFile
 
@@ -41,6 +42,7 @@ private:
   std::map<std::string, FlowFunctionPtrType> SpecialFlowFunctions;
   std::map<std::string, std::shared_ptr<EdgeFunction<V>>> SpecialEdgeFunctions;
   std::vector<std::string> SpecialFunctionNames;
+  SummaryLibrary::AnalysisSummaries LibrarySummaries;
 
   // Constructs the SpecialSummaryMap such that it contains all glibc,
   // llvm.intrinsics and C++'s new, new[], delete, delete[] with identity
@@ -113,11 +115,38 @@ public:
     return SpecialEdgeFunctions[Name];
   }
 
+  // Replaces the summaries of a previously loaded library with the summaries
+  // that Lib provides for the analysis with the given command-line name.
+  // Returns the number of loaded summaries.
+  size_t loadSummaryLibrary(const SummaryLibrary &Lib,
+                            llvm::StringRef AnalysisName) {
+    LibrarySummaries.clear();
+    if (const auto *Summaries = Lib.getSummaries(AnalysisName)) {
+      LibrarySummaries = *Summaries;
+    }
+    return LibrarySummaries.size();
+  }
+
+  void clearSummaryLibrary() { LibrarySummaries.clear(); }
+
+  [[nodiscard]] bool hasLibrarySummaries() const {
+    return !LibrarySummaries.empty();
+  }
+
+  // Returns nullptr if the loaded library does not summarize Func.
+  const FunctionSummary *getLibrarySummary(const llvm::Function *Func) const {
+    if (LibrarySummaries.empty()) {
+      return nullptr;
+    }
+    auto It = LibrarySummaries.find(Func->getName());
+    return It != LibrarySummaries.end() ? &It->second : nullptr;
+  }
+
   friend llvm::raw_ostream &
-  operator<<(llvm::raw_ostream &OS, const SpecialSummaries<D> &SpecialSumms) {
+  operator<<(llvm::raw_ostream &OS, const SpecialSummaries &SpecialSumms) {
     OS << "SpecialSummaries:\n";
-    for (auto &Entry : SpecialSumms.SpecialFunctionNames) {
-      OS << Entry.first << " ";
+    for (const auto &Name : SpecialSumms.SpecialFunctionNames) {
+      OS << Name << " ";
     }
     return OS;
   }
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SUMMARYLIBRARY_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SUMMARYLIBRARY_H
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "nlohmann/json.hpp"
+
+namespace llvm {
+class CallBase;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/// The edge function that is associated with a summarized flow. The solver
+/// instantiates the concrete edge functions for its value domain.
+enum class SummaryEdgeKind {
+  /// The value is copied unchanged
+  Identity,
+  AllTop,
+  /// The value is computed from the source, so nothing is known about it
+  AllBottom,
+};
+
+std::string toString(SummaryEdgeKind Kind);
+SummaryEdgeKind toSummaryEdgeKind(llvm::StringRef Str);
+
+/// A flow from one position of a summarized call to another one. Positions
+/// are argument indices or one of the special positions Zero and Return.
+/// Facts on pointer arguments stand for the memory that is reachable through
+/// them.
+struct SummaryFlow {
+  static constexpr int Zero = -1;
+  static constexpr int Return = -2;
+
+  int From = Zero;
+  int To = Return;
+  SummaryEdgeKind Edge = SummaryEdgeKind::Identity;
+
+  friend bool operator==(const SummaryFlow &Lhs, const SummaryFlow &Rhs) {
+    return Lhs.From == Rhs.From && Lhs.To == Rhs.To && Lhs.Edge == Rhs.Edge;
+  }
+  friend bool operator<(const SummaryFlow &Lhs, const SummaryFlow &Rhs) {
+    return std::tie(Lhs.From, Lhs.To, Lhs.Edge) <
+           std::tie(Rhs.From, Rhs.To, Rhs.Edge);
+  }
+};
+
+/// The summary of a single function for a single analysis. All facts that are
+/// not killed hold unchanged after the call; the flows generate additional
+/// facts.
+struct FunctionSummary {
+  std::vector<SummaryFlow> Flows;
+  /// Argument positions whose facts do not survive the call
+  std::vector<int> Kills;
+
+  /// Returns true if Fact is passed to a killed argument at the call-site CS
+  [[nodiscard]] bool kills(const llvm::CallBase *CS,
+                           const llvm::Value *Fact) const;
+
+  /// Computes the facts that hold after the call-site CS for the fact that
+  /// holds before it, together with the edges that lead to them.
+  void computeTargets(
+      const llvm::CallBase *CS, const llvm::Value *Fact, bool IsZero,
+      llvm::SmallVectorImpl<std::pair<const llvm::Value *, SummaryEdgeKind>>
+          &Targets) const;
+
+  friend bool operator==(const FunctionSummary &Lhs,
+                         const FunctionSummary &Rhs) {
+    return Lhs.Flows == Rhs.Flows && Lhs.Kills == Rhs.Kills;
+  }
+};
+
+/// A versioned collection of precomputed function summaries, grouped by the
+/// analyses they have been computed for. Analyses are identified by their
+/// command-line names (see DataFlowAnalysisType.def), functions by their
+/// (mangled) names. Libraries are stored as JSON:
+///
+///   {"version": 1,
+///    "analyses": {
+///      "ifds-taint": {
+///        "memcpy": {"flows": [{"from": "arg1", "to": "arg0",
+///                              "edge": "identity"},
+///                             {"from": "arg0", "to": "ret",
+///                              "edge": "identity"}],
+///                   "kills": []}}}}
+///
+/// Positions are "zero", "ret" or "argN". Loaded libraries are passed to the
+/// IDE solver via SpecialSummaries::loadSummaryLibrary().
+class SummaryLibrary {
+public:
+  static constexpr unsigned Version = 1;
+
+  using AnalysisSummaries = std::map<std::string, FunctionSummary, std::less<>>;
+
+  SummaryLibrary() = default;
+
+  /// Throws std::runtime_error if the JSON has the wrong version or is
+  /// malformed.
+  explicit SummaryLibrary(const nlohmann::json &J);
+
+  static SummaryLibrary readFile(const std::string &Path);
+
+  void writeFile(const std::string &Path) const;
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+
+  /// Returns true, when an existing summary is overwritten, false otherwise.
+  bool addSummary(llvm::StringRef Analysis, llvm::StringRef Function,
+                  FunctionSummary Summary);
+
+  [[nodiscard]] const FunctionSummary *
+  getSummary(llvm::StringRef Analysis, llvm::StringRef Function) const;
+
+  /// Returns nullptr if the library contains no summaries for Analysis.
+  [[nodiscard]] const AnalysisSummaries *
+  getSummaries(llvm::StringRef Analysis) const;
+
+  [[nodiscard]] std::vector<std::string> getAnalyses() const;
+
+  [[nodiscard]] size_t size() const;
+
+  [[nodiscard]] bool empty() const { return Summaries.empty(); }
+
+private:
+  std::map<std::string, AnalysisSummaries, std::less<>> Summaries;
+};
+
+} // namespace psr
+
+#endif
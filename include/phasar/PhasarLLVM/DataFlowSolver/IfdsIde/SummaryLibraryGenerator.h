@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SUMMARYLIBRARYGENERATOR_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SUMMARYLIBRARYGENERATOR_H
+
+#include <string>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
+
+namespace llvm {
+class Function;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/// Precomputes value-flow summaries for the function definitions of a
+/// library, e.g. libc or libc++ compiled to bitcode, bottom-up over the
+/// call-graph. A summary records which parameters (or the memory reachable
+/// through them) may flow into the memory reachable through other parameters
+/// and into the return value. Flows that copy values get identity edges,
+/// flows that compute new values bottom edges.
+///
+/// The analysis is flow-insensitive and never kills facts. Functions that
+/// access mutable globals, call unresolved functions or use atomics cannot be
+/// summarized and keep being analyzed by the solver.
+class SummaryLibraryGenerator {
+public:
+  explicit SummaryLibraryGenerator(const ProjectIRDB &IRDB);
+
+  /// Returns nullptr if F cannot be summarized.
+  [[nodiscard]] const FunctionSummary *
+  getSummary(const llvm::Function *F) const;
+
+  /// Adds the summaries of all externally visible functions to Lib, once for
+  /// each of the given analyses.
+  void addTo(SummaryLibrary &Lib, llvm::ArrayRef<std::string> Analyses) const;
+
+  [[nodiscard]] size_t size() const { return Summaries.size(); }
+
+private:
+  llvm::DenseMap<const llvm::Function *, FunctionSummary> Summaries;
+};
+
+} // namespace psr
+
+#endif
@@ -68,7 +68,7 @@ public:
   void print(llvm::raw_ostream &OS) const {
     OS << "Call string: [ ";
     for (auto C : CallString) {
-      OS << llvmIRToString(C);
+      OS << llvmIRToStringRef(C);
       if (C != CallString.back()) {
         OS << " * ";
       }
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_PASSES_IRNORMALIZATIONPASS_H_
+#define PHASAR_PHASARLLVM_PASSES_IRNORMALIZATIONPASS_H_
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+class Function;
+class Module;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Shrinks unoptimized (-O0) IR before it is analyzed: stack variables that do
+ * not escape are promoted to SSA registers (like mem2reg), instructions with
+ * constant operands are folded and trivially dead instructions are removed.
+ * This removes most of the allocas, loads and stores that inflate the number
+ * of nodes and data-flow facts of the analyses.
+ *
+ * The pass expects that ValueAnnotationPass already annotated the module. The
+ * instructions that remain keep their IDs. Instructions that the promotion
+ * synthesizes, i.e., phi nodes and debug intrinsics, get a fresh ID and are
+ * additionally annotated with the ID of the original instruction they stand
+ * for (see PhasarConfig::OriginMetaDataKind() and getOriginalMetaDataID()),
+ * which is the alloca of the promoted variable. The IR strings that reports
+ * and traces print for such instructions (see llvmIRToString()) show both IDs.
+ *
+ * @brief Promotes, folds and removes instructions to shrink the IR.
+ */
+class IRNormalizationPass
+    : public llvm::AnalysisInfoMixin<IRNormalizationPass> {
+private:
+  friend llvm::AnalysisInfoMixin<IRNormalizationPass>;
+  static llvm::AnalysisKey Key;
+
+public:
+  explicit IRNormalizationPass();
+
+  static llvm::PreservedAnalyses run(llvm::Module &M,
+                                     llvm::ModuleAnalysisManager &AM);
+
+  /// Normalizes a single function; returns true if F has been changed. The
+  /// cached analysis results of F have to be invalidated in that case (see
+  /// LLVMFunctionAnalysisCache::invalidate()).
+  static bool normalizeFunction(llvm::Function &F);
+};
+
+} // namespace psr
+
+#endif
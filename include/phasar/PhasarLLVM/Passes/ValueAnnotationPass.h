@@ -20,6 +20,7 @@
 #include "llvm/IR/PassManager.h"
 
 namespace llvm {
+class Instruction;
 class LLVMContext;
 class Module;
 class AnalysisUsage;
@@ -49,6 +50,12 @@ public:
   static llvm::PreservedAnalyses run(llvm::Module &M,
                                      llvm::ModuleAnalysisManager &AM);
 
+  /**
+   * @brief Annotates an instruction that has been created after the pass ran
+   * with a fresh ID.
+   */
+  static void annotate(llvm::Instruction &I);
+
   /**
    * @brief Resets the global ID - only used for unit testing!
    */
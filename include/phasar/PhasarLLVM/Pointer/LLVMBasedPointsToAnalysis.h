@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_POINTER_LLVMBASEDPOINTSTOANALYSIS_H_
 #define PHASAR_PHASARLLVM_POINTER_LLVMBASEDPOINTSTOANALYSIS_H_
 
+#include <functional>
 #include <unordered_map>
 
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -29,23 +30,43 @@ namespace psr {
 class ProjectIRDB;
 
 class LLVMBasedPointsToAnalysis {
+public:
+  /// Returns the alias analysis results of a function, e.g. from the
+  /// FunctionAnalysisManager of the pass pipeline phasar runs in.
+  using AAResultsGetterTy = std::function<llvm::AAResults &(llvm::Function &)>;
+
 private:
   llvm::PassBuilder PB;
   llvm::AAManager AA;
   llvm::FunctionAnalysisManager FAM;
   llvm::FunctionPassManager FPM;
+  /// The analyzed functions and their alias analysis results. Results that
+  /// are provided by GetAAResults are not stored, as their owner may drop
+  /// them at any time, e.g. the IRDB's analysis cache on invalidation. They
+  /// are fetched on every query instead.
   mutable std::unordered_map<const llvm::Function *, llvm::AAResults *> AAInfos;
   PointerAnalysisType PATy;
+  AAResultsGetterTy GetAAResults;
 
   bool hasPointsToInfo(const llvm::Function &Fun) const;
 
   void computePointsToInfo(llvm::Function &Fun);
 
 public:
+  /// Shares the alias analysis results that IRDB's analysis cache computes if
+  /// they are computed for PATy and runs the alias analyses on its own
+  /// otherwise.
   LLVMBasedPointsToAnalysis(
       ProjectIRDB &IRDB, bool UseLazyEvaluation = true,
       PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
 
+  /// Uses the alias analysis results provided by GetAAResults instead of
+  /// running the alias analyses on its own. The results are not owned and
+  /// are not released by erase() or clear(). PATy is only informational.
+  explicit LLVMBasedPointsToAnalysis(
+      AAResultsGetterTy GetAAResults,
+      PointerAnalysisType PATy = PointerAnalysisType::Invalid);
+
   ~LLVMBasedPointsToAnalysis() = default;
 
   void print(llvm::raw_ostream &OS = llvm::outs()) const;
@@ -54,6 +75,9 @@ public:
     if (!hasPointsToInfo(*F)) {
       computePointsToInfo(*F);
     }
+    if (GetAAResults) {
+      return &GetAAResults(*F);
+    }
     return AAInfos.at(F);
   };
 
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_LLVMCONTEXTSENSITIVEPOINTSTOQUERY_H
+#define PHASAR_PHASARLLVM_POINTER_LLVMCONTEXTSENSITIVEPOINTSTOQUERY_H
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+#include "phasar/PhasarLLVM/Pointer/PointsToSetOwner.h"
+
+namespace llvm {
+class CallBase;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/// Refines the points-to sets of a context-insensitive LLVMPointsToInfo for
+/// single pointers in a given calling context.
+///
+/// A query walks the value flow of the pointer backwards to the allocation
+/// sites it may point to (allocas, heap allocations, globals). Arguments are
+/// resolved at the call site on top of the call string and return values of
+/// callees are resolved in the callee's context, whose call string is limited
+/// to the K innermost call sites (k-CFA). Allocas and heap allocations are
+/// distinguished by the context they are allocated in. Memory is only tracked
+/// through allocas and globals that are exclusively loaded from and stored to
+/// directly. The refined points-to set contains those members of the
+/// context-insensitive points-to set that may point to one of these
+/// allocation sites.
+///
+/// Each query visits at most Budget values. If the budget runs out, or the
+/// walk reaches a value it cannot handle, e.g. the result of an indirect
+/// call, the context-insensitive points-to set is returned instead. Results
+/// are memoized, so the query engine must be cleared when the underlying
+/// points-to information changes.
+class LLVMContextSensitivePointsToQuery {
+public:
+  using CallStringTy = llvm::ArrayRef<const llvm::CallBase *>;
+  /// Identifies an interned call string
+  using ContextId = unsigned;
+  /// An allocation site together with the context it allocates in. The
+  /// context of global objects is always the empty context.
+  using AllocationSiteTy = std::pair<const llvm::Value *, ContextId>;
+  using AllocationSiteSetTy = llvm::DenseSet<AllocationSiteTy>;
+
+  static constexpr ContextId EmptyContext = 0;
+
+  static constexpr unsigned DefaultCallStringLength = 2;
+  static constexpr size_t DefaultBudget = 10000;
+
+  explicit LLVMContextSensitivePointsToQuery(
+      LLVMPointsToInfo &PT, unsigned K = DefaultCallStringLength,
+      size_t Budget = DefaultBudget);
+
+  /// Returns the points-to set of V in the calling context CallString, where
+  /// the innermost call site comes last.
+  [[nodiscard]] LLVMPointsToInfo::PointsToSetPtrTy
+  getPointsToSetInContext(const llvm::Value *V, CallStringTy CallString);
+
+  /// Returns the allocation sites V may point to in the calling context
+  /// CallString, or nullptr if they cannot be determined within the budget.
+  /// Arguments of functions that may be called from outside the module stand
+  /// for the memory that is passed in from there.
+  [[nodiscard]] const AllocationSiteSetTy *
+  getAllocationSitesInContext(const llvm::Value *V, CallStringTy CallString);
+
+  [[nodiscard]] ContextId getContextId(CallStringTy CallString);
+  [[nodiscard]] CallStringTy getCallString(ContextId Ctx) const {
+    return CallStrings[Ctx];
+  }
+
+  /// True if S1 and S2 may denote the same object, i.e. if they have the same
+  /// allocation site and one context is a truncation of the other.
+  [[nodiscard]] bool mayBeSameObject(AllocationSiteTy S1,
+                                     AllocationSiteTy S2) const;
+
+  /// Forgets all memoized results. The points-to sets that have been returned
+  /// by getPointsToSetInContext() stay valid until the query engine is
+  /// destroyed.
+  void clear();
+
+  [[nodiscard]] unsigned getCallStringLength() const noexcept { return K; }
+  [[nodiscard]] size_t getBudget() const noexcept { return Budget; }
+
+private:
+  [[nodiscard]] ContextId pushCallSite(ContextId Ctx,
+                                       const llvm::CallBase *CallSite);
+  [[nodiscard]] std::pair<const llvm::CallBase *, ContextId>
+  popCallSite(ContextId Ctx);
+
+  [[nodiscard]] const AllocationSiteSetTy *
+  getAllocationSites(const llvm::Value *V, ContextId Ctx);
+  [[nodiscard]] std::optional<AllocationSiteSetTy>
+  computeAllocationSites(const llvm::Value *V, ContextId Ctx);
+
+  LLVMPointsToInfo &PT;
+  unsigned K;
+  size_t Budget;
+
+  /// Interned call strings; the id of a call string is its index
+  std::vector<std::vector<const llvm::CallBase *>> CallStrings;
+  std::map<std::vector<const llvm::CallBase *>, ContextId> CallStringIds;
+
+  /// std::nullopt if the allocation sites could not be determined
+  std::map<std::pair<const llvm::Value *, ContextId>,
+           std::optional<AllocationSiteSetTy>>
+      AllocationSites;
+  /// The queries that are currently computed and the budget that is left for
+  /// the outermost of them
+  llvm::DenseSet<std::pair<const llvm::Value *, ContextId>> InProgress;
+  size_t RemainingBudget = 0;
+
+  PointsToSetOwner<LLVMPointsToInfo::PointsToSetTy>::memory_resource_type MRes;
+  PointsToSetOwner<LLVMPointsToInfo::PointsToSetTy> Owner{&MRes};
+  llvm::DenseMap<std::pair<const llvm::Value *, ContextId>,
+                 LLVMPointsToInfo::PointsToSetPtrTy>
+      RefinedPointsToSets;
+};
+
+} // namespace psr
+
+#endif
@@ -10,13 +10,13 @@
 #ifndef PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOGRAPH_H_
 #define PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOGRAPH_H_
 
-#include <ostream>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
-#include "boost/graph/adjacency_list.hpp"
-
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/IR/AbstractCallSite.h"
 
 #include "nlohmann/json.hpp"
@@ -43,7 +43,12 @@ namespace psr {
  *  the llvm alias analysis or merge several points-to graphs into a single
  *	points-to graph, e.g. to construct a whole program points-to graph.
  *
- *	The graph itself is undirectional and can have labeled edges.
+ *	The graph itself is undirectional and can have labeled edges. Each value
+ *	is represented by a single vertex with a dense id. The connected
+ *	components of the graph, i.e. the points-to sets, are tracked in a
+ *	union-find structure, such that alias queries do not need to traverse the
+ *	graph. The adjacency of the vertices is only materialized in compressed
+ *	sparse row (CSR) form when the graph is printed.
  *
  *	@brief Represents the points-to graph of a function.
  */
@@ -51,74 +56,77 @@ class LLVMPointsToGraph : public LLVMPointsToInfo {
 public:
   // Call-graph firends
   friend class LLVMBasedICFG;
-  /**
-   * 	@brief Holds the information of a vertex in the points-to graph.
-   */
-  struct VertexProperties {
-    /**
-     * This might be an Instruction, an Operand of an Instruction, Global
-     * Variable or a formal Argument.
-     */
-    const llvm::Value *V = nullptr;
-    VertexProperties() = default;
-    VertexProperties(const llvm::Value *V);
-    std::string getValueAsString() const;
 
-    // Fetching the users for V is expensive, so we cache the result.
-    mutable std::vector<const llvm::User *> Users;
-    std::vector<const llvm::User *> getUsers() const;
-  };
+  /// The type for vertex representative objects.
+  using vertex_t = uint32_t;
 
   /**
    * 	@brief Holds the information of an edge in the points-to graph.
    */
   struct EdgeProperties {
+    vertex_t Source{};
+    vertex_t Target{};
     /// This may contain a call or invoke instruction.
     const llvm::Value *V = nullptr;
-    EdgeProperties() = default;
-    EdgeProperties(const llvm::Value *V);
     [[nodiscard]] std::string getValueAsString() const;
   };
 
-  /// Data structure for holding the points-to graph.
-  using graph_t =
-      boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
-                            VertexProperties, EdgeProperties>;
-
-  /// The type for vertex representative objects.
-  using vertex_t = boost::graph_traits<graph_t>::vertex_descriptor;
-
-  /// The type for edge representative objects.
-  using edge_t = boost::graph_traits<graph_t>::edge_descriptor;
-
-  /// The type for a vertex iterator.
-  using vertex_iterator = boost::graph_traits<graph_t>::vertex_iterator;
-  using out_edge_iterator = boost::graph_traits<graph_t>::out_edge_iterator;
-  using in_edge_iterator = boost::graph_traits<graph_t>::in_edge_iterator;
-
 private:
-  struct AllocationSiteDFSVisitor;
-  struct ReachabilityDFSVisitor;
+  /// Maps each value in the graph to its vertex
+  llvm::DenseMap<const llvm::Value *, vertex_t> ValueVertexMap;
+  /// Maps each vertex to its value
+  std::vector<const llvm::Value *> Vertices;
+  std::vector<EdgeProperties> Edges;
+
+  /// Union-find over the vertices. The connected component of a vertex is its
+  /// points-to set.
+  mutable std::vector<vertex_t> Parent;
+  std::vector<uint32_t> ComponentSize;
+  /// Links the vertices of each component in a cyclic list, such that
+  /// components can be merged and enumerated without traversing the edges.
+  std::vector<vertex_t> NextInComponent;
+  size_t NumComponents = 0;
+
+  /// The adjacency in CSR form: the edges incident to vertex V are
+  /// AdjacentEdges[AdjacencyOffsets[V], AdjacencyOffsets[V + 1]).
+  mutable std::vector<uint32_t> AdjacencyOffsets;
+  mutable std::vector<uint32_t> AdjacentEdges;
 
-  /// The points to graph.
-  graph_t PAG;
-  using ValueVertexMapT = std::unordered_map<const llvm::Value *, vertex_t>;
-  ValueVertexMapT ValueVertexMap;
   /// Keep track of what has already been merged into this points-to graph.
-  std::unordered_set<const llvm::Function *> AnalyzedFunctions;
+  llvm::SetVector<const llvm::Function *> AnalyzedFunctions;
+  /// The pointer parameters of the analyzed functions
+  llvm::DenseMap<const llvm::Function *,
+                 std::vector<std::pair<unsigned, const llvm::Value *>>>
+      EscapingParams;
+  /// The pointers returned by the analyzed functions
+  llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Value *>>
+      EscapingReturns;
   LLVMBasedPointsToAnalysis PTA;
 
   PointsToSetOwner<PointsToSetTy>::memory_resource_type MRes;
   PointsToSetOwner<PointsToSetTy> Owner{&MRes};
-  std::unordered_map<const llvm::Value *, DynamicPointsToSetPtr<PointsToSetTy>>
+  llvm::DenseMap<const llvm::Value *, DynamicPointsToSetPtr<PointsToSetTy>>
       Cache;
 
-  // void mergeGraph(const LLVMPointsToGraph &Other);
-
   void computePointsToGraph(const llvm::Value *V);
 
   void computePointsToGraph(llvm::Function *F);
 
+  vertex_t getOrCreateVertex(const llvm::Value *V);
+  void addEdge(vertex_t From, vertex_t To, const llvm::Value *Label = nullptr);
+  [[nodiscard]] vertex_t findComponent(vertex_t V) const;
+  /// Returns true if the components of V1 and V2 were different before
+  bool unionComponents(vertex_t V1, vertex_t V2);
+  template <typename HandlerFn>
+  void foreachInComponent(vertex_t V, HandlerFn Handler) const {
+    auto Curr = V;
+    do {
+      Handler(Curr);
+      Curr = NextInComponent[Curr];
+    } while (Curr != V);
+  }
+  void buildAdjacency() const;
+
 public:
   /**
    * Creates a points-to graph based on the computed Alias results.
@@ -142,6 +150,14 @@ public:
   AliasResult alias(const llvm::Value *V1, const llvm::Value *V2,
                     const llvm::Instruction *I = nullptr) override;
 
+  /**
+   * @brief Returns true if V1 and V2 are in the same connected component of
+   * the points-to graph. Does not compute the points-to graphs of the
+   * functions of V1 and V2.
+   */
+  [[nodiscard]] bool isAlias(const llvm::Value *V1,
+                             const llvm::Value *V2) const;
+
   PointsToSetPtrTy
   getPointsToSet(const llvm::Value *V,
                  const llvm::Instruction *I = nullptr) override;
@@ -188,6 +204,16 @@ public:
   std::vector<std::pair<unsigned, const llvm::Value *>>
   getPointersEscapingThroughParams();
 
+  /**
+   * @brief Returns the pointers which are escaping through the parameters of
+   *        a specific analyzed function.
+   * @param F Function pointer
+   * @return Vector holding function argument pointers and the function argument
+   * number.
+   */
+  [[nodiscard]] llvm::ArrayRef<std::pair<unsigned, const llvm::Value *>>
+  getPointersEscapingThroughParamsForFunction(const llvm::Function *F) const;
+
   /**
    * @brief Returns a std::vector containing pointers which are escaping through
    *        function return statements.
@@ -196,13 +222,13 @@ public:
   std::vector<const llvm::Value *> getPointersEscapingThroughReturns() const;
 
   /**
-   * @brief Returns a std::vector containing pointers which are escaping through
-   *        function return statements for a specific function.
+   * @brief Returns the pointers which are escaping through the return
+   *        statements of a specific analyzed function.
    * @param F Function pointer
    * @return Vector with pointers.
    */
-  std::vector<const llvm::Value *>
-  getPointersEscapingThroughReturnsForFunction(const llvm::Function *Fd) const;
+  [[nodiscard]] llvm::ArrayRef<const llvm::Value *>
+  getPointersEscapingThroughReturnsForFunction(const llvm::Function *F) const;
 
   /**
    * @brief Checks if a given value is represented by a vertex in the points-to
@@ -219,23 +245,6 @@ public:
    */
   void printValueVertexMap();
 
-  class PointerVertexOrEdgePrinter {
-  public:
-    PointerVertexOrEdgePrinter(const graph_t &PAG) : PAG(PAG) {}
-    template <class VertexOrEdge>
-    void operator()(std::ostream &Out, const VertexOrEdge &V) const {
-      Out << "[label=\"" << PAG[V].getValueAsString() << "\"]";
-    }
-
-  private:
-    const graph_t &PAG;
-  };
-
-  static inline PointerVertexOrEdgePrinter
-  makePointerVertexOrEdgePrinter(const graph_t &PAG) {
-    return {PAG};
-  }
-
   /**
    * @brief Prints the points-to graph in .dot format to the given output
    * stream.
@@ -246,6 +255,12 @@ public:
   size_t getNumVertices() const;
 
   size_t getNumEdges() const;
+
+  /**
+   * @brief Returns the number of connected components, i.e. of distinct
+   * points-to sets.
+   */
+  size_t getNumComponents() const;
 };
 
 } // namespace psr
@@ -10,9 +10,12 @@
 #ifndef PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOINFO_H_
 #define PHASAR_PHASARLLVM_POINTER_LLVMPOINTSTOINFO_H_
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include "phasar/PhasarLLVM/Pointer/PointsToInfo.h"
 
 namespace llvm {
+class CallBase;
 class Function;
 class Instruction;
 class Value;
@@ -29,6 +32,13 @@ public:
 
   ~LLVMPointsToInfo() override = default;
 
+  /// Returns the points-to set of V in the calling context CallString, where
+  /// the innermost call site comes last. Points-to information that is not
+  /// context-sensitive returns the context-insensitive points-to set.
+  [[nodiscard]] virtual PointsToSetPtrTy
+  getPointsToSetInContext(const llvm::Value *V,
+                          llvm::ArrayRef<const llvm::CallBase *> CallString);
+
   static const llvm::Function *retrieveFunction(const llvm::Value *V);
 };
 
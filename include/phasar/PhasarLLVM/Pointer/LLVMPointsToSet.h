@@ -20,6 +20,9 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 
+#include <memory>
+#include <optional>
+
 #include "nlohmann/json.hpp"
 
 namespace llvm {
@@ -34,6 +37,8 @@ class Type;
 
 namespace psr {
 
+class LLVMContextSensitivePointsToQuery;
+
 class LLVMPointsToSet : public LLVMPointsToInfo {
 private:
   using PointsToSetMap =
@@ -47,6 +52,19 @@ private:
 
   PointsToSetMap PointsToSets;
 
+  /// The maximal number of GEPs that are tracked per pointer; 0 means that the
+  /// analysis is field-insensitive
+  unsigned FieldSensitivityDepth = 0;
+
+  /// Answers getPointsToSetInContext(); created on the first such query
+  std::unique_ptr<LLVMContextSensitivePointsToQuery> ContextSensitiveQuery;
+  /// The number of analyzed functions the memoized results of
+  /// ContextSensitiveQuery are based on. In lazy mode, analyzing another
+  /// function may extend the points-to sets, which outdates these results.
+  size_t NumAnalyzedFunctionsOfQuery = 0;
+
+  void initialize(ProjectIRDB &IRDB, bool UseLazyEvaluation);
+
   void computeValuesPointsToSet(const llvm::Value *V);
 
   void computeFunctionsPointsToSet(llvm::Function *F);
@@ -58,6 +76,15 @@ private:
   void mergePointsToSets(DynamicPointsToSetPtr<PointsToSetTy> PTS1,
                          DynamicPointsToSetPtr<PointsToSetTy> PTS2);
 
+  /// True if V1, V2 and all members of their points-to sets are derived from
+  /// the same base pointer by constant GEPs (at most FieldSensitivityDepth
+  /// each) and no member of V1's set points to the same offset as a member of
+  /// V2's set. A single member whose access path is unknown, e.g. a pointer
+  /// that may point to either field, makes the sets non-distinct.
+  [[nodiscard]] bool isDistinctField(const llvm::DataLayout &DL,
+                                     const llvm::Value *V1,
+                                     const llvm::Value *V2) const;
+
   bool interIsReachableAllocationSiteTy(const llvm::Value *V,
                                         const llvm::Value *P);
 
@@ -77,16 +104,32 @@ public:
   /**
    * Creates points-to set(s) for all functions in the IRDB. If
    * UseLazyEvaluation is true, computes points-to-sets for functions that do
-   * not use global variables on the fly
+   * not use global variables on the fly.
+   *
+   * If FieldSensitivityDepth is non-zero, pointers that are derived from the
+   * same base pointer by at most FieldSensitivityDepth GEPs with constant
+   * indices are only considered aliases if they point to the same offset, i.e.
+   * a field is no longer merged with its enclosing object or sibling fields.
    */
   explicit LLVMPointsToSet(
       ProjectIRDB &IRDB, bool UseLazyEvaluation = true,
-      PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
+      PointerAnalysisType PATy = PointerAnalysisType::CFLAnders,
+      unsigned FieldSensitivityDepth = 0);
+
+  /**
+   * Creates points-to set(s) for all functions in the IRDB based on the alias
+   * analysis results provided by GetAAResults, e.g. the ones a pass pipeline
+   * has already computed.
+   */
+  LLVMPointsToSet(ProjectIRDB &IRDB,
+                  LLVMBasedPointsToAnalysis::AAResultsGetterTy GetAAResults,
+                  bool UseLazyEvaluation = true,
+                  unsigned FieldSensitivityDepth = 0);
 
   explicit LLVMPointsToSet(ProjectIRDB &IRDB,
                            const nlohmann::json &SerializedPTS);
 
-  ~LLVMPointsToSet() override = default;
+  ~LLVMPointsToSet() override;
 
   [[nodiscard]] inline bool isInterProcedural() const override {
     return false;
@@ -105,6 +148,13 @@ public:
   getPointsToSet(const llvm::Value *V,
                  const llvm::Instruction *I = nullptr) override;
 
+  /// Refines the points-to set of V on demand for the given calling context
+  /// (see LLVMContextSensitivePointsToQuery). Falls back to getPointsToSet(V)
+  /// if the refinement exceeds its budget.
+  [[nodiscard]] PointsToSetPtrTy getPointsToSetInContext(
+      const llvm::Value *V,
+      llvm::ArrayRef<const llvm::CallBase *> CallString) override;
+
   [[nodiscard]] AllocationSiteSetPtrTy
   getReachableAllocationSites(const llvm::Value *V, bool IntraProcOnly = false,
                               const llvm::Instruction *I = nullptr) override;
@@ -122,6 +172,29 @@ public:
                       const llvm::Instruction *I = nullptr,
                       AliasResult Kind = AliasResult::MustAlias) override;
 
+  /// Computes the points-to sets of all pointers in F, unless this has already
+  /// been done.
+  void analyzeFunction(const llvm::Function *F);
+
+  [[nodiscard]] bool isAnalyzed(const llvm::Function *F) const {
+    return AnalyzedFunctions.count(F);
+  }
+
+  [[nodiscard]] size_t getNumAnalyzedFunctions() const {
+    return AnalyzedFunctions.size();
+  }
+
+  /// Returns the points-to set of V without computing anything, i.e. without
+  /// modifying this. Returns std::nullopt, if the points-to set of V has not
+  /// been computed, yet, or if V is a global object, because the points-to
+  /// sets of global objects are refined on every query.
+  [[nodiscard]] std::optional<PointsToSetPtrTy>
+  getPointsToSetIfComputed(const llvm::Value *V) const;
+
+  [[nodiscard]] bool isFieldSensitive() const noexcept {
+    return FieldSensitivityDepth != 0;
+  }
+
   [[nodiscard]] inline bool empty() const { return AnalyzedFunctions.empty(); }
 
   void print(llvm::raw_ostream &OS = llvm::outs()) const override;
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_LLVMTHREADSAFEPOINTSTOSET_H
+#define PHASAR_PHASARLLVM_POINTER_LLVMTHREADSAFEPOINTSTOSET_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+
+namespace psr {
+
+class LLVMPointsToSet;
+class ProjectIRDB;
+
+/// A facade for LLVMPointsToSet that can be queried from multiple threads
+/// concurrently, e.g. by the flow functions of solvers that run in parallel.
+///
+/// LLVMPointsToSet computes the points-to sets function by function on the
+/// first query. The facade only lets one thread at a time run such a
+/// computation and each function is computed at most once. Points-to sets
+/// that have already been computed are looked up under a shared lock, and
+/// each thread caches the sets it has already looked up.
+///
+/// After freeze(), all points-to sets are computed and the facade is
+/// read-mostly: the returned sets do not change anymore, so they can be
+/// iterated from any thread, and introduceAlias() and mergeWith() are
+/// rejected. Without freezing, the lazy computation of a function that uses a
+/// global variable may still extend the points-to sets of that global's
+/// aliases. Therefore, the facade hands out immutable snapshots of the
+/// points-to sets in lazy mode. Each change of the wrapped points-to sets
+/// starts a new generation of snapshots, which subsequent queries return.
+/// A set that has not changed keeps its snapshot across generations, so only
+/// sets that actually grow are copied again. Still, the snapshots are kept
+/// alive as long as the facade, as their handles may still be in use, so the
+/// memory that lazy mode takes grows with each change of a queried set. Long
+/// running clients should therefore call freeze() before they start querying;
+/// a frozen facade does not take any snapshots.
+///
+/// The wrapped LLVMPointsToSet must outlive the facade and must not be used
+/// directly while the facade is in use.
+class LLVMThreadSafePointsToSet : public LLVMPointsToInfo {
+public:
+  explicit LLVMThreadSafePointsToSet(LLVMPointsToSet &PT);
+  ~LLVMThreadSafePointsToSet() override = default;
+
+  LLVMThreadSafePointsToSet(const LLVMThreadSafePointsToSet &) = delete;
+  LLVMThreadSafePointsToSet &
+  operator=(const LLVMThreadSafePointsToSet &) = delete;
+
+  /// Computes the points-to sets of all functions and globals in IRDB and
+  /// switches to the read-mostly mode.
+  void freeze(const ProjectIRDB &IRDB);
+
+  [[nodiscard]] bool isFrozen() const noexcept {
+    return Frozen.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] bool isInterProcedural() const override;
+
+  [[nodiscard]] PointerAnalysisType getPointerAnalysistype() const override;
+
+  [[nodiscard]] AliasResult
+  alias(const llvm::Value *V1, const llvm::Value *V2,
+        const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] PointsToSetPtrTy
+  getPointsToSet(const llvm::Value *V,
+                 const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] PointsToSetPtrTy getPointsToSetInContext(
+      const llvm::Value *V,
+      llvm::ArrayRef<const llvm::CallBase *> CallString) override;
+
+  [[nodiscard]] AllocationSiteSetPtrTy
+  getReachableAllocationSites(const llvm::Value *V, bool IntraProcOnly = false,
+                              const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] bool
+  isInReachableAllocationSites(const llvm::Value *V,
+                               const llvm::Value *PotentialValue,
+                               bool IntraProcOnly = false,
+                               const llvm::Instruction *I = nullptr) override;
+
+  void mergeWith(const PointsToInfo &PTI) override;
+
+  void introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
+                      const llvm::Instruction *I = nullptr,
+                      AliasResult Kind = AliasResult::MustAlias) override;
+
+  void print(llvm::raw_ostream &OS = llvm::outs()) const override;
+
+  [[nodiscard]] nlohmann::json getAsJson() const override;
+
+  void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const override;
+
+private:
+  /// A snapshot of a points-to set that has been taken in the given
+  /// generation
+  struct Snapshot {
+    uint64_t Generation = 0;
+    PointsToSetTy **Set = nullptr;
+  };
+
+  [[nodiscard]] PointsToSetPtrTy
+  lookupOrComputePointsToSet(const llvm::Value *V);
+
+  /// Returns PTS, or an immutable copy of PTS in lazy mode. Requires Mtx to
+  /// be held.
+  [[nodiscard]] PointsToSetPtrTy snapshot(const llvm::Value *V,
+                                          PointsToSetPtrTy PTS);
+
+  /// Starts a new generation of snapshots if the wrapped points-to sets may
+  /// have changed since NumAnalyzedFunctions was taken. Requires Mtx to be
+  /// held exclusively.
+  void updateGeneration(size_t NumAnalyzedFunctions);
+
+  LLVMPointsToSet &PT;
+  mutable std::shared_mutex Mtx;
+  std::atomic<bool> Frozen{false};
+  /// Is incremented whenever the wrapped points-to sets change
+  std::atomic<uint64_t> Generation{0};
+  std::mutex SnapshotMtx;
+  llvm::DenseMap<const llvm::Value *, Snapshot> Snapshots;
+  std::deque<PointsToSetTy> SnapshotSets;
+  std::deque<PointsToSetTy *> SnapshotSlots;
+  /// The points-to sets of the global objects, precomputed by freeze()
+  llvm::DenseMap<const llvm::Value *, PointsToSetPtrTy> FrozenGlobals;
+  /// Identifies the per-thread caches that belong to this facade
+  uint64_t Id;
+};
+
+} // namespace psr
+
+#endif
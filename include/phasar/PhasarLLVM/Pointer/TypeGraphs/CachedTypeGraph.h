@@ -19,59 +19,29 @@
 
 #include <set>
 #include <string>
-#include <unordered_map>
 
 #include "gtest/gtest_prod.h"
 
-#include "boost/graph/adjacency_list.hpp"
-#include "boost/graph/graph_traits.hpp"
-#include "boost/graph/reverse_graph.hpp"
+#include "llvm/ADT/BitVector.h"
 
 #include "phasar/PhasarLLVM/Pointer/TypeGraphs/TypeGraph.h"
+#include "phasar/PhasarLLVM/Pointer/TypeGraphs/TypePropagationGraph.h"
 
 namespace llvm {
 class StructType;
 } // namespace llvm
 
 namespace psr {
+/**
+ * A type graph that keeps the types reachable from each type up-to-date
+ * while links are added, i.e. every link propagates the types of its target
+ * to all predecessors.
+ */
 class CachedTypeGraph : public TypeGraph<CachedTypeGraph> {
 protected:
-  struct VertexProperties {
-    std::string Name;
-    std::set<const llvm::StructType *> Types;
-    const llvm::StructType *BaseType = nullptr;
-  };
-
-  struct EdgeProperties {
-    EdgeProperties() = default;
-  };
-
-  using graph_t =
-      boost::adjacency_list<boost::setS, boost::vecS, boost::bidirectionalS,
-                            VertexProperties, EdgeProperties>;
-
-  using vertex_t = boost::graph_traits<graph_t>::vertex_descriptor;
-  using vertex_iterator = boost::graph_traits<graph_t>::vertex_iterator;
-  using edge_t = boost::graph_traits<graph_t>::edge_descriptor;
-  using out_edge_iterator = boost::graph_traits<graph_t>::out_edge_iterator;
-  using in_edge_iterator = boost::graph_traits<graph_t>::in_edge_iterator;
-
-  using rev_graph_t = boost::reverse_graph<graph_t, graph_t &>;
-
-  using rev_vertex_t = boost::graph_traits<rev_graph_t>::vertex_descriptor;
-  using rev_vertex_iterator = boost::graph_traits<rev_graph_t>::vertex_iterator;
-  using rev_edge_t = boost::graph_traits<rev_graph_t>::edge_descriptor;
-  using rev_out_edge_iterator =
-      boost::graph_traits<rev_graph_t>::out_edge_iterator;
-  using rev_in_edge_iterator =
-      boost::graph_traits<rev_graph_t>::in_edge_iterator;
-
-  struct dfs_visitor;
-  struct reverse_type_propagation_dfs_visitor;
-
-  std::unordered_map<std::string, vertex_t> TypeVertexMap;
-  graph_t G;
-  bool AlreadyVisited = false;
+  using vertex_t = TypePropagationGraph::TypeId;
+
+  TypePropagationGraph G;
 
   FRIEND_TEST(TypeGraphTest, AddType);
   FRIEND_TEST(TypeGraphTest, AddLinkSimple);
@@ -101,6 +71,12 @@ public:
   void printAsDot(const std::string &Path = "typegraph.dot") const override;
   std::set<const llvm::StructType *>
   getTypes(const llvm::StructType *StructType) override;
+
+  /// Returns the ids of the types that StructType may have at runtime. The
+  /// ids are resolved with getGraph().getType().
+  const llvm::BitVector &getTypeIds(const llvm::StructType *StructType);
+
+  [[nodiscard]] const TypePropagationGraph &getGraph() const { return G; }
 };
 } // namespace psr
 
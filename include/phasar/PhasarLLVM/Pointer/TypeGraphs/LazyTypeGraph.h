@@ -19,57 +19,26 @@
 
 #include <set>
 #include <string>
-#include <unordered_map>
 
-#include "gtest/gtest_prod.h"
-
-#include "boost/graph/adjacency_list.hpp"
-#include "boost/graph/graph_traits.hpp"
-#include "boost/graph/reverse_graph.hpp"
+#include "llvm/ADT/BitVector.h"
 
 #include "phasar/PhasarLLVM/Pointer/TypeGraphs/TypeGraph.h"
+#include "phasar/PhasarLLVM/Pointer/TypeGraphs/TypePropagationGraph.h"
 
 namespace llvm {
 class StructType;
 } // namespace llvm
 
 namespace psr {
+/**
+ * A type graph that only records the links and computes the types reachable
+ * from each type on the first query after links have been added.
+ */
 class LazyTypeGraph : public TypeGraph<LazyTypeGraph> {
 protected:
-  struct VertexProperties {
-    std::string Name;
-    const llvm::StructType *SType = nullptr;
-  };
-
-  struct EdgeProperties {
-    EdgeProperties() = default;
-  };
-
-  using graph_t =
-      boost::adjacency_list<boost::setS, boost::vecS, boost::bidirectionalS,
-                            VertexProperties, EdgeProperties>;
-
-  using vertex_t = boost::graph_traits<graph_t>::vertex_descriptor;
-  using vertex_iterator = boost::graph_traits<graph_t>::vertex_iterator;
-  using edge_t = boost::graph_traits<graph_t>::edge_descriptor;
-  using out_edge_iterator = boost::graph_traits<graph_t>::out_edge_iterator;
-  using in_edge_iterator = boost::graph_traits<graph_t>::in_edge_iterator;
+  using vertex_t = TypePropagationGraph::TypeId;
 
-  using rev_graph_t = boost::reverse_graph<graph_t, graph_t &>;
-
-  using rev_vertex_t = boost::graph_traits<rev_graph_t>::vertex_descriptor;
-  using rev_vertex_iterator = boost::graph_traits<rev_graph_t>::vertex_iterator;
-  using rev_edge_t = boost::graph_traits<rev_graph_t>::edge_descriptor;
-  using rev_out_edge_iterator =
-      boost::graph_traits<rev_graph_t>::out_edge_iterator;
-  using rev_in_edge_iterator =
-      boost::graph_traits<rev_graph_t>::in_edge_iterator;
-
-  struct dfs_visitor;
-
-  std::unordered_map<std::string, vertex_t> TypeToVertexMap;
-  graph_t Graph;
-  bool AlreadyVisited = false;
+  TypePropagationGraph Graph;
 
   vertex_t addType(const llvm::StructType *NewType);
   void aggregateTypes();
@@ -88,6 +57,12 @@ public:
   void printAsDot(const std::string &Path = "typegraph.dot") const override;
   [[nodiscard]] std::set<const llvm::StructType *>
   getTypes(const llvm::StructType *StructType) override;
+
+  /// Returns the ids of the types that StructType may have at runtime. The
+  /// ids are resolved with getGraph().getType().
+  const llvm::BitVector &getTypeIds(const llvm::StructType *StructType);
+
+  [[nodiscard]] const TypePropagationGraph &getGraph() const { return Graph; }
 };
 } // namespace psr
 
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_POINTER_TYPEGRAPHS_TYPEPROPAGATIONGRAPH_H
+#define PHASAR_PHASARLLVM_POINTER_TYPEGRAPHS_TYPEPROPAGATIONGRAPH_H
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+class StructType;
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+
+/// The backend of the DTA type graphs. Each struct type gets a dense id and
+/// each vertex holds the set of types reachable from it as a bitset over these
+/// ids. Strongly connected components are collapsed into a single
+/// representative that owns the bitset of the whole component.
+///
+/// The reachable types can either be maintained incrementally with
+/// addEdgeAndPropagate(), which only visits the predecessors whose bitsets
+/// actually change, or computed all at once with computeClosure() after a
+/// batch of addEdge() calls.
+class TypePropagationGraph {
+public:
+  using TypeId = uint32_t;
+
+  /// Returns the id of Type, adding Type to the graph if necessary. Types are
+  /// identified by their name, literal types by their address.
+  TypeId addType(const llvm::StructType *Type);
+
+  [[nodiscard]] std::optional<TypeId>
+  getTypeId(const llvm::StructType *Type) const;
+
+  [[nodiscard]] const llvm::StructType *getType(TypeId Id) const {
+    return Types[Id];
+  }
+  [[nodiscard]] llvm::StringRef getTypeName(TypeId Id) const {
+    return Names[Id];
+  }
+
+  /// Adds the edge From -> To without updating the reachable types. Returns
+  /// false if the edge was already in the graph.
+  bool addEdge(TypeId From, TypeId To);
+
+  /// Adds the edge From -> To and propagates the types reachable from To to
+  /// all predecessors of To. Collapses the cycle if the edge closes one.
+  /// Returns false if the edge was already in the graph.
+  bool addEdgeAndPropagate(TypeId From, TypeId To);
+
+  [[nodiscard]] bool hasEdge(TypeId From, TypeId To) const {
+    return EdgeSet.count({From, To});
+  }
+
+  /// Propagates the types reachable from Id to all (transitive) predecessors
+  /// of Id using a worklist.
+  void propagateToPredecessors(TypeId Id);
+
+  /// Computes the types reachable from each vertex from scratch. Collapses
+  /// all strongly connected components.
+  void computeClosure();
+
+  /// True if edges have been added with addEdge() since the last
+  /// computeClosure().
+  [[nodiscard]] bool isClosureStale() const noexcept { return ClosureStale; }
+
+  /// Returns the ids of the types reachable from Id, including Id itself.
+  [[nodiscard]] const llvm::BitVector &getReachableTypeIds(TypeId Id) const {
+    return Reachable[findRepresentative(Id)];
+  }
+
+  [[nodiscard]] std::set<const llvm::StructType *>
+  getReachableTypes(TypeId Id) const;
+
+  /// Returns the ids of those Types that are contained in the graph.
+  template <typename ContainerTy>
+  [[nodiscard]] llvm::BitVector getTypeIds(const ContainerTy &Types) const {
+    llvm::BitVector Ret(getNumTypes());
+    for (const auto *Type : Types) {
+      if (auto Id = getTypeId(Type)) {
+        Ret.set(*Id);
+      }
+    }
+    return Ret;
+  }
+
+  /// Returns the representative of the strongly connected component of Id.
+  [[nodiscard]] TypeId findRepresentative(TypeId Id) const;
+
+  [[nodiscard]] llvm::ArrayRef<TypeId> successors(TypeId Id) const {
+    return Successors[Id];
+  }
+  [[nodiscard]] llvm::ArrayRef<TypeId> predecessors(TypeId Id) const {
+    return Predecessors[Id];
+  }
+
+  [[nodiscard]] size_t getNumTypes() const noexcept { return Types.size(); }
+  [[nodiscard]] size_t getNumEdges() const noexcept { return EdgeSet.size(); }
+  [[nodiscard]] size_t getNumComponents() const noexcept {
+    return NumComponents;
+  }
+
+  void printAsDot(llvm::raw_ostream &OS) const;
+
+private:
+  bool insertEdge(TypeId From, TypeId To);
+  /// Merges the components of Id1 and Id2 and returns the new representative
+  TypeId mergeComponents(TypeId Id1, TypeId Id2);
+  template <typename HandlerFn>
+  void foreachInComponent(TypeId Rep, HandlerFn Handler) const {
+    auto Curr = Rep;
+    do {
+      Handler(Curr);
+      Curr = NextInComponent[Curr];
+    } while (Curr != Rep);
+  }
+
+  llvm::DenseMap<const llvm::StructType *, TypeId> TypeIds;
+  llvm::StringMap<TypeId> NameIds;
+  std::vector<const llvm::StructType *> Types;
+  std::vector<std::string> Names;
+
+  std::vector<llvm::SmallVector<TypeId, 2>> Successors;
+  std::vector<llvm::SmallVector<TypeId, 2>> Predecessors;
+  llvm::DenseSet<std::pair<TypeId, TypeId>> EdgeSet;
+
+  /// Union-find over the strongly connected components
+  mutable std::vector<TypeId> Parent;
+  /// Links the members of each component in a cyclic list
+  std::vector<TypeId> NextInComponent;
+  /// The reachable types; only valid for the representatives
+  std::vector<llvm::BitVector> Reachable;
+  size_t NumComponents = 0;
+  bool ClosureStale = false;
+};
+
+} // namespace psr
+
+#endif
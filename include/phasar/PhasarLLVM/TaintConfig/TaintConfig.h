@@ -24,6 +24,7 @@
 #include "llvm/IR/Value.h"
 
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/FunctionClassification.h"
 
 namespace psr {
 
@@ -112,6 +113,10 @@ public:
                                        const llvm::Function *Callee) const;
 
   [[nodiscard]] TaintCategory getCategory(const llvm::Value *V) const;
+  /// Returns the taint roles of Fun given by the parameters that are marked as
+  /// source, sink or sanitizer. Roles that are assigned via callbacks are not
+  /// considered.
+  [[nodiscard]] FunctionClass getTaintRole(const llvm::Function *Fun) const;
 
   void addSourceValue(const llvm::Value *V);
   void addSinkValue(const llvm::Value *V);
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_ESGTRACE_H_
+#define PHASAR_PHASARLLVM_UTILS_ESGTRACE_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/MemoryBufferRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+namespace psr {
+
+/// The binary ESG trace is a stream of records that is written by the IFDS/IDE
+/// solver and can be sliced offline by the phasar-esg-viewer tool. After an
+/// 8 byte header ("PSRESG" followed by a two byte version), each record
+/// starts with one byte denoting its kind. All integers are ULEB128 encoded;
+/// strings are stored as their length followed by the raw bytes. Functions,
+/// nodes, facts and edge-function labels are numbered implicitly in the order
+/// of their definition and must be defined before they are referenced by an
+/// edge.
+enum class ESGTraceRecordKind : uint8_t {
+  Function = 1,
+  Node = 2,
+  Fact = 3,
+  EdgeFunctionLabel = 4,
+  Edge = 5,
+};
+
+struct ESGTraceEdge {
+  static constexpr uint32_t NoLabel = std::numeric_limits<uint32_t>::max();
+
+  uint32_t FromNode = 0;
+  uint32_t FromFact = 0;
+  uint32_t ToNode = 0;
+  uint32_t ToFact = 0;
+  uint32_t EdgeFunctionLabel = NoLabel;
+  bool IsInterProcedural = false;
+};
+
+/// Serializes an exploded super-graph into the binary ESG trace format. The
+/// writer does not intern anything by itself; the solver is responsible for
+/// defining each function, node and fact exactly once.
+class ESGTraceWriter {
+public:
+  static constexpr uint16_t Version = 1;
+
+  explicit ESGTraceWriter(llvm::raw_ostream &OS);
+
+  uint32_t addFunction(llvm::StringRef Name);
+  uint32_t addNode(uint32_t FunctionId, llvm::StringRef StmtId,
+                   llvm::StringRef Label);
+  uint32_t addFact(llvm::StringRef Label, bool IsZero = false);
+  uint32_t addEdgeFunctionLabel(llvm::StringRef Label);
+  void addEdge(const ESGTraceEdge &Edge);
+
+  [[nodiscard]] size_t getNumEdges() const noexcept { return NumEdges; }
+
+private:
+  void writeString(llvm::StringRef Str);
+
+  llvm::raw_ostream &OS;
+  uint32_t NumFunctions = 0;
+  uint32_t NumNodes = 0;
+  uint32_t NumFacts = 0;
+  uint32_t NumEdgeFunctionLabels = 0;
+  size_t NumEdges = 0;
+};
+
+/// In-memory representation of a binary ESG trace. All slicing operations
+/// return a new trace that shares the symbol tables (functions, nodes, facts)
+/// with the original, but only keeps the selected edges. Rendering only emits
+/// the nodes and facts that are referenced by at least one edge.
+class ESGTrace {
+public:
+  struct Function {
+    std::string Name;
+  };
+  struct Node {
+    uint32_t FunctionId = 0;
+    std::string StmtId;
+    std::string Label;
+  };
+  struct Fact {
+    std::string Label;
+    bool IsZero = false;
+  };
+  /// A vertex of the exploded super-graph, i.e. a fact at a node.
+  struct Vertex {
+    uint32_t Node = 0;
+    uint32_t Fact = 0;
+  };
+
+  /// Parses the given buffer; throws std::runtime_error if the buffer does
+  /// not contain a well-formed ESG trace.
+  static ESGTrace read(llvm::MemoryBufferRef Buffer);
+  static ESGTrace readFile(const llvm::Twine &Path);
+
+  [[nodiscard]] const std::vector<Function> &getFunctions() const {
+    return Syms->Functions;
+  }
+  [[nodiscard]] const std::vector<Node> &getNodes() const {
+    return Syms->Nodes;
+  }
+  [[nodiscard]] const std::vector<Fact> &getFacts() const {
+    return Syms->Facts;
+  }
+  [[nodiscard]] const std::vector<std::string> &
+  getEdgeFunctionLabels() const {
+    return Syms->EdgeFunctionLabels;
+  }
+  [[nodiscard]] const std::vector<ESGTraceEdge> &getEdges() const {
+    return Edges;
+  }
+
+  /// Returns all nodes whose statement-id equals StmtId.
+  [[nodiscard]] std::vector<uint32_t> findNodes(llvm::StringRef StmtId) const;
+  /// Returns all facts whose label contains LabelPart.
+  [[nodiscard]] std::vector<uint32_t>
+  findFacts(llvm::StringRef LabelPart) const;
+
+  /// Keeps all edges that start or end in the given function.
+  [[nodiscard]] ESGTrace sliceFunction(llvm::StringRef FunctionName) const;
+
+  /// Keeps all edges that are adjacent to one of the given facts.
+  [[nodiscard]] ESGTrace sliceFacts(llvm::ArrayRef<uint32_t> FactIds) const;
+
+  /// Keeps exactly the edges that lie on at least one path from any vertex
+  /// in From to any vertex in To.
+  [[nodiscard]] ESGTrace slicePaths(llvm::ArrayRef<Vertex> From,
+                                    llvm::ArrayRef<Vertex> To) const;
+
+  [[nodiscard]] ESGTrace
+  filterEdges(llvm::function_ref<bool(const ESGTraceEdge &)> Pred) const;
+
+  void printAsDot(llvm::raw_ostream &OS) const;
+  [[nodiscard]] nlohmann::json getAsJson() const;
+
+private:
+  struct SymbolTables {
+    std::vector<Function> Functions;
+    std::vector<Node> Nodes;
+    std::vector<Fact> Facts;
+    std::vector<std::string> EdgeFunctionLabels;
+  };
+
+  ESGTrace(std::shared_ptr<const SymbolTables> Syms,
+           std::vector<ESGTraceEdge> Edges) noexcept
+      : Syms(std::move(Syms)), Edges(std::move(Edges)) {}
+
+  std::shared_ptr<const SymbolTables> Syms;
+  std::vector<ESGTraceEdge> Edges;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_LLVMFUNCTIONANALYSISCACHE_H_
+#define PHASAR_PHASARLLVM_UTILS_LLVMFUNCTIONANALYSISCACHE_H_
+
+#include <mutex>
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+
+#include "phasar/PhasarLLVM/Pointer/PointerAnalysisType.h"
+
+namespace llvm {
+class AAResults;
+class DominatorTree;
+class Function;
+class LoopInfo;
+class Module;
+class PostDominatorTree;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Lazily computes and caches LLVM's per-function analyses, i.e. dominator
+ * trees, post-dominator trees, loop info and alias analysis results, such that
+ * all components that analyze the same IR share them instead of recomputing
+ * them. The ProjectIRDB owns one cache for all the functions it contains (see
+ * ProjectIRDB::getAnalysisCache()).
+ *
+ * Computing the results is thread-safe. The returned results stay valid until
+ * the function is invalidated; the dominator trees, post-dominator trees and
+ * loop infos may be queried concurrently, the alias analysis results however
+ * update internal caches when queried.
+ *
+ * Whoever changes the IR of a function, e.g. the IRNormalizationPass, has to
+ * invalidate it afterwards.
+ *
+ * @brief Shares LLVM's function analyses among phasar's components.
+ */
+class LLVMFunctionAnalysisCache {
+private:
+  std::mutex Mtx;
+  PointerAnalysisType PATy;
+  llvm::PassBuilder PB;
+  llvm::FunctionAnalysisManager FAM;
+
+  template <typename AnalysisT>
+  typename AnalysisT::Result &getResult(const llvm::Function *F);
+
+public:
+  /// The alias analysis results combine LLVM's basic and type-based alias
+  /// analysis with the one selected by PATy, if any.
+  explicit LLVMFunctionAnalysisCache(
+      PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
+
+  LLVMFunctionAnalysisCache(const LLVMFunctionAnalysisCache &) = delete;
+  LLVMFunctionAnalysisCache &
+  operator=(const LLVMFunctionAnalysisCache &) = delete;
+
+  ~LLVMFunctionAnalysisCache();
+
+  [[nodiscard]] llvm::DominatorTree &getDominatorTree(const llvm::Function *F);
+
+  [[nodiscard]] llvm::PostDominatorTree &
+  getPostDominatorTree(const llvm::Function *F);
+
+  [[nodiscard]] llvm::LoopInfo &getLoopInfo(const llvm::Function *F);
+
+  [[nodiscard]] llvm::AAResults &getAAResults(const llvm::Function *F);
+
+  [[nodiscard]] inline PointerAnalysisType getPointerAnalysisType() const {
+    return PATy;
+  }
+
+  /// Returns a functor that provides the cached dominator trees, e.g. to a
+  /// BasicBlockOrdering.
+  [[nodiscard]] inline auto getDominatorTreeGetter() {
+    return [this](const llvm::Function *F) -> llvm::DominatorTree & {
+      return getDominatorTree(F);
+    };
+  }
+
+  /// Drops all results of F, which have to be recomputed after F has been
+  /// changed.
+  void invalidate(const llvm::Function &F);
+
+  /// Drops all results of the functions of M.
+  void invalidate(const llvm::Module &M);
+
+  /// Drops all results.
+  void clear();
+};
+
+} // namespace psr
+
+#endif
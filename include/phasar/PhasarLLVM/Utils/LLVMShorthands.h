@@ -52,6 +52,8 @@ bool matchesSignature(const llvm::Function *F, const llvm::FunctionType *FType,
 bool matchesSignature(const llvm::FunctionType *FType1,
                       const llvm::FunctionType *FType2);
 
+/// Returns the slot tracker of V's module, see
+/// ModulesToSlotTracker::getSlotTrackerForModule().
 llvm::ModuleSlotTracker &getModuleSlotTrackerFor(const llvm::Value *V);
 
 /**
@@ -72,6 +74,29 @@ std::string llvmIRToStableString(const llvm::Value *V);
  */
 std::string llvmIRToShortString(const llvm::Value *V);
 
+/**
+ * @brief Same as @link(llvmIRToString), but returns a reference to a cached
+ * string representation.
+ *
+ * Each value is rendered at most once. The function-local values are rendered
+ * all at once when the first of them is requested, such that the slot numbers
+ * of a function only need to be computed once. The returned string remains
+ * valid until the module of V is updated in or removed from its ProjectIRDB.
+ */
+llvm::StringRef llvmIRToStringRef(const llvm::Value *V);
+
+/**
+ * @brief Same as @link(llvmIRToStableString), but returns a reference to a
+ * cached string representation, see @link(llvmIRToStringRef).
+ */
+llvm::StringRef llvmIRToStableStringRef(const llvm::Value *V);
+
+/**
+ * @brief Same as @link(llvmIRToShortString), but returns a reference to a
+ * cached string representation, see @link(llvmIRToStringRef).
+ */
+llvm::StringRef llvmIRToShortStringRef(const llvm::Value *V);
+
 LLVM_DUMP_METHOD void dumpIRValue(const llvm::Value *V);
 LLVM_DUMP_METHOD void dumpIRValue(const llvm::Instruction *V);
 
@@ -96,6 +121,16 @@ globalValuesUsedinFunction(const llvm::Function *F);
  */
 std::string getMetaDataID(const llvm::Value *V);
 
+/**
+ * Instructions that IRNormalizationPass synthesized have an ID of their own,
+ * but stand for an instruction of the original IR, e.g. a phi node for the
+ * alloca of the promoted variable.
+ *
+ * @brief Returns the ID of the original instruction that V stands for, or the
+ * ID of V itself (see getMetaDataID()).
+ */
+std::string getOriginalMetaDataID(const llvm::Value *V);
+
 /**
  * @brief Does less-than comparison based on the annotated ID.
  *
@@ -236,14 +271,15 @@ class ModulesToSlotTracker {
   friend class LLVMZeroValue;
 
 private:
-  static inline llvm::SmallDenseMap<const llvm::Module *,
-                                    std::unique_ptr<llvm::ModuleSlotTracker>, 2>
-      MToST{};
-
+  /// Also invalidates the cached string representations of the module's values
   static void updateMSTForModule(const llvm::Module *Module);
   static void deleteMSTForModule(const llvm::Module *Module);
 
 public:
+  /// Returns the slot tracker of Module. The reference is only valid until
+  /// the module is updated or deleted, i.e. until its ProjectIRDB changes or
+  /// is destroyed. The tracker is not synchronized: other threads must not
+  /// print values of the same module while the reference is in use.
   static llvm::ModuleSlotTracker &
   getSlotTrackerForModule(const llvm::Module *Module);
 };
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARPASS_PHASARANALYSIS_H_
+#define PHASAR_PHASARPASS_PHASARANALYSIS_H_
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/PassManager.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/CallGraphAnalysisType.h"
+
+namespace llvm {
+class DominatorTree;
+class Function;
+class Module;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMBasedICFG;
+class LLVMPointsToSet;
+class LLVMTypeHierarchy;
+class ProjectIRDB;
+
+/// Provides phasar's infrastructure, i.e. the IRDB, type hierarchy, points-to
+/// information and ICFG, for a module as a new-pass-manager analysis.
+///
+/// The alias analysis results and dominator trees are obtained from the
+/// pipeline's FunctionAnalysisManager instead of being recomputed. The result
+/// is cached by the ModuleAnalysisManager and shared by all passes that
+/// request it until a pass does not preserve it.
+///
+/// The entry points and the call-graph algorithm are configured via the
+/// options in Options.h.
+class PhasarAnalysis : public llvm::AnalysisInfoMixin<PhasarAnalysis> {
+  friend llvm::AnalysisInfoMixin<PhasarAnalysis>;
+  static llvm::AnalysisKey Key; // NOLINT
+
+public:
+  class Result {
+  public:
+    /// Sets up phasar's infrastructure for M using phasar's own alias
+    /// analyses and dominator trees, e.g. for the legacy PhasarPass.
+    Result(llvm::Module &M, const std::vector<std::string> &EntryPoints,
+           CallGraphAnalysisType CGTy);
+
+    /// Sets up phasar's infrastructure for M using the alias analysis results
+    /// and dominator trees cached in FAM.
+    Result(llvm::Module &M, const std::vector<std::string> &EntryPoints,
+           CallGraphAnalysisType CGTy, llvm::FunctionAnalysisManager &FAM);
+
+    Result(Result &&) noexcept;
+    Result &operator=(Result &&) noexcept;
+    ~Result();
+
+    [[nodiscard]] ProjectIRDB &getProjectIRDB() { return *IRDB; }
+    [[nodiscard]] LLVMTypeHierarchy &getTypeHierarchy() { return *TH; }
+    [[nodiscard]] LLVMPointsToSet &getPointsToInfo() { return *PT; }
+    [[nodiscard]] LLVMBasedICFG &getICFG() { return *ICF; }
+    [[nodiscard]] const std::set<std::string> &getEntryPoints() const {
+      return EntryPoints;
+    }
+
+    /// Returns the dominator tree of F, cached in the FunctionAnalysisManager
+    /// if there is one and in the IRDB's analysis cache otherwise.
+    [[nodiscard]] llvm::DominatorTree &getDominatorTree(const llvm::Function *F);
+
+    /// Solves the data-flow analysis with the name DataFlowAnalysis (see
+    /// DataFlowAnalysisType.def) on this infrastructure.
+    void runDataFlowAnalysis(llvm::StringRef DataFlowAnalysis,
+                             bool DumpResults);
+
+    /// The result is invalidated when PhasarAnalysis is not preserved, e.g.
+    /// because a pass changed the IR, or when the cached function analyses it
+    /// refers to are invalidated.
+    bool invalidate(llvm::Module &M, const llvm::PreservedAnalyses &PA,
+                    llvm::ModuleAnalysisManager::Invalidator &Inv);
+
+  private:
+    Result(llvm::Module &M, const std::vector<std::string> &EntryPoints,
+           CallGraphAnalysisType CGTy, llvm::FunctionAnalysisManager *FAM);
+
+    std::set<std::string> EntryPoints;
+    llvm::FunctionAnalysisManager *FAM = nullptr;
+    std::unique_ptr<ProjectIRDB> IRDB;
+    std::unique_ptr<LLVMTypeHierarchy> TH;
+    std::unique_ptr<LLVMPointsToSet> PT;
+    std::unique_ptr<LLVMBasedICFG> ICF;
+  };
+
+  Result run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+};
+
+/// The new-pass-manager counterpart of PhasarPass. Runs the data-flow analysis
+/// that is configured via the options in Options.h on the (possibly cached)
+/// PhasarAnalysis result.
+class PhasarModulePass : public llvm::PassInfoMixin<PhasarModulePass> {
+public:
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+};
+
+} // namespace psr
+
+#endif
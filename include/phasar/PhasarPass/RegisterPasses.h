@@ -10,4 +10,17 @@
 #ifndef PHASAR_PHASARPASS_REGISTERPASSES_H_
 #define PHASAR_PHASARPASS_REGISTERPASSES_H_
 
+namespace llvm {
+class PassBuilder;
+} // namespace llvm
+
+namespace psr {
+
+/// Registers PhasarAnalysis and the module pass "phasar" with PB, such that
+/// `opt -load-pass-plugin=libphasar_pass.so -passes=phasar` runs the
+/// data-flow analysis that is configured via the options in Options.h.
+void registerPhasarPasses(llvm::PassBuilder &PB);
+
+} // namespace psr
+
 #endif
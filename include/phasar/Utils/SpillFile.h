@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SPILLFILE_H
+#define PHASAR_UTILS_SPILLFILE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace psr {
+
+/**
+ * A temporary file that data structures can move cold parts of their contents
+ * to. Each append() yields a Slice that can be mapped back into memory with
+ * read(). A slice stays valid until it is passed to release() or the file is
+ * destroyed, which also removes it from disk. The space of released slices is
+ * reused by later appends, such that repeatedly spilling the same contents
+ * does not grow the file.
+ */
+class SpillFile {
+public:
+  struct Slice {
+    uint64_t Offset = 0;
+    uint64_t Size = 0;
+  };
+
+  /// Creates a new temporary file whose name starts with Prefix. Throws a
+  /// std::system_error if the file cannot be created.
+  explicit SpillFile(llvm::StringRef Prefix);
+  ~SpillFile();
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+  SpillFile(SpillFile &&) noexcept = delete;
+  SpillFile &operator=(SpillFile &&) noexcept = delete;
+
+  /// Writes Data to the first released range that is large enough, or to the
+  /// end of the file otherwise
+  Slice append(llvm::StringRef Data);
+
+  /// Marks the range of S as unused. S must not be read afterwards.
+  void release(Slice S);
+
+  /// Maps S into memory. Throws a std::system_error if S cannot be read.
+  [[nodiscard]] std::unique_ptr<llvm::MemoryBuffer> read(Slice S);
+
+  /// Returns the size of the file, including the released ranges
+  [[nodiscard]] uint64_t size() const noexcept { return Size; }
+
+  /// Returns the number of bytes in released ranges that are not reused yet
+  [[nodiscard]] uint64_t getNumFreeBytes() const noexcept { return FreeBytes; }
+
+  [[nodiscard]] llvm::StringRef getPath() const noexcept { return Path; }
+
+private:
+  llvm::SmallString<128> Path;
+  std::unique_ptr<llvm::raw_fd_ostream> OS;
+  uint64_t Size = 0;
+  uint64_t FreeBytes = 0;
+  /// The released ranges by offset; adjacent ranges are merged
+  std::map<uint64_t, uint64_t> FreeRanges;
+};
+
+} // namespace psr
+
+#endif
@@ -107,6 +107,15 @@ public:
     return Result;
   }
 
+  template <typename HandlerFn> void foreachCell(HandlerFn Handler) const {
+    // Calls Handler(Row, Column, Value) for each cell without copying them.
+    for (const auto &M1 : Tab) {
+      for (const auto &M2 : M1.second) {
+        Handler(M1.first, M2.first, M2.second);
+      }
+    }
+  }
+
   [[nodiscard]] std::unordered_map<R, V> column(C ColumnKey) const {
     // Returns a view of all mappings that have the given column key.
     std::unordered_map<R, V> Column;
@@ -56,10 +56,12 @@ AnalysisController::AnalysisController(
     AnalysisStrategy Strategy, AnalysisControllerEmitterOptions EmitterOptions,
     IFDSIDESolverConfig SolverConfig, const std::string &ProjectID,
     const std::string &OutDirectory,
-    const nlohmann::json &PrecomputedPointsToInfo)
+    const nlohmann::json &PrecomputedPointsToInfo,
+    SummaryLibrary LibrarySummaries, unsigned FieldSensitivityDepth)
     : IRDB(IRDB), TH(IRDB),
       PT(PrecomputedPointsToInfo.empty()
-             ? LLVMPointsToSet(IRDB, !needsToEmitPTA(EmitterOptions), PTATy)
+             ? LLVMPointsToSet(IRDB, !needsToEmitPTA(EmitterOptions), PTATy,
+                               FieldSensitivityDepth)
              : LLVMPointsToSet(IRDB, PrecomputedPointsToInfo)),
       ICF(&IRDB, CGTy, EntryPoints, &TH, &PT, SoundnessLevel,
           AutoGlobalSupport),
@@ -67,7 +69,8 @@ AnalysisController::AnalysisController(
       AnalysisConfigs(std::move(AnalysisConfigs)), EntryPoints(EntryPoints),
       Strategy(Strategy), EmitterOptions(EmitterOptions), ProjectID(ProjectID),
       OutDirectory(OutDirectory), SolverConfig(SolverConfig),
-      SoundnessLevel(SoundnessLevel), AutoGlobalSupport(AutoGlobalSupport) {
+      SoundnessLevel(SoundnessLevel), AutoGlobalSupport(AutoGlobalSupport),
+      LibrarySummaries(std::move(LibrarySummaries)) {
   if (!OutDirectory.empty()) {
     // create directory for results
     ResultDirectory = OutDirectory;
@@ -111,6 +114,7 @@ void AnalysisController::executeVariational() {}
 void AnalysisController::executeWholeProgram() {
   size_t ConfigIdx = 0;
   for (const auto &DataFlowAnalysis : DataFlowAnalyses) {
+    CurrentDataFlowAnalysis = DataFlowAnalysis;
     switch (DataFlowAnalysis) {
     case DataFlowAnalysisType::IFDSUninitializedVariables: {
       executeIFDSUninitVar();
@@ -142,6 +146,9 @@ void AnalysisController::executeWholeProgram() {
     case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis: {
       executeIDECSTDIOTS();
     } break;
+    case DataFlowAnalysisType::IDEMultiTypeStateAnalysis: {
+      executeIDEMultiTS();
+    } break;
     case DataFlowAnalysisType::IFDSTypeAnalysis: {
       executeIFDSType();
     } break;
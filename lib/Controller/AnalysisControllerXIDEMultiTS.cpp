@@ -0,0 +1,29 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "phasar/Controller/AnalysisController.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEMultiTypeStateAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CSTDFILEIOTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/OpenSSLEVPKDFDescription.h"
+
+namespace psr {
+
+void AnalysisController::executeIDEMultiTS() {
+  CSTDFILEIOTypeStateDescription FileIODesc;
+  OpenSSLEVPKDFDescription KDFDesc;
+  IDEMultiTypeStateAnalysis::ConfigurationTy TSDescs = {&FileIODesc, &KDFDesc};
+  WholeProgramAnalysis<IDESolver_P<IDEMultiTypeStateAnalysis>,
+                       IDEMultiTypeStateAnalysis>
+      WPA(SolverConfig, IRDB, &TSDescs, EntryPoints, &PT, &ICF, &TH);
+  WPA.solve();
+  emitRequestedDataFlowResults(WPA);
+  WPA.releaseAllHelperAnalyses();
+}
+
+} // namespace psr
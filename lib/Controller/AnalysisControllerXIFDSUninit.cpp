@@ -9,11 +9,37 @@
 
 #include "phasar/Controller/AnalysisController.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/Utils/Table.h"
 
 namespace psr {
 
 void AnalysisController::executeIFDSUninitVar() {
-  executeIFDSAnalysis<IFDSUninitializedVariables>();
+  if (!SolverConfig.solveWithBitVectors()) {
+    executeIFDSAnalysis<IFDSUninitializedVariables>();
+    return;
+  }
+  IFDSUninitializedVariables Problem(&IRDB, &TH, &ICF, &PT,
+                                     {EntryPoints.begin(), EntryPoints.end()});
+  Problem.solveWithBitVectors();
+  // The bit-vector solver only computes the uses of uninitialized values, so
+  // the text report is the only result that can be emitted.
+  if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTextReport) {
+    Table<IFDSUninitializedVariables::n_t, IFDSUninitializedVariables::d_t,
+          IFDSUninitializedVariables::l_t>
+        NoResults;
+    SolverResults<IFDSUninitializedVariables::n_t,
+                  IFDSUninitializedVariables::d_t,
+                  IFDSUninitializedVariables::l_t>
+        Results(NoResults, Problem.getZeroValue());
+    if (!ResultDirectory.empty()) {
+      if (auto OFS = openFileStream("/psr-report.txt")) {
+        Problem.emitTextReport(Results, *OFS);
+      }
+    } else {
+      Problem.emitTextReport(Results, llvm::outs());
+    }
+  }
 }
 
 } // namespace psr
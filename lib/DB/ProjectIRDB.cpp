@@ -11,6 +11,7 @@
 #include "phasar/Config/Configuration.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
 #include "phasar/PhasarLLVM/Passes/GeneralStatisticsAnalysis.h"
+#include "phasar/PhasarLLVM/Passes/IRNormalizationPass.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/EnumFlags.h"
@@ -19,6 +20,7 @@
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/Demangle/Demangle.h"
@@ -43,7 +45,9 @@ using namespace std;
 
 namespace psr {
 
-ProjectIRDB::ProjectIRDB(IRDBOptions Options) : Options(Options) {
+ProjectIRDB::ProjectIRDB(IRDBOptions Options)
+    : Options(Options),
+      AnalysisCache(std::make_unique<LLVMFunctionAnalysisCache>()) {
   // register the GeneralStaticsPass analysis pass to the ModuleAnalysisManager
   // such that we can query its results later on
   GeneralStatisticsAnalysis GSP;
@@ -51,6 +55,11 @@ ProjectIRDB::ProjectIRDB(IRDBOptions Options) : Options(Options) {
   PB.registerModuleAnalyses(MAM);
   // add the transformation pass ValueAnnotationPass
   MPM.addPass(ValueAnnotationPass());
+  if (Options & IRDBOptions::NORMALIZE) {
+    // shrink the IR after annotating it, such that the IDs of the original
+    // instructions remain available
+    MPM.addPass(IRNormalizationPass());
+  }
   // just to be sure that none of the passes messed up the module!
   MPM.addPass(llvm::VerifierPass());
   ModulesToSlotTracker::updateMSTForModule(LLVMZeroValueMod.get());
@@ -106,6 +115,13 @@ ProjectIRDB::ProjectIRDB(const std::vector<llvm::Module *> &Modules,
 }
 
 ProjectIRDB::~ProjectIRDB() {
+  // The synthetic modules share the contexts of the analyzed modules, so they
+  // have to go first
+  for (auto &[Key, SynthM] : SyntheticModules) {
+    ModulesToSlotTracker::deleteMSTForModule(SynthM.get());
+  }
+  SyntheticModulesInOrder.clear();
+  SyntheticModules.clear();
   for (auto &[File, Module] : Modules) {
     ModulesToSlotTracker::deleteMSTForModule(Module.get());
   }
@@ -127,6 +143,8 @@ void ProjectIRDB::preprocessModule(llvm::Module *M) {
   START_TIMER("LLVM Passes", PAMM_SEVERITY_LEVEL::Full);
   PHASAR_LOG_LEVEL(INFO, "Preprocess module: " << M->getModuleIdentifier());
   MPM.run(*M, MAM);
+  // the passes, e.g. the IRNormalizationPass, may have changed the IR
+  AnalysisCache->invalidate(*M);
   // retrieve data from the GeneralStatisticsAnalysis registered earlier
   auto GSPResult = MAM.getResult<GeneralStatisticsAnalysis>(*M);
   StatsJson = GSPResult.getAsJson();
@@ -183,6 +201,8 @@ void ProjectIRDB::linkForWPA() {
     }
     // Update the IRDB reflecting that we now only need 'MainMod' and its
     // corresponding context!
+    // forget the functions of the modules that are deleted next
+    AnalysisCache->clear();
     // delete every other module
     for (auto It = Modules.begin(); It != Modules.end();) {
       if (It->second.get() != MainMod) {
@@ -271,6 +291,17 @@ std::size_t ProjectIRDB::getInstructionID(const llvm::Instruction *I) {
   return Id;
 }
 
+std::size_t
+ProjectIRDB::getOriginalInstructionID(const llvm::Instruction *I) {
+  if (const auto *Origin =
+          I->getMetadata(PhasarConfig::OriginMetaDataKind())) {
+    return stol(llvm::cast<llvm::MDString>(Origin->getOperand(0))
+                    ->getString()
+                    .str());
+  }
+  return getInstructionID(I);
+}
+
 void ProjectIRDB::print() const {
   for (const auto &[File, Module] : Modules) {
     llvm::outs() << "Module: " << File << '\n';
@@ -335,6 +366,12 @@ ProjectIRDB::internalGetFunctionDefinition(llvm::StringRef FunctionName) const {
       return F;
     }
   }
+  for (const auto *SynthM : SyntheticModulesInOrder) {
+    auto *F = SynthM->getFunction(FunctionName);
+    if (F && !F->isDeclaration()) {
+      return F;
+    }
+  }
   return nullptr;
 }
 
@@ -356,6 +393,12 @@ ProjectIRDB::internalGetFunction(llvm::StringRef FunctionName) const {
       return F;
     }
   }
+  for (const auto *SynthM : SyntheticModulesInOrder) {
+    auto *F = SynthM->getFunction(FunctionName);
+    if (F && !F->isDeclaration()) {
+      return F;
+    }
+  }
   return nullptr;
 }
 
@@ -497,6 +540,13 @@ std::set<const llvm::Function *> ProjectIRDB::getAllFunctions() const {
       Functions.insert(&F);
     }
   }
+  for (const auto &[Key, SynthM] : SyntheticModules) {
+    for (auto &F : *SynthM) {
+      if (!F.isDeclaration()) {
+        Functions.insert(&F);
+      }
+    }
+  }
   return Functions;
 }
 
@@ -508,7 +558,12 @@ void ProjectIRDB::insertModule(llvm::Module *M) {
 
 void ProjectIRDB::insertFunction(llvm::Function *F) {
   assert(WPAModule && "insertFunction is only suported in WPA mode!");
-  auto Id = IDInstructionMapping.size() + NumGlobals;
+  // The IDs are not dense, e.g. once the IR has been normalized, thus continue
+  // after the largest ID in use
+  auto Id = NumGlobals;
+  if (!IDInstructionMapping.empty()) {
+    Id = std::max(Id, IDInstructionMapping.rbegin()->first + 1);
+  }
   auto &Context = F->getContext();
   for (auto &Inst : llvm::instructions(F)) {
     llvm::MDNode *Node = llvm::MDNode::get(
@@ -520,6 +575,50 @@ void ProjectIRDB::insertFunction(llvm::Function *F) {
   }
 }
 
+llvm::Module *ProjectIRDB::getOrCreateSyntheticModule(const llvm::Module &M,
+                                                      llvm::StringRef Key) {
+  auto &SynthM = SyntheticModules[{&M, Key.str()}];
+  if (!SynthM) {
+    SynthM = std::make_unique<llvm::Module>(M.getModuleIdentifier() +
+                                                ".psr-synthetic." + Key.str(),
+                                            M.getContext());
+    SynthM->setDataLayout(M.getDataLayout());
+    SynthM->setTargetTriple(M.getTargetTriple());
+    SyntheticModulesInOrder.push_back(SynthM.get());
+  }
+  return SynthM.get();
+}
+
+llvm::Module *ProjectIRDB::getSyntheticModule(const llvm::Module &M,
+                                              llvm::StringRef Key) const {
+  if (auto It = SyntheticModules.find({&M, Key.str()});
+      It != SyntheticModules.end()) {
+    return It->second.get();
+  }
+  return nullptr;
+}
+
+bool ProjectIRDB::isSyntheticModule(const llvm::Module *M) const {
+  return llvm::is_contained(SyntheticModulesInOrder, M);
+}
+
+const llvm::GlobalValue *
+ProjectIRDB::resolveSyntheticDeclaration(const llvm::GlobalValue *GV) const {
+  if (!GV->isDeclaration() || !isSyntheticModule(GV->getParent())) {
+    return GV;
+  }
+  if (llvm::isa<llvm::Function>(GV)) {
+    if (const auto *F = getFunctionDefinition(GV->getName())) {
+      return F;
+    }
+  } else if (llvm::isa<llvm::GlobalVariable>(GV)) {
+    if (const auto *G = getGlobalVariableDefinition(GV->getName().str())) {
+      return G;
+    }
+  }
+  return GV;
+}
+
 std::set<const llvm::StructType *>
 ProjectIRDB::getAllocatedStructTypes() const {
   std::set<const llvm::StructType *> StructTypes;
@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/ControlFlow/FunctionClassification.h"
+#include "phasar/Config/Configuration.h"
+#include "phasar/DB/ProjectIRDB.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cassert>
+#include <cctype>
+#include <string>
+
+namespace psr {
+
+LLVMFunctionClassification::LLVMFunctionClassification() {
+  for (const auto &Name :
+       PhasarConfig::getPhasarConfig().specialFunctionNames()) {
+    SpecialFunctionNames.insert(Name);
+  }
+}
+
+LLVMFunctionClassification::LLVMFunctionClassification(const ProjectIRDB &IRDB)
+    : LLVMFunctionClassification() {
+  classify(IRDB);
+}
+
+void LLVMFunctionClassification::classify(const ProjectIRDB &IRDB) {
+  Attributes.reserve(Attributes.size() + IRDB.getNumFunctions());
+  for (const auto *Module : IRDB.getAllModules()) {
+    for (const auto &F : *Module) {
+      classify(&F);
+    }
+  }
+}
+
+const FunctionAttributes &
+LLVMFunctionClassification::classify(const llvm::Function *F) {
+  assert(F != nullptr);
+  auto Attrs = computeAttributes(F);
+  auto [It, Inserted] = Attributes.try_emplace(F, Attrs);
+  if (!Inserted) {
+    Attrs.Classes |=
+        FunctionClass(It->second.Classes & FunctionClass::AnyTaintRole);
+    It->second = Attrs;
+  }
+  return It->second;
+}
+
+FunctionAttributes
+LLVMFunctionClassification::getAttributes(const llvm::Function *F) const {
+  if (const auto *Attrs = lookup(F)) {
+    return *Attrs;
+  }
+  return computeAttributes(F);
+}
+
+void LLVMFunctionClassification::addFunctionClasses(
+    llvm::function_ref<FunctionClass(const llvm::Function *)> Classifier) {
+  for (auto &[F, Attrs] : Attributes) {
+    Attrs.Classes |= Classifier(F);
+  }
+}
+
+void LLVMFunctionClassification::removeFunctionClasses(FunctionClass Classes) {
+  for (auto &Entry : Attributes) {
+    Entry.second.Classes &= ~Classes;
+  }
+}
+
+FunctionAttributes
+LLVMFunctionClassification::computeAttributes(const llvm::Function *F) const {
+  FunctionAttributes Attrs;
+  if (!F) {
+    return Attrs;
+  }
+  if (F->isDeclaration()) {
+    Attrs.Classes |= FunctionClass::Declaration;
+  }
+  if (F->isIntrinsic()) {
+    Attrs.Classes |= FunctionClass::LLVMIntrinsic;
+  }
+  if (SpecialFunctionNames.count(F->getName())) {
+    Attrs.Classes |= FunctionClass::SpecialFunction;
+  }
+  if (isHeapAllocatingFunction(F)) {
+    Attrs.Classes |= FunctionClass::HeapAllocating;
+  }
+  Attrs.SpecialMemberKind = getSpecialMemberFunctionType(F);
+  return Attrs;
+}
+
+bool LLVMFunctionClassification::isHeapAllocatingFunction(
+    const llvm::Function *F) {
+  return llvm::StringSwitch<bool>(F->getName())
+      .Cases("_Znwm", "_Znam", "malloc", "calloc", "realloc", true)
+      .Default(false);
+}
+
+SpecialMemberFunctionType
+LLVMFunctionClassification::getSpecialMemberFunctionType(
+    const llvm::Function *F) {
+  if (!F) {
+    return SpecialMemberFunctionType::None;
+  }
+  llvm::StringRef FunctionName = F->getName();
+  // Special member functions only exist in mangled C++ names
+  if (!FunctionName.startswith("_Z")) {
+    return SpecialMemberFunctionType::None;
+  }
+  static constexpr std::pair<llvm::StringLiteral, SpecialMemberFunctionType>
+      Codes[] = {{"C1", SpecialMemberFunctionType::Constructor},
+                 {"C2", SpecialMemberFunctionType::Constructor},
+                 {"C3", SpecialMemberFunctionType::Constructor},
+                 {"D0", SpecialMemberFunctionType::Destructor},
+                 {"D1", SpecialMemberFunctionType::Destructor},
+                 {"D2", SpecialMemberFunctionType::Destructor},
+                 {"aSERKS_", SpecialMemberFunctionType::CopyAssignment},
+                 {"aSEOS_", SpecialMemberFunctionType::MoveAssignment}};
+  llvm::SmallVector<std::pair<std::size_t, SpecialMemberFunctionType>> Found;
+  for (const auto &[Code, Kind] : Codes) {
+    for (auto Index = FunctionName.find(Code); Index != llvm::StringRef::npos;
+         Index = FunctionName.find(Code, Index + 1)) {
+      Found.emplace_back(Index, Kind);
+    }
+  }
+  if (Found.empty()) {
+    return SpecialMemberFunctionType::None;
+  }
+
+  // test if codes are in function name or type information
+  bool NoName = true;
+  for (auto Index : Found) {
+    for (const auto *C = FunctionName.begin();
+         C < FunctionName.begin() + Index.first; ++C) {
+      if (isdigit(*C)) {
+        short I = 0;
+        while (isdigit(*(C + I))) {
+          ++I;
+        }
+        // C points to the length of a source name, e.g. 3Foo
+        auto Len = stoul(std::string(C, C + I));
+        auto NameEnd = std::distance(FunctionName.begin(), C) + I + Len;
+        if (Index.first < NameEnd) {
+          NoName = false;
+          break;
+        }
+        // Skip the source name, it may contain digits itself
+        C += I + Len - 1;
+      }
+    }
+    if (NoName) {
+      return Index.second;
+    }
+    NoName = true;
+  }
+  return SpecialMemberFunctionType::None;
+}
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                              const FunctionAttributes &Attrs) {
+  OS << '{';
+  bool First = true;
+  auto Print = [&OS, &First, &Attrs](FunctionClass Class,
+                                     llvm::StringRef Name) {
+    if (Attrs.is(Class)) {
+      OS << (First ? "" : ", ") << Name;
+      First = false;
+    }
+  };
+  Print(FunctionClass::Declaration, "Declaration");
+  Print(FunctionClass::LLVMIntrinsic, "LLVMIntrinsic");
+  Print(FunctionClass::SpecialFunction, "SpecialFunction");
+  Print(FunctionClass::HeapAllocating, "HeapAllocating");
+  Print(FunctionClass::TaintSource, "TaintSource");
+  Print(FunctionClass::TaintSink, "TaintSink");
+  Print(FunctionClass::TaintSanitizer, "TaintSanitizer");
+  if (Attrs.isSpecialMemberFunction()) {
+    OS << (First ? "" : ", ") << Attrs.SpecialMemberKind;
+  }
+  return OS << '}';
+}
+
+} // namespace psr
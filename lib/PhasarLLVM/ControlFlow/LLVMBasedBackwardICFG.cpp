@@ -17,6 +17,7 @@ LLVMBasedBackwardICFG::LLVMBasedBackwardICFG(LLVMBasedICFG *ForwardICFG)
                            ForwardICFG->getIgnoreDbgInstructions()),
       ForwardICFG(ForwardICFG) {
   assert(ForwardICFG != nullptr);
+  setFunctionClassification(ForwardICFG->getFunctionClassification());
 }
 
 FunctionRange LLVMBasedBackwardICFG::getAllFunctionsImpl() const {
@@ -8,13 +8,13 @@
  *****************************************************************************/
 
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/FunctionClassification.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedBackwardCFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/SpecialMemberFunctionType.h"
 #include "phasar/PhasarLLVM/Utils/LLVMIRToSrc.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 
 #include "llvm/ADT/StringExtras.h"
-#include "llvm/ADT/StringSwitch.h"
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/IR/IntrinsicInst.h"
 
@@ -225,71 +225,36 @@ bool detail::LLVMBasedCFGImpl<Derived>::isBranchTargetImpl(
 template <typename Derived>
 bool detail::LLVMBasedCFGImpl<Derived>::isHeapAllocatingFunctionImpl(
     f_t Fun) const {
-  return llvm::StringSwitch<bool>(Fun->getName())
-      .Cases("_Znwm", "_Znam", "malloc", "calloc", "realloc", true)
-      .Default(false);
+  if (FunClasses) {
+    if (const auto *Attrs = FunClasses->lookup(Fun)) {
+      return Attrs->isHeapAllocating();
+    }
+  }
+  return LLVMFunctionClassification::isHeapAllocatingFunction(Fun);
 }
 
 template <typename Derived>
 SpecialMemberFunctionType
 detail::LLVMBasedCFGImpl<Derived>::getSpecialMemberFunctionTypeImpl(
     f_t Fun) const {
-  if (!Fun) {
-    return SpecialMemberFunctionType::None;
-  }
-  llvm::StringRef FunctionName = Fun->getName();
-  /// TODO: this looks terrible and needs fix
-  static constexpr std::pair<llvm::StringLiteral, SpecialMemberFunctionType>
-      Codes[] = {{"C1", SpecialMemberFunctionType::Constructor},
-                 {"C2", SpecialMemberFunctionType::Constructor},
-                 {"C3", SpecialMemberFunctionType::Constructor},
-                 {"D0", SpecialMemberFunctionType::Destructor},
-                 {"D1", SpecialMemberFunctionType::Destructor},
-                 {"D2", SpecialMemberFunctionType::Destructor},
-                 {"aSERKS_", SpecialMemberFunctionType::CopyAssignment},
-                 {"aSEOS_", SpecialMemberFunctionType::MoveAssignment}};
-  llvm::SmallVector<std::pair<std::size_t, SpecialMemberFunctionType>> Found;
-  std::size_t Blacklist = 0;
-  auto It = std::begin(Codes);
-  while (It != std::end(Codes)) {
-    if (std::size_t Index = FunctionName.find(It->first, Blacklist)) {
-      if (Index != llvm::StringRef::npos) {
-        Found.emplace_back(Index, It->second);
-        Blacklist = Index + 1;
-      } else {
-        ++It;
-        Blacklist = 0;
-      }
+  if (FunClasses && Fun) {
+    if (const auto *Attrs = FunClasses->lookup(Fun)) {
+      return Attrs->SpecialMemberKind;
     }
   }
-  if (Found.empty()) {
-    return SpecialMemberFunctionType::None;
-  }
+  return LLVMFunctionClassification::getSpecialMemberFunctionType(Fun);
+}
 
-  // test if codes are in function name or type information
-  bool NoName = true;
-  for (auto Index : Found) {
-    for (const auto *C = FunctionName.begin();
-         C < FunctionName.begin() + Index.first; ++C) {
-      if (isdigit(*C)) {
-        short I = 0;
-        while (isdigit(*(C + I))) {
-          ++I;
-        }
-        std::string ST(C, C + I);
-        if (Index.first <= std::distance(FunctionName.begin(), C) + stoul(ST)) {
-          NoName = false;
-          break;
-        }
-        C = C + *C;
-      }
-    }
-    if (NoName) {
-      return Index.second;
-    }
-    NoName = true;
+template <typename Derived>
+FunctionAttributes
+detail::LLVMBasedCFGImpl<Derived>::getFunctionAttributesImpl(f_t Fun) const {
+  if (FunClasses) {
+    return FunClasses->getAttributes(Fun);
   }
-  return SpecialMemberFunctionType::None;
+  // Without a precomputed classification, use the special functions that are
+  // known at the first query
+  static const LLVMFunctionClassification OnTheFly;
+  return OnTheFly.getAttributes(Fun);
 }
 
 template <typename Derived>
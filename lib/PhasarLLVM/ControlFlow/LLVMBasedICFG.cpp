@@ -16,6 +16,7 @@
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TaintConfig/TaintConfig.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/LLVMBasedContainerConfig.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
@@ -164,8 +165,12 @@ bool LLVMBasedICFG::Builder::processFunction(const llvm::Function *F) {
       Res->preCall(&I);
 
       // check if function call can be resolved statically
-      if (CS->getCalledFunction() != nullptr) {
-        PossibleTargets.insert(CS->getCalledFunction());
+      if (const auto *Callee = CS->getCalledFunction()) {
+        // The synthetic functions call the functions of the analyzed modules
+        // through declarations
+        Callee = llvm::cast<llvm::Function>(
+            IRDB->resolveSyntheticDeclaration(Callee));
+        PossibleTargets.insert(Callee);
 
         PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
                              "Found static call-site: "
@@ -386,6 +391,11 @@ LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB *IRDB, CallGraphAnalysisType CGType,
 
   B.buildCallGraph(S);
 
+  // Classify the functions only now, as building the call-graph may have
+  // added the model of the global constructors and destructors to the IRDB
+  FunctionClasses.classify(*IRDB);
+  setFunctionClassification(&FunctionClasses);
+
   PHASAR_LOG_LEVEL_CAT(
       INFO, "LLVMBasedICFG",
       "Finished ICFG construction "
@@ -394,6 +404,13 @@ LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB *IRDB, CallGraphAnalysisType CGType,
 
 LLVMBasedICFG::~LLVMBasedICFG() = default;
 
+void LLVMBasedICFG::setTaintRoles(const TaintConfig &Config) {
+  FunctionClasses.removeFunctionClasses(FunctionClass::AnyTaintRole);
+  FunctionClasses.addFunctionClasses(
+      [&Config](const llvm::Function *F) { return Config.getTaintRole(F); });
+  TaintRolesOf = &Config;
+}
+
 [[nodiscard]] FunctionRange LLVMBasedICFG::getAllFunctionsImpl() const {
   /// With the new LLVMProjectIRDB, this will be easier...
   return llvm::map_range(
@@ -403,6 +420,14 @@ LLVMBasedICFG::~LLVMBasedICFG() = default;
 
 [[nodiscard]] auto LLVMBasedICFG::getFunctionImpl(llvm::StringRef Fun) const
     -> f_t {
+  // Prefer the model this ICFG has been built with over the ones of other
+  // ICFGs on the same IRDB
+  if (GlobalModelModule) {
+    if (const auto *F = GlobalModelModule->getFunction(Fun);
+        F && !F->isDeclaration()) {
+      return F;
+    }
+  }
   return IRDB->getFunction(Fun);
 }
 
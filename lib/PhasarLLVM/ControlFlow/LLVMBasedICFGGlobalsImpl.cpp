@@ -13,11 +13,55 @@
 #include "phasar/Utils/Logger.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
 
 #include <functional>
 
 namespace psr {
+namespace {
+/// Maps the globals of an analyzed module to declarations in the synthetic
+/// module that holds the model, such that the model never refers to a global
+/// of another module. The call-graph construction resolves the declarations
+/// to the definitions in the analyzed module by name.
+class SyntheticModuleMapper final : public llvm::ValueMaterializer {
+public:
+  explicit SyntheticModuleMapper(llvm::Module &SynthM) noexcept
+      : SynthM(SynthM) {}
+
+  llvm::Value *materialize(llvm::Value *V) override {
+    auto *GV = llvm::dyn_cast<llvm::GlobalValue>(V);
+    if (!GV || GV->getParent() == &SynthM) {
+      return GV;
+    }
+    if (!GV->hasName()) {
+      // Cannot be resolved by name
+      return nullptr;
+    }
+    if (auto *F = llvm::dyn_cast<llvm::Function>(GV)) {
+      return SynthM
+          .getOrInsertFunction(F->getName(), F->getFunctionType(),
+                               F->getAttributes())
+          .getCallee();
+    }
+    return SynthM.getOrInsertGlobal(GV->getName(), GV->getValueType());
+  }
+
+  /// Returns the counterpart of the constant V in the synthetic module, or
+  /// nullptr if there is none, e.g. because V is not a constant.
+  template <typename T> T *map(T *V) {
+    return llvm::dyn_cast_or_null<T>(
+        llvm::MapValue(V, VMap, llvm::RF_NullMapMissingGlobalValues,
+                       /*TypeMapper*/ nullptr, this));
+  }
+
+private:
+  llvm::Module &SynthM;
+  llvm::ValueToValueMapTy VMap;
+};
+} // namespace
+
 template <typename MapTy>
 static void insertGlobalCtorsDtorsImpl(MapTy &Into, const llvm::Module &M,
                                        llvm::StringRef Fun) {
@@ -119,14 +163,16 @@ static std::string getReducedModuleName(const llvm::Module &M) {
 }
 
 static llvm::Function *createDtorCallerForModule(
-    llvm::Module &Mod,
+    const llvm::Module &Mod, llvm::Module &SynthM,
+    SyntheticModuleMapper &Mapper,
     const llvm::SmallVectorImpl<std::pair<llvm::FunctionCallee, llvm::Value *>>
         &RegisteredDtors) {
 
   auto *PhasarDtorCaller = llvm::cast<llvm::Function>(
-      Mod.getOrInsertFunction("__psrGlobalDtorsCaller." +
-                                  getReducedModuleName(Mod),
-                              llvm::Type::getVoidTy(Mod.getContext()))
+      SynthM
+          .getOrInsertFunction("__psrGlobalDtorsCaller." +
+                                   getReducedModuleName(Mod),
+                               llvm::Type::getVoidTy(Mod.getContext()))
           .getCallee());
 
   auto *BB =
@@ -136,7 +182,17 @@ static llvm::Function *createDtorCallerForModule(
 
   for (auto It = RegisteredDtors.rbegin(), End = RegisteredDtors.rend();
        It != End; ++It) {
-    IRB.CreateCall(It->first, {It->second});
+    auto [DtorCallee, Arg] = *It;
+    auto *Dtor = Mapper.map(DtorCallee.getCallee());
+    auto *DtorArg = Mapper.map(Arg);
+    if (!Dtor || !DtorArg) {
+      PHASAR_LOG_LEVEL_CAT(WARNING, "LLVMBasedICFG",
+                           "Skip registered dtor that cannot be called from "
+                           "the model: "
+                               << llvmIRToString(DtorCallee.getCallee()));
+      continue;
+    }
+    IRB.CreateCall(DtorCallee.getFunctionType(), Dtor, {DtorArg});
   }
 
   IRB.CreateRetVoid();
@@ -146,7 +202,8 @@ static llvm::Function *createDtorCallerForModule(
 
 [[nodiscard]] static llvm::Function *collectRegisteredDtors(
     std::multimap<size_t, llvm::Function *, std::greater<>> &GlobalDtors,
-    llvm::Module &Mod) {
+    const llvm::Module &Mod, llvm::Module &SynthM,
+    SyntheticModuleMapper &Mapper) {
   PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
                        "Collect Registered Dtors for Module " << Mod.getName());
 
@@ -160,7 +217,8 @@ static llvm::Function *createDtorCallerForModule(
                        "> Found " << RegisteredDtors.size()
                                   << " Registered Dtors");
 
-  auto *RegisteredDtorCaller = createDtorCallerForModule(Mod, RegisteredDtors);
+  auto *RegisteredDtorCaller =
+      createDtorCallerForModule(Mod, SynthM, Mapper, RegisteredDtors);
   // auto It =
   GlobalDtors.emplace(0, RegisteredDtorCaller);
   // GlobalDtorFn.try_emplace(RegisteredDtorCaller, it);
@@ -169,11 +227,11 @@ static llvm::Function *createDtorCallerForModule(
 }
 
 static std::pair<llvm::Function *, bool> buildCRuntimeGlobalDtorsModel(
-    llvm::Module &M,
+    llvm::Module &M, SyntheticModuleMapper &Mapper,
     const std::multimap<size_t, llvm::Function *, std::greater<>>
         &GlobalDtors) {
   if (GlobalDtors.size() == 1) {
-    return {GlobalDtors.begin()->second, false};
+    return {Mapper.map(GlobalDtors.begin()->second), false};
   }
 
   auto &CTX = M.getContext();
@@ -191,7 +249,9 @@ static std::pair<llvm::Function *, bool> buildCRuntimeGlobalDtorsModel(
   for (auto [unused, Dtor] : GlobalDtors) {
     assert(Dtor);
     assert(Dtor->arg_empty());
-    IRB.CreateCall(Dtor);
+    if (auto *MappedDtor = Mapper.map(Dtor)) {
+      IRB.CreateCall(MappedDtor);
+    }
   }
 
   IRB.CreateRetVoid();
@@ -200,29 +260,50 @@ static std::pair<llvm::Function *, bool> buildCRuntimeGlobalDtorsModel(
 }
 
 llvm::Function *LLVMBasedICFG::buildCRuntimeGlobalCtorsDtorsModel(
-    llvm::Module &M, llvm::ArrayRef<llvm::Function *> UserEntryPoints) {
+    const llvm::Module &M, llvm::ArrayRef<llvm::Function *> UserEntryPoints) {
+  auto &CTX = M.getContext();
+
+  /// The model is built into a separate module per set of entry points, such
+  /// that M is not modified and models that other ICFGs use stay intact
+  auto Key = llvm::join(llvm::map_range(UserEntryPoints,
+                                        [](const llvm::Function *UEntry) {
+                                          return UEntry->getName();
+                                        }),
+                        ",");
+  auto &SynthM = *IRDB->getOrCreateSyntheticModule(M, Key);
+  GlobalModelModule = &SynthM;
+  if (auto *GlobModel = SynthM.getFunction(GlobalCRuntimeModelName);
+      GlobModel && !GlobModel->isDeclaration()) {
+    /// The model has already been built for the same entry points, e.g. by
+    /// a previous ICFG on the same IRDB
+    return GlobModel;
+  }
+
+  SyntheticModuleMapper Mapper(SynthM);
+
   auto GlobalCtors = collectGlobalCtors(M);
   auto GlobalDtors = collectGlobalDtors(M);
-  auto *RegisteredDtorCaller = collectRegisteredDtors(GlobalDtors, M);
+  auto *RegisteredDtorCaller =
+      collectRegisteredDtors(GlobalDtors, M, SynthM, Mapper);
   if (RegisteredDtorCaller) {
     IRDB->insertFunction(RegisteredDtorCaller);
   }
 
   auto [GlobalCleanupFn, Inserted] =
-      buildCRuntimeGlobalDtorsModel(M, GlobalDtors);
+      buildCRuntimeGlobalDtorsModel(SynthM, Mapper, GlobalDtors);
   if (Inserted) {
     IRDB->insertFunction(GlobalCleanupFn);
   }
 
-  auto &CTX = M.getContext();
   auto *GlobModel = llvm::cast<llvm::Function>(
-      M.getOrInsertFunction(GlobalCRuntimeModelName,
-                            /*retTy*/
-                            llvm::Type::getVoidTy(CTX),
-                            /*argc*/
-                            llvm::Type::getInt32Ty(CTX),
-                            /*argv*/
-                            llvm::Type::getInt8PtrTy(CTX)->getPointerTo())
+      SynthM
+          .getOrInsertFunction(GlobalCRuntimeModelName,
+                               /*retTy*/
+                               llvm::Type::getVoidTy(CTX),
+                               /*argc*/
+                               llvm::Type::getInt32Ty(CTX),
+                               /*argv*/
+                               llvm::Type::getInt8PtrTy(CTX)->getPointerTo())
           .getCallee());
 
   auto *EntryBB = llvm::BasicBlock::Create(CTX, "entry", GlobModel);
@@ -235,7 +316,9 @@ llvm::Function *LLVMBasedICFG::buildCRuntimeGlobalCtorsDtorsModel(
     assert(Ctor != nullptr);
     assert(Ctor->arg_size() == 0);
 
-    IRB.CreateCall(Ctor);
+    if (auto *MappedCtor = Mapper.map(Ctor)) {
+      IRB.CreateCall(MappedCtor);
+    }
   }
 
   /// After all ctors have been called, now go for the user-defined entrypoints
@@ -244,6 +327,8 @@ llvm::Function *LLVMBasedICFG::buildCRuntimeGlobalCtorsDtorsModel(
 
   auto CallUEntry =
       [&, GlobalCleanupFn{GlobalCleanupFn}](llvm::Function *UEntry) { // NOLINT
+        UEntry = Mapper.map(UEntry);
+        assert(UEntry != nullptr && "User entry points have names");
         switch (UEntry->arg_size()) {
         case 0:
           IRB.CreateCall(UEntry);
@@ -271,7 +356,7 @@ llvm::Function *LLVMBasedICFG::buildCRuntimeGlobalCtorsDtorsModel(
           break;
         }
 
-        if (UEntry->getName() == "main") {
+        if (UEntry->getName() == "main" && GlobalCleanupFn) {
           ///  After the main function, we must call all global destructors...
           IRB.CreateCall(GlobalCleanupFn);
         }
@@ -283,7 +368,7 @@ llvm::Function *LLVMBasedICFG::buildCRuntimeGlobalCtorsDtorsModel(
     IRB.CreateRetVoid();
   } else {
 
-    auto UEntrySelectorFn = M.getOrInsertFunction(
+    auto UEntrySelectorFn = SynthM.getOrInsertFunction(
         "__psrCRuntimeUserEntrySelector", llvm::Type::getInt32Ty(CTX));
 
     auto *UEntrySelector = IRB.CreateCall(UEntrySelectorFn, {});
@@ -318,7 +403,7 @@ llvm::Function *LLVMBasedICFG::buildCRuntimeGlobalCtorsDtorsModel(
   }
 
   IRDB->insertFunction(GlobModel);
-  ModulesToSlotTracker::updateMSTForModule(&M);
+  ModulesToSlotTracker::updateMSTForModule(&SynthM);
 
   return GlobModel;
 }
@@ -56,19 +56,37 @@ auto CHAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
 
   const auto *ReceiverTy = getReceiverType(CallSite);
 
+  auto [It, Inserted] =
+      PossibleCalleesCache.try_emplace({ReceiverTy, VtableIndex});
+  if (Inserted) {
+    for (const auto &[Ty, Target] :
+         getDispatchTable(ReceiverTy, VtableIndex, CallSite)) {
+      It->second.insert(Target);
+    }
+  }
+  return It->second;
+}
+
+auto CHAResolver::getDispatchTable(const llvm::StructType *ReceiverTy,
+                                   unsigned VtableIndex,
+                                   const llvm::CallBase *CallSite)
+    -> const DispatchTableTy & {
+  auto [It, Inserted] = DispatchTables.try_emplace({ReceiverTy, VtableIndex});
+  if (!Inserted) {
+    return It->second;
+  }
+
   // also insert all possible subtypes vtable entries
   auto FallbackTys = Resolver::TH->getSubTypes(ReceiverTy);
 
-  FunctionSetTy PossibleCallees;
-
   for (const auto &FallbackTy : FallbackTys) {
     const auto *Target =
         getNonPureVirtualVFTEntry(FallbackTy, VtableIndex, CallSite);
     if (Target) {
-      PossibleCallees.insert(Target);
+      It->second.emplace_back(FallbackTy, Target);
     }
   }
-  return PossibleCallees;
+  return It->second;
 }
 
 std::string CHAResolver::str() const { return "CHA"; }
@@ -175,21 +175,26 @@ auto DTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
 
   const auto *ReceiverType = getReceiverType(CallSite);
 
-  auto PossibleTypes = TypeGraph.getTypes(ReceiverType);
+  // The types reachable in the type graph that are sub-types of the receiver
+  // type. If the type hierarchy does not know the receiver type, we cannot
+  // restrict the possible types.
+  auto PossibleTypes = TypeGraph.getTypeIds(ReceiverType);
+  if (Resolver::TH->hasType(ReceiverType)) {
+    PossibleTypes &= getSubTypeIds(ReceiverType);
+  }
 
   // WARNING We deactivated the check on allocated because it is
   // unabled to get the types allocated in the used libraries
   // auto allocated_types = IRDB.getAllocatedTypes();
   // auto end_it = allocated_types.end();
-  for (const auto *PossibleType : PossibleTypes) {
-    if (const auto *PossibleTypeStruct =
-            llvm::dyn_cast<llvm::StructType>(PossibleType)) {
-      // if ( allocated_types.find(possible_type_struct) != end_it ) {
-      const auto *Target =
-          getNonPureVirtualVFTEntry(PossibleTypeStruct, VtableIndex, CallSite);
-      if (Target) {
-        PossibleCallTargets.insert(Target);
-      }
+  for (auto PossibleTypeId : PossibleTypes.set_bits()) {
+    const auto *PossibleTypeStruct =
+        TypeGraph.getGraph().getType(PossibleTypeId);
+    // if ( allocated_types.find(possible_type_struct) != end_it ) {
+    const auto *Target =
+        getNonPureVirtualVFTEntry(PossibleTypeStruct, VtableIndex, CallSite);
+    if (Target) {
+      PossibleCallTargets.insert(Target);
     }
   }
 
@@ -207,4 +212,19 @@ auto DTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
   return PossibleCallTargets;
 }
 
+const llvm::BitVector &
+DTAResolver::getSubTypeIds(const llvm::StructType *ReceiverType) {
+  auto &[NumTypes, Ids] = SubTypeIds[ReceiverType];
+  // Sub-types that are added to the type graph later on would be missing
+  if (NumTypes != TypeGraph.getGraph().getNumTypes()) {
+    Ids = TypeGraph.getGraph().getTypeIds(
+        Resolver::TH->getSubTypes(ReceiverType));
+    if (auto ReceiverId = TypeGraph.getGraph().getTypeId(ReceiverType)) {
+      Ids.set(*ReceiverId);
+    }
+    NumTypes = TypeGraph.getGraph().getNumTypes();
+  }
+  return Ids;
+}
+
 std::string DTAResolver::str() const { return "DTA"; }
@@ -31,7 +31,11 @@ using namespace std;
 using namespace psr;
 
 RTAResolver::RTAResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH)
-    : CHAResolver(IRDB, TH) {}
+    : CHAResolver(IRDB, TH) {
+  for (const auto *StructTy : IRDB.getAllocatedStructTypes()) {
+    AllocatedStructTypes.insert(StructTy);
+  }
+}
 
 // void RTAResolver::firstFunction(const llvm::Function *F) {
 //   auto func_type = F->getFunctionType();
@@ -51,8 +55,6 @@ auto RTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
   // throw runtime_error("RTA is currently unabled to deal with already built "
   //                     "library, it has been disable until this is fixed");
 
-  FunctionSetTy PossibleCallTargets;
-
   PHASAR_LOG_LEVEL(DEBUG,
                    "Call virtual function: " << llvmIRToString(CallSite));
 
@@ -72,31 +74,23 @@ auto RTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
 
   const auto *ReceiverType = getReceiverType(CallSite);
 
-  // also insert all possible subtypes vtable entries
-  auto ReachableTypes = Resolver::TH->getSubTypes(ReceiverType);
-
-  // also insert all possible subtypes vtable entries
-  auto PossibleTypes = IRDB.getAllocatedStructTypes();
-
-  auto EndIt = ReachableTypes.end();
-  for (const auto *PossibleType : PossibleTypes) {
-    if (const auto *PossibleTypeStruct =
-            llvm::dyn_cast<llvm::StructType>(PossibleType)) {
-      if (ReachableTypes.find(PossibleTypeStruct) != EndIt) {
-        const auto *Target = getNonPureVirtualVFTEntry(PossibleTypeStruct,
-                                                       VtableIndex, CallSite);
-        if (Target) {
-          PossibleCallTargets.insert(Target);
-        }
+  auto [It, Inserted] =
+      PossibleCallTargetsCache.try_emplace({ReceiverType, VtableIndex});
+  if (Inserted) {
+    // only consider the subtypes that are actually allocated
+    for (const auto &[Ty, Target] :
+         getDispatchTable(ReceiverType, VtableIndex, CallSite)) {
+      if (AllocatedStructTypes.count(Ty)) {
+        It->second.insert(Target);
       }
     }
   }
 
-  if (PossibleCallTargets.empty()) {
+  if (It->second.empty()) {
     return CHAResolver::resolveVirtualCall(CallSite);
   }
 
-  return PossibleCallTargets;
+  return It->second;
 }
 
 std::string RTAResolver::str() const { return "RTA"; }
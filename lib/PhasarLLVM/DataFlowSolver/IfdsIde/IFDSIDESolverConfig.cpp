@@ -38,6 +38,28 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+bool IFDSIDESolverConfig::inferIdentitySummaries() const {
+  return hasFlag(Options, SolverConfigOptions::InferIdentitySummaries);
+}
+bool IFDSIDESolverConfig::adaptivePrecision() const {
+  return hasFlag(Options, SolverConfigOptions::AdaptivePrecision);
+}
+size_t IFDSIDESolverConfig::maxFactsPerNode() const { return MaxFactsPerNode; }
+size_t IFDSIDESolverConfig::maxFactsPerFunction() const {
+  return MaxFactsPerFunction;
+}
+bool IFDSIDESolverConfig::spillJumpFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::SpillJumpFunctions);
+}
+size_t IFDSIDESolverConfig::maxResidentJumpFunctions() const {
+  return MaxResidentJumpFunctions;
+}
+bool IFDSIDESolverConfig::compressFactClasses() const {
+  return hasFlag(Options, SolverConfigOptions::CompressFactClasses);
+}
+bool IFDSIDESolverConfig::solveWithBitVectors() const {
+  return hasFlag(Options, SolverConfigOptions::SolveWithBitVectors);
+}
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -57,6 +79,29 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setInferIdentitySummaries(bool Set) {
+  setFlag(Options, SolverConfigOptions::InferIdentitySummaries, Set);
+}
+void IFDSIDESolverConfig::setAdaptivePrecision(bool Set) {
+  setFlag(Options, SolverConfigOptions::AdaptivePrecision, Set);
+}
+void IFDSIDESolverConfig::setFactLimits(size_t MaxPerNode,
+                                        size_t MaxPerFunction) {
+  MaxFactsPerNode = MaxPerNode;
+  MaxFactsPerFunction = MaxPerFunction;
+}
+void IFDSIDESolverConfig::setSpillJumpFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::SpillJumpFunctions, Set);
+}
+void IFDSIDESolverConfig::setMaxResidentJumpFunctions(size_t MaxResident) {
+  MaxResidentJumpFunctions = MaxResident;
+}
+void IFDSIDESolverConfig::setCompressFactClasses(bool Set) {
+  setFlag(Options, SolverConfigOptions::CompressFactClasses, Set);
+}
+void IFDSIDESolverConfig::setSolveWithBitVectors(bool Set) {
+  setFlag(Options, SolverConfigOptions::SolveWithBitVectors, Set);
+}
 
 void IFDSIDESolverConfig::setConfig(SolverConfigOptions Opt) { Options = Opt; }
 
@@ -69,6 +114,15 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
+            << "\tinferIdentitySummaries: " << SC.inferIdentitySummaries()
+            << "\n"
+            << "\tadaptivePrecision: " << SC.adaptivePrecision() << " ("
+            << SC.maxFactsPerNode() << " facts per node, "
+            << SC.maxFactsPerFunction() << " per function)\n"
+            << "\tspillJumpFunctions: " << SC.spillJumpFunctions() << " ("
+            << SC.maxResidentJumpFunctions() << " resident)\n"
+            << "\tcompressFactClasses: " << SC.compressFactClasses() << "\n"
+            << "\tsolveWithBitVectors: " << SC.solveWithBitVectors() << "\n"
             << "\temitESG: " << SC.emitESG();
 }
 
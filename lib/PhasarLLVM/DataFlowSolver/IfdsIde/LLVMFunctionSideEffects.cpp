@@ -0,0 +1,322 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFunctionSideEffects.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+constexpr FunctionSideEffects TransitiveEffects =
+    FunctionSideEffects::ReadsMemory | FunctionSideEffects::WritesMemory |
+    FunctionSideEffects::UsesGlobals | FunctionSideEffects::CapturesPointer |
+    FunctionSideEffects::Unknown;
+
+bool isLocalMemory(const llvm::Value *Ptr) {
+  return llvm::isa<llvm::AllocaInst>(llvm::getUnderlyingObject(Ptr));
+}
+
+bool isConstantMemory(const llvm::Value *Ptr) {
+  const auto *Glob =
+      llvm::dyn_cast<llvm::GlobalVariable>(llvm::getUnderlyingObject(Ptr));
+  return Glob && Glob->isConstant();
+}
+
+/// Whether Ptr may point into the memory of Fact, e.g. as a field of it.
+/// Without an alias analysis at hand, only distinct identified objects are
+/// known not to alias.
+bool mayPointIntoFact(const llvm::Value *Ptr, const llvm::Value *Fact) {
+  if (!Ptr->getType()->isPointerTy()) {
+    return false;
+  }
+  const auto *PtrObj = llvm::getUnderlyingObject(Ptr);
+  const auto *FactObj = llvm::getUnderlyingObject(Fact);
+  return PtrObj == FactObj || !llvm::isIdentifiedObject(PtrObj) ||
+         !llvm::isIdentifiedObject(FactObj);
+}
+
+bool isMutableGlobal(const llvm::Value *V) {
+  const auto *Glob = llvm::dyn_cast<llvm::GlobalVariable>(V);
+  return Glob && !Glob->isConstant();
+}
+
+/// Effects of calling a function without body, derived from its attributes
+FunctionSideEffects getDeclarationEffects(const llvm::CallBase *CS,
+                                          const llvm::Function *Callee) {
+  if (Callee->doesNotAccessMemory()) {
+    return FunctionSideEffects::None;
+  }
+  auto Ret = FunctionSideEffects::None;
+  if (Callee->onlyAccessesArgMemory()) {
+    bool OnlyLocalArgs = llvm::all_of(CS->args(), [](const llvm::Use &Arg) {
+      return !Arg->getType()->isPointerTy() || isLocalMemory(Arg.get());
+    });
+    if (OnlyLocalArgs) {
+      return FunctionSideEffects::None;
+    }
+    if (llvm::any_of(CS->args(), [](const llvm::Use &Arg) {
+          return isMutableGlobal(llvm::getUnderlyingObject(Arg.get()));
+        })) {
+      Ret |= FunctionSideEffects::UsesGlobals;
+    }
+  } else if (!Callee->onlyReadsMemory()) {
+    // Arbitrary memory may be written
+    return FunctionSideEffects::Unknown;
+  }
+  if (!Callee->onlyWritesMemory()) {
+    Ret |= FunctionSideEffects::ReadsMemory;
+  }
+  if (!Callee->onlyReadsMemory()) {
+    Ret |= FunctionSideEffects::WritesMemory;
+  }
+  for (unsigned I = 0, End = CS->arg_size(); I < End; ++I) {
+    if (CS->getArgOperand(I)->getType()->isPointerTy() &&
+        !Callee->hasParamAttribute(I, llvm::Attribute::NoCapture)) {
+      Ret |= FunctionSideEffects::CapturesPointer;
+    }
+  }
+  return Ret;
+}
+
+} // namespace
+
+std::string toString(InferredSummaryKind Kind) {
+  switch (Kind) {
+  case InferredSummaryKind::None:
+    return "None";
+  case InferredSummaryKind::Identity:
+    return "Identity";
+  case InferredSummaryKind::KillOnly:
+    return "KillOnly";
+  }
+  llvm_unreachable("All InferredSummaryKinds should be handled in the switch");
+}
+
+LLVMFunctionSideEffects::LLVMFunctionSideEffects(const LLVMBasedICFG &ICF) {
+  // The effects of a function are the union of its local effects and the
+  // effects of its callees. We start with the local effects and propagate
+  // them to the callers until nothing changes anymore, which also handles
+  // recursion.
+  llvm::DenseMap<const llvm::Function *,
+                 llvm::SmallVector<const llvm::Function *, 4>>
+      DefinedCallees;
+  std::vector<const llvm::Function *> WorkList;
+
+  for (const auto *F : ICF.getAllVertexFunctions()) {
+    if (F->isDeclaration()) {
+      continue;
+    }
+    auto Local = FunctionSideEffects::None;
+    if (F->getReturnType()->isPointerTy()) {
+      Local |= FunctionSideEffects::ReturnsPointer;
+    }
+    auto &Callees = DefinedCallees[F];
+    for (const auto &I : llvm::instructions(F)) {
+      for (const auto &Op : I.operands()) {
+        if (Op->getType()->isPointerTy() &&
+            isMutableGlobal(llvm::getUnderlyingObject(Op.get()))) {
+          Local |= FunctionSideEffects::UsesGlobals;
+        }
+      }
+      if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+        const auto *Ptr = Load->getPointerOperand();
+        if (!isLocalMemory(Ptr) && !isConstantMemory(Ptr)) {
+          Local |= FunctionSideEffects::ReadsMemory;
+        }
+      } else if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+        if (!isLocalMemory(Store->getPointerOperand())) {
+          Local |= FunctionSideEffects::WritesMemory;
+          if (Store->getValueOperand()->getType()->isPointerTy()) {
+            Local |= FunctionSideEffects::CapturesPointer;
+          }
+        }
+      } else if (llvm::isa<llvm::AtomicRMWInst, llvm::AtomicCmpXchgInst>(I)) {
+        Local |= FunctionSideEffects::ReadsMemory |
+                 FunctionSideEffects::WritesMemory;
+      } else if (llvm::isa<llvm::VAArgInst>(I)) {
+        Local |= FunctionSideEffects::ReadsMemory;
+      } else if (llvm::isa<llvm::PtrToIntInst>(I)) {
+        Local |= FunctionSideEffects::CapturesPointer;
+      } else if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        auto ResolvedCallees = ICF.getCalleesOfCallAt(CS);
+        llvm::SmallVector<const llvm::Function *, 2> CallTargets(
+            ResolvedCallees.begin(), ResolvedCallees.end());
+        if (CallTargets.empty()) {
+          if (const auto *StaticCallee = CS->getCalledFunction()) {
+            CallTargets.push_back(StaticCallee);
+          } else {
+            Local |= FunctionSideEffects::Unknown;
+          }
+        }
+        for (const auto *Callee : CallTargets) {
+          if (Callee->getReturnType()->isPointerTy()) {
+            // We do not know where the returned pointer comes from
+            Local |= FunctionSideEffects::UsesGlobals;
+          }
+          if (Callee->isDeclaration()) {
+            Local |= getDeclarationEffects(CS, Callee);
+          } else {
+            Callees.push_back(Callee);
+          }
+        }
+      }
+    }
+    Effects[F] = Local;
+    WorkList.push_back(F);
+  }
+
+  while (!WorkList.empty()) {
+    const auto *F = WorkList.back();
+    WorkList.pop_back();
+    auto Old = Effects[F];
+    auto New = Old;
+    for (const auto *Callee : DefinedCallees[F]) {
+      auto It = Effects.find(Callee);
+      // Callees outside of the ICF have not been analyzed
+      New |= It != Effects.end()
+                 ? FunctionSideEffects(It->second & TransitiveEffects)
+                 : FunctionSideEffects::Unknown;
+    }
+    if (New == Old) {
+      continue;
+    }
+    Effects[F] = New;
+    for (const auto *CallSite : ICF.getCallersOf(F)) {
+      WorkList.push_back(CallSite->getFunction());
+    }
+  }
+
+  IF_LOG_ENABLED({
+    std::string Str;
+    llvm::raw_string_ostream RSO(Str);
+    print(RSO);
+    PHASAR_LOG_LEVEL(DEBUG, RSO.str());
+  });
+}
+
+FunctionSideEffects
+LLVMFunctionSideEffects::getSideEffects(const llvm::Function *F) const {
+  auto It = Effects.find(F);
+  if (It == Effects.end()) {
+    return FunctionSideEffects::Unknown;
+  }
+  return It->second;
+}
+
+InferredSummaryKind
+LLVMFunctionSideEffects::getSummaryKind(const llvm::Function *F) const {
+  if (F->isDeclaration()) {
+    return InferredSummaryKind::None;
+  }
+  auto E = getSideEffects(F);
+  if (E & (FunctionSideEffects::Unknown | FunctionSideEffects::CapturesPointer |
+           FunctionSideEffects::ReturnsPointer)) {
+    return InferredSummaryKind::None;
+  }
+  if (!(E & FunctionSideEffects::WritesMemory)) {
+    return InferredSummaryKind::Identity;
+  }
+  if (!(E & (FunctionSideEffects::ReadsMemory |
+             FunctionSideEffects::UsesGlobals))) {
+    return InferredSummaryKind::KillOnly;
+  }
+  return InferredSummaryKind::None;
+}
+
+InferredFactEffect
+LLVMFunctionSideEffects::getFactEffect(const llvm::CallBase *CS,
+                                       const llvm::Function *Callee,
+                                       const llvm::Value *Fact,
+                                       bool IsZero) const {
+  auto Kind = getSummaryKind(Callee);
+  if (Kind == InferredSummaryKind::None) {
+    return InferredFactEffect::Unknown;
+  }
+  if (IsZero) {
+    // The zero fact generates the facts within the callee, which are of
+    // interest in their own right, e.g. uses of uninitialized variables
+    return InferredFactEffect::Unknown;
+  }
+  bool ResultUsed = !CS->getType()->isVoidTy() && !CS->use_empty();
+  if (!Fact->getType()->isPointerTy()) {
+    return InferredFactEffect::Unknown;
+  }
+  const auto *StrippedFact = Fact->stripPointerCasts();
+  bool IsArg = llvm::any_of(CS->args(), [StrippedFact](const llvm::Use &Arg) {
+    return Arg->stripPointerCasts() == StrippedFact;
+  });
+  if (ResultUsed &&
+      (IsArg || (getSideEffects(Callee) & FunctionSideEffects::ReadsMemory))) {
+    // The fact may flow into the (non-pointer) return value
+    return InferredFactEffect::Unknown;
+  }
+  if (Kind == InferredSummaryKind::KillOnly) {
+    if (IsArg) {
+      return InferredFactEffect::Kill;
+    }
+    // A write through a pointer derived from the fact, e.g. a field GEP,
+    // modifies the fact's memory without killing it
+    if (llvm::any_of(CS->args(), [Fact](const llvm::Use &Arg) {
+          return mayPointIntoFact(Arg, Fact);
+        })) {
+      return InferredFactEffect::Unknown;
+    }
+  }
+  return InferredFactEffect::Preserve;
+}
+
+void LLVMFunctionSideEffects::print(llvm::raw_ostream &OS) const {
+  std::vector<const llvm::Function *> Functions;
+  Functions.reserve(Effects.size());
+  for (const auto &[F, E] : Effects) {
+    Functions.push_back(F);
+  }
+  std::sort(Functions.begin(), Functions.end(),
+            [](const auto *Lhs, const auto *Rhs) {
+              return Lhs->getName() < Rhs->getName();
+            });
+  OS << "Inferred function summaries:\n";
+  for (const auto *F : Functions) {
+    auto E = getSideEffects(F);
+    OS << "  " << F->getName() << ": " << toString(getSummaryKind(F)) << " [";
+    llvm::ListSeparator LS;
+    auto PrintIf = [&OS, &LS, E](FunctionSideEffects Flag, const char *Name) {
+      if (E & Flag) {
+        OS << LS << Name;
+      }
+    };
+    PrintIf(FunctionSideEffects::ReadsMemory, "reads");
+    PrintIf(FunctionSideEffects::WritesMemory, "writes");
+    PrintIf(FunctionSideEffects::UsesGlobals, "globals");
+    PrintIf(FunctionSideEffects::CapturesPointer, "captures");
+    PrintIf(FunctionSideEffects::ReturnsPointer, "returns-pointer");
+    PrintIf(FunctionSideEffects::Unknown, "unknown");
+    OS << "]\n";
+  }
+}
+
+} // namespace psr
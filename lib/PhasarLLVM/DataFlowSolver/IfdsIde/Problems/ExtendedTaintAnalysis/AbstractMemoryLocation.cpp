@@ -200,7 +200,7 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
   if (LLVMZeroValue::getInstance()->isLLVMZeroValue(TV->base())) {
     OS << "<ZERO>";
   } else {
-    OS << llvmIRToShortString(TV->base());
+    OS << llvmIRToShortStringRef(TV->base());
   }
   OS << "; Offsets=" << PrettyPrinter{TV->offsets()};
 
@@ -7,6 +7,7 @@
  *     Fabian Schiebel and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <limits>
 #include <new>
 
@@ -260,6 +261,29 @@ const AbstractMemoryLocationImpl *AbstractMemoryLocationFactoryBase::limitImpl(
   return Ret;
 }
 
+const AbstractMemoryLocationImpl *
+AbstractMemoryLocationFactoryBase::coarsenImpl(
+    const AbstractMemoryLocationImpl *AML, unsigned NumDroppedOffs) {
+  if (AML->isZero()) {
+    return AML;
+  }
+
+  auto Offs = AML->offsets();
+  Offs = Offs.drop_back(
+      std::min<size_t>(NumDroppedOffs, Offs.empty() ? 0 : Offs.size() - 1));
+  if (Offs.size() == AML->offsets().size() && AML->isOverApproximation()) {
+    return AML;
+  }
+
+  const auto *Ret = getOrCreateImpl(AML->base(), Offs, 0);
+
+#ifdef XTAINT_DIAGNOSTICS
+  overApproximatedAMLs.insert(Ret);
+#endif
+
+  return Ret;
+}
+
 const AbstractMemoryLocationImpl *
 AbstractMemoryLocationFactoryBase::withIndirectionOfImpl(
     const AbstractMemoryLocationImpl *AML, llvm::ArrayRef<ptrdiff_t> Ind) {
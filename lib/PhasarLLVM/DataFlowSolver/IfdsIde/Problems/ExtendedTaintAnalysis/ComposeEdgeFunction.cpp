@@ -19,10 +19,21 @@ ComposeEdgeFunction::ComposeEdgeFunction(BasicBlockOrdering &BBO,
                                          EdgeFunctionPtrType F,
                                          EdgeFunctionPtrType G)
     : EdgeFunctionBase(EFKind::Compose, BBO), F(std::move(F)), G(std::move(G)) {
+  for (const auto &EF : {this->F, this->G}) {
+    if (auto *EFC = dynamic_cast<ComposeEdgeFunction *>(&*EF)) {
+      Sequence.insert(Sequence.end(), EFC->Sequence.begin(),
+                      EFC->Sequence.end());
+    } else if (!isEdgeIdentity(&*EF)) {
+      Sequence.push_back(EF);
+    }
+  }
 }
 
 auto ComposeEdgeFunction::computeTarget(l_t Source) -> l_t {
-  return G->computeTarget(F->computeTarget(Source));
+  for (const auto &EF : Sequence) {
+    Source = EF->computeTarget(Source);
+  }
+  return Source;
 }
 
 bool ComposeEdgeFunction::equal_to(EdgeFunctionPtrType Other) const {
@@ -54,6 +54,6 @@ bool DebugEdgeIdentity::equal_to(EdgeFunctionPtrType Other) const {
 
 void DebugEdgeIdentity::print(llvm::raw_ostream &OS,
                               [[maybe_unused]] bool IsForDebug) const {
-  OS << "EdgeId[" << llvmIRToShortString(Inst) << "]";
+  OS << "EdgeId[" << llvmIRToShortStringRef(Inst) << "]";
 }
 } // namespace psr::XTaint
@@ -127,7 +127,7 @@ bool GenEdgeFunction::equal_to(EdgeFunctionPtrType OtherFunction) const {
 
 void GenEdgeFunction::print(llvm::raw_ostream &OS,
                             [[maybe_unused]] bool IsForDebug) const {
-  OS << "GenEF[" << (Sani ? llvmIRToString(Sani) : "null") << "]";
+  OS << "GenEF[" << (Sani ? llvmIRToStringRef(Sani) : "null") << "]";
 }
 
 } // namespace psr::XTaint
@@ -47,6 +47,6 @@ bool TransferEdgeFunction::equal_to(EdgeFunctionPtrType Other) const {
 
 void TransferEdgeFunction::print(llvm::raw_ostream &OS,
                                  [[maybe_unused]] bool IsForDebug) const {
-  OS << "Transfer[To: " << llvmIRToShortString(To) << "]";
+  OS << "Transfer[To: " << llvmIRToShortStringRef(To) << "]";
 }
 } // namespace psr::XTaint
@@ -79,6 +79,10 @@ bool IDEExtendedTaintAnalysis::isZeroValue(d_t Fact) const {
   return Fact->isZero();
 }
 
+auto IDEExtendedTaintAnalysis::coarsenFact(d_t Fact, unsigned Level) -> d_t {
+  return FactFactory.coarsen(Fact, Level);
+}
+
 IDEExtendedTaintAnalysis::EdgeFunctionPtrType
 IDEExtendedTaintAnalysis::allTopFunction() {
   return getAllTop();
@@ -759,7 +763,7 @@ auto IDEExtendedTaintAnalysis::getSummaryEdgeFunction(n_t Curr, d_t CurrNode,
 
 void IDEExtendedTaintAnalysis::printNode(llvm::raw_ostream &OS,
                                          n_t Inst) const {
-  OS << llvmIRToString(Inst);
+  OS << llvmIRToStringRef(Inst);
 }
 
 void IDEExtendedTaintAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
@@ -790,7 +794,7 @@ void IDEExtendedTaintAnalysis::emitTextReport(
     printNode(OS, Inst);
     OS << "\n";
     for (const auto &Leak : LeakSet) {
-      OS << "\t" << llvmIRToShortString(Leak) << "\n";
+      OS << "\t" << llvmIRToShortStringRef(Leak) << "\n";
     }
   }
   OS << '\n';
@@ -498,13 +498,13 @@ IDEGeneralizedLCA::allTopFunction() {
 
 void IDEGeneralizedLCA::printNode(llvm::raw_ostream &Os,
                                   IDEGeneralizedLCA::n_t Stmt) const {
-  Os << llvmIRToString(Stmt);
+  Os << llvmIRToStringRef(Stmt);
 }
 
 void IDEGeneralizedLCA::printDataFlowFact(llvm::raw_ostream &Os,
                                           IDEGeneralizedLCA::d_t Fact) const {
   assert(Fact && "Invalid dataflow fact");
-  Os << llvmIRToString(Fact);
+  Os << llvmIRToStringRef(Fact);
 }
 
 void IDEGeneralizedLCA::printFunction(llvm::raw_ostream &Os,
@@ -706,7 +706,7 @@ void IDEGeneralizedLCA::LCAResult::print(llvm::raw_ostream &Os) {
   }
   Os << "\nCorresponding IR Instructions:\n";
   for (const auto *Ir : IRTrace) {
-    Os << "  " << llvmIRToString(Ir) << '\n';
+    Os << "  " << llvmIRToStringRef(Ir) << '\n';
   }
 }
 
@@ -32,15 +32,17 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/MathExtras.h"
 
+#include <cassert>
 #include <limits>
 #include <memory>
 #include <utility>
 
 namespace psr {
 // Initialize debug counter for edge functions
-unsigned IDELinearConstantAnalysis::CurrGenConstantId = 0; // NOLINT
-unsigned IDELinearConstantAnalysis::CurrLCAIDId = 0;       // NOLINT
-unsigned IDELinearConstantAnalysis::CurrBinaryId = 0;      // NOLINT
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrGenConstantId{0}; // NOLINT
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrLCAIDId{0};       // NOLINT
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrBinaryId{0};      // NOLINT
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrLinearId{0};      // NOLINT
 
 const IDELinearConstantAnalysis::l_t IDELinearConstantAnalysis::TOP = Top{};
 
@@ -56,11 +58,7 @@ IDELinearConstantAnalysis::IDELinearConstantAnalysis(
       IDELinearConstantAnalysis::createZeroValue();
 }
 
-IDELinearConstantAnalysis::~IDELinearConstantAnalysis() {
-  CurrGenConstantId = 0;
-  CurrLCAIDId = 0;
-  CurrBinaryId = 0;
-}
+IDELinearConstantAnalysis::~IDELinearConstantAnalysis() = default;
 
 // Start formulating our analysis by specifying the parts required for IFDS
 
@@ -121,10 +119,18 @@ IDELinearConstantAnalysis::getCallFlowFunction(n_t CallSite, f_t DestFun) {
       std::vector<const llvm::Value *> Actuals;
       std::vector<const llvm::Value *> Formals;
       const llvm::Function *DestFun;
-      LCAFF(const llvm::CallBase *CallSite, f_t DestFun) : DestFun(DestFun) {
+      LCAFF(const llvm::CallBase *CallSite, f_t DestFun,
+            const ProjectIRDB *IRDB)
+          : DestFun(DestFun) {
         // std::set up the actual parameters
         for (unsigned Idx = 0; Idx < CallSite->arg_size(); ++Idx) {
-          Actuals.push_back(CallSite->getArgOperand(Idx));
+          const llvm::Value *Actual = CallSite->getArgOperand(Idx);
+          // The model of the global ctors and dtors passes the globals of the
+          // analyzed module through declarations
+          if (const auto *GV = llvm::dyn_cast<llvm::GlobalValue>(Actual)) {
+            Actual = IRDB->resolveSyntheticDeclaration(GV);
+          }
+          Actuals.push_back(Actual);
         }
         // std::set up the formal parameters
         for (unsigned Idx = 0; Idx < DestFun->arg_size(); ++Idx) {
@@ -181,7 +187,7 @@ IDELinearConstantAnalysis::getCallFlowFunction(n_t CallSite, f_t DestFun) {
     };
 
     if (!DestFun->isDeclaration()) {
-      return std::make_shared<LCAFF>(CS, DestFun);
+      return std::make_shared<LCAFF>(CS, DestFun, IRDB);
     }
   }
   // Pass everything else as identity
@@ -265,7 +271,7 @@ IDELinearConstantAnalysis::initialSeeds() {
   } else {
     // Consider the user specified entry points
     for (const auto &EntryPoint : EntryPoints) {
-      EntryPointFuns.insert(IRDB->getFunctionDefinition(EntryPoint));
+      EntryPointFuns.insert(ICF->getFunction(EntryPoint));
     }
   }
 
@@ -363,6 +369,33 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(n_t Curr, d_t CurrNode,
         (CurrNode == Rop && !llvm::isa<llvm::ConstantInt>(Lop))) {
       return std::make_shared<AllBottom<l_t>>(BOTTOM);
     }
+    const auto *Lic = llvm::dyn_cast<llvm::ConstantInt>(Lop);
+    const auto *Ric = llvm::dyn_cast<llvm::ConstantInt>(Rop);
+    // Both operands are constant, so the result is constant as well
+    if (isZeroValue(CurrNode) && Lic && Ric) {
+      auto Res = executeBinOperation(OP, Lic->getSExtValue(),
+                                     Ric->getSExtValue());
+      if (const auto *IntConst = std::get_if<int64_t>(&Res)) {
+        return std::make_shared<GenConstant>(*IntConst);
+      }
+      if (Res == TOP) {
+        return std::make_shared<AllTop<l_t>>(TOP);
+      }
+      return std::make_shared<AllBottom<l_t>>(BOTTOM);
+    }
+    // Use the closed form for operations that are linear in CurrNode
+    if (CurrNode == Lop && Ric) {
+      if (auto Linear = LCALinear::create(OP, Ric->getSExtValue(),
+                                          /*ConstIsLeft*/ false)) {
+        return Linear;
+      }
+    }
+    if (CurrNode == Rop && Lic) {
+      if (auto Linear = LCALinear::create(OP, Lic->getSExtValue(),
+                                          /*ConstIsLeft*/ true)) {
+        return Linear;
+      }
+    }
 
     return std::make_shared<BinOp>(OP, Lop, Rop, CurrNode);
   }
@@ -449,7 +482,9 @@ IDELinearConstantAnalysis::allTopFunction() {
 std::shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
 IDELinearConstantAnalysis::LCAEdgeFunctionComposer::composeWith(
     std::shared_ptr<EdgeFunction<l_t>> SecondFunction) {
-  if (dynamic_cast<AllBottom<l_t> *>(SecondFunction.get())) {
+  if (dynamic_cast<AllBottom<l_t> *>(SecondFunction.get()) ||
+      dynamic_cast<AllTop<l_t> *>(SecondFunction.get()) ||
+      dynamic_cast<GenConstant *>(SecondFunction.get())) {
     return SecondFunction;
   }
   if (dynamic_cast<EdgeIdentity<l_t> *>(SecondFunction.get()) ||
@@ -457,7 +492,7 @@ IDELinearConstantAnalysis::LCAEdgeFunctionComposer::composeWith(
     return this->shared_from_this();
   }
 
-  return F->composeWith(G->composeWith(SecondFunction));
+  return EdgeFunctionComposer<l_t>::composeWith(SecondFunction);
 }
 
 std::shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
@@ -473,6 +508,41 @@ IDELinearConstantAnalysis::LCAEdgeFunctionComposer::joinWith(
   return std::make_shared<AllBottom<l_t>>(BOTTOM);
 }
 
+void IDELinearConstantAnalysis::LCAEdgeFunctionComposer::normalize(
+    SequenceTy &Seq) {
+  SequenceTy Normalized;
+  Normalized.reserve(Seq.size());
+  for (auto EF : Seq) {
+    if (dynamic_cast<LCAIdentity *>(EF.get())) {
+      continue;
+    }
+    // Constants are evaluated right away and linear functions followed by
+    // linear functions are composed in closed form
+    if (!Normalized.empty() &&
+        (dynamic_cast<GenConstant *>(Normalized.back().get()) ||
+         (dynamic_cast<LCALinear *>(Normalized.back().get()) &&
+          dynamic_cast<LCALinear *>(EF.get())))) {
+      EF = Normalized.back()->composeWith(EF);
+      Normalized.pop_back();
+    }
+    // Constant functions do not depend on the functions before them
+    if (dynamic_cast<GenConstant *>(EF.get()) ||
+        dynamic_cast<AllBottom<l_t> *>(EF.get()) ||
+        dynamic_cast<AllTop<l_t> *>(EF.get())) {
+      Normalized.clear();
+    }
+    Normalized.push_back(std::move(EF));
+  }
+  Seq = std::move(Normalized);
+}
+
+std::shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
+IDELinearConstantAnalysis::LCAEdgeFunctionComposer::makeComposer(
+    std::shared_ptr<EdgeFunction<l_t>> F,
+    std::shared_ptr<EdgeFunction<l_t>> G) const {
+  return std::make_shared<LCAEdgeFunctionComposer>(std::move(F), std::move(G));
+}
+
 IDELinearConstantAnalysis::GenConstant::GenConstant(int64_t IntConst)
     : GenConstantId(++CurrGenConstantId), IntConst(IntConst) {}
 
@@ -566,6 +636,109 @@ void IDELinearConstantAnalysis::LCAIdentity::print(llvm::raw_ostream &OS,
   OS << "Id (EF:" << LCAIDId << ')';
 }
 
+IDELinearConstantAnalysis::LCALinear::LCALinear(int64_t Factor,
+                                                int64_t Offset)
+    : LinearId(++CurrLinearId), Factor(Factor), Offset(Offset) {
+  assert(Factor != 0 && "A constant function must be a GenConstant");
+}
+
+std::shared_ptr<IDELinearConstantAnalysis::LCALinear>
+IDELinearConstantAnalysis::LCALinear::create(const unsigned Op,
+                                             int64_t Const,
+                                             bool ConstIsLeft) {
+  switch (Op) {
+  case llvm::Instruction::Add:
+    return std::make_shared<LCALinear>(1, Const);
+  case llvm::Instruction::Sub:
+    if (ConstIsLeft) {
+      return std::make_shared<LCALinear>(-1, Const);
+    }
+    // The negation of min is not representable
+    if (Const == std::numeric_limits<int64_t>::min()) {
+      return nullptr;
+    }
+    return std::make_shared<LCALinear>(1, -Const);
+  case llvm::Instruction::Mul:
+    // Multiplying with zero yields zero only for non-bottom values, which is
+    // left to BinOp
+    if (Const == 0) {
+      return nullptr;
+    }
+    return std::make_shared<LCALinear>(Const, 0);
+  default:
+    return nullptr;
+  }
+}
+
+IDELinearConstantAnalysis::l_t
+IDELinearConstantAnalysis::LCALinear::computeTarget(l_t Source) {
+  const auto *Val = std::get_if<int64_t>(&Source);
+  if (!Val) {
+    return BOTTOM;
+  }
+  int64_t Res;
+  if (llvm::MulOverflow(Factor, *Val, Res) ||
+      llvm::AddOverflow(Res, Offset, Res)) {
+    return BOTTOM;
+  }
+  return Res;
+}
+
+std::shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
+IDELinearConstantAnalysis::LCALinear::composeWith(
+    std::shared_ptr<EdgeFunction<l_t>> SecondFunction) {
+  if (dynamic_cast<AllBottom<l_t> *>(SecondFunction.get()) ||
+      dynamic_cast<AllTop<l_t> *>(SecondFunction.get()) ||
+      dynamic_cast<GenConstant *>(SecondFunction.get())) {
+    return SecondFunction;
+  }
+  if (dynamic_cast<EdgeIdentity<l_t> *>(SecondFunction.get()) ||
+      dynamic_cast<LCAIdentity *>(SecondFunction.get())) {
+    return this->shared_from_this();
+  }
+  // (G o F)(x) = G.Factor * (Factor * x + Offset) + G.Offset
+  if (auto *G = dynamic_cast<LCALinear *>(SecondFunction.get())) {
+    int64_t ComposedFactor;
+    int64_t ComposedOffset;
+    if (llvm::MulOverflow(G->Factor, Factor, ComposedFactor) ||
+        llvm::MulOverflow(G->Factor, Offset, ComposedOffset) ||
+        llvm::AddOverflow(ComposedOffset, G->Offset, ComposedOffset)) {
+      return std::make_shared<AllBottom<l_t>>(BOTTOM);
+    }
+    return std::make_shared<LCALinear>(ComposedFactor, ComposedOffset);
+  }
+
+  return std::make_shared<LCAEdgeFunctionComposer>(this->shared_from_this(),
+                                                   SecondFunction);
+}
+
+std::shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
+IDELinearConstantAnalysis::LCALinear::joinWith(
+    std::shared_ptr<EdgeFunction<l_t>> OtherFunction) {
+  if (OtherFunction.get() == this ||
+      OtherFunction->equal_to(this->shared_from_this())) {
+    return this->shared_from_this();
+  }
+  if (dynamic_cast<AllTop<l_t> *>(OtherFunction.get())) {
+    return this->shared_from_this();
+  }
+  // Two different linear functions agree on at most one value
+  return std::make_shared<AllBottom<l_t>>(BOTTOM);
+}
+
+bool IDELinearConstantAnalysis::LCALinear::equal_to(
+    std::shared_ptr<EdgeFunction<l_t>> Other) const {
+  if (auto *Linear = dynamic_cast<LCALinear *>(Other.get())) {
+    return Linear->Factor == Factor && Linear->Offset == Offset;
+  }
+  return this == Other.get();
+}
+
+void IDELinearConstantAnalysis::LCALinear::print(llvm::raw_ostream &OS,
+                                                 bool /*IsForDebug*/) const {
+  OS << Factor << " * x + " << Offset << " (EF:" << LinearId << ')';
+}
+
 IDELinearConstantAnalysis::BinOp::BinOp(const unsigned Op, d_t Lop, d_t Rop,
                                         d_t CurrNode)
     : EdgeFunctionID(++CurrBinaryId), Op(Op), Lop(Lop), Rop(Rop),
@@ -755,12 +928,12 @@ IDELinearConstantAnalysis::executeBinOperation(const unsigned Op, l_t LVal,
 
 void IDELinearConstantAnalysis::printNode(llvm::raw_ostream &OS,
                                           n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IDELinearConstantAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                                   d_t Fact) const {
-  OS << llvmIRToShortString(Fact);
+  OS << llvmIRToShortStringRef(Fact);
 }
 
 void IDELinearConstantAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -0,0 +1,447 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEMultiTypeStateAnalysis.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/LLVMIRToSrc.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <utility>
+
+namespace psr {
+
+namespace {
+
+using l_t = IDEMultiTypeStateAnalysis::l_t;
+
+l_t getStates(const IDEMultiTypeStateAnalysis::ConfigurationTy &TSDs,
+              TypeStateDescription::State (TypeStateDescription::*Get)()
+                  const) {
+  l_t States;
+  States.reserve(TSDs.size());
+  for (const auto *TSD : TSDs) {
+    States.push_back((TSD->*Get)());
+  }
+  return States;
+}
+
+std::vector<std::unique_ptr<CompiledTypeStateDescription>>
+compileDescriptions(const IDEMultiTypeStateAnalysis::ConfigurationTy &TSDs,
+                    const ProjectIRDB &IRDB) {
+  std::vector<std::unique_ptr<CompiledTypeStateDescription>> CTSDs;
+  CTSDs.reserve(TSDs.size());
+  for (const auto *TSD : TSDs) {
+    CTSDs.push_back(std::make_unique<CompiledTypeStateDescription>(*TSD, IRDB));
+  }
+  return CTSDs;
+}
+
+std::vector<CompiledTypeStateDescription *> getPointers(
+    const std::vector<std::unique_ptr<CompiledTypeStateDescription>> &CTSDs) {
+  std::vector<CompiledTypeStateDescription *> Ptrs;
+  Ptrs.reserve(CTSDs.size());
+  for (const auto &CTSD : CTSDs) {
+    Ptrs.push_back(CTSD.get());
+  }
+  return Ptrs;
+}
+
+} // namespace
+
+IDEMultiTypeStateAnalysis::IDEMultiTypeStateAnalysis(
+    const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+    const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT, const ConfigurationTy &TSDs,
+    std::set<std::string> EntryPoints)
+    : IDETabulationProblem(IRDB, TH, ICF, PT, std::move(EntryPoints)),
+      TOP(getStates(TSDs, &TypeStateDescription::top)),
+      BOTTOM(getStates(TSDs, &TypeStateDescription::bottom)),
+      CTSDs(compileDescriptions(TSDs, *IRDB)), Flow(PT, getPointers(CTSDs)) {
+  if (TSDs.empty()) {
+    llvm::report_fatal_error(
+        "IDEMultiTypeStateAnalysis requires at least one type state "
+        "description");
+  }
+  IDETabulationProblem::ZeroValue =
+      IDEMultiTypeStateAnalysis::createZeroValue();
+  for (size_t Desc = 0; Desc < CTSDs.size(); ++Desc) {
+    Identities.push_back(CTSDs[Desc]->getIdentity());
+    TopConstants.push_back(CTSDs[Desc]->getConstant(TOP[Desc]));
+    BottomConstants.push_back(CTSDs[Desc]->getConstant(BOTTOM[Desc]));
+  }
+}
+
+// Start formulating our analysis by specifying the parts required for IFDS
+
+IDEMultiTypeStateAnalysis::FlowFunctionPtrType
+IDEMultiTypeStateAnalysis::getNormalFlowFunction(n_t Curr, n_t /*Succ*/) {
+  return Flow.getNormalFlowFunction(Curr);
+}
+
+IDEMultiTypeStateAnalysis::FlowFunctionPtrType
+IDEMultiTypeStateAnalysis::getCallFlowFunction(n_t CallSite, f_t DestFun) {
+  return Flow.getCallFlowFunction(CallSite, DestFun);
+}
+
+IDEMultiTypeStateAnalysis::FlowFunctionPtrType
+IDEMultiTypeStateAnalysis::getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                              n_t ExitStmt, n_t /*RetSite*/) {
+  return Flow.getRetFlowFunction(CallSite, CalleeFun, ExitStmt);
+}
+
+IDEMultiTypeStateAnalysis::FlowFunctionPtrType
+IDEMultiTypeStateAnalysis::getCallToRetFlowFunction(
+    n_t CallSite, n_t /*RetSite*/, llvm::ArrayRef<f_t> Callees) {
+  return Flow.getCallToRetFlowFunction(CallSite, Callees);
+}
+
+IDEMultiTypeStateAnalysis::FlowFunctionPtrType
+IDEMultiTypeStateAnalysis::getSummaryFlowFunction(n_t /*CallSite*/,
+                                                  f_t /*DestFun*/) {
+  return nullptr;
+}
+
+InitialSeeds<IDEMultiTypeStateAnalysis::n_t, IDEMultiTypeStateAnalysis::d_t,
+             IDEMultiTypeStateAnalysis::l_t>
+IDEMultiTypeStateAnalysis::initialSeeds() {
+  InitialSeeds<n_t, d_t, l_t> Seeds;
+  for (const auto &EntryPoint : EntryPoints) {
+    Seeds.addSeed(&ICF->getFunction(EntryPoint)->front().front(),
+                  getZeroValue(), bottomElement());
+  }
+  return Seeds;
+}
+
+IDEMultiTypeStateAnalysis::d_t
+IDEMultiTypeStateAnalysis::createZeroValue() const {
+  return LLVMZeroValue::getInstance();
+}
+
+bool IDEMultiTypeStateAnalysis::isZeroValue(d_t Fact) const {
+  return LLVMZeroValue::isLLVMZeroValue(Fact);
+}
+
+// in addition provide specifications for the IDE parts
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::getNormalEdgeFunction(n_t Curr, d_t CurrNode,
+                                                 n_t /*Succ*/, d_t SuccNode) {
+  // Set alloca instructions of a target type to uninitialized in the
+  // protocols whose type matches.
+  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
+    if (isZeroValue(CurrNode) && SuccNode == Alloca &&
+        Flow.hasMatchingType(Alloca)) {
+      auto Transitions = TopConstants;
+      for (unsigned Desc = 0; Desc < CTSDs.size(); ++Desc) {
+        if (Flow.hasMatchingType(Alloca, Desc)) {
+          Transitions[Desc] =
+              CTSDs[Desc]->getConstant(getDescription(Desc).uninit());
+        }
+      }
+      return getTransitionFunction(std::move(Transitions));
+    }
+  }
+  return EdgeIdentity<l_t>::getInstance();
+}
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::getCallEdgeFunction(n_t /*CallSite*/,
+                                               d_t /*SrcNode*/,
+                                               f_t /*DestinationFunction*/,
+                                               d_t /*DestNode*/) {
+  return EdgeIdentity<l_t>::getInstance();
+}
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::getReturnEdgeFunction(n_t /*CallSite*/,
+                                                 f_t /*CalleeFunction*/,
+                                                 n_t /*ExitInst*/,
+                                                 d_t /*ExitNode*/,
+                                                 n_t /*RetSite*/,
+                                                 d_t /*RetNode*/) {
+  return EdgeIdentity<l_t>::getInstance();
+}
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::getCallToRetEdgeFunction(
+    n_t CallSite, d_t CallNode, n_t /*RetSite*/, d_t RetSiteNode,
+    llvm::ArrayRef<f_t> Callees) {
+  const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
+  // The factory functions of all protocols generate from the zero value
+  if (isZeroValue(CallNode) && RetSiteNode == CS) {
+    auto Transitions = TopConstants;
+    bool IsFactory = false;
+    for (unsigned Desc = 0; Desc < CTSDs.size(); ++Desc) {
+      for (const auto *Callee : Callees) {
+        if (CTSDs[Desc]->isFactoryFunction(Callee)) {
+          auto &CTSD = *CTSDs[Desc];
+          Transitions[Desc] = CTSD.getConstant(
+              CTSD.getNextState(CS, Callee, CTSD.getDescription().uninit()));
+          IsFactory = true;
+          break;
+        }
+      }
+    }
+    if (IsFactory) {
+      return getTransitionFunction(std::move(Transitions));
+    }
+  }
+
+  // Each protocol applies the transition of its first consuming callee that
+  // consumes CallNode; the other protocols leave their state unchanged.
+  if (CallNode != RetSiteNode) {
+    return EdgeIdentity<l_t>::getInstance();
+  }
+  auto Transitions = Identities;
+  for (unsigned Desc = 0; Desc < CTSDs.size(); ++Desc) {
+    for (const auto *Callee : Callees) {
+      const auto &Info = CTSDs[Desc]->getFunctionInfo(Callee);
+      if (!Info.IsConsuming) {
+        continue;
+      }
+      bool Consumed = false;
+      for (auto Idx : Info.ConsumerParamIdx) {
+        auto PointsToAndAllocas =
+            Flow.getWMAliasesAndAllocas(CS->getArgOperand(Idx));
+        if (PointsToAndAllocas.count(CallNode)) {
+          Consumed = true;
+          break;
+        }
+      }
+      if (Consumed) {
+        Transitions[Desc] = CTSDs[Desc]->getTransition(CS, Callee);
+        break;
+      }
+    }
+  }
+  return getTransitionFunction(std::move(Transitions));
+}
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::getSummaryEdgeFunction(n_t /*CallSite*/,
+                                                  d_t /*CallNode*/,
+                                                  n_t /*RetSite*/,
+                                                  d_t /*RetSiteNode*/) {
+  return nullptr;
+}
+
+IDEMultiTypeStateAnalysis::l_t IDEMultiTypeStateAnalysis::topElement() {
+  return TOP;
+}
+
+IDEMultiTypeStateAnalysis::l_t IDEMultiTypeStateAnalysis::bottomElement() {
+  return BOTTOM;
+}
+
+IDEMultiTypeStateAnalysis::l_t IDEMultiTypeStateAnalysis::join(l_t Lhs,
+                                                               l_t Rhs) {
+  for (size_t Desc = 0; Desc < Lhs.size(); ++Desc) {
+    if (Lhs[Desc] == Rhs[Desc] || Rhs[Desc] == TOP[Desc]) {
+      continue;
+    }
+    if (Lhs[Desc] == TOP[Desc]) {
+      Lhs[Desc] = Rhs[Desc];
+    } else {
+      Lhs[Desc] = BOTTOM[Desc];
+    }
+  }
+  return Lhs;
+}
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::allTopFunction() {
+  return std::make_shared<AllTop<l_t>>(TOP);
+}
+
+void IDEMultiTypeStateAnalysis::printNode(llvm::raw_ostream &OS,
+                                          n_t Stmt) const {
+  OS << llvmIRToStringRef(Stmt);
+}
+
+void IDEMultiTypeStateAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
+                                                  d_t Fact) const {
+  OS << llvmIRToStringRef(Fact);
+}
+
+void IDEMultiTypeStateAnalysis::printFunction(llvm::raw_ostream &OS,
+                                              f_t Func) const {
+  OS << Func->getName();
+}
+
+void IDEMultiTypeStateAnalysis::printEdgeFact(llvm::raw_ostream &OS,
+                                              l_t L) const {
+  OS << '[';
+  for (size_t Desc = 0; Desc < L.size(); ++Desc) {
+    if (Desc != 0) {
+      OS << ", ";
+    }
+    OS << getDescription(Desc).stateToString(L[Desc]);
+  }
+  OS << ']';
+}
+
+std::shared_ptr<EdgeFunction<IDEMultiTypeStateAnalysis::l_t>>
+IDEMultiTypeStateAnalysis::getTransitionFunction(
+    llvm::SmallVector<TransitionId, 4> Transitions) {
+  if (Transitions == Identities) {
+    return EdgeIdentity<l_t>::getInstance();
+  }
+  return std::make_shared<MultiTSEdgeFunction>(*this, std::move(Transitions));
+}
+
+auto IDEMultiTypeStateAnalysis::MultiTSEdgeFunction::computeTarget(
+    l_t Source) -> l_t {
+  for (size_t Desc = 0; Desc < Transitions.size(); ++Desc) {
+    Source[Desc] = Problem.CTSDs[Desc]->apply(Transitions[Desc], Source[Desc]);
+  }
+  return Source;
+}
+
+auto IDEMultiTypeStateAnalysis::MultiTSEdgeFunction::composeWith(
+    std::shared_ptr<EdgeFunction<l_t>> SecondFunction)
+    -> std::shared_ptr<EdgeFunction<l_t>> {
+  if (dynamic_cast<EdgeIdentity<l_t> *>(SecondFunction.get())) {
+    return shared_from_this();
+  }
+  if (dynamic_cast<AllBottom<l_t> *>(SecondFunction.get()) ||
+      dynamic_cast<AllTop<l_t> *>(SecondFunction.get())) {
+    return SecondFunction;
+  }
+  if (auto *MTSEF = dynamic_cast<MultiTSEdgeFunction *>(SecondFunction.get());
+      MTSEF && &MTSEF->Problem == &Problem) {
+    auto Composed = Transitions;
+    for (size_t Desc = 0; Desc < Composed.size(); ++Desc) {
+      Composed[Desc] = Problem.CTSDs[Desc]->compose(Transitions[Desc],
+                                                    MTSEF->Transitions[Desc]);
+    }
+    return Problem.getTransitionFunction(std::move(Composed));
+  }
+  llvm::report_fatal_error("Unexpected edge function in "
+                           "IDEMultiTypeStateAnalysis");
+}
+
+auto IDEMultiTypeStateAnalysis::MultiTSEdgeFunction::joinWith(
+    std::shared_ptr<EdgeFunction<l_t>> OtherFunction)
+    -> std::shared_ptr<EdgeFunction<l_t>> {
+  if (OtherFunction.get() == this ||
+      OtherFunction->equal_to(shared_from_this()) ||
+      dynamic_cast<AllTop<l_t> *>(OtherFunction.get())) {
+    return shared_from_this();
+  }
+  if (dynamic_cast<AllBottom<l_t> *>(OtherFunction.get())) {
+    return OtherFunction;
+  }
+  llvm::ArrayRef<TransitionId> Others;
+  if (dynamic_cast<EdgeIdentity<l_t> *>(OtherFunction.get())) {
+    Others = Problem.Identities;
+  } else if (auto *MTSEF =
+                 dynamic_cast<MultiTSEdgeFunction *>(OtherFunction.get());
+             MTSEF && &MTSEF->Problem == &Problem) {
+    Others = MTSEF->Transitions;
+  } else {
+    return std::make_shared<AllBottom<l_t>>(Problem.BOTTOM);
+  }
+  // Join the protocols separately, as conservatively as TSEdgeFunction does
+  auto Joined = Transitions;
+  for (size_t Desc = 0; Desc < Joined.size(); ++Desc) {
+    if (Joined[Desc] == Others[Desc] ||
+        Others[Desc] == Problem.TopConstants[Desc]) {
+      continue;
+    }
+    Joined[Desc] = Joined[Desc] == Problem.TopConstants[Desc]
+                       ? Others[Desc]
+                       : Problem.BottomConstants[Desc];
+  }
+  return Problem.getTransitionFunction(std::move(Joined));
+}
+
+bool IDEMultiTypeStateAnalysis::MultiTSEdgeFunction::equal_to(
+    std::shared_ptr<EdgeFunction<l_t>> Other) const {
+  // Transitions are interned
+  if (const auto *MTSEF = dynamic_cast<MultiTSEdgeFunction *>(Other.get())) {
+    return &MTSEF->Problem == &Problem && MTSEF->Transitions == Transitions;
+  }
+  return false;
+}
+
+void IDEMultiTypeStateAnalysis::MultiTSEdgeFunction::print(
+    llvm::raw_ostream &OS, bool /*IsForDebug*/) const {
+  OS << "MultiTSEF[";
+  for (size_t Desc = 0; Desc < Transitions.size(); ++Desc) {
+    if (Desc != 0) {
+      OS << "; ";
+    }
+    const auto &CTSD = *Problem.CTSDs[Desc];
+    const auto &TSD = CTSD.getDescription();
+    auto Table = CTSD.getTable(Transitions[Desc]);
+    for (size_t Idx = 0; Idx < Table.size(); ++Idx) {
+      if (Idx != 0) {
+        OS << ", ";
+      }
+      OS << TSD.stateToString(CTSD.getState(Idx)) << " -> "
+         << TSD.stateToString(CTSD.getState(Table[Idx]));
+    }
+  }
+  OS << "]";
+}
+
+void IDEMultiTypeStateAnalysis::emitTextReport(
+    const SolverResults<n_t, d_t, l_t> &SR, llvm::raw_ostream &OS) {
+  OS << "\n======= MULTI TYPE STATE RESULTS =======\n";
+  for (const auto &F : ICF->getAllFunctions()) {
+    OS << '\n' << getFunctionNameFromIR(F) << '\n';
+    for (const auto &BB : *F) {
+      for (const auto &I : BB) {
+        bool IsExit = ICF->isExitInst(&I);
+        for (const auto &Res : SR.resultsAt(&I, true)) {
+          if (!llvm::isa<llvm::AllocaInst>(Res.first)) {
+            continue;
+          }
+          for (size_t Desc = 0; Desc < CTSDs.size(); ++Desc) {
+            const auto &TSD = getDescription(Desc);
+            if (Res.second[Desc] == TSD.error()) {
+              OS << "\n=== ERROR STATE DETECTED ===\nProtocol: "
+                 << TSD.getTypeNameOfInterest()
+                 << "\nAlloca: " << DtoString(Res.first)
+                 << "\nAt IR Inst: " << NtoString(&I) << '\n';
+              for (const auto *Pred : ICF->getPredsOf(&I)) {
+                OS << "\nPredecessor: " << NtoString(Pred) << '\n';
+                for (const auto &PredRes : SR.resultsAt(Pred, true)) {
+                  if (PredRes.first == Res.first) {
+                    OS << "Pred State: " << LtoString(PredRes.second) << '\n';
+                  }
+                }
+              }
+              OS << "============================\n";
+            }
+          }
+          if (IsExit) {
+            OS << "\nAt exit stmt: " << NtoString(&I)
+               << "\nAlloca : " << DtoString(Res.first)
+               << "\nState  : " << LtoString(Res.second) << '\n';
+          }
+        }
+      }
+    }
+    OS << "\n--------------------------------------------\n";
+  }
+}
+
+} // namespace psr
@@ -194,12 +194,12 @@ bool IDEProtoAnalysis::IDEProtoAnalysisAllTop::equal_to(
 
 void IDEProtoAnalysis::printNode(llvm::raw_ostream &OS,
                                  IDEProtoAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IDEProtoAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                          IDEProtoAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IDEProtoAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -209,7 +209,7 @@ void IDEProtoAnalysis::printFunction(llvm::raw_ostream &OS,
 
 void IDEProtoAnalysis::printEdgeFact(llvm::raw_ostream &OS,
                                      IDEProtoAnalysis::l_t L) const {
-  OS << llvmIRToString(L);
+  OS << llvmIRToStringRef(L);
 }
 
 } // namespace psr
@@ -94,7 +94,7 @@ bool IDESecureHeapPropagation::isZeroValue(d_t Fact) const {
 
 void IDESecureHeapPropagation::printNode(llvm::raw_ostream &Os,
                                          n_t Stmt) const {
-  Os << llvmIRToString(Stmt);
+  Os << llvmIRToStringRef(Stmt);
 }
 
 void IDESecureHeapPropagation::printDataFlowFact(llvm::raw_ostream &Os,
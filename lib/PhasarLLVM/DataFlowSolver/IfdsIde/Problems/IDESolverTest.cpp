@@ -189,12 +189,12 @@ bool IDESolverTest::IDESolverTestAllTop::equal_to(
 
 void IDESolverTest::printNode(llvm::raw_ostream &OS,
                               IDESolverTest::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IDESolverTest::printDataFlowFact(llvm::raw_ostream &OS,
                                       IDESolverTest::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IDESolverTest::printFunction(llvm::raw_ostream &OS,
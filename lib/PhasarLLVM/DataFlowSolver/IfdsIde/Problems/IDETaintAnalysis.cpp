@@ -179,12 +179,12 @@ bool IDETaintAnalysis::IDETainAnalysisAllTop::equal_to(
 
 void IDETaintAnalysis::printNode(llvm::raw_ostream &OS,
                                  IDETaintAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IDETaintAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                          IDETaintAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IDETaintAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -194,7 +194,7 @@ void IDETaintAnalysis::printFunction(llvm::raw_ostream &OS,
 
 void IDETaintAnalysis::printEdgeFact(llvm::raw_ostream &OS,
                                      IDETaintAnalysis::l_t L) const {
-  OS << llvmIRToString(L);
+  OS << llvmIRToStringRef(L);
 }
 
 } // namespace psr
@@ -22,7 +22,6 @@
 #include "phasar/Utils/Logger.h"
 
 #include "llvm/ADT/DenseMap.h"
-#include "llvm/Demangle/Demangle.h"
 #include "llvm/IR/AbstractCallSite.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instruction.h"
@@ -45,7 +44,8 @@ IDETypeStateAnalysis::IDETypeStateAnalysis(const ProjectIRDB *IRDB,
                                            const TypeStateDescription &TSD,
                                            std::set<std::string> EntryPoints)
     : IDETabulationProblem(IRDB, TH, ICF, PT, std::move(EntryPoints)), TSD(TSD),
-      TOP(TSD.top()), BOTTOM(TSD.bottom()) {
+      TOP(TSD.top()), BOTTOM(TSD.bottom()), CTSD(TSD, *IRDB),
+      Flow(PT, {&CTSD}) {
   IDETabulationProblem::ZeroValue = IDETypeStateAnalysis::createZeroValue();
 }
 
@@ -54,250 +54,27 @@ IDETypeStateAnalysis::IDETypeStateAnalysis(const ProjectIRDB *IRDB,
 IDETypeStateAnalysis::FlowFunctionPtrType
 IDETypeStateAnalysis::getNormalFlowFunction(
     IDETypeStateAnalysis::n_t Curr, IDETypeStateAnalysis::n_t /*Succ*/) {
-  // Check if Alloca's type matches the target type. If so, generate from zero
-  // value.
-  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
-    if (hasMatchingType(Alloca)) {
-      return make_shared<Gen<IDETypeStateAnalysis::d_t>>(Alloca,
-                                                         getZeroValue());
-    }
-  }
-  // Check load instructions for target type. Generate from the loaded value and
-  // kill the load instruction if it was generated previously (strong update!).
-  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
-    if (hasMatchingType(Load)) {
-      struct TSFlowFunction : FlowFunction<IDETypeStateAnalysis::d_t> {
-        const llvm::LoadInst *Load;
-
-        TSFlowFunction(const llvm::LoadInst *L) : Load(L) {}
-        ~TSFlowFunction() override = default;
-        set<IDETypeStateAnalysis::d_t>
-        computeTargets(IDETypeStateAnalysis::d_t Source) override {
-          if (Source == Load) {
-            return {};
-          }
-          if (Source == Load->getPointerOperand()) {
-            return {Source, Load};
-          }
-          return {Source};
-        }
-      };
-      return make_shared<TSFlowFunction>(Load);
-    }
-  }
-  if (const auto *Gep = llvm::dyn_cast<llvm::GetElementPtrInst>(Curr)) {
-    if (hasMatchingType(Gep->getPointerOperand())) {
-      return makeLambdaFlow<d_t>([=](d_t Source) -> set<d_t> {
-        // if (Source == Gep->getPointerOperand()) {
-        //  return {Source, Gep};
-        //}
-        return {Source};
-      });
-    }
-  }
-  // Check store instructions for target type. Perform a strong update, i.e.
-  // kill the alloca pointed to by the pointer-operand and all alloca's related
-  // to the value-operand and then generate them from the value-operand.
-  if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Curr)) {
-    if (hasMatchingType(Store)) {
-      auto RelevantAliasesAndAllocas = getLocalAliasesAndAllocas(
-          Store->getPointerOperand(), // pointer- or value operand???
-          // Store->getValueOperand(),
-          Curr->getParent()->getParent()->getName().str());
-
-      struct TSFlowFunction : FlowFunction<IDETypeStateAnalysis::d_t> {
-        const llvm::StoreInst *Store;
-        std::set<IDETypeStateAnalysis::d_t> AliasesAndAllocas;
-        TSFlowFunction(const llvm::StoreInst *S,
-                       std::set<IDETypeStateAnalysis::d_t> AA)
-            : Store(S), AliasesAndAllocas(std::move(AA)) {}
-        ~TSFlowFunction() override = default;
-        set<IDETypeStateAnalysis::d_t>
-        computeTargets(IDETypeStateAnalysis::d_t Source) override {
-          // We kill all relevant loacal aliases and alloca's
-          if (Source != Store->getValueOperand() &&
-              // AliasesAndAllocas.find(Source) != AliasesAndAllocas.end()
-              // Is simple comparison sufficient?
-              Source == Store->getPointerOperand()) {
-            return {};
-          }
-          // Generate all local aliases and relevant alloca's from the stored
-          // value
-          if (Source == Store->getValueOperand()) {
-            AliasesAndAllocas.insert(Source);
-            return AliasesAndAllocas;
-          }
-          return {Source};
-        }
-      };
-      return make_shared<TSFlowFunction>(Store, RelevantAliasesAndAllocas);
-    }
-  }
-  return Identity<IDETypeStateAnalysis::d_t>::getInstance();
+  return Flow.getNormalFlowFunction(Curr);
 }
 
 IDETypeStateAnalysis::FlowFunctionPtrType
 IDETypeStateAnalysis::getCallFlowFunction(IDETypeStateAnalysis::n_t CallSite,
                                           IDETypeStateAnalysis::f_t DestFun) {
-  // Kill all data-flow facts if we hit a function of the target API.
-  // Those functions are modled within Call-To-Return.
-  if (TSD.isAPIFunction(llvm::demangle(DestFun->getName().str()))) {
-    return KillAll<IDETypeStateAnalysis::d_t>::getInstance();
-  }
-  // Otherwise, if we have an ordinary function call, we can just use the
-  // standard mapping.
-  if (llvm::isa<llvm::CallInst>(CallSite) ||
-      llvm::isa<llvm::InvokeInst>(CallSite)) {
-    return make_shared<MapFactsToCallee<>>(llvm::cast<llvm::CallBase>(CallSite),
-                                           DestFun);
-  }
-  llvm::report_fatal_error("callSite not a CallInst nor a InvokeInst");
+  return Flow.getCallFlowFunction(CallSite, DestFun);
 }
 
 IDETypeStateAnalysis::FlowFunctionPtrType
 IDETypeStateAnalysis::getRetFlowFunction(
     IDETypeStateAnalysis::n_t CallSite, IDETypeStateAnalysis::f_t CalleeFun,
     IDETypeStateAnalysis::n_t ExitStmt, IDETypeStateAnalysis::n_t /*RetSite*/) {
-  // Besides mapping the formal parameter back into the actual parameter and
-  // propagating the return value into the caller context, we also propagate
-  // all related alloca's of the formal parameter and the return value.
-  struct TSFlowFunction : FlowFunction<IDETypeStateAnalysis::d_t> {
-    const llvm::CallBase *CallSite;
-    const llvm::Function *CalleeFun;
-    const llvm::ReturnInst *ExitSite;
-    IDETypeStateAnalysis *Analysis;
-    std::vector<const llvm::Value *> Actuals;
-    std::vector<const llvm::Value *> Formals;
-    TSFlowFunction(const llvm::CallBase *CallSite,
-                   const llvm::Function *CalleeFun,
-                   const llvm::Instruction *ExitSite,
-                   IDETypeStateAnalysis *Analysis)
-        : CallSite(CallSite), CalleeFun(CalleeFun),
-          ExitSite(llvm::dyn_cast<llvm::ReturnInst>(ExitSite)),
-          Analysis(Analysis) {
-      // Set up the actual parameters
-      for (unsigned Idx = 0; Idx < CallSite->arg_size(); ++Idx) {
-        Actuals.push_back(CallSite->getArgOperand(Idx));
-      }
-      // Set up the formal parameters
-      for (unsigned Idx = 0; Idx < CalleeFun->arg_size(); ++Idx) {
-        Formals.push_back(getNthFunctionArgument(CalleeFun, Idx));
-      }
-    }
-
-    ~TSFlowFunction() override = default;
-
-    set<IDETypeStateAnalysis::d_t>
-    computeTargets(IDETypeStateAnalysis::d_t Source) override {
-      if (!LLVMZeroValue::isLLVMZeroValue(Source)) {
-        set<const llvm::Value *> Res;
-        // Handle C-style varargs functions
-        if (CalleeFun->isVarArg() && !CalleeFun->isDeclaration()) {
-          const llvm::Instruction *AllocVarArg;
-          // Find the allocation of %struct.__va_list_tag
-          for (const auto &BB : *CalleeFun) {
-            for (const auto &I : BB) {
-              if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
-                if (Alloc->getAllocatedType()->isArrayTy() &&
-                    Alloc->getAllocatedType()->getArrayNumElements() > 0 &&
-                    Alloc->getAllocatedType()
-                        ->getArrayElementType()
-                        ->isStructTy() &&
-                    Alloc->getAllocatedType()
-                            ->getArrayElementType()
-                            ->getStructName() == "struct.__va_list_tag") {
-                  AllocVarArg = Alloc;
-                  // TODO break out this nested loop earlier (without goto ;-)
-                }
-              }
-            }
-          }
-          // Generate the varargs things by using an over-approximation
-          if (Source == AllocVarArg) {
-            for (unsigned Idx = Formals.size(); Idx < Actuals.size(); ++Idx) {
-              Res.insert(Actuals[Idx]);
-            }
-          }
-        }
-        // Handle ordinary case
-        // Map formal parameter into corresponding actual parameter.
-        for (unsigned Idx = 0; Idx < Formals.size(); ++Idx) {
-          if (Source == Formals[Idx]) {
-            Res.insert(Actuals[Idx]); // corresponding actual
-          }
-        }
-        // Collect the return value
-        if (Source == ExitSite->getReturnValue()) {
-          Res.insert(CallSite);
-        }
-        // Collect all relevant alloca's to map into caller context
-        std::set<IDETypeStateAnalysis::d_t> RelAllocas;
-        for (const auto *Fact : Res) {
-          auto Allocas = Analysis->getRelevantAllocas(Fact);
-          RelAllocas.insert(Allocas.begin(), Allocas.end());
-        }
-        Res.insert(RelAllocas.begin(), RelAllocas.end());
-        return Res;
-      }
-      return {Source};
-    }
-  };
-  return make_shared<TSFlowFunction>(llvm::cast<llvm::CallBase>(CallSite),
-                                     CalleeFun, ExitStmt, this);
+  return Flow.getRetFlowFunction(CallSite, CalleeFun, ExitStmt);
 }
 
 IDETypeStateAnalysis::FlowFunctionPtrType
 IDETypeStateAnalysis::getCallToRetFlowFunction(
     IDETypeStateAnalysis::n_t CallSite, IDETypeStateAnalysis::n_t /*RetSite*/,
     llvm::ArrayRef<f_t> Callees) {
-  const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
-  for (const auto *Callee : Callees) {
-    std::string DemangledFname = llvm::demangle(Callee->getName().str());
-    // Generate the return value of factory functions from zero value
-    if (TSD.isFactoryFunction(DemangledFname)) {
-      struct TSFlowFunction : FlowFunction<IDETypeStateAnalysis::d_t> {
-        IDETypeStateAnalysis::d_t CS, ZeroValue;
-
-        TSFlowFunction(IDETypeStateAnalysis::d_t CS,
-                       IDETypeStateAnalysis::d_t Z)
-            : CS(CS), ZeroValue(Z) {}
-        ~TSFlowFunction() override = default;
-        set<IDETypeStateAnalysis::d_t>
-        computeTargets(IDETypeStateAnalysis::d_t Source) override {
-          if (Source == CS) {
-            return {};
-          }
-          if (Source == ZeroValue) {
-            return {Source, CS};
-          }
-          return {Source};
-        }
-      };
-      return make_shared<TSFlowFunction>(CS, getZeroValue());
-    }
-
-    // Handle all functions that are not modeld with special semantics.
-    // Kill actual parameters of target type and all its aliases
-    // and the corresponding alloca(s) as these data-flow facts are
-    // (inter-procedurally) propagated via Call- and the corresponding
-    // Return-Flow. Otherwise we might propagate facts with not updated
-    // states.
-    // Alloca's related to the return value of non-api functions will
-    // not be killed during call-to-return, since it is not safe to assume
-    // that the return value will be used afterwards, i.e. is stored to memory
-    // pointed to by related alloca's.
-    if (!TSD.isAPIFunction(DemangledFname) && !Callee->isDeclaration()) {
-      for (const auto &Arg : CS->args()) {
-        if (hasMatchingType(Arg)) {
-          std::set<IDETypeStateAnalysis::d_t> FactsToKill =
-              getWMAliasesAndAllocas(Arg.get());
-          return make_shared<KillMultiple<IDETypeStateAnalysis::d_t>>(
-              FactsToKill);
-        }
-      }
-    }
-  }
-  return Identity<IDETypeStateAnalysis::d_t>::getInstance();
+  return Flow.getCallToRetFlowFunction(CallSite, Callees);
 }
 
 IDETypeStateAnalysis::FlowFunctionPtrType
@@ -338,7 +115,7 @@ IDETypeStateAnalysis::getNormalEdgeFunction(
     IDETypeStateAnalysis::n_t /*Succ*/, IDETypeStateAnalysis::d_t SuccNode) {
   // Set alloca instructions of target type to uninitialized.
   if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
-    if (hasMatchingType(Alloca)) {
+    if (Flow.hasMatchingType(Alloca)) {
       if (CurrNode == getZeroValue() && SuccNode == Alloca) {
         struct TSAllocaEF : public TSConstant {
           const llvm::AllocaInst *Alloca;
@@ -348,7 +125,7 @@ IDETypeStateAnalysis::getNormalEdgeFunction(
 
           void print(llvm::raw_ostream &OS,
                      bool /*IsForDebug = false*/) const override {
-            OS << "Alloca(" << llvmIRToShortString(Alloca) << ")";
+            OS << "Alloca(" << llvmIRToShortStringRef(Alloca) << ")";
           }
         };
         return make_shared<TSAllocaEF>(TSD, Alloca);
@@ -385,11 +162,11 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
     IDETypeStateAnalysis::d_t RetSiteNode, llvm::ArrayRef<f_t> Callees) {
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (const auto *Callee : Callees) {
-    std::string DemangledFname = llvm::demangle(Callee->getName().str());
+    const auto &Info = CTSD.getFunctionInfo(Callee);
 
     // For now we assume that we can only generate from the return value.
     // We apply the same edge function for the return value, i.e. callsite.
-    if (TSD.isFactoryFunction(DemangledFname)) {
+    if (Info.IsFactory) {
       PHASAR_LOG_LEVEL(DEBUG, "Processing factory function");
       if (isZeroValue(CallNode) && RetSiteNode == CS) {
         struct TSFactoryEF : public TSConstant {
@@ -397,21 +174,21 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
               : TSConstant(Tsd, State) {}
         };
         return make_shared<TSFactoryEF>(
-            TSD, TSD.getNextState(DemangledFname, TSD.uninit(), CS));
+            TSD, CTSD.getNextState(CS, Callee, TSD.uninit()));
       }
     }
 
     // For every consuming parameter and all its aliases and relevant alloca's
     // we apply the same edge function.
-    if (TSD.isConsumingFunction(DemangledFname)) {
+    if (Info.IsConsuming) {
       PHASAR_LOG_LEVEL(DEBUG, "Processing consuming function");
-      for (auto Idx : TSD.getConsumerParamIdx(DemangledFname)) {
+      for (auto Idx : Info.ConsumerParamIdx) {
         std::set<IDETypeStateAnalysis::d_t> PointsToAndAllocas =
-            getWMAliasesAndAllocas(CS->getArgOperand(Idx));
+            Flow.getWMAliasesAndAllocas(CS->getArgOperand(Idx));
 
         if (CallNode == RetSiteNode &&
             PointsToAndAllocas.find(CallNode) != PointsToAndAllocas.end()) {
-          return make_shared<TSEdgeFunction>(TSD, DemangledFname, CS);
+          return getTransitionFunction(CTSD.getTransition(CS, Callee));
         }
       }
     }
@@ -455,12 +232,12 @@ IDETypeStateAnalysis::allTopFunction() {
 }
 
 void IDETypeStateAnalysis::printNode(llvm::raw_ostream &OS, n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IDETypeStateAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                              d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IDETypeStateAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -487,16 +264,62 @@ IDETypeStateAnalysis::TSEdgeFunctionComposer::joinWith(
   return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(BotElement);
 }
 
-IDETypeStateAnalysis::l_t IDETypeStateAnalysis::TSEdgeFunction::computeTarget(
-    IDETypeStateAnalysis::l_t Source) {
+void IDETypeStateAnalysis::TSEdgeFunctionComposer::normalize(
+    SequenceTy &Seq) {
+  SequenceTy Normalized;
+  Normalized.reserve(Seq.size());
+  for (auto EF : Seq) {
+    // Constants are evaluated right away and transitions followed by
+    // transitions are composed into a single transition
+    if (!Normalized.empty()) {
+      const auto *PrevTSEF =
+          dynamic_cast<TSEdgeFunction *>(Normalized.back().get());
+      const auto *TSEF = dynamic_cast<TSEdgeFunction *>(EF.get());
+      if (dynamic_cast<TSConstant *>(Normalized.back().get()) ||
+          (PrevTSEF && TSEF && PrevTSEF->composesWith(*TSEF))) {
+        EF = Normalized.back()->composeWith(EF);
+        Normalized.pop_back();
+      }
+    }
+    // Constant functions do not depend on the functions before them
+    if (dynamic_cast<TSConstant *>(EF.get()) ||
+        dynamic_cast<AllBottom<l_t> *>(EF.get()) ||
+        dynamic_cast<AllTop<l_t> *>(EF.get())) {
+      Normalized.clear();
+    }
+    Normalized.push_back(std::move(EF));
+  }
+  Seq = std::move(Normalized);
+}
 
-  // assert((Source != TSD.top()) && "Error: call computeTarget with TOP\n");
+shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
+IDETypeStateAnalysis::TSEdgeFunctionComposer::makeComposer(
+    shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> F,
+    shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> G) const {
+  return make_shared<TSEdgeFunctionComposer>(std::move(F), std::move(G),
+                                             BotElement);
+}
 
-  auto CurrentState = TSD.getNextState(
-      Token, Source == TSD.top() ? TSD.uninit() : Source, CallSite);
+shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
+IDETypeStateAnalysis::getTransitionFunction(
+    CompiledTypeStateDescription::TransitionId T) {
+  if (T >= TransitionFunctions.size()) {
+    TransitionFunctions.resize(T + 1);
+  }
+  auto &EF = TransitionFunctions[T];
+  if (!EF) {
+    EF = make_shared<TSEdgeFunction>(*this, T);
+  }
+  return EF;
+}
+
+IDETypeStateAnalysis::l_t IDETypeStateAnalysis::TSEdgeFunction::computeTarget(
+    IDETypeStateAnalysis::l_t Source) {
+  auto CurrentState = Problem.CTSD.apply(Transition, Source);
   PHASAR_LOG_LEVEL(DEBUG, "State machine transition: ("
-                              << Token << " , " << TSD.stateToString(Source)
-                              << ") -> " << TSD.stateToString(CurrentState));
+                              << Transition << " , "
+                              << Problem.TSD.stateToString(Source) << ") -> "
+                              << Problem.TSD.stateToString(CurrentState));
   return CurrentState;
 }
 
@@ -512,8 +335,19 @@ IDETypeStateAnalysis::TSEdgeFunction::composeWith(
           SecondFunction.get())) {
     return this->shared_from_this();
   }
+  if (auto *TSEF = dynamic_cast<TSEdgeFunction *>(SecondFunction.get());
+      TSEF && &TSEF->Problem == &Problem) {
+    return Problem.getTransitionFunction(
+        Problem.CTSD.compose(Transition, TSEF->Transition));
+  }
+  // Constant functions ignore the state that this transition yields
+  if (dynamic_cast<TSConstant *>(SecondFunction.get()) ||
+      dynamic_cast<AllTop<IDETypeStateAnalysis::l_t> *>(
+          SecondFunction.get())) {
+    return SecondFunction;
+  }
   return make_shared<TSEdgeFunctionComposer>(this->shared_from_this(),
-                                             SecondFunction, TSD.bottom());
+                                             SecondFunction, Problem.BOTTOM);
 }
 
 std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
@@ -523,29 +357,35 @@ IDETypeStateAnalysis::TSEdgeFunction::joinWith(
       OtherFunction->equal_to(this->shared_from_this())) {
     return this->shared_from_this();
   }
-  // if (auto *EI = dynamic_cast<EdgeIdentity<IDETypeStateAnalysis::l_t> *>(
-  //         otherFunction.get())) {
-  //   return this->shared_from_this();
-  // }
   if (auto *AT = dynamic_cast<AllTop<IDETypeStateAnalysis::l_t> *>(
           OtherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(TSD.bottom());
+  return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(Problem.BOTTOM);
 }
 
 bool IDETypeStateAnalysis::TSEdgeFunction::equal_to(
     std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> Other) const {
-  /*if (auto *TSEF =
-          dynamic_cast<IDETypeStateAnalysis::TSEdgeFunction *>(Other.get())) {
-    return this->CurrentState == TSEF->CurrentState;
-  }*/
-  return this == Other.get();
+  // Transitions are interned
+  if (const auto *TSEF = dynamic_cast<TSEdgeFunction *>(Other.get())) {
+    return &TSEF->Problem == &Problem && TSEF->Transition == Transition;
+  }
+  return false;
 }
 
 void IDETypeStateAnalysis::TSEdgeFunction::print(llvm::raw_ostream &OS,
                                                  bool /*IsForDebug*/) const {
-  OS << "TSEF(" << Token << " at " << llvmIRToShortString(CallSite) << ")";
+  const auto &CTSD = Problem.CTSD;
+  OS << "TSEF[";
+  auto Table = CTSD.getTable(Transition);
+  for (size_t Idx = 0; Idx < Table.size(); ++Idx) {
+    if (Idx != 0) {
+      OS << ", ";
+    }
+    OS << Problem.TSD.stateToString(CTSD.getState(Idx)) << " -> "
+       << Problem.TSD.stateToString(CTSD.getState(Table[Idx]));
+  }
+  OS << "]";
 }
 
 IDETypeStateAnalysis::TSConstant::TSConstant(const TypeStateDescription &TSD,
@@ -611,150 +451,6 @@ void IDETypeStateAnalysis::TSConstant::print(llvm::raw_ostream &OS,
   OS << "TSConstant[" << TSD.stateToString(State) << "]";
 }
 
-std::set<IDETypeStateAnalysis::d_t>
-IDETypeStateAnalysis::getRelevantAllocas(IDETypeStateAnalysis::d_t V) {
-  if (RelevantAllocaCache.find(V) != RelevantAllocaCache.end()) {
-    return RelevantAllocaCache[V];
-  }
-  auto PointsToSet = getWMPointsToSet(V);
-  std::set<IDETypeStateAnalysis::d_t> RelevantAllocas;
-  PHASAR_LOG_LEVEL(DEBUG, "Compute relevant alloca's of "
-                              << IDETypeStateAnalysis::DtoString(V));
-  for (const auto *Alias : PointsToSet) {
-    PHASAR_LOG_LEVEL(DEBUG,
-                     "Alias: " << IDETypeStateAnalysis::DtoString(Alias));
-    // Collect the pointer operand of a aliased load instruciton
-    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Alias)) {
-      if (hasMatchingType(Alias)) {
-        PHASAR_LOG_LEVEL(DEBUG,
-                         " -> Alloca: " << IDETypeStateAnalysis::DtoString(
-                             Load->getPointerOperand()));
-        RelevantAllocas.insert(Load->getPointerOperand());
-      }
-    } else {
-      // For all other types of aliases, e.g. callsites, function arguments,
-      // we check store instructions where thoses aliases are value operands.
-      for (const auto *User : Alias->users()) {
-        PHASAR_LOG_LEVEL(DEBUG,
-                         "  User: " << IDETypeStateAnalysis::DtoString(User));
-        if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(User)) {
-          if (hasMatchingType(Store)) {
-            PHASAR_LOG_LEVEL(
-                DEBUG, "    -> Alloca: " << IDETypeStateAnalysis::DtoString(
-                           Store->getPointerOperand()));
-            RelevantAllocas.insert(Store->getPointerOperand());
-          }
-        }
-      }
-    }
-  }
-  for (const auto *Alias : PointsToSet) {
-    RelevantAllocaCache[Alias] = RelevantAllocas;
-  }
-  return RelevantAllocas;
-}
-
-std::set<IDETypeStateAnalysis::d_t>
-IDETypeStateAnalysis::getWMPointsToSet(IDETypeStateAnalysis::d_t V) {
-  if (PointsToCache.find(V) != PointsToCache.end()) {
-    std::set<IDETypeStateAnalysis::d_t> PointsToSet(PointsToCache[V].begin(),
-                                                    PointsToCache[V].end());
-    return PointsToSet;
-  }
-  auto PTS = PT->getPointsToSet(V);
-  for (const auto *Alias : *PTS) {
-    if (hasMatchingType(Alias)) {
-      PointsToCache[Alias] = *PTS;
-    }
-  }
-  std::set<IDETypeStateAnalysis::d_t> PointsToSet(PTS->begin(), PTS->end());
-  return PointsToSet;
-}
-
-std::set<IDETypeStateAnalysis::d_t>
-IDETypeStateAnalysis::getWMAliasesAndAllocas(IDETypeStateAnalysis::d_t V) {
-  std::set<IDETypeStateAnalysis::d_t> PointsToAndAllocas;
-  std::set<IDETypeStateAnalysis::d_t> RelevantAllocas = getRelevantAllocas(V);
-  std::set<IDETypeStateAnalysis::d_t> Aliases = getWMPointsToSet(V);
-  PointsToAndAllocas.insert(Aliases.begin(), Aliases.end());
-  PointsToAndAllocas.insert(RelevantAllocas.begin(), RelevantAllocas.end());
-  return PointsToAndAllocas;
-}
-
-std::set<IDETypeStateAnalysis::d_t>
-IDETypeStateAnalysis::getLocalAliasesAndAllocas(IDETypeStateAnalysis::d_t V,
-                                                const std::string & /*Fname*/) {
-  std::set<IDETypeStateAnalysis::d_t> PointsToAndAllocas;
-  std::set<IDETypeStateAnalysis::d_t> RelevantAllocas = getRelevantAllocas(V);
-  std::set<IDETypeStateAnalysis::d_t>
-      Aliases; // =
-               // IRDB->getPointsToGraph(Fname)->getPointsToSet(V);
-  for (const auto *Alias : Aliases) {
-    if (hasMatchingType(Alias)) {
-      PointsToAndAllocas.insert(Alias);
-    }
-  }
-  // PointsToAndAllocas.insert(Aliases.begin(), Aliases.end());
-  PointsToAndAllocas.insert(RelevantAllocas.begin(), RelevantAllocas.end());
-  return PointsToAndAllocas;
-}
-bool hasMatchingTypeName(const llvm::Type *Ty, const std::string &Pattern) {
-  if (const auto *StructTy = llvm::dyn_cast<llvm::StructType>(Ty)) {
-    return StructTy->getName().contains(Pattern);
-  }
-  // primitive type
-  std::string Str;
-  llvm::raw_string_ostream S(Str);
-  S << *Ty;
-  S.flush();
-  return Str.find(Pattern) != std::string::npos;
-}
-bool IDETypeStateAnalysis::hasMatchingType(IDETypeStateAnalysis::d_t V) {
-  // General case
-  if (V->getType()->isPointerTy()) {
-    if (hasMatchingTypeName(V->getType()->getPointerElementType(),
-                            TSD.getTypeNameOfInterest())) {
-      return true;
-    }
-  }
-  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(V)) {
-    if (Alloca->getAllocatedType()->isPointerTy()) {
-      if (hasMatchingTypeName(
-              Alloca->getAllocatedType()->getPointerElementType(),
-              TSD.getTypeNameOfInterest())) {
-        return true;
-      }
-    }
-    return false;
-  }
-  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(V)) {
-    if (Load->getPointerOperand()
-            ->getType()
-            ->getPointerElementType()
-            ->isPointerTy()) {
-      if (hasMatchingTypeName(Load->getPointerOperand()
-                                  ->getType()
-                                  ->getPointerElementType()
-                                  ->getPointerElementType(),
-                              TSD.getTypeNameOfInterest())) {
-        return true;
-      }
-    }
-    return false;
-  }
-  if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(V)) {
-    if (Store->getValueOperand()->getType()->isPointerTy()) {
-      if (hasMatchingTypeName(
-              Store->getValueOperand()->getType()->getPointerElementType(),
-              TSD.getTypeNameOfInterest())) {
-        return true;
-      }
-    }
-    return false;
-  }
-  return false;
-}
-
 void IDETypeStateAnalysis::emitTextReport(
     const SolverResults<IDETypeStateAnalysis::n_t, IDETypeStateAnalysis::d_t,
                         IDETypeStateAnalysis::l_t> &SR,
@@ -200,12 +200,12 @@ bool IFDSConstAnalysis::isZeroValue(IFDSConstAnalysis::d_t Fact) const {
 
 void IFDSConstAnalysis::printNode(llvm::raw_ostream &OS,
                                   IFDSConstAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSConstAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                           IFDSConstAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IFDSConstAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -317,7 +317,7 @@ void IFDSConstAnalysis::emitTextReport(
   } else {
     OS << "Immutable/const stack and/or heap memory locations:\n";
     for (const auto *Memloc : AllMemLocs) {
-      OS << "\nIR  : " << llvmIRToString(Memloc) << '\n';
+      OS << "\nIR  : " << llvmIRToStringRef(Memloc) << '\n';
     }
   }
   OS << "\n===================================================\n";
@@ -2,6 +2,7 @@
  * @author Sebastian Roland <seroland86@gmail.com>
  */
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
@@ -236,6 +237,21 @@ IFDSFieldSensTaintAnalysis::initialSeeds() {
   return Seeds;
 }
 
+ExtendedValue IFDSFieldSensTaintAnalysis::coarsenFact(ExtendedValue Fact,
+                                                      unsigned Level) {
+  // Memory locations are matched by their common prefix, so a shorter
+  // sequence taints all locations that share it.
+  auto MemLocationSeq = Fact.getMemLocationSeq();
+  if (MemLocationSeq.size() <= 1) {
+    return Fact;
+  }
+  MemLocationSeq.resize(
+      MemLocationSeq.size() -
+      std::min<std::size_t>(Level, MemLocationSeq.size() - 1));
+  Fact.setMemLocationSeq(MemLocationSeq);
+  return Fact;
+}
+
 void IFDSFieldSensTaintAnalysis::emitTextReport(
     const SolverResults<const llvm::Instruction *, ExtendedValue, BinaryDomain>
         & /*SolverResults*/,
@@ -121,7 +121,7 @@ bool IFDSLinearConstantAnalysis::isZeroValue(
 
 void IFDSLinearConstantAnalysis::printNode(
     llvm::raw_ostream &OS, IFDSLinearConstantAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSLinearConstantAnalysis::printDataFlowFact(
@@ -96,12 +96,12 @@ bool IFDSProtoAnalysis::isZeroValue(IFDSProtoAnalysis::d_t Fact) const {
 
 void IFDSProtoAnalysis::printNode(llvm::raw_ostream &OS,
                                   IFDSProtoAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSProtoAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                           IFDSProtoAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IFDSProtoAnalysis::printFunction(llvm::raw_ostream &OS,
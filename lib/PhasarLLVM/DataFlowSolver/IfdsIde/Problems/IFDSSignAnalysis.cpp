@@ -88,12 +88,12 @@ bool IFDSSignAnalysis::isZeroValue(IFDSSignAnalysis::d_t Fact) const {
 
 void IFDSSignAnalysis::printNode(llvm::raw_ostream &OS,
                                  IFDSSignAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSSignAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                          IFDSSignAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IFDSSignAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -90,12 +90,12 @@ bool IFDSSolverTest::isZeroValue(IFDSSolverTest::d_t Fact) const {
 
 void IFDSSolverTest::printNode(llvm::raw_ostream &OS,
                                IFDSSolverTest::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSSolverTest::printDataFlowFact(llvm::raw_ostream &OS,
                                        IFDSSolverTest::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IFDSSolverTest::printFunction(llvm::raw_ostream &OS,
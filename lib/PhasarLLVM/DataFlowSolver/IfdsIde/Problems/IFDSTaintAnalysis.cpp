@@ -44,12 +44,20 @@ IFDSTaintAnalysis::IFDSTaintAnalysis(const ProjectIRDB *IRDB,
   IFDSTaintAnalysis::ZeroValue = IFDSTaintAnalysis::createZeroValue();
 }
 
+FunctionClass
+IFDSTaintAnalysis::getTaintRole(const llvm::Function *Callee) const {
+  if (ICF && ICF->hasTaintRolesOf(Config)) {
+    if (const auto *Attrs = ICF->getFunctionClassification()->lookup(Callee)) {
+      return Attrs->Classes & FunctionClass::AnyTaintRole;
+    }
+  }
+  return Config.getTaintRole(Callee);
+}
+
 bool IFDSTaintAnalysis::isSourceCall(const llvm::CallBase *CB,
                                      const llvm::Function *Callee) const {
-  for (const auto &Arg : Callee->args()) {
-    if (Config.isSource(&Arg)) {
-      return true;
-    }
+  if (bool(getTaintRole(Callee) & FunctionClass::TaintSource)) {
+    return true;
   }
   auto Callback = Config.getRegisteredSourceCallBack();
   if (!Callback) {
@@ -74,10 +82,8 @@ bool IFDSTaintAnalysis::isSourceCall(const llvm::CallBase *CB,
 
 bool IFDSTaintAnalysis::isSinkCall(const llvm::CallBase *CB,
                                    const llvm::Function *Callee) const {
-  for (const auto &Arg : Callee->args()) {
-    if (Config.isSink(&Arg)) {
-      return true;
-    }
+  if (bool(getTaintRole(Callee) & FunctionClass::TaintSink)) {
+    return true;
   }
   auto Callback = Config.getRegisteredSinkCallBack();
   if (!Callback) {
@@ -102,9 +108,7 @@ bool IFDSTaintAnalysis::isSinkCall(const llvm::CallBase *CB,
 
 bool IFDSTaintAnalysis::isSanitizerCall(const llvm::CallBase * /*CB*/,
                                         const llvm::Function *Callee) const {
-  return std::any_of(
-      Callee->arg_begin(), Callee->arg_end(),
-      [this](const auto &Arg) { return Config.isSanitizer(&Arg); });
+  return bool(getTaintRole(Callee) & FunctionClass::TaintSanitizer);
 }
 
 void IFDSTaintAnalysis::populateWithMayAliases(std::set<d_t> &Facts) const {
@@ -210,7 +214,9 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
     }
     collectGeneratedFacts(Gen, Config, CS, Callee);
     collectLeakedFacts(Leak, Config, CS, Callee);
-    collectSanitizedFacts(Kill, Config, CS, Callee);
+    if (isSanitizerCall(CS, Callee)) {
+      collectSanitizedFacts(Kill, Config, CS, Callee);
+    }
   }
 
   if (HasBody && Gen.empty() && Leak.empty() && Kill.empty()) {
@@ -322,12 +328,12 @@ bool IFDSTaintAnalysis::isZeroValue(IFDSTaintAnalysis::d_t FlowFact) const {
 
 void IFDSTaintAnalysis::printNode(llvm::raw_ostream &Os,
                                   IFDSTaintAnalysis::n_t Inst) const {
-  Os << llvmIRToString(Inst);
+  Os << llvmIRToStringRef(Inst);
 }
 
 void IFDSTaintAnalysis::printDataFlowFact(
     llvm::raw_ostream &Os, IFDSTaintAnalysis::d_t FlowFact) const {
-  Os << llvmIRToString(FlowFact);
+  Os << llvmIRToStringRef(FlowFact);
 }
 
 void IFDSTaintAnalysis::printFunction(llvm::raw_ostream &Os,
@@ -343,15 +349,15 @@ void IFDSTaintAnalysis::emitTextReport(
     OS << "No leaks found!\n";
   } else {
     for (const auto &Leak : Leaks) {
-      OS << "At instruction\nIR  : " << llvmIRToString(Leak.first) << '\n';
+      OS << "At instruction\nIR  : " << llvmIRToStringRef(Leak.first) << '\n';
       OS << "\n\nLeak(s):\n";
       for (const auto *LeakedValue : Leak.second) {
         OS << "IR  : ";
         // Get the actual leaked alloca instruction if possible
         if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(LeakedValue)) {
-          OS << llvmIRToString(Load->getPointerOperand()) << '\n';
+          OS << llvmIRToStringRef(Load->getPointerOperand()) << '\n';
         } else {
-          OS << llvmIRToString(LeakedValue) << '\n';
+          OS << llvmIRToStringRef(LeakedValue) << '\n';
         }
       }
       OS << "-------------------\n";
@@ -111,12 +111,12 @@ bool IFDSTypeAnalysis::isZeroValue(IFDSTypeAnalysis::d_t Fact) const {
 
 void IFDSTypeAnalysis::printNode(llvm::raw_ostream &OS,
                                  IFDSTypeAnalysis::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSTypeAnalysis::printDataFlowFact(llvm::raw_ostream &OS,
                                          IFDSTypeAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IFDSTypeAnalysis::printFunction(llvm::raw_ostream &OS,
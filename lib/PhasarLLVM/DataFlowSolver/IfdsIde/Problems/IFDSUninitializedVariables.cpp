@@ -9,8 +9,12 @@
 
 #include <utility>
 
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/IR/AbstractCallSite.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
@@ -404,8 +408,13 @@ IFDSUninitializedVariables::initialSeeds() {
                IFDSUninitializedVariables::l_t>
       Seeds;
   for (const auto &EntryPoint : EntryPoints) {
-    Seeds.addSeed(&ICF->getFunction(EntryPoint)->front().front(),
-                  getZeroValue());
+    const auto *F = ICF->getFunction(EntryPoint);
+    if (!F || F->isDeclaration()) {
+      llvm::errs() << "WARNING: Entry-Function \"" << EntryPoint
+                   << "\" not contained in the module; skip it\n";
+      continue;
+    }
+    Seeds.addSeed(&F->front().front(), getZeroValue());
   }
   return Seeds;
 }
@@ -424,12 +433,12 @@ bool IFDSUninitializedVariables::isZeroValue(
 
 void IFDSUninitializedVariables::printNode(
     llvm::raw_ostream &OS, IFDSUninitializedVariables::n_t Stmt) const {
-  OS << llvmIRToString(Stmt);
+  OS << llvmIRToStringRef(Stmt);
 }
 
 void IFDSUninitializedVariables::printDataFlowFact(
     llvm::raw_ostream &OS, IFDSUninitializedVariables::d_t Fact) const {
-  OS << llvmIRToShortString(Fact);
+  OS << llvmIRToShortStringRef(Fact);
 }
 
 void IFDSUninitializedVariables::printFunction(
@@ -541,9 +550,9 @@ void IFDSUninitializedVariables::UninitResult::print(llvm::raw_ostream &OS) {
   OS << "\nCorresponding IR Statements and uninit. Values\n";
   if (!IRTrace.empty()) {
     for (const auto &Trace : IRTrace) {
-      OS << "At IR Statement: " << llvmIRToString(Trace.first) << '\n';
+      OS << "At IR Statement: " << llvmIRToStringRef(Trace.first) << '\n';
       for (const auto *IRVal : Trace.second) {
-        OS << "   Uninit Value: " << llvmIRToString(IRVal) << '\n';
+        OS << "   Uninit Value: " << llvmIRToStringRef(IRVal) << '\n';
       }
       // os << '\n';
     }
@@ -556,4 +565,405 @@ IFDSUninitializedVariables::getAllUndefUses() const {
   return UndefValueUses;
 }
 
+namespace {
+
+/// Implements IFDSUninitializedVariables::solveWithBitVectors().
+///
+/// The flow functions of IFDSUninitializedVariables are distributive, so the
+/// facts that hold at an instruction are the union of the facts that any
+/// single fact at the function's entry leads to. The analysis therefore
+/// propagates sets of facts through each function, where the facts that may
+/// hold in a function are numbered, and summarizes each callee once per fact
+/// at its entry.
+class UninitBitVectorAnalysis {
+public:
+  using n_t = IFDSUninitializedVariables::n_t;
+  using d_t = IFDSUninitializedVariables::d_t;
+  using f_t = IFDSUninitializedVariables::f_t;
+
+  UninitBitVectorAnalysis(const LLVMBasedICFG &ICF, d_t ZeroValue)
+      : ICF(ICF), ZeroValue(ZeroValue) {}
+
+  void solve(llvm::ArrayRef<f_t> EntryPoints,
+             std::map<n_t, std::set<d_t>> &UndefValueUses);
+
+private:
+  /// The facts that may hold in a function: the zero value has index 0, the
+  /// formal parameters follow, then the instructions and their operands.
+  struct FunctionInfo {
+    std::vector<d_t> Facts;
+    llvm::DenseMap<d_t, unsigned> FactIndex;
+    std::vector<n_t> Insts;
+    llvm::DenseMap<n_t, unsigned> InstIndex;
+
+    [[nodiscard]] unsigned indexOf(d_t Fact) const {
+      auto It = FactIndex.find(Fact);
+      assert(It != FactIndex.end() && "Fact does not belong to the function");
+      return It->second;
+    }
+  };
+
+  /// The facts that are returned to the caller, if a single fact holds at the
+  /// entry of a function
+  struct Summary {
+    bool ReturnsUninit = false;
+    /// The formal parameters that are uninitialized at a return
+    llvm::BitVector Formals;
+
+    bool operator==(const Summary &Other) const {
+      return ReturnsUninit == Other.ReturnsUninit && Formals == Other.Formals;
+    }
+    bool operator!=(const Summary &Other) const { return !(*this == Other); }
+  };
+
+  /// A function together with the index of a fact at its entry
+  using EntryFact = std::pair<f_t, unsigned>;
+  using CalleeSummaryFn = llvm::function_ref<const Summary &(f_t, unsigned)>;
+
+  const FunctionInfo &getInfo(f_t F);
+  const Summary &getSummary(f_t F, unsigned Fact);
+
+  std::vector<llvm::BitVector> propagate(const FunctionInfo &FI, n_t Start,
+                                         const llvm::BitVector &Entry,
+                                         CalleeSummaryFn CalleeSummary);
+  static void applyNormalFlow(const FunctionInfo &FI, n_t Inst,
+                              const llvm::BitVector &In, llvm::BitVector &Out);
+  void applyCallFlow(const FunctionInfo &FI, const llvm::CallBase *CS,
+                     const llvm::BitVector &In, llvm::BitVector &Out,
+                     CalleeSummaryFn CalleeSummary);
+  [[nodiscard]] static Summary
+  summarize(f_t F, const FunctionInfo &FI,
+            const std::vector<llvm::BitVector> &In);
+  void recordUndefUses(const FunctionInfo &FI,
+                       const std::vector<llvm::BitVector> &In,
+                       std::map<n_t, std::set<d_t>> &UndefValueUses) const;
+
+  const LLVMBasedICFG &ICF;
+  d_t ZeroValue;
+  std::map<f_t, FunctionInfo> Infos;
+  std::map<EntryFact, Summary> Summaries;
+  /// The summaries that have been computed using the summary of a callee
+  std::map<EntryFact, std::set<EntryFact>> Dependents;
+};
+
+auto UninitBitVectorAnalysis::getInfo(f_t F) -> const FunctionInfo & {
+  auto [It, Inserted] = Infos.try_emplace(F);
+  auto &FI = It->second;
+  if (!Inserted) {
+    return FI;
+  }
+  auto AddFact = [&FI](d_t Fact) {
+    if (FI.FactIndex.try_emplace(Fact, FI.Facts.size()).second) {
+      FI.Facts.push_back(Fact);
+    }
+  };
+  AddFact(ZeroValue);
+  for (const auto &Arg : F->args()) {
+    AddFact(&Arg);
+  }
+  for (const auto &Inst : llvm::instructions(F)) {
+    FI.InstIndex[&Inst] = FI.Insts.size();
+    FI.Insts.push_back(&Inst);
+    AddFact(&Inst);
+  }
+  for (const auto *Inst : FI.Insts) {
+    for (const auto &Op : Inst->operands()) {
+      AddFact(Op);
+    }
+  }
+  return FI;
+}
+
+auto UninitBitVectorAnalysis::getSummary(f_t F, unsigned Fact)
+    -> const Summary & {
+  auto [RootIt, Inserted] = Summaries.try_emplace(EntryFact{F, Fact});
+  if (!Inserted) {
+    return RootIt->second;
+  }
+  RootIt->second.Formals.resize(F->arg_size());
+
+  std::vector<EntryFact> WorkList = {RootIt->first};
+  while (!WorkList.empty()) {
+    auto Curr = WorkList.back();
+    WorkList.pop_back();
+
+    const auto &FI = getInfo(Curr.first);
+    llvm::BitVector Entry(FI.Facts.size());
+    Entry.set(Curr.second);
+    auto In = propagate(
+        FI, &Curr.first->front().front(), Entry,
+        [&](f_t Callee, unsigned CalleeFact) -> const Summary & {
+          EntryFact Dep{Callee, CalleeFact};
+          auto [It, Inserted] = Summaries.try_emplace(Dep);
+          if (Inserted) {
+            It->second.Formals.resize(Callee->arg_size());
+            WorkList.push_back(Dep);
+          }
+          Dependents[Dep].insert(Curr);
+          return It->second;
+        });
+
+    auto NewSummary = summarize(Curr.first, FI, In);
+    auto &OldSummary = Summaries[Curr];
+    if (NewSummary != OldSummary) {
+      OldSummary = std::move(NewSummary);
+      const auto &Deps = Dependents[Curr];
+      WorkList.insert(WorkList.end(), Deps.begin(), Deps.end());
+    }
+  }
+  return RootIt->second;
+}
+
+std::vector<llvm::BitVector>
+UninitBitVectorAnalysis::propagate(const FunctionInfo &FI, n_t Start,
+                                   const llvm::BitVector &Entry,
+                                   CalleeSummaryFn CalleeSummary) {
+  std::vector<llvm::BitVector> In(FI.Insts.size(),
+                                  llvm::BitVector(FI.Facts.size()));
+  llvm::BitVector InWorkList(FI.Insts.size());
+  std::vector<unsigned> WorkList;
+
+  auto StartIdx = FI.InstIndex.lookup(Start);
+  In[StartIdx] = Entry;
+  WorkList.push_back(StartIdx);
+  InWorkList.set(StartIdx);
+
+  llvm::BitVector Out;
+  while (!WorkList.empty()) {
+    auto Idx = WorkList.back();
+    WorkList.pop_back();
+    InWorkList.reset(Idx);
+
+    const auto *Inst = FI.Insts[Idx];
+    auto Succs = ICF.getSuccsOf(Inst);
+    if (Succs.empty()) {
+      continue;
+    }
+    Out = In[Idx];
+    if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(Inst)) {
+      applyCallFlow(FI, CS, In[Idx], Out, CalleeSummary);
+    } else {
+      applyNormalFlow(FI, Inst, In[Idx], Out);
+    }
+
+    for (const auto *Succ : Succs) {
+      auto SuccIdx = FI.InstIndex.lookup(Succ);
+      if (!Out.test(In[SuccIdx])) {
+        continue;
+      }
+      In[SuccIdx] |= Out;
+      if (!InWorkList.test(SuccIdx)) {
+        InWorkList.set(SuccIdx);
+        WorkList.push_back(SuccIdx);
+      }
+    }
+  }
+  return In;
+}
+
+void UninitBitVectorAnalysis::applyNormalFlow(const FunctionInfo &FI,
+                                              n_t Inst,
+                                              const llvm::BitVector &In,
+                                              llvm::BitVector &Out) {
+  if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Inst)) {
+    const auto *ValueOp = Store->getValueOperand();
+    auto PointerIdx = FI.indexOf(Store->getPointerOperand());
+    // storing an initialized value initializes the variable
+    if (Store->getPointerOperand() != ValueOp) {
+      Out.reset(PointerIdx);
+    }
+    if (In.test(FI.indexOf(ValueOp)) ||
+        (In.test(0) && llvm::isa<llvm::UndefValue>(ValueOp))) {
+      Out.set(PointerIdx);
+    }
+    return;
+  }
+  if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(Inst)) {
+    const auto *Ty = Alloc->getAllocatedType();
+    if (In.test(0) && (Ty->isIntegerTy() || Ty->isFloatingPointTy() ||
+                       Ty->isPointerTy() || Ty->isArrayTy())) {
+      Out.set(FI.indexOf(Alloc));
+    }
+    return;
+  }
+  // an undef operand is used, whatever fact holds
+  for (const auto &Op : Inst->operands()) {
+    if (llvm::isa<llvm::UndefValue>(Op) ? In.any()
+                                        : In.test(FI.indexOf(Op))) {
+      Out.set(FI.indexOf(Inst));
+      return;
+    }
+  }
+}
+
+void UninitBitVectorAnalysis::applyCallFlow(const FunctionInfo &FI,
+                                            const llvm::CallBase *CS,
+                                            const llvm::BitVector &In,
+                                            llvm::BitVector &Out,
+                                            CalleeSummaryFn CalleeSummary) {
+  // the callee may initialize the pointer arguments
+  for (const auto &Arg : CS->args()) {
+    if (Arg->getType()->isPointerTy()) {
+      Out.reset(FI.indexOf(Arg));
+    }
+  }
+
+  for (const auto *Callee : ICF.getCalleesOfCallAt(CS)) {
+    if (Callee->isDeclaration()) {
+      continue;
+    }
+    llvm::SmallVector<unsigned, 4> EntryFacts;
+    if (In.test(0)) {
+      EntryFacts.push_back(0);
+    }
+    // like getCallFlowFunction(), only map arguments to formals for calls
+    // and invokes
+    if (llvm::isa<llvm::CallInst>(CS) || llvm::isa<llvm::InvokeInst>(CS)) {
+      auto NumArgs = std::min<size_t>(Callee->arg_size(), CS->arg_size());
+      for (unsigned Idx = 0; Idx < NumArgs; ++Idx) {
+        if (In.test(FI.indexOf(CS->getArgOperand(Idx)))) {
+          EntryFacts.push_back(Idx + 1);
+        }
+      }
+    }
+
+    for (auto Fact : EntryFacts) {
+      const auto &Sum = CalleeSummary(Callee, Fact);
+      if (Sum.ReturnsUninit) {
+        Out.set(FI.indexOf(CS));
+      }
+      if (CS->getCalledFunction() != Callee) {
+        continue;
+      }
+      for (auto ArgNo : Sum.Formals.set_bits()) {
+        if (ArgNo < CS->arg_size() &&
+            Callee->getArg(ArgNo)->getType()->isPointerTy()) {
+          Out.set(FI.indexOf(CS->getArgOperand(ArgNo)));
+        }
+      }
+    }
+  }
+}
+
+auto UninitBitVectorAnalysis::summarize(f_t F, const FunctionInfo &FI,
+                                        const std::vector<llvm::BitVector> &In)
+    -> Summary {
+  Summary Sum;
+  Sum.Formals.resize(F->arg_size());
+  for (unsigned Idx = 0; Idx < FI.Insts.size(); ++Idx) {
+    const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(FI.Insts[Idx]);
+    if (!Ret) {
+      continue;
+    }
+    if (Ret->getNumOperands() > 0 &&
+        In[Idx].test(FI.indexOf(Ret->getOperand(0)))) {
+      Sum.ReturnsUninit = true;
+    }
+    for (unsigned ArgNo = 0; ArgNo < F->arg_size(); ++ArgNo) {
+      if (In[Idx].test(ArgNo + 1)) {
+        Sum.Formals.set(ArgNo);
+      }
+    }
+  }
+  return Sum;
+}
+
+void UninitBitVectorAnalysis::recordUndefUses(
+    const FunctionInfo &FI, const std::vector<llvm::BitVector> &In,
+    std::map<n_t, std::set<d_t>> &UndefValueUses) const {
+  for (unsigned Idx = 0; Idx < FI.Insts.size(); ++Idx) {
+    const auto *Inst = FI.Insts[Idx];
+    if (In[Idx].none() || llvm::isa<llvm::CallBase>(Inst) ||
+        llvm::isa<llvm::StoreInst>(Inst) ||
+        llvm::isa<llvm::AllocaInst>(Inst) ||
+        llvm::isa<llvm::GetElementPtrInst>(Inst) ||
+        llvm::isa<llvm::CastInst>(Inst) || llvm::isa<llvm::PHINode>(Inst) ||
+        ICF.getSuccsOf(Inst).empty()) {
+      continue;
+    }
+    // Each fact is reported as the first operand it matches, where an undef
+    // operand matches any fact
+    auto Unmatched = In[Idx];
+    for (const auto &Op : Inst->operands()) {
+      if (llvm::isa<llvm::UndefValue>(Op)) {
+        if (Unmatched.any()) {
+          UndefValueUses[Inst].insert(Op);
+        }
+        break;
+      }
+      auto OpIdx = FI.indexOf(Op);
+      if (Unmatched.test(OpIdx)) {
+        UndefValueUses[Inst].insert(Op);
+        Unmatched.reset(OpIdx);
+      }
+    }
+  }
+}
+
+void UninitBitVectorAnalysis::solve(
+    llvm::ArrayRef<f_t> EntryPoints,
+    std::map<n_t, std::set<d_t>> &UndefValueUses) {
+  // The facts that may hold at the entry of each reachable function
+  std::map<f_t, llvm::BitVector> EntryFacts;
+  std::vector<f_t> WorkList;
+  auto AddEntryFact = [&EntryFacts, &WorkList](f_t F, unsigned Fact) {
+    auto &Facts = EntryFacts[F];
+    if (Facts.empty()) {
+      Facts.resize(F->arg_size() + 1);
+    }
+    if (!Facts.test(Fact)) {
+      Facts.set(Fact);
+      WorkList.push_back(F);
+    }
+  };
+  for (const auto *F : EntryPoints) {
+    AddEntryFact(F, 0);
+  }
+
+  auto Propagate = [&](f_t F, n_t Start) {
+    const auto &FI = getInfo(F);
+    auto Entry = EntryFacts[F];
+    Entry.resize(FI.Facts.size());
+    return propagate(FI, Start, Entry,
+                     [&](f_t Callee, unsigned CalleeFact) -> const Summary & {
+                       AddEntryFact(Callee, CalleeFact);
+                       return getSummary(Callee, CalleeFact);
+                     });
+  };
+  auto GetStart = [this, &EntryPoints](f_t F) -> n_t {
+    // the seeds are placed at the very first instruction of an entry point
+    if (llvm::is_contained(EntryPoints, F)) {
+      return &F->front().front();
+    }
+    return ICF.getStartPointsOf(F).front();
+  };
+
+  while (!WorkList.empty()) {
+    const auto *F = WorkList.back();
+    WorkList.pop_back();
+    (void)Propagate(F, GetStart(F));
+  }
+  for (const auto &[F, Facts] : EntryFacts) {
+    recordUndefUses(getInfo(F), Propagate(F, GetStart(F)), UndefValueUses);
+  }
+}
+
+} // namespace
+
+void IFDSUninitializedVariables::solveWithBitVectors() {
+  llvm::SmallVector<f_t> EntryFunctions;
+  for (const auto &EntryPoint : EntryPoints) {
+    const auto *F = ICF->getFunction(EntryPoint);
+    if (!F || F->isDeclaration()) {
+      llvm::errs() << "WARNING: Entry-Function \"" << EntryPoint
+                   << "\" not contained in the module; skip it\n";
+      continue;
+    }
+    EntryFunctions.push_back(F);
+  }
+  UndefValueUses.clear();
+  UninitBitVectorAnalysis(*ICF, getZeroValue())
+      .solve(EntryFunctions, UndefValueUses);
+}
+
 } // namespace psr
@@ -130,6 +130,13 @@ std::string CSTDFILEIOTypeStateDescription::stateToString(
   }
 }
 
+std::vector<TypeStateDescription::State>
+CSTDFILEIOTypeStateDescription::getStates() const {
+  return {CSTDFILEIOState::TOP, CSTDFILEIOState::UNINIT,
+          CSTDFILEIOState::OPENED, CSTDFILEIOState::CLOSED,
+          CSTDFILEIOState::ERROR, CSTDFILEIOState::BOT};
+}
+
 TypeStateDescription::State CSTDFILEIOTypeStateDescription::bottom() const {
   return CSTDFILEIOState::BOT;
 }
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <numeric>
+
+#include "llvm/Demangle/Demangle.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CompiledTypeStateDescription.h"
+
+namespace psr {
+
+CompiledTypeStateDescription::CompiledTypeStateDescription(
+    const TypeStateDescription &TSD, const ProjectIRDB &IRDB)
+    : TSD(TSD) {
+  auto AddState = [this](State S) {
+    if (StateIds.try_emplace(S, States.size()).second) {
+      States.push_back(S);
+    }
+  };
+  for (auto S : TSD.getStates()) {
+    AddState(S);
+  }
+  AddState(TSD.top());
+  AddState(TSD.bottom());
+  AddState(TSD.uninit());
+  Bottom = StateIds[TSD.bottom()];
+
+  for (const auto *F : IRDB.getAllFunctions()) {
+    (void)getFunctionInfo(F);
+  }
+}
+
+auto CompiledTypeStateDescription::getFunctionInfo(const llvm::Function *F)
+    -> const FunctionInfo & {
+  auto [It, Inserted] = Functions.try_emplace(F);
+  if (!Inserted) {
+    return It->second;
+  }
+  auto &Info = It->second;
+  std::string Name = llvm::demangle(F->getName().str());
+  Info.IsAPI = TSD.isAPIFunction(Name);
+  if (!Info.IsAPI) {
+    return Info;
+  }
+  Info.IsFactory = TSD.isFactoryFunction(Name);
+  Info.IsConsuming = TSD.isConsumingFunction(Name);
+  if (Info.IsConsuming) {
+    auto ParamIdx = TSD.getConsumerParamIdx(Name);
+    Info.ConsumerParamIdx.append(ParamIdx.begin(), ParamIdx.end());
+  }
+  auto [TokIt, NewToken] = TokenIds.try_emplace(Name, TokenNames.size());
+  if (NewToken) {
+    TokenNames.push_back(std::move(Name));
+  }
+  Info.Token = TokIt->second;
+  return Info;
+}
+
+auto CompiledTypeStateDescription::getTransition(
+    const llvm::CallBase *CallSite, const llvm::Function *F) -> TransitionId {
+  auto Tok = getFunctionInfo(F).Token;
+  auto It = CallSiteTransitions.find({CallSite, Tok});
+  if (It != CallSiteTransitions.end()) {
+    return It->second;
+  }
+  const auto &Name = TokenNames[Tok];
+  std::vector<StateId> Table;
+  Table.reserve(States.size());
+  for (auto S : States) {
+    auto Next = TSD.getNextState(Name, S == TSD.top() ? TSD.uninit() : S,
+                                 CallSite);
+    auto NextIt = StateIds.find(Next);
+    Table.push_back(NextIt != StateIds.end() ? NextIt->second : Bottom);
+  }
+  auto T = intern(std::move(Table));
+  CallSiteTransitions.try_emplace({CallSite, Tok}, T);
+  return T;
+}
+
+auto CompiledTypeStateDescription::getIdentity() -> TransitionId {
+  std::vector<StateId> Table(States.size());
+  std::iota(Table.begin(), Table.end(), 0);
+  return intern(std::move(Table));
+}
+
+auto CompiledTypeStateDescription::getConstant(State S) -> TransitionId {
+  auto It = StateIds.find(S);
+  return intern(std::vector<StateId>(
+      States.size(), It != StateIds.end() ? It->second : Bottom));
+}
+
+auto CompiledTypeStateDescription::compose(TransitionId First,
+                                           TransitionId Second)
+    -> TransitionId {
+  auto It = Compositions.find({First, Second});
+  if (It != Compositions.end()) {
+    return It->second;
+  }
+  std::vector<StateId> Table;
+  Table.reserve(States.size());
+  for (auto S : Tables[First]) {
+    Table.push_back(Tables[Second][S]);
+  }
+  auto T = intern(std::move(Table));
+  Compositions.try_emplace({First, Second}, T);
+  return T;
+}
+
+auto CompiledTypeStateDescription::apply(TransitionId T, State S) const
+    -> State {
+  auto It = StateIds.find(S);
+  if (It == StateIds.end()) {
+    return States[Bottom];
+  }
+  return States[Tables[T][It->second]];
+}
+
+auto CompiledTypeStateDescription::intern(std::vector<StateId> Table)
+    -> TransitionId {
+  auto [It, Inserted] = TableIds.try_emplace(Table, Tables.size());
+  if (Inserted) {
+    Tables.push_back(std::move(Table));
+  }
+  return It->second;
+}
+
+} // namespace psr
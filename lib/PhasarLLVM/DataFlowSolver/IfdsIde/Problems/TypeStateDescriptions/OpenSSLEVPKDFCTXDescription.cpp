@@ -180,6 +180,14 @@ std::string OpenSSLEVPKDFCTXDescription::stateToString(
   }
 }
 
+std::vector<TypeStateDescription::State>
+OpenSSLEVPKDFCTXDescription::getStates() const {
+  return {OpenSSLEVPKDFState::TOP, OpenSSLEVPKDFState::UNINIT,
+          OpenSSLEVPKDFState::CTX_ATTACHED, OpenSSLEVPKDFState::PARAM_INIT,
+          OpenSSLEVPKDFState::DERIVED, OpenSSLEVPKDFState::ERROR,
+          OpenSSLEVPKDFState::BOT};
+}
+
 TypeStateDescription::State OpenSSLEVPKDFCTXDescription::bottom() const {
   return OpenSSLEVPKDFState::BOT;
 }
@@ -113,6 +113,13 @@ OpenSSLEVPKDFDescription::stateToString(TypeStateDescription::State S) const {
   }
 }
 
+std::vector<TypeStateDescription::State>
+OpenSSLEVPKDFDescription::getStates() const {
+  return {OpenSSLEVPKDFState::TOP, OpenSSLEVPKDFState::UNINIT,
+          OpenSSLEVPKDFState::KDF_FETCHED, OpenSSLEVPKDFState::ERROR,
+          OpenSSLEVPKDFState::BOT};
+}
+
 TypeStateDescription::State OpenSSLEVPKDFDescription::bottom() const {
   return OpenSSLEVPKDFState::BOT;
 }
@@ -151,6 +151,14 @@ std::string OpenSSLSecureHeapDescription::stateToString(
   }
 }
 
+std::vector<TypeStateDescription::State>
+OpenSSLSecureHeapDescription::getStates() const {
+  return {OpenSSLSecureHeapState::TOP, OpenSSLSecureHeapState::BOT,
+          OpenSSLSecureHeapState::UNINIT, OpenSSLSecureHeapState::ALLOCATED,
+          OpenSSLSecureHeapState::ZEROED, OpenSSLSecureHeapState::FREED,
+          OpenSSLSecureHeapState::ERROR};
+}
+
 TypeStateDescription::State OpenSSLSecureHeapDescription::bottom() const {
   return OpenSSLSecureHeapState::BOT;
 }
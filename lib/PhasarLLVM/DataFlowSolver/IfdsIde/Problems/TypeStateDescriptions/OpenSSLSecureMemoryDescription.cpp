@@ -128,6 +128,13 @@ std::string OpenSSLSecureMemoryDescription::stateToString(
   }
 }
 
+std::vector<TypeStateDescription::State>
+OpenSSLSecureMemoryDescription::getStates() const {
+  return {OpenSSLSecureMemoryState::TOP, OpenSSLSecureMemoryState::BOT,
+          OpenSSLSecureMemoryState::ZEROED, OpenSSLSecureMemoryState::FREED,
+          OpenSSLSecureMemoryState::ERROR, OpenSSLSecureMemoryState::ALLOCATED};
+}
+
 TypeStateDescription::State OpenSSLSecureMemoryDescription::bottom() const {
   return OpenSSLSecureMemoryState::BOT;
 }
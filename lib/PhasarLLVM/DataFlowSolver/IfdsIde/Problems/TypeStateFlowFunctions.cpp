@@ -0,0 +1,437 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <utility>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Value.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CompiledTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateFlowFunctions.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+namespace {
+
+bool hasMatchingTypeName(const llvm::Type *Ty, const std::string &Pattern) {
+  if (const auto *StructTy = llvm::dyn_cast<llvm::StructType>(Ty)) {
+    return StructTy->getName().contains(Pattern);
+  }
+  // primitive type
+  std::string Str;
+  llvm::raw_string_ostream S(Str);
+  S << *Ty;
+  S.flush();
+  return Str.find(Pattern) != std::string::npos;
+}
+
+} // namespace
+
+TypeStateFlowFunctions::TypeStateFlowFunctions(
+    LLVMPointsToInfo *PT,
+    std::vector<CompiledTypeStateDescription *> Descriptions)
+    : PT(PT), Descriptions(std::move(Descriptions)) {
+  for (const auto *CTSD : this->Descriptions) {
+    TypeNamesOfInterest.push_back(
+        CTSD->getDescription().getTypeNameOfInterest());
+  }
+}
+
+bool TypeStateFlowFunctions::isAPIFunction(f_t F) {
+  for (auto *CTSD : Descriptions) {
+    if (CTSD->isAPIFunction(F)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TypeStateFlowFunctions::isFactoryFunction(f_t F) {
+  for (auto *CTSD : Descriptions) {
+    if (CTSD->isFactoryFunction(F)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TypeStateFlowFunctions::FlowFunctionPtrType
+TypeStateFlowFunctions::getNormalFlowFunction(n_t Curr) {
+  // Check if Alloca's type matches the target type. If so, generate from zero
+  // value.
+  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
+    if (hasMatchingType(Alloca)) {
+      return std::make_shared<Gen<d_t>>(Alloca, LLVMZeroValue::getInstance());
+    }
+  }
+  // Check load instructions for target type. Generate from the loaded value and
+  // kill the load instruction if it was generated previously (strong update!).
+  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
+    if (hasMatchingType(Load)) {
+      struct TSFlowFunction : FlowFunction<d_t> {
+        const llvm::LoadInst *Load;
+
+        TSFlowFunction(const llvm::LoadInst *L) : Load(L) {}
+        ~TSFlowFunction() override = default;
+        std::set<d_t> computeTargets(d_t Source) override {
+          if (Source == Load) {
+            return {};
+          }
+          if (Source == Load->getPointerOperand()) {
+            return {Source, Load};
+          }
+          return {Source};
+        }
+      };
+      return std::make_shared<TSFlowFunction>(Load);
+    }
+  }
+  if (const auto *Gep = llvm::dyn_cast<llvm::GetElementPtrInst>(Curr)) {
+    if (hasMatchingType(Gep->getPointerOperand())) {
+      return makeLambdaFlow<d_t>([=](d_t Source) -> std::set<d_t> {
+        // if (Source == Gep->getPointerOperand()) {
+        //  return {Source, Gep};
+        //}
+        return {Source};
+      });
+    }
+  }
+  // Check store instructions for target type. Perform a strong update, i.e.
+  // kill the alloca pointed to by the pointer-operand and all alloca's related
+  // to the value-operand and then generate them from the value-operand.
+  if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Curr)) {
+    if (hasMatchingType(Store)) {
+      // pointer- or value operand???
+      auto RelevantAliasesAndAllocas =
+          getLocalAliasesAndAllocas(Store->getPointerOperand());
+
+      struct TSFlowFunction : FlowFunction<d_t> {
+        const llvm::StoreInst *Store;
+        std::set<d_t> AliasesAndAllocas;
+        TSFlowFunction(const llvm::StoreInst *S, std::set<d_t> AA)
+            : Store(S), AliasesAndAllocas(std::move(AA)) {}
+        ~TSFlowFunction() override = default;
+        std::set<d_t> computeTargets(d_t Source) override {
+          // We kill all relevant loacal aliases and alloca's
+          if (Source != Store->getValueOperand() &&
+              // AliasesAndAllocas.find(Source) != AliasesAndAllocas.end()
+              // Is simple comparison sufficient?
+              Source == Store->getPointerOperand()) {
+            return {};
+          }
+          // Generate all local aliases and relevant alloca's from the stored
+          // value
+          if (Source == Store->getValueOperand()) {
+            AliasesAndAllocas.insert(Source);
+            return AliasesAndAllocas;
+          }
+          return {Source};
+        }
+      };
+      return std::make_shared<TSFlowFunction>(Store, RelevantAliasesAndAllocas);
+    }
+  }
+  return Identity<d_t>::getInstance();
+}
+
+TypeStateFlowFunctions::FlowFunctionPtrType
+TypeStateFlowFunctions::getCallFlowFunction(n_t CallSite, f_t DestFun) {
+  // Kill all data-flow facts if we hit a function of the target API.
+  // Those functions are modled within Call-To-Return.
+  if (isAPIFunction(DestFun)) {
+    return KillAll<d_t>::getInstance();
+  }
+  // Otherwise, if we have an ordinary function call, we can just use the
+  // standard mapping.
+  if (llvm::isa<llvm::CallInst>(CallSite) ||
+      llvm::isa<llvm::InvokeInst>(CallSite)) {
+    return std::make_shared<MapFactsToCallee<>>(
+        llvm::cast<llvm::CallBase>(CallSite), DestFun);
+  }
+  llvm::report_fatal_error("callSite not a CallInst nor a InvokeInst");
+}
+
+TypeStateFlowFunctions::FlowFunctionPtrType
+TypeStateFlowFunctions::getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                           n_t ExitStmt) {
+  // Besides mapping the formal parameter back into the actual parameter and
+  // propagating the return value into the caller context, we also propagate
+  // all related alloca's of the formal parameter and the return value.
+  struct TSFlowFunction : FlowFunction<d_t> {
+    const llvm::CallBase *CallSite;
+    const llvm::Function *CalleeFun;
+    const llvm::ReturnInst *ExitSite;
+    TypeStateFlowFunctions *Flow;
+    std::vector<const llvm::Value *> Actuals;
+    std::vector<const llvm::Value *> Formals;
+    TSFlowFunction(const llvm::CallBase *CallSite,
+                   const llvm::Function *CalleeFun,
+                   const llvm::Instruction *ExitSite,
+                   TypeStateFlowFunctions *Flow)
+        : CallSite(CallSite), CalleeFun(CalleeFun),
+          ExitSite(llvm::dyn_cast<llvm::ReturnInst>(ExitSite)), Flow(Flow) {
+      // Set up the actual parameters
+      for (unsigned Idx = 0; Idx < CallSite->arg_size(); ++Idx) {
+        Actuals.push_back(CallSite->getArgOperand(Idx));
+      }
+      // Set up the formal parameters
+      for (unsigned Idx = 0; Idx < CalleeFun->arg_size(); ++Idx) {
+        Formals.push_back(getNthFunctionArgument(CalleeFun, Idx));
+      }
+    }
+
+    ~TSFlowFunction() override = default;
+
+    std::set<d_t> computeTargets(d_t Source) override {
+      if (!LLVMZeroValue::isLLVMZeroValue(Source)) {
+        std::set<const llvm::Value *> Res;
+        // Handle C-style varargs functions
+        if (CalleeFun->isVarArg() && !CalleeFun->isDeclaration()) {
+          const llvm::Instruction *AllocVarArg;
+          // Find the allocation of %struct.__va_list_tag
+          for (const auto &BB : *CalleeFun) {
+            for (const auto &I : BB) {
+              if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+                if (Alloc->getAllocatedType()->isArrayTy() &&
+                    Alloc->getAllocatedType()->getArrayNumElements() > 0 &&
+                    Alloc->getAllocatedType()
+                        ->getArrayElementType()
+                        ->isStructTy() &&
+                    Alloc->getAllocatedType()
+                            ->getArrayElementType()
+                            ->getStructName() == "struct.__va_list_tag") {
+                  AllocVarArg = Alloc;
+                  // TODO break out this nested loop earlier (without goto ;-)
+                }
+              }
+            }
+          }
+          // Generate the varargs things by using an over-approximation
+          if (Source == AllocVarArg) {
+            for (unsigned Idx = Formals.size(); Idx < Actuals.size(); ++Idx) {
+              Res.insert(Actuals[Idx]);
+            }
+          }
+        }
+        // Handle ordinary case
+        // Map formal parameter into corresponding actual parameter.
+        for (unsigned Idx = 0; Idx < Formals.size(); ++Idx) {
+          if (Source == Formals[Idx]) {
+            Res.insert(Actuals[Idx]); // corresponding actual
+          }
+        }
+        // Collect the return value
+        if (Source == ExitSite->getReturnValue()) {
+          Res.insert(CallSite);
+        }
+        // Collect all relevant alloca's to map into caller context
+        std::set<d_t> RelAllocas;
+        for (const auto *Fact : Res) {
+          auto Allocas = Flow->getRelevantAllocas(Fact);
+          RelAllocas.insert(Allocas.begin(), Allocas.end());
+        }
+        Res.insert(RelAllocas.begin(), RelAllocas.end());
+        return Res;
+      }
+      return {Source};
+    }
+  };
+  return std::make_shared<TSFlowFunction>(llvm::cast<llvm::CallBase>(CallSite),
+                                          CalleeFun, ExitStmt, this);
+}
+
+TypeStateFlowFunctions::FlowFunctionPtrType
+TypeStateFlowFunctions::getCallToRetFlowFunction(n_t CallSite,
+                                                 llvm::ArrayRef<f_t> Callees) {
+  const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
+  for (const auto *Callee : Callees) {
+    // Generate the return value of factory functions from zero value
+    if (isFactoryFunction(Callee)) {
+      struct TSFlowFunction : FlowFunction<d_t> {
+        d_t CS, ZeroValue;
+
+        TSFlowFunction(d_t CS, d_t Z) : CS(CS), ZeroValue(Z) {}
+        ~TSFlowFunction() override = default;
+        std::set<d_t> computeTargets(d_t Source) override {
+          if (Source == CS) {
+            return {};
+          }
+          if (Source == ZeroValue) {
+            return {Source, CS};
+          }
+          return {Source};
+        }
+      };
+      return std::make_shared<TSFlowFunction>(CS, LLVMZeroValue::getInstance());
+    }
+
+    // Handle all functions that are not modeld with special semantics.
+    // Kill actual parameters of target type and all its aliases
+    // and the corresponding alloca(s) as these data-flow facts are
+    // (inter-procedurally) propagated via Call- and the corresponding
+    // Return-Flow. Otherwise we might propagate facts with not updated
+    // states.
+    // Alloca's related to the return value of non-api functions will
+    // not be killed during call-to-return, since it is not safe to assume
+    // that the return value will be used afterwards, i.e. is stored to memory
+    // pointed to by related alloca's.
+    if (!isAPIFunction(Callee) && !Callee->isDeclaration()) {
+      for (const auto &Arg : CS->args()) {
+        if (hasMatchingType(Arg)) {
+          std::set<d_t> FactsToKill = getWMAliasesAndAllocas(Arg.get());
+          return std::make_shared<KillMultiple<d_t>>(FactsToKill);
+        }
+      }
+    }
+  }
+  return Identity<d_t>::getInstance();
+}
+
+std::set<TypeStateFlowFunctions::d_t>
+TypeStateFlowFunctions::getRelevantAllocas(d_t V) {
+  if (RelevantAllocaCache.find(V) != RelevantAllocaCache.end()) {
+    return RelevantAllocaCache[V];
+  }
+  auto PointsToSet = getWMPointsToSet(V);
+  std::set<d_t> RelevantAllocas;
+  PHASAR_LOG_LEVEL(DEBUG, "Compute relevant alloca's of " << llvmIRToString(V));
+  for (const auto *Alias : PointsToSet) {
+    PHASAR_LOG_LEVEL(DEBUG, "Alias: " << llvmIRToString(Alias));
+    // Collect the pointer operand of a aliased load instruciton
+    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Alias)) {
+      if (hasMatchingType(Alias)) {
+        PHASAR_LOG_LEVEL(DEBUG, " -> Alloca: " << llvmIRToString(
+                                    Load->getPointerOperand()));
+        RelevantAllocas.insert(Load->getPointerOperand());
+      }
+    } else {
+      // For all other types of aliases, e.g. callsites, function arguments,
+      // we check store instructions where thoses aliases are value operands.
+      for (const auto *User : Alias->users()) {
+        PHASAR_LOG_LEVEL(DEBUG, "  User: " << llvmIRToString(User));
+        if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(User)) {
+          if (hasMatchingType(Store)) {
+            PHASAR_LOG_LEVEL(DEBUG, "    -> Alloca: " << llvmIRToString(
+                                        Store->getPointerOperand()));
+            RelevantAllocas.insert(Store->getPointerOperand());
+          }
+        }
+      }
+    }
+  }
+  for (const auto *Alias : PointsToSet) {
+    RelevantAllocaCache[Alias] = RelevantAllocas;
+  }
+  return RelevantAllocas;
+}
+
+std::set<TypeStateFlowFunctions::d_t>
+TypeStateFlowFunctions::getWMPointsToSet(d_t V) {
+  if (PointsToCache.find(V) != PointsToCache.end()) {
+    std::set<d_t> PointsToSet(PointsToCache[V].begin(), PointsToCache[V].end());
+    return PointsToSet;
+  }
+  auto PTS = PT->getPointsToSet(V);
+  for (const auto *Alias : *PTS) {
+    if (hasMatchingType(Alias)) {
+      PointsToCache[Alias] = *PTS;
+    }
+  }
+  std::set<d_t> PointsToSet(PTS->begin(), PTS->end());
+  return PointsToSet;
+}
+
+std::set<TypeStateFlowFunctions::d_t>
+TypeStateFlowFunctions::getWMAliasesAndAllocas(d_t V) {
+  std::set<d_t> PointsToAndAllocas;
+  std::set<d_t> RelevantAllocas = getRelevantAllocas(V);
+  std::set<d_t> Aliases = getWMPointsToSet(V);
+  PointsToAndAllocas.insert(Aliases.begin(), Aliases.end());
+  PointsToAndAllocas.insert(RelevantAllocas.begin(), RelevantAllocas.end());
+  return PointsToAndAllocas;
+}
+
+std::set<TypeStateFlowFunctions::d_t>
+TypeStateFlowFunctions::getLocalAliasesAndAllocas(d_t V) {
+  std::set<d_t> PointsToAndAllocas;
+  std::set<d_t> RelevantAllocas = getRelevantAllocas(V);
+  std::set<d_t> Aliases; // = IRDB->getPointsToGraph(Fname)->getPointsToSet(V);
+  for (const auto *Alias : Aliases) {
+    if (hasMatchingType(Alias)) {
+      PointsToAndAllocas.insert(Alias);
+    }
+  }
+  // PointsToAndAllocas.insert(Aliases.begin(), Aliases.end());
+  PointsToAndAllocas.insert(RelevantAllocas.begin(), RelevantAllocas.end());
+  return PointsToAndAllocas;
+}
+
+bool TypeStateFlowFunctions::hasMatchingType(d_t V) {
+  for (unsigned Desc = 0; Desc < Descriptions.size(); ++Desc) {
+    if (hasMatchingType(V, Desc)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TypeStateFlowFunctions::hasMatchingType(d_t V, unsigned Desc) {
+  const auto &TypeName = TypeNamesOfInterest[Desc];
+  // General case
+  if (V->getType()->isPointerTy()) {
+    if (hasMatchingTypeName(V->getType()->getPointerElementType(), TypeName)) {
+      return true;
+    }
+  }
+  if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(V)) {
+    if (Alloca->getAllocatedType()->isPointerTy()) {
+      if (hasMatchingTypeName(
+              Alloca->getAllocatedType()->getPointerElementType(), TypeName)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(V)) {
+    if (Load->getPointerOperand()
+            ->getType()
+            ->getPointerElementType()
+            ->isPointerTy()) {
+      if (hasMatchingTypeName(Load->getPointerOperand()
+                                  ->getType()
+                                  ->getPointerElementType()
+                                  ->getPointerElementType(),
+                              TypeName)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(V)) {
+    if (Store->getValueOperand()->getType()->isPointerTy()) {
+      if (hasMatchingTypeName(
+              Store->getValueOperand()->getType()->getPointerElementType(),
+              TypeName)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return false;
+}
+
+} // namespace psr
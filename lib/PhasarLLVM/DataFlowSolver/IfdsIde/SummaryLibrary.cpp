@@ -0,0 +1,261 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <stdexcept>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Value.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
+#include "phasar/Utils/IO.h"
+
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+std::string positionToString(int Pos) {
+  switch (Pos) {
+  case SummaryFlow::Zero:
+    return "zero";
+  case SummaryFlow::Return:
+    return "ret";
+  default:
+    return "arg" + std::to_string(Pos);
+  }
+}
+
+int positionFromJson(const nlohmann::json &J) {
+  if (!J.is_string()) {
+    throw std::runtime_error("Malformed summary library: position " +
+                             J.dump() + " is not a string");
+  }
+  llvm::StringRef Str = J.get_ref<const std::string &>();
+  if (Str == "zero") {
+    return SummaryFlow::Zero;
+  }
+  if (Str == "ret") {
+    return SummaryFlow::Return;
+  }
+  unsigned Idx = 0;
+  if (!Str.consume_front("arg") || Str.getAsInteger(10, Idx)) {
+    throw std::runtime_error("Malformed summary library: unknown position '" +
+                             Str.str() + "'");
+  }
+  return static_cast<int>(Idx);
+}
+
+/// Looks through pointer casts, so that facts on casted arguments are matched
+bool isSameValue(const llvm::Value *Lhs, const llvm::Value *Rhs) {
+  return Lhs == Rhs || Lhs->stripPointerCasts() == Rhs->stripPointerCasts();
+}
+
+} // namespace
+
+std::string toString(SummaryEdgeKind Kind) {
+  switch (Kind) {
+  case SummaryEdgeKind::Identity:
+    return "identity";
+  case SummaryEdgeKind::AllTop:
+    return "top";
+  case SummaryEdgeKind::AllBottom:
+    return "bottom";
+  }
+  llvm_unreachable("All SummaryEdgeKinds should be handled in the switch");
+}
+
+SummaryEdgeKind toSummaryEdgeKind(llvm::StringRef Str) {
+  if (Str == "identity") {
+    return SummaryEdgeKind::Identity;
+  }
+  if (Str == "top") {
+    return SummaryEdgeKind::AllTop;
+  }
+  if (Str == "bottom") {
+    return SummaryEdgeKind::AllBottom;
+  }
+  throw std::runtime_error("Malformed summary library: unknown edge kind '" +
+                           Str.str() + "'");
+}
+
+bool FunctionSummary::kills(const llvm::CallBase *CS,
+                            const llvm::Value *Fact) const {
+  return llvm::any_of(Kills, [CS, Fact](int Pos) {
+    return Pos >= 0 && static_cast<unsigned>(Pos) < CS->arg_size() &&
+           isSameValue(CS->getArgOperand(Pos), Fact);
+  });
+}
+
+void FunctionSummary::computeTargets(
+    const llvm::CallBase *CS, const llvm::Value *Fact, bool IsZero,
+    llvm::SmallVectorImpl<std::pair<const llvm::Value *, SummaryEdgeKind>>
+        &Targets) const {
+  auto Matches = [CS, Fact, IsZero](int Pos) {
+    if (Pos == SummaryFlow::Zero) {
+      return IsZero;
+    }
+    if (IsZero || Pos == SummaryFlow::Return ||
+        static_cast<unsigned>(Pos) >= CS->arg_size()) {
+      return false;
+    }
+    return isSameValue(CS->getArgOperand(Pos), Fact);
+  };
+
+  if (IsZero || !kills(CS, Fact)) {
+    Targets.emplace_back(Fact, SummaryEdgeKind::Identity);
+  }
+  for (const auto &Flow : Flows) {
+    if (!Matches(Flow.From)) {
+      continue;
+    }
+    const llvm::Value *To = nullptr;
+    if (Flow.To == SummaryFlow::Return) {
+      if (CS->getType()->isVoidTy()) {
+        continue;
+      }
+      To = CS;
+    } else if (Flow.To >= 0 && static_cast<unsigned>(Flow.To) < CS->arg_size()) {
+      To = CS->getArgOperand(Flow.To);
+    } else {
+      // The zero fact is never generated and variadic arguments may be absent
+      continue;
+    }
+    Targets.emplace_back(To, Flow.Edge);
+  }
+}
+
+SummaryLibrary::SummaryLibrary(const nlohmann::json &J) {
+  if (!J.is_object() || !J.contains("version") ||
+      !J["version"].is_number_unsigned()) {
+    throw std::runtime_error("Malformed summary library: missing version");
+  }
+  if (auto V = J["version"].get<unsigned>(); V != Version) {
+    throw std::runtime_error("Unsupported summary library version " +
+                             std::to_string(V) + " (expected " +
+                             std::to_string(Version) + ")");
+  }
+  if (!J.contains("analyses")) {
+    return;
+  }
+  try {
+    for (const auto &[Analysis, Functions] : J["analyses"].items()) {
+      for (const auto &[Function, JSum] : Functions.items()) {
+        FunctionSummary Sum;
+        if (JSum.contains("flows")) {
+          for (const auto &JFlow : JSum["flows"]) {
+            SummaryFlow Flow;
+            Flow.From = positionFromJson(JFlow.at("from"));
+            Flow.To = positionFromJson(JFlow.at("to"));
+            if (JFlow.contains("edge")) {
+              Flow.Edge = toSummaryEdgeKind(
+                  JFlow["edge"].get_ref<const std::string &>());
+            }
+            Sum.Flows.push_back(Flow);
+          }
+        }
+        if (JSum.contains("kills")) {
+          for (const auto &JKill : JSum["kills"]) {
+            Sum.Kills.push_back(positionFromJson(JKill));
+          }
+        }
+        addSummary(Analysis, Function, std::move(Sum));
+      }
+    }
+  } catch (const nlohmann::json::exception &Ex) {
+    throw std::runtime_error(std::string("Malformed summary library: ") +
+                             Ex.what());
+  }
+}
+
+SummaryLibrary SummaryLibrary::readFile(const std::string &Path) {
+  nlohmann::json J;
+  try {
+    J = readJsonFile(Path);
+  } catch (const nlohmann::json::parse_error &Ex) {
+    throw std::runtime_error(Path + " is not a summary library: " + Ex.what());
+  }
+  return SummaryLibrary(J);
+}
+
+void SummaryLibrary::writeFile(const std::string &Path) const {
+  writeTextFile(Path, getAsJson().dump(2) + '\n');
+}
+
+nlohmann::json SummaryLibrary::getAsJson() const {
+  nlohmann::json J;
+  J["version"] = Version;
+  auto &JAnalyses = J["analyses"];
+  JAnalyses = nlohmann::json::object();
+  for (const auto &[Analysis, Functions] : Summaries) {
+    auto &JFunctions = JAnalyses[Analysis];
+    for (const auto &[Function, Sum] : Functions) {
+      nlohmann::json JSum;
+      JSum["flows"] = nlohmann::json::array();
+      for (const auto &Flow : Sum.Flows) {
+        JSum["flows"].push_back({{"from", positionToString(Flow.From)},
+                                 {"to", positionToString(Flow.To)},
+                                 {"edge", toString(Flow.Edge)}});
+      }
+      JSum["kills"] = nlohmann::json::array();
+      for (auto Kill : Sum.Kills) {
+        JSum["kills"].push_back(positionToString(Kill));
+      }
+      JFunctions[Function] = std::move(JSum);
+    }
+  }
+  return J;
+}
+
+bool SummaryLibrary::addSummary(llvm::StringRef Analysis,
+                                llvm::StringRef Function,
+                                FunctionSummary Summary) {
+  auto &Functions = Summaries[Analysis.str()];
+  auto [It, Inserted] =
+      Functions.insert_or_assign(Function.str(), std::move(Summary));
+  return !Inserted;
+}
+
+const FunctionSummary *
+SummaryLibrary::getSummary(llvm::StringRef Analysis,
+                           llvm::StringRef Function) const {
+  const auto *Functions = getSummaries(Analysis);
+  if (!Functions) {
+    return nullptr;
+  }
+  auto It = Functions->find(Function);
+  return It != Functions->end() ? &It->second : nullptr;
+}
+
+const SummaryLibrary::AnalysisSummaries *
+SummaryLibrary::getSummaries(llvm::StringRef Analysis) const {
+  auto It = Summaries.find(Analysis);
+  return It != Summaries.end() ? &It->second : nullptr;
+}
+
+std::vector<std::string> SummaryLibrary::getAnalyses() const {
+  std::vector<std::string> Ret;
+  Ret.reserve(Summaries.size());
+  for (const auto &Entry : Summaries) {
+    Ret.push_back(Entry.first);
+  }
+  return Ret;
+}
+
+size_t SummaryLibrary::size() const {
+  size_t Ret = 0;
+  for (const auto &Entry : Summaries) {
+    Ret += Entry.second.size();
+  }
+  return Ret;
+}
+
+} // namespace psr
@@ -0,0 +1,475 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallBitVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibraryGenerator.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+/// Parameters are tracked as bits of a 64 bit mask
+constexpr unsigned MaxParams = 64;
+
+/// Dependencies of a value on the parameters of the summarized function. Bit
+/// I stands for parameter I and the memory that is reachable through it.
+struct Dependencies {
+  uint64_t Copied = 0;
+  uint64_t Computed = 0;
+
+  bool merge(const Dependencies &Other) {
+    auto OldCopied = Copied;
+    auto OldComputed = Computed;
+    Copied |= Other.Copied;
+    Computed |= Other.Computed;
+    return Copied != OldCopied || Computed != OldComputed;
+  }
+
+  [[nodiscard]] Dependencies asComputed() const {
+    return {0, Copied | Computed};
+  }
+
+  [[nodiscard]] uint64_t all() const { return Copied | Computed; }
+};
+
+/// The abstraction of a value or of the contents of an abstract memory
+/// location
+struct AbstractValue {
+  Dependencies Deps;
+  /// The abstract memory locations the value may point to
+  llvm::SmallBitVector PointsTo;
+  /// The value may point to memory that is not modeled, i.e. mutable globals
+  bool PointsToUnknown = false;
+
+  bool merge(const AbstractValue &Other) {
+    bool Changed = Deps.merge(Other.Deps);
+    if (PointsTo.size() < Other.PointsTo.size()) {
+      PointsTo.resize(Other.PointsTo.size());
+    }
+    if (Other.PointsTo.test(PointsTo)) {
+      PointsTo |= Other.PointsTo;
+      Changed = true;
+    }
+    if (Other.PointsToUnknown && !PointsToUnknown) {
+      PointsToUnknown = true;
+      Changed = true;
+    }
+    return Changed;
+  }
+
+  [[nodiscard]] AbstractValue asComputed() const {
+    AbstractValue Ret;
+    Ret.Deps = Deps.asComputed();
+    return Ret;
+  }
+};
+
+bool isDeallocatingFunction(llvm::StringRef Name) {
+  return llvm::StringSwitch<bool>(Name)
+      .Cases("free", "_ZdlPv", "_ZdaPv", "_ZdlPvm", "_ZdaPvm", true)
+      .Default(false);
+}
+
+/// Summarizes a single function based on the current summaries of its
+/// callees. The abstract memory locations are the memory reachable through
+/// each parameter and one location per stack slot or allocation site.
+class FunctionSummarizer {
+public:
+  FunctionSummarizer(
+      const llvm::Function &F,
+      const llvm::DenseMap<const llvm::Function *, FunctionSummary> &Callees)
+      : F(F), Callees(Callees) {}
+
+  std::optional<FunctionSummary> summarize() {
+    if (F.isVarArg() || F.arg_size() > MaxParams) {
+      return std::nullopt;
+    }
+    NumLocations = F.arg_size();
+    for (const auto &I : llvm::instructions(F)) {
+      if (llvm::isa<llvm::AllocaInst>(I) ||
+          (llvm::isa<llvm::CallBase>(I) && I.getType()->isPointerTy())) {
+        AllocationSites[&I] = NumLocations++;
+      }
+    }
+    Contents.assign(NumLocations, AbstractValue{});
+    for (auto &Content : Contents) {
+      Content.PointsTo.resize(NumLocations);
+    }
+    for (const auto &Arg : F.args()) {
+      if (Arg.getType()->isPointerTy()) {
+        Contents[Arg.getArgNo()] = getValue(&Arg);
+      }
+    }
+    RetVal.PointsTo.resize(NumLocations);
+
+    // Flow-insensitive fixpoint iteration over all instructions
+    bool Changed = true;
+    while (Changed) {
+      Changed = false;
+      for (const auto &I : llvm::instructions(F)) {
+        if (!transfer(I, Changed)) {
+          return std::nullopt;
+        }
+      }
+    }
+    return createSummary();
+  }
+
+private:
+  const llvm::Function &F;
+  const llvm::DenseMap<const llvm::Function *, FunctionSummary> &Callees;
+  unsigned NumLocations = 0;
+  llvm::DenseMap<const llvm::Instruction *, unsigned> AllocationSites;
+  llvm::DenseMap<const llvm::Value *, AbstractValue> Values;
+  std::vector<AbstractValue> Contents;
+  AbstractValue RetVal;
+
+  AbstractValue getValue(const llvm::Value *V) const {
+    AbstractValue Ret;
+    Ret.PointsTo.resize(NumLocations);
+    if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+      Ret.Deps.Copied = uint64_t(1) << Arg->getArgNo();
+      if (Arg->getType()->isPointerTy()) {
+        Ret.PointsTo.set(Arg->getArgNo());
+      }
+    } else if (llvm::isa<llvm::Instruction>(V)) {
+      auto It = Values.find(V);
+      if (It != Values.end()) {
+        Ret.merge(It->second);
+      }
+    } else if (V->getType()->isPointerTy()) {
+      // Constant memory does not carry any dependencies on the parameters
+      const auto *Glob =
+          llvm::dyn_cast<llvm::GlobalVariable>(llvm::getUnderlyingObject(V));
+      Ret.PointsToUnknown = Glob && !Glob->isConstant();
+    }
+    return Ret;
+  }
+
+  AbstractValue getOperands(const llvm::User &U) const {
+    AbstractValue Ret;
+    Ret.PointsTo.resize(NumLocations);
+    for (const auto &Op : U.operands()) {
+      if (!llvm::isa<llvm::BasicBlock>(Op)) {
+        Ret.merge(getValue(Op));
+      }
+    }
+    return Ret;
+  }
+
+  /// The contents of all locations the given value may point to
+  AbstractValue getPointee(const AbstractValue &Ptr) const {
+    AbstractValue Ret;
+    Ret.PointsTo.resize(NumLocations);
+    for (auto Loc : Ptr.PointsTo.set_bits()) {
+      Ret.merge(Contents[Loc]);
+    }
+    return Ret;
+  }
+
+  /// The dependencies of all memory that is (transitively) reachable through
+  /// the given value
+  Dependencies getReachable(const AbstractValue &Ptr) const {
+    Dependencies Ret;
+    llvm::SmallBitVector Visited(NumLocations);
+    llvm::SmallVector<unsigned, 8> WorkList;
+    auto Enqueue = [&WorkList, &Visited](const llvm::SmallBitVector &Locs) {
+      for (auto Loc : Locs.set_bits()) {
+        if (!Visited.test(Loc)) {
+          Visited.set(Loc);
+          WorkList.push_back(Loc);
+        }
+      }
+    };
+    Enqueue(Ptr.PointsTo);
+    while (!WorkList.empty()) {
+      auto Loc = WorkList.pop_back_val();
+      Ret.merge(Contents[Loc].Deps);
+      Enqueue(Contents[Loc].PointsTo);
+    }
+    return Ret;
+  }
+
+  bool update(const llvm::Value *V, const AbstractValue &AV, bool &Changed) {
+    auto [It, Inserted] = Values.try_emplace(V);
+    if (Inserted) {
+      It->second.PointsTo.resize(NumLocations);
+    }
+    Changed |= It->second.merge(AV);
+    return true;
+  }
+
+  bool store(const AbstractValue &Ptr, const AbstractValue &AV,
+             bool &Changed) {
+    if (Ptr.PointsToUnknown) {
+      return false;
+    }
+    for (auto Loc : Ptr.PointsTo.set_bits()) {
+      Changed |= Contents[Loc].merge(AV);
+    }
+    return true;
+  }
+
+  /// Returns false if the instruction prevents summarizing the function
+  bool transfer(const llvm::Instruction &I, bool &Changed) {
+    if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      AbstractValue AV;
+      AV.PointsTo.resize(NumLocations);
+      AV.PointsTo.set(AllocationSites.lookup(Alloca));
+      return update(&I, AV, Changed);
+    }
+    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+      auto Ptr = getValue(Load->getPointerOperand());
+      if (Ptr.PointsToUnknown) {
+        return false;
+      }
+      return update(&I, getPointee(Ptr), Changed);
+    }
+    if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      return store(getValue(Store->getPointerOperand()),
+                   getValue(Store->getValueOperand()), Changed);
+    }
+    if (llvm::isa<llvm::AtomicRMWInst, llvm::AtomicCmpXchgInst,
+                  llvm::VAArgInst>(I)) {
+      return false;
+    }
+    if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(&I)) {
+      return transferCall(CS, Changed);
+    }
+    if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(&I)) {
+      if (const auto *RetV = Ret->getReturnValue()) {
+        RetVal.merge(getValue(RetV));
+      }
+      return true;
+    }
+    if (I.getType()->isVoidTy()) {
+      return true;
+    }
+    if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+      return update(&I, getValue(GEP->getPointerOperand()), Changed);
+    }
+    if (llvm::isa<llvm::IntToPtrInst>(I)) {
+      auto AV = getValue(I.getOperand(0));
+      AV.PointsToUnknown = true;
+      return update(&I, AV, Changed);
+    }
+    if (const auto *Select = llvm::dyn_cast<llvm::SelectInst>(&I)) {
+      auto AV = getValue(Select->getTrueValue());
+      AV.merge(getValue(Select->getFalseValue()));
+      return update(&I, AV, Changed);
+    }
+    if (llvm::isa<llvm::BinaryOperator, llvm::UnaryOperator, llvm::CmpInst>(
+            I)) {
+      return update(&I, getOperands(I).asComputed(), Changed);
+    }
+    // Casts, phis and aggregate operations copy their operands
+    return update(&I, getOperands(I), Changed);
+  }
+
+  bool transferCall(const llvm::CallBase *CS, bool &Changed) {
+    if (const auto *Intrinsic = llvm::dyn_cast<llvm::IntrinsicInst>(CS)) {
+      if (Intrinsic->isAssumeLikeIntrinsic()) {
+        return true;
+      }
+    }
+    if (const auto *MemCpy = llvm::dyn_cast<llvm::MemTransferInst>(CS)) {
+      auto Src = getValue(MemCpy->getRawSource());
+      if (Src.PointsToUnknown) {
+        return false;
+      }
+      return store(getValue(MemCpy->getRawDest()), getPointee(Src), Changed);
+    }
+    if (const auto *MemSet = llvm::dyn_cast<llvm::MemSetInst>(CS)) {
+      return store(getValue(MemSet->getRawDest()),
+                   getValue(MemSet->getValue()), Changed);
+    }
+
+    const auto *Callee = llvm::dyn_cast<llvm::Function>(
+        CS->getCalledOperand()->stripPointerCasts());
+    if (!Callee) {
+      return false;
+    }
+    AbstractValue Result;
+    Result.PointsTo.resize(NumLocations);
+    if (CS->getType()->isPointerTy()) {
+      // The callee may return fresh memory
+      Result.PointsTo.set(AllocationSites.lookup(CS));
+    }
+
+    if (!Callee->isDeclaration()) {
+      auto It = Callees.find(Callee);
+      if (It == Callees.end()) {
+        return false;
+      }
+      for (const auto &Flow : It->second.Flows) {
+        if (Flow.From < 0 || unsigned(Flow.From) >= CS->arg_size()) {
+          continue;
+        }
+        auto Arg = getValue(CS->getArgOperand(Flow.From));
+        if (Arg.PointsToUnknown) {
+          return false;
+        }
+        auto Src = getPointee(Arg);
+        Src.merge(Arg);
+        if (Flow.Edge != SummaryEdgeKind::Identity) {
+          Src = Src.asComputed();
+        }
+        if (Flow.To == SummaryFlow::Return) {
+          Result.merge(Src);
+        } else if (Flow.To >= 0 && unsigned(Flow.To) < CS->arg_size()) {
+          if (!store(getValue(CS->getArgOperand(Flow.To)), Src, Changed)) {
+            return false;
+          }
+        }
+      }
+    } else if (HeapAllocatingFunctions.count(Callee->getName()) ||
+               isDeallocatingFunction(Callee->getName())) {
+      // Allocations are handled above, the contents of fresh memory do not
+      // depend on the parameters
+    } else if (Callee->doesNotAccessMemory()) {
+      Result.merge(getOperands(*CS).asComputed());
+    } else if (Callee->onlyReadsMemory() || Callee->onlyAccessesArgMemory()) {
+      auto Args = getOperands(*CS);
+      if (Args.PointsToUnknown) {
+        return false;
+      }
+      auto Combined = getPointee(Args);
+      Combined.merge(Args);
+      Combined = Combined.asComputed();
+      if (!Callee->onlyReadsMemory() && !store(Args, Combined, Changed)) {
+        return false;
+      }
+      Result.merge(Combined);
+    } else {
+      return false;
+    }
+    if (CS->getType()->isVoidTy()) {
+      return true;
+    }
+    return update(CS, Result, Changed);
+  }
+
+  FunctionSummary createSummary() const {
+    FunctionSummary Sum;
+    auto AddFlows = [&Sum](const Dependencies &Deps, int To) {
+      for (unsigned From = 0; From < MaxParams; ++From) {
+        uint64_t Bit = uint64_t(1) << From;
+        bool IsComputed = Deps.Computed & Bit;
+        // A parameter trivially flows into itself, unless it is modified
+        if (!(Deps.all() & Bit) || (int(From) == To && !IsComputed)) {
+          continue;
+        }
+        Sum.Flows.push_back({int(From), To,
+                             IsComputed ? SummaryEdgeKind::AllBottom
+                                        : SummaryEdgeKind::Identity});
+      }
+    };
+
+    for (const auto &Arg : F.args()) {
+      if (!Arg.getType()->isPointerTy()) {
+        continue;
+      }
+      AbstractValue Ptr;
+      Ptr.PointsTo.resize(NumLocations);
+      Ptr.PointsTo.set(Arg.getArgNo());
+      AddFlows(getReachable(Ptr), int(Arg.getArgNo()));
+    }
+    if (!F.getReturnType()->isVoidTy()) {
+      auto Deps = RetVal.Deps;
+      Deps.merge(getReachable(RetVal));
+      AddFlows(Deps, SummaryFlow::Return);
+    }
+    return Sum;
+  }
+};
+
+} // namespace
+
+SummaryLibraryGenerator::SummaryLibraryGenerator(const ProjectIRDB &IRDB) {
+  // Summaries only grow until they reach a fixpoint, so we start with empty
+  // summaries and re-summarize the callers of each changed function.
+  // Functions that cannot be summarized are dropped along with their callers.
+  llvm::DenseMap<const llvm::Function *,
+                 llvm::SmallVector<const llvm::Function *, 4>>
+      Callers;
+  std::vector<const llvm::Function *> WorkList;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    if (F->isDeclaration()) {
+      continue;
+    }
+    Summaries[F] = {};
+    WorkList.push_back(F);
+    for (const auto &I : llvm::instructions(F)) {
+      if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        if (const auto *Callee = llvm::dyn_cast<llvm::Function>(
+                CS->getCalledOperand()->stripPointerCasts())) {
+          Callers[Callee].push_back(F);
+        }
+      }
+    }
+  }
+
+  while (!WorkList.empty()) {
+    const auto *F = WorkList.back();
+    WorkList.pop_back();
+    auto It = Summaries.find(F);
+    if (It == Summaries.end()) {
+      continue;
+    }
+    auto Sum = FunctionSummarizer(*F, Summaries).summarize();
+    if (!Sum) {
+      PHASAR_LOG_LEVEL(DEBUG, "Cannot summarize '" << F->getName() << "'");
+      Summaries.erase(It);
+    } else if (*Sum == It->second) {
+      continue;
+    } else {
+      It->second = std::move(*Sum);
+    }
+    WorkList.insert(WorkList.end(), Callers[F].begin(), Callers[F].end());
+  }
+}
+
+const FunctionSummary *
+SummaryLibraryGenerator::getSummary(const llvm::Function *F) const {
+  auto It = Summaries.find(F);
+  return It != Summaries.end() ? &It->second : nullptr;
+}
+
+void SummaryLibraryGenerator::addTo(
+    SummaryLibrary &Lib, llvm::ArrayRef<std::string> Analyses) const {
+  for (const auto &[F, Sum] : Summaries) {
+    if (F->hasLocalLinkage()) {
+      continue;
+    }
+    for (const auto &Analysis : Analyses) {
+      Lib.addSummary(Analysis, F->getName(), Sum);
+    }
+  }
+}
+
+} // namespace psr
@@ -171,7 +171,7 @@ void InterMonoFullConstantPropagation::printContainer(
     llvm::raw_ostream &OS,
     InterMonoFullConstantPropagation::mono_container_t Con) const {
   for (const auto &[Var, Val] : Con) {
-    OS << "<" << llvmIRToString(Var) << ", " << Val << ">, ";
+    OS << "<" << llvmIRToStringRef(Var) << ", " << Val << ">, ";
   }
 }
 
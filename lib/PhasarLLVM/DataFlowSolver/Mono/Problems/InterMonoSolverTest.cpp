@@ -102,12 +102,12 @@ InterMonoSolverTest::initialSeeds() {
 
 void InterMonoSolverTest::printNode(llvm::raw_ostream &OS,
                                     InterMonoSolverTest::n_t Inst) const {
-  OS << llvmIRToString(Inst);
+  OS << llvmIRToStringRef(Inst);
 }
 
 void InterMonoSolverTest::printDataFlowFact(
     llvm::raw_ostream &OS, InterMonoSolverTest::d_t Fact) const {
-  OS << llvmIRToString(Fact) << '\n';
+  OS << llvmIRToStringRef(Fact) << '\n';
 }
 
 void InterMonoSolverTest::printFunction(llvm::raw_ostream &OS,
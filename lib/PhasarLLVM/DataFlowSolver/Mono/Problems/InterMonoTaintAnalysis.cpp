@@ -182,12 +182,12 @@ InterMonoTaintAnalysis::initialSeeds() {
 
 void InterMonoTaintAnalysis::printNode(llvm::raw_ostream &OS,
                                        InterMonoTaintAnalysis::n_t Inst) const {
-  OS << llvmIRToString(Inst);
+  OS << llvmIRToStringRef(Inst);
 }
 
 void InterMonoTaintAnalysis::printDataFlowFact(
     llvm::raw_ostream &OS, InterMonoTaintAnalysis::d_t Fact) const {
-  OS << llvmIRToString(Fact) << '\n';
+  OS << llvmIRToStringRef(Fact) << '\n';
 }
 
 void InterMonoTaintAnalysis::printFunction(llvm::raw_ostream &OS,
@@ -223,12 +223,12 @@ IntraMonoFullConstantPropagation::executeBinOperation(
 
 void IntraMonoFullConstantPropagation::printNode(
     llvm::raw_ostream &OS, IntraMonoFullConstantPropagation::n_t Inst) const {
-  OS << llvmIRToString(Inst);
+  OS << llvmIRToStringRef(Inst);
 }
 
 void IntraMonoFullConstantPropagation::printDataFlowFact(
     llvm::raw_ostream &OS, IntraMonoFullConstantPropagation::d_t Fact) const {
-  OS << "< " + llvmIRToString(Fact.first) << ", ";
+  OS << "< " + llvmIRToStringRef(Fact.first) << ", ";
   if (std::holds_alternative<Top>(Fact.second)) {
     OS << std::get<Top>(Fact.second);
   }
@@ -73,12 +73,12 @@ IntraMonoSolverTest::initialSeeds() {
 
 void IntraMonoSolverTest::printNode(llvm::raw_ostream &OS,
                                     IntraMonoSolverTest::n_t Inst) const {
-  OS << llvmIRToString(Inst);
+  OS << llvmIRToStringRef(Inst);
 }
 
 void IntraMonoSolverTest::printDataFlowFact(
     llvm::raw_ostream &OS, IntraMonoSolverTest::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IntraMonoSolverTest::printFunction(llvm::raw_ostream &OS,
@@ -92,12 +92,12 @@ IntraMonoUninitVariables::initialSeeds() {
 
 void IntraMonoUninitVariables::printNode(
     llvm::raw_ostream &OS, IntraMonoUninitVariables::n_t Inst) const {
-  OS << llvmIRToString(Inst);
+  OS << llvmIRToStringRef(Inst);
 }
 
 void IntraMonoUninitVariables::printDataFlowFact(
     llvm::raw_ostream &OS, IntraMonoUninitVariables::d_t Fact) const {
-  OS << llvmIRToString(Fact);
+  OS << llvmIRToStringRef(Fact);
 }
 
 void IntraMonoUninitVariables::printFunction(
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <string>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/ConstantFolding.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Casting.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/PromoteMemToReg.h"
+
+#include "phasar/Config/Configuration.h"
+#include "phasar/PhasarLLVM/Passes/IRNormalizationPass.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+namespace {
+
+using VariableOriginMap =
+    llvm::DenseMap<const llvm::DILocalVariable *, std::string>;
+
+bool isAnnotated(const llvm::Instruction &I) {
+  return I.getMetadata(PhasarConfig::MetaDataKind()) != nullptr;
+}
+
+/// Gives a synthesized instruction an ID of its own and links it to the
+/// original instruction with the given ID, if any.
+void annotateSynthesized(llvm::Instruction &I, llvm::StringRef OriginId) {
+  ValueAnnotationPass::annotate(I);
+  if (OriginId.empty() || OriginId == "-1") {
+    return;
+  }
+  auto &Context = I.getContext();
+  I.setMetadata(
+      PhasarConfig::OriginMetaDataKind(),
+      llvm::MDNode::get(Context, llvm::MDString::get(Context, OriginId)));
+}
+
+/// Promotes the allocas that only are loaded from and stored to. They are
+/// promoted one at a time, such that the phi nodes that the promotion inserts
+/// can be attributed to the alloca of their variable.
+bool promoteAllocas(llvm::Function &F, VariableOriginMap &VariableOrigins) {
+  llvm::SmallVector<llvm::AllocaInst *, 16> Allocas;
+  for (auto &I : F.getEntryBlock()) {
+    if (auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I);
+        Alloca && llvm::isAllocaPromotable(Alloca)) {
+      Allocas.push_back(Alloca);
+    }
+  }
+  if (Allocas.empty()) {
+    return false;
+  }
+  // Promotion does not change the CFG, so the dominator tree stays valid
+  llvm::DominatorTree DT(F);
+  for (auto *Alloca : Allocas) {
+    auto OriginId = getMetaDataID(Alloca);
+    // The promotion replaces the variable's dbg.declare by dbg.values
+    for (auto *DII : llvm::FindDbgAddrUses(Alloca)) {
+      VariableOrigins.try_emplace(DII->getVariable(), OriginId);
+    }
+    llvm::PromoteMemToReg(Alloca, DT);
+    for (auto &BB : F) {
+      for (auto &Phi : BB.phis()) {
+        if (!isAnnotated(Phi)) {
+          annotateSynthesized(Phi, OriginId);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/// Folds instructions whose operands are constants and removes instructions
+/// whose results are unused and that have no side effects.
+bool foldAndRemoveDeadInstructions(llvm::Function &F) {
+  const auto &DL = F.getParent()->getDataLayout();
+  llvm::SmallSetVector<llvm::Instruction *, 64> Worklist;
+  for (auto &I : llvm::instructions(F)) {
+    Worklist.insert(&I);
+  }
+  bool Changed = false;
+  while (!Worklist.empty()) {
+    auto *I = Worklist.pop_back_val();
+    if (llvm::isInstructionTriviallyDead(I)) {
+      for (auto &Op : I->operands()) {
+        if (auto *OpInst = llvm::dyn_cast<llvm::Instruction>(Op)) {
+          Worklist.insert(OpInst);
+        }
+      }
+      llvm::salvageDebugInfo(*I);
+      I->eraseFromParent();
+      Changed = true;
+      continue;
+    }
+    if (auto *C = llvm::ConstantFoldInstruction(I, DL)) {
+      for (auto *User : I->users()) {
+        Worklist.insert(llvm::cast<llvm::Instruction>(User));
+      }
+      I->replaceAllUsesWith(C);
+      // I is dead now
+      Worklist.insert(I);
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+} // namespace
+
+llvm::AnalysisKey IRNormalizationPass::Key;
+
+IRNormalizationPass::IRNormalizationPass() = default;
+
+llvm::PreservedAnalyses
+IRNormalizationPass::run(llvm::Module &M,
+                         llvm::ModuleAnalysisManager & /*AM*/) {
+  PHASAR_LOG_LEVEL(INFO, "Running IRNormalizationPass");
+  size_t NumInstsBefore = M.getInstructionCount();
+  bool Changed = false;
+  for (auto &F : M) {
+    if (!F.isDeclaration()) {
+      Changed |= normalizeFunction(F);
+    }
+  }
+  PHASAR_LOG_LEVEL(INFO, "IRNormalizationPass shrank "
+                             << M.getModuleIdentifier() << " from "
+                             << NumInstsBefore << " to "
+                             << M.getInstructionCount() << " instructions");
+  return Changed ? llvm::PreservedAnalyses::none()
+                 : llvm::PreservedAnalyses::all();
+}
+
+bool IRNormalizationPass::normalizeFunction(llvm::Function &F) {
+  VariableOriginMap VariableOrigins;
+  bool Changed = promoteAllocas(F, VariableOrigins);
+  Changed |= foldAndRemoveDeadInstructions(F);
+  if (!Changed) {
+    return false;
+  }
+  // Annotate the remaining instructions that the promotion inserted, i.e.,
+  // the dbg.values that describe the promoted variables
+  for (auto &I : llvm::instructions(F)) {
+    if (isAnnotated(I)) {
+      continue;
+    }
+    std::string OriginId;
+    if (const auto *DVI = llvm::dyn_cast<llvm::DbgVariableIntrinsic>(&I)) {
+      OriginId = VariableOrigins.lookup(DVI->getVariable());
+    }
+    annotateSynthesized(I, OriginId);
+  }
+  return true;
+}
+
+} // namespace psr
@@ -57,20 +57,21 @@ ValueAnnotationPass::run(llvm::Module &M,
   for (auto &F : M) {
     for (auto &BB : F) {
       for (auto &I : BB) {
-        llvm::MDNode *Node = llvm::MDNode::get(
-            Context,
-            llvm::MDString::get(Context, std::to_string(UniqueValueId)));
-        I.setMetadata(PhasarConfig::MetaDataKind(), Node);
-        //		    	std::cout <<
-        // llvm::cast<llvm::MDString>(I.getMetadata(MetaDataKind)->getOperand(0))->getString().str()
-        //<< std::endl;
-        ++UniqueValueId;
+        annotate(I);
       }
     }
   }
   return llvm::PreservedAnalyses::none();
 }
 
+void ValueAnnotationPass::annotate(llvm::Instruction &I) {
+  auto &Context = I.getContext();
+  llvm::MDNode *Node = llvm::MDNode::get(
+      Context, llvm::MDString::get(Context, std::to_string(UniqueValueId)));
+  I.setMetadata(PhasarConfig::MetaDataKind(), Node);
+  ++UniqueValueId;
+}
+
 void ValueAnnotationPass::resetValueID() {
   llvm::outs() << "Reset ID" << '\n';
   UniqueValueId = 0;
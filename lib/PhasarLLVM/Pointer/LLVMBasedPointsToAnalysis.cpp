@@ -89,6 +89,10 @@ bool LLVMBasedPointsToAnalysis::hasPointsToInfo(
 }
 
 void LLVMBasedPointsToAnalysis::computePointsToInfo(llvm::Function &Fun) {
+  if (GetAAResults) {
+    AAInfos.insert(std::make_pair(&Fun, nullptr));
+    return;
+  }
   llvm::PreservedAnalyses PA = FPM.run(Fun, FAM);
   llvm::AAResults &AAR = FAM.getResult<llvm::AAManager>(Fun);
   AAInfos.insert(std::make_pair(&Fun, &AAR));
@@ -98,35 +102,47 @@ void LLVMBasedPointsToAnalysis::erase(llvm::Function *F) {
   // after we clear all stuff, we need to set it up for the next function-wise
   // analysis
   AAInfos.erase(F);
-  FAM.clear(*F, F->getName());
+  if (!GetAAResults) {
+    FAM.clear(*F, F->getName());
+  }
 }
 
 void LLVMBasedPointsToAnalysis::clear() {
   AAInfos.clear();
-  FAM.clear();
+  if (!GetAAResults) {
+    FAM.clear();
+  }
 }
 
 LLVMBasedPointsToAnalysis::LLVMBasedPointsToAnalysis(ProjectIRDB &IRDB,
                                                      bool UseLazyEvaluation,
                                                      PointerAnalysisType PATy)
     : PATy(PATy) {
-  AA.registerFunctionAnalysis<llvm::BasicAA>();
-  switch (PATy) {
-  case PointerAnalysisType::CFLAnders:
-    AA.registerFunctionAnalysis<llvm::CFLAndersAA>();
-    break;
-  case PointerAnalysisType::CFLSteens:
-    AA.registerFunctionAnalysis<llvm::CFLSteensAA>();
-    break;
-  default:
-    break;
+  if (auto &Cache = IRDB.getAnalysisCache();
+      Cache.getPointerAnalysisType() == PATy) {
+    // Share the alias analysis results with the other users of the IRDB
+    GetAAResults = [&Cache](llvm::Function &F) -> llvm::AAResults & {
+      return Cache.getAAResults(&F);
+    };
+  } else {
+    AA.registerFunctionAnalysis<llvm::BasicAA>();
+    switch (PATy) {
+    case PointerAnalysisType::CFLAnders:
+      AA.registerFunctionAnalysis<llvm::CFLAndersAA>();
+      break;
+    case PointerAnalysisType::CFLSteens:
+      AA.registerFunctionAnalysis<llvm::CFLSteensAA>();
+      break;
+    default:
+      break;
+    }
+    AA.registerFunctionAnalysis<llvm::TypeBasedAA>();
+    FAM.registerPass([&] { return std::move(AA); });
+    PB.registerFunctionAnalyses(FAM);
+    llvm::FunctionPassManager FPM;
+    // Always verify the input.
+    FPM.addPass(llvm::VerifierPass());
   }
-  AA.registerFunctionAnalysis<llvm::TypeBasedAA>();
-  FAM.registerPass([&] { return std::move(AA); });
-  PB.registerFunctionAnalyses(FAM);
-  llvm::FunctionPassManager FPM;
-  // Always verify the input.
-  FPM.addPass(llvm::VerifierPass());
   if (!UseLazyEvaluation) {
     for (llvm::Module *M : IRDB.getAllModules()) {
       for (auto &F : *M) {
@@ -138,9 +154,17 @@ LLVMBasedPointsToAnalysis::LLVMBasedPointsToAnalysis(ProjectIRDB &IRDB,
   }
 }
 
+LLVMBasedPointsToAnalysis::LLVMBasedPointsToAnalysis(
+    AAResultsGetterTy GetAAResults, PointerAnalysisType PATy)
+    : PATy(PATy), GetAAResults(std::move(GetAAResults)) {}
+
 void LLVMBasedPointsToAnalysis::print(llvm::raw_ostream &OS) const {
   OS << "Points-to Info:\n";
-  for (auto &[Fn, AA] : AAInfos) {
+  for (const auto &[Fn, OwnedAA] : AAInfos) {
+    llvm::AAResults *AA =
+        GetAAResults
+            ? &GetAAResults(*const_cast<llvm::Function *>(Fn)) // NOLINT
+            : OwnedAA;
     bool PrintAll = true;
     bool PrintNoAlias = true;
     bool PrintMayAlias = true;
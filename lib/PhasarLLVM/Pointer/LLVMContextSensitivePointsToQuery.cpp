@@ -0,0 +1,315 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/Casting.h"
+
+#include "phasar/PhasarLLVM/Pointer/LLVMContextSensitivePointsToQuery.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+
+namespace psr {
+
+static bool isAllocationSite(const llvm::Value *V) {
+  if (llvm::isa<llvm::AllocaInst>(V) || llvm::isa<llvm::GlobalObject>(V)) {
+    return true;
+  }
+  if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(V)) {
+    const auto *Callee = CS->getCalledFunction();
+    return Callee && Callee->hasName() &&
+           HeapAllocatingFunctions.count(Callee->getName());
+  }
+  return false;
+}
+
+/// Collects the values that are stored to Obj, if Obj is an alloca or a
+/// global variable that is only loaded from and stored to directly. Returns
+/// false otherwise, e.g. if Obj escapes into a call.
+static bool
+collectStoredValues(const llvm::Value *Obj,
+                    llvm::SmallVectorImpl<const llvm::Value *> &StoredValues) {
+  if (const auto *Glob = llvm::dyn_cast<llvm::GlobalVariable>(Obj)) {
+    if (!Glob->hasDefinitiveInitializer()) {
+      return false;
+    }
+    StoredValues.push_back(Glob->getInitializer());
+  } else if (!llvm::isa<llvm::AllocaInst>(Obj)) {
+    return false;
+  }
+  for (const auto &Use : Obj->uses()) {
+    if (llvm::isa<llvm::LoadInst>(Use.getUser())) {
+      continue;
+    }
+    if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Use.getUser());
+        Store && Use.getOperandNo() == Store->getPointerOperandIndex()) {
+      StoredValues.push_back(Store->getValueOperand());
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+LLVMContextSensitivePointsToQuery::LLVMContextSensitivePointsToQuery(
+    LLVMPointsToInfo &PT, unsigned K, size_t Budget)
+    : PT(PT), K(K), Budget(Budget) {
+  CallStrings.emplace_back();
+  CallStringIds.try_emplace({}, EmptyContext);
+}
+
+auto LLVMContextSensitivePointsToQuery::getContextId(CallStringTy CallString)
+    -> ContextId {
+  if (CallString.size() > K) {
+    CallString = CallString.take_back(K);
+  }
+  auto [It, Inserted] =
+      CallStringIds.try_emplace(CallString.vec(), CallStrings.size());
+  if (Inserted) {
+    CallStrings.push_back(It->first);
+  }
+  return It->second;
+}
+
+auto LLVMContextSensitivePointsToQuery::pushCallSite(
+    ContextId Ctx, const llvm::CallBase *CallSite) -> ContextId {
+  llvm::SmallVector<const llvm::CallBase *, 4> CallString(
+      CallStrings[Ctx].begin(), CallStrings[Ctx].end());
+  CallString.push_back(CallSite);
+  return getContextId(CallString);
+}
+
+auto LLVMContextSensitivePointsToQuery::popCallSite(ContextId Ctx)
+    -> std::pair<const llvm::CallBase *, ContextId> {
+  CallStringTy CallString = CallStrings[Ctx];
+  assert(!CallString.empty());
+  return {CallString.back(), getContextId(CallString.drop_back())};
+}
+
+bool LLVMContextSensitivePointsToQuery::mayBeSameObject(
+    AllocationSiteTy S1, AllocationSiteTy S2) const {
+  if (S1.first != S2.first) {
+    return false;
+  }
+  auto CallString1 = getCallString(S1.second);
+  auto CallString2 = getCallString(S2.second);
+  if (CallString1.size() > CallString2.size()) {
+    std::swap(CallString1, CallString2);
+  }
+  // The innermost call sites come last
+  return CallString1 == CallString2.take_back(CallString1.size());
+}
+
+auto LLVMContextSensitivePointsToQuery::computeAllocationSites(
+    const llvm::Value *V, ContextId Ctx) -> std::optional<AllocationSiteSetTy> {
+  AllocationSiteSetTy Sites;
+  llvm::DenseSet<std::pair<const llvm::Value *, ContextId>> Visited;
+  llvm::SmallVector<std::pair<const llvm::Value *, ContextId>, 16> WorkList;
+
+  auto Propagate = [&Visited, &WorkList](const llvm::Value *Next,
+                                         ContextId NextCtx) {
+    if (Visited.insert({Next, NextCtx}).second) {
+      WorkList.emplace_back(Next, NextCtx);
+    }
+  };
+
+  Propagate(V, Ctx);
+  while (!WorkList.empty()) {
+    if (RemainingBudget == 0) {
+      return std::nullopt;
+    }
+    --RemainingBudget;
+
+    auto [Curr, CurrCtx] = WorkList.pop_back_val();
+    if (!isInterestingPointer(Curr) || llvm::isa<llvm::UndefValue>(Curr)) {
+      continue;
+    }
+    if (isAllocationSite(Curr)) {
+      Sites.insert({Curr, llvm::isa<llvm::GlobalObject>(Curr) ? EmptyContext
+                                                               : CurrCtx});
+      continue;
+    }
+
+    if (const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(Curr)) {
+      if (!CE->isCast() &&
+          CE->getOpcode() != llvm::Instruction::GetElementPtr) {
+        return std::nullopt;
+      }
+      Propagate(CE->getOperand(0), CurrCtx);
+    } else if (const auto *Cast = llvm::dyn_cast<llvm::CastInst>(Curr)) {
+      if (llvm::isa<llvm::IntToPtrInst>(Cast)) {
+        return std::nullopt;
+      }
+      Propagate(Cast->getOperand(0), CurrCtx);
+    } else if (const auto *GEP =
+                   llvm::dyn_cast<llvm::GetElementPtrInst>(Curr)) {
+      Propagate(GEP->getPointerOperand(), CurrCtx);
+    } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(Curr)) {
+      for (const auto &Incoming : Phi->incoming_values()) {
+        Propagate(Incoming, CurrCtx);
+      }
+    } else if (const auto *Select = llvm::dyn_cast<llvm::SelectInst>(Curr)) {
+      Propagate(Select->getTrueValue(), CurrCtx);
+      Propagate(Select->getFalseValue(), CurrCtx);
+    } else if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(Curr)) {
+      const auto *Fun = Arg->getParent();
+      auto ArgNo = Arg->getArgNo();
+      if (CurrCtx != EmptyContext) {
+        // The argument is passed at the innermost call site of the context
+        auto [CallSite, CallerCtx] = popCallSite(CurrCtx);
+        const auto *Callee = CallSite->getCalledFunction();
+        if ((Callee && Callee != Fun) || ArgNo >= CallSite->arg_size()) {
+          return std::nullopt;
+        }
+        Propagate(CallSite->getArgOperand(ArgNo), CallerCtx);
+        continue;
+      }
+      // Without a context, the argument may be passed at any call site
+      if (Fun->hasAddressTaken()) {
+        return std::nullopt;
+      }
+      if (!Fun->hasLocalLinkage()) {
+        Sites.insert({Arg, EmptyContext});
+      }
+      for (const auto &Use : Fun->uses()) {
+        const auto *Caller = llvm::dyn_cast<llvm::CallBase>(Use.getUser());
+        if (Caller && Caller->isCallee(&Use) && ArgNo < Caller->arg_size()) {
+          Propagate(Caller->getArgOperand(ArgNo), EmptyContext);
+        }
+      }
+    } else if (const auto *CallSite = llvm::dyn_cast<llvm::CallBase>(Curr)) {
+      const auto *Callee = llvm::dyn_cast<llvm::Function>(
+          CallSite->getCalledOperand()->stripPointerCasts());
+      if (!Callee || Callee->isDeclaration()) {
+        return std::nullopt;
+      }
+      auto CalleeCtx = pushCallSite(CurrCtx, CallSite);
+      for (const auto &Inst : llvm::instructions(Callee)) {
+        if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(&Inst);
+            Ret && Ret->getReturnValue()) {
+          Propagate(Ret->getReturnValue(), CalleeCtx);
+        }
+      }
+    } else if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
+      const auto *Objects =
+          getAllocationSites(Load->getPointerOperand(), CurrCtx);
+      if (!Objects) {
+        return std::nullopt;
+      }
+      for (auto [Obj, ObjCtx] : *Objects) {
+        llvm::SmallVector<const llvm::Value *, 4> StoredValues;
+        if (!collectStoredValues(Obj, StoredValues)) {
+          return std::nullopt;
+        }
+        // An alloca is only accessed from its own function, i.e. in the
+        // context of its frame. A global may be stored to from anywhere.
+        auto StoreCtx =
+            llvm::isa<llvm::AllocaInst>(Obj) ? ObjCtx : EmptyContext;
+        for (const auto *Stored : StoredValues) {
+          Propagate(Stored, StoreCtx);
+        }
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+  return Sites;
+}
+
+auto LLVMContextSensitivePointsToQuery::getAllocationSites(const llvm::Value *V,
+                                                           ContextId Ctx)
+    -> const AllocationSiteSetTy * {
+  if (auto It = AllocationSites.find({V, Ctx}); It != AllocationSites.end()) {
+    return It->second ? &*It->second : nullptr;
+  }
+  bool IsRootQuery = InProgress.empty();
+  if (IsRootQuery) {
+    RemainingBudget = Budget;
+  }
+  // V's allocation sites depend on themselves, e.g. through a cycle of loads
+  if (!InProgress.insert({V, Ctx}).second) {
+    return nullptr;
+  }
+  auto Sites = computeAllocationSites(V, Ctx);
+  InProgress.erase({V, Ctx});
+  // A nested query may only have failed because the remaining budget of the
+  // root query was too small, so do not memoize that failure
+  if (!Sites && !IsRootQuery) {
+    return nullptr;
+  }
+  auto &Entry = AllocationSites[{V, Ctx}];
+  Entry = std::move(Sites);
+  return Entry ? &*Entry : nullptr;
+}
+
+auto LLVMContextSensitivePointsToQuery::getAllocationSitesInContext(
+    const llvm::Value *V, CallStringTy CallString)
+    -> const AllocationSiteSetTy * {
+  return getAllocationSites(V, getContextId(CallString));
+}
+
+auto LLVMContextSensitivePointsToQuery::getPointsToSetInContext(
+    const llvm::Value *V, CallStringTy CallString)
+    -> LLVMPointsToInfo::PointsToSetPtrTy {
+  auto InsensitivePTS = PT.getPointsToSet(V);
+  if (!isInterestingPointer(V)) {
+    return InsensitivePTS;
+  }
+  auto Ctx = getContextId(CallString);
+  if (auto It = RefinedPointsToSets.find({V, Ctx});
+      It != RefinedPointsToSets.end()) {
+    return It->second;
+  }
+
+  LLVMPointsToInfo::PointsToSetPtrTy Result = InsensitivePTS;
+  if (const auto *Sites = getAllocationSites(V, Ctx)) {
+    llvm::DenseMap<const llvm::Value *, llvm::SmallVector<ContextId, 2>>
+        SiteContexts;
+    for (auto [Site, SiteCtx] : *Sites) {
+      SiteContexts[Site].push_back(SiteCtx);
+    }
+    auto MayPointToSite = [this, &SiteContexts](AllocationSiteTy AliasSite) {
+      auto It = SiteContexts.find(AliasSite.first);
+      return It != SiteContexts.end() &&
+             llvm::any_of(It->second, [this, AliasSite](ContextId SiteCtx) {
+               return mayBeSameObject({AliasSite.first, SiteCtx}, AliasSite);
+             });
+    };
+
+    auto RefinedPTS = Owner.acquire();
+    for (const auto *Alias : *InsensitivePTS) {
+      if (Alias == V) {
+        RefinedPTS->insert(Alias);
+        continue;
+      }
+      // Any context of Alias is subsumed by the empty context
+      const auto *AliasSites = getAllocationSites(Alias, EmptyContext);
+      if (!AliasSites || llvm::any_of(*AliasSites, MayPointToSite)) {
+        RefinedPTS->insert(Alias);
+      }
+    }
+    Result = RefinedPTS;
+  }
+  RefinedPointsToSets.try_emplace({V, Ctx}, Result);
+  return Result;
+}
+
+void LLVMContextSensitivePointsToQuery::clear() {
+  AllocationSites.clear();
+  // The refined points-to sets that have been handed out may still be in use,
+  // so they are only reclaimed together with the Owner
+  RefinedPointsToSets.clear();
+}
+
+} // namespace psr
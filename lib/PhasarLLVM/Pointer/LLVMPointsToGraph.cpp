@@ -16,124 +16,101 @@
 #include "llvm/IR/Value.h"
 #include "llvm/Support/raw_ostream.h"
 
-#include "boost/graph/copy.hpp"
-#include "boost/graph/depth_first_search.hpp"
-#include "boost/graph/graph_utility.hpp"
-#include "boost/graph/graphviz.hpp"
-
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToGraph.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
-#include "phasar/Utils/GraphExtensions.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/NlohmannLogging.h"
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Utilities.h"
 
+#include <cassert>
+
 using namespace std;
 using namespace psr;
 
 namespace psr {
-struct LLVMPointsToGraph::AllocationSiteDFSVisitor
-    : boost::default_dfs_visitor {
-  // collect the allocation sites that are found
-  PointsToSetTy &AllocationSites;
-  // keeps track of the current path
-  std::vector<vertex_t> VisitorStack;
-  // the call stack that can be matched against the visitor stack
-  const std::vector<const llvm::Instruction *> &CallStack;
-
-  AllocationSiteDFSVisitor(PointsToSetTy &AllocationSizes,
-                           const vector<const llvm::Instruction *> &CallStack)
-      : AllocationSites(AllocationSizes), CallStack(CallStack) {}
-
-  template <typename Vertex, typename Graph>
-  void discover_vertex(Vertex U, const Graph & /*G*/) {
-    VisitorStack.push_back(U);
-  }
-
-  template <typename Vertex, typename Graph>
-  void finish_vertex(Vertex U, const Graph &G) {
-    // check for stack allocation
-    if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(G[U].V)) {
-      // If the call stack is empty, we completely ignore the calling context
-      if (matchesStack(G) || CallStack.empty()) {
-        PHASAR_LOG_LEVEL(DEBUG,
-                         "Found stack allocation: " << llvmIRToString(Alloc));
-        AllocationSites.insert(G[U].V);
-      }
-    }
-    // check for heap allocation
-    if (llvm::isa<llvm::CallInst>(G[U].V) ||
-        llvm::isa<llvm::InvokeInst>(G[U].V)) {
-      const auto *CallSite = llvm::cast<llvm::CallBase>(G[U].V);
-      if (CallSite->getCalledFunction() != nullptr &&
-          HeapAllocatingFunctions.count(
-              CallSite->getCalledFunction()->getName())) {
-        // If the call stack is empty, we completely ignore the calling
-        // context
-        if (matchesStack(G) || CallStack.empty()) {
-          PHASAR_LOG_LEVEL(
-              DEBUG, "Found heap allocation: " << llvmIRToString(CallSite));
-          AllocationSites.insert(G[U].V);
-        }
-      }
-    }
-    VisitorStack.pop_back();
-  }
-
-  template <typename Graph> bool matchesStack(const Graph &G) {
-    size_t CallStackIdx = 0;
-    for (size_t I = 0, J = 1;
-         I < VisitorStack.size() && J < VisitorStack.size(); ++I, ++J) {
-      auto E = boost::edge(VisitorStack[I], VisitorStack[J], G);
-      if (G[E.first].V == nullptr) {
-        continue;
-      }
-      if (G[E.first].V != CallStack[CallStack.size() - CallStackIdx - 1]) {
-        return false;
-      }
-      CallStackIdx++;
-    }
-    return true;
-  }
-};
-
-struct LLVMPointsToGraph::ReachabilityDFSVisitor : boost::default_dfs_visitor {
-  std::set<vertex_t> &PointsToSet;
-  ReachabilityDFSVisitor(set<vertex_t> &Result) : PointsToSet(Result) {}
-  template <typename Vertex, typename Graph>
-  void finish_vertex(Vertex U, const Graph & /*Graph*/) {
-    PointsToSet.insert(U);
-  }
-};
 
 // points-to graph internal stuff
 
-LLVMPointsToGraph::VertexProperties::VertexProperties(const llvm::Value *V)
-    : V(V) {}
-
-std::string LLVMPointsToGraph::VertexProperties::getValueAsString() const {
+std::string LLVMPointsToGraph::EdgeProperties::getValueAsString() const {
   return llvmIRToString(V);
 }
 
-std::vector<const llvm::User *>
-LLVMPointsToGraph::VertexProperties::getUsers() const {
-  if (!Users.empty() || V == nullptr) {
-    return Users;
+auto LLVMPointsToGraph::getOrCreateVertex(const llvm::Value *V) -> vertex_t {
+  auto [It, Inserted] =
+      ValueVertexMap.try_emplace(V, vertex_t(Vertices.size()));
+  if (Inserted) {
+    Vertices.push_back(V);
+    Parent.push_back(It->second);
+    ComponentSize.push_back(1);
+    NextInComponent.push_back(It->second);
+    ++NumComponents;
+    AdjacencyOffsets.clear();
   }
-  auto AllUsers = V->users();
-  Users.insert(Users.end(), AllUsers.begin(), AllUsers.end());
-  return Users;
+  return It->second;
 }
 
-LLVMPointsToGraph::EdgeProperties::EdgeProperties(const llvm::Value *V)
-    : V(V) {}
+void LLVMPointsToGraph::addEdge(vertex_t From, vertex_t To,
+                                const llvm::Value *Label) {
+  Edges.push_back({From, To, Label});
+  unionComponents(From, To);
+  AdjacencyOffsets.clear();
+}
 
-std::string LLVMPointsToGraph::EdgeProperties::getValueAsString() const {
-  return llvmIRToString(V);
+auto LLVMPointsToGraph::findComponent(vertex_t V) const -> vertex_t {
+  // path halving
+  while (Parent[V] != V) {
+    Parent[V] = Parent[Parent[V]];
+    V = Parent[V];
+  }
+  return V;
+}
+
+bool LLVMPointsToGraph::unionComponents(vertex_t V1, vertex_t V2) {
+  auto Root1 = findComponent(V1);
+  auto Root2 = findComponent(V2);
+  if (Root1 == Root2) {
+    return false;
+  }
+  // union by size
+  if (ComponentSize[Root1] < ComponentSize[Root2]) {
+    std::swap(Root1, Root2);
+  }
+  Parent[Root2] = Root1;
+  ComponentSize[Root1] += ComponentSize[Root2];
+  // splice the two cyclic member lists
+  std::swap(NextInComponent[Root1], NextInComponent[Root2]);
+  --NumComponents;
+  return true;
+}
+
+void LLVMPointsToGraph::buildAdjacency() const {
+  if (AdjacencyOffsets.size() == Vertices.size() + 1) {
+    return;
+  }
+  AdjacencyOffsets.assign(Vertices.size() + 1, 0);
+  for (const auto &Edge : Edges) {
+    ++AdjacencyOffsets[Edge.Source + 1];
+    if (Edge.Source != Edge.Target) {
+      ++AdjacencyOffsets[Edge.Target + 1];
+    }
+  }
+  for (size_t I = 1; I < AdjacencyOffsets.size(); ++I) {
+    AdjacencyOffsets[I] += AdjacencyOffsets[I - 1];
+  }
+  AdjacentEdges.resize(AdjacencyOffsets.back());
+  std::vector<uint32_t> Pos(AdjacencyOffsets.begin(),
+                            std::prev(AdjacencyOffsets.end()));
+  for (uint32_t EdgeIdx = 0; EdgeIdx < Edges.size(); ++EdgeIdx) {
+    const auto &Edge = Edges[EdgeIdx];
+    AdjacentEdges[Pos[Edge.Source]++] = EdgeIdx;
+    if (Edge.Source != Edge.Target) {
+      AdjacentEdges[Pos[Edge.Target]++] = EdgeIdx;
+    }
+  }
 }
 
 // points-to graph stuff
@@ -150,26 +127,25 @@ void LLVMPointsToGraph::computePointsToGraph(const llvm::Value *V) {
 
 void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
   // check if we already analyzed the function
-  if (AnalyzedFunctions.find(F) != AnalyzedFunctions.end()) {
+  if (!F || AnalyzedFunctions.count(F)) {
     return;
   }
   PAMM_GET_INSTANCE;
   PHASAR_LOG_LEVEL(DEBUG, "Analyzing function: " << F->getName());
   AnalyzedFunctions.insert(F);
   llvm::AAResults &AA = *PTA.getAAResults(F);
-  bool EvalAAMD = true;
 
   // taken from llvm/Analysis/AliasAnalysisEvaluator.cpp
   const llvm::DataLayout &DL = F->getParent()->getDataLayout();
 
   llvm::SetVector<llvm::Value *> Pointers;
-  llvm::SmallSetVector<llvm::CallBase *, 16> Calls;
-  llvm::SetVector<llvm::Value *> Loads;
-  llvm::SetVector<llvm::Value *> Stores;
+  auto &Params = EscapingParams[F];
+  auto &Returns = EscapingReturns[F];
 
   for (auto &I : F->args()) {
     if (I.getType()->isPointerTy()) { // Add all pointer arguments.
       Pointers.insert(&I);
+      Params.emplace_back(I.getArgNo(), &I);
     }
   }
 
@@ -177,12 +153,6 @@ void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
     if (I->getType()->isPointerTy()) { // Add all pointer instructions.
       Pointers.insert(&*I);
     }
-    if (EvalAAMD && llvm::isa<llvm::LoadInst>(&*I)) {
-      Loads.insert(&*I);
-    }
-    if (EvalAAMD && llvm::isa<llvm::StoreInst>(&*I)) {
-      Stores.insert(&*I);
-    }
     llvm::Instruction &Inst = *I;
     if (auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
       llvm::Value *Callee = Call->getCalledOperand();
@@ -196,7 +166,6 @@ void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
           Pointers.insert(DataOp);
         }
       }
-      Calls.insert(Call);
     } else {
       // Consider all operands.
       for (llvm::Instruction::op_iterator OI = Inst.op_begin(),
@@ -206,30 +175,40 @@ void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
           Pointers.insert(*OI);
         }
       }
+      if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(&Inst)) {
+        const auto *RetVal = Ret->getReturnValue();
+        if (RetVal && isInterestingPointer(RetVal)) {
+          Returns.push_back(RetVal);
+        }
+      }
     }
   }
 
   INC_COUNTER("GS Pointer", Pointers.size(), PAMM_SEVERITY_LEVEL::Core);
 
   // make vertices for all pointers
+  std::vector<vertex_t> PointerVertices;
+  std::vector<uint64_t> PointerSizes;
+  PointerVertices.reserve(Pointers.size());
+  PointerSizes.reserve(Pointers.size());
   for (auto *P : Pointers) {
-    ValueVertexMap[P] = boost::add_vertex(VertexProperties(P), PAG);
+    PointerVertices.push_back(getOrCreateVertex(P));
+    llvm::Type *ElTy =
+        llvm::cast<llvm::PointerType>(P->getType())->getElementType();
+    PointerSizes.push_back(ElTy->isSized() ? DL.getTypeStoreSize(ElTy)
+                                           : llvm::MemoryLocation::UnknownSize);
   }
-  // iterate over the worklist, and run the full (n^2)/2 disambiguations
-  const auto MapEnd = ValueVertexMap.end();
-  for (auto I1 = ValueVertexMap.begin(); I1 != MapEnd; ++I1) {
-    llvm::Type *I1ElTy =
-        llvm::cast<llvm::PointerType>(I1->first->getType())->getElementType();
-    const uint64_t I1Size = I1ElTy->isSized()
-                                ? DL.getTypeStoreSize(I1ElTy)
-                                : llvm::MemoryLocation::UnknownSize;
-    for (auto I2 = std::next(I1); I2 != MapEnd; ++I2) {
-      llvm::Type *I2ElTy =
-          llvm::cast<llvm::PointerType>(I2->first->getType())->getElementType();
-      const uint64_t I2Size = I2ElTy->isSized()
-                                  ? DL.getTypeStoreSize(I2ElTy)
-                                  : llvm::MemoryLocation::UnknownSize;
-      switch (AA.alias(I1->first, I1Size, I2->first, I2Size)) {
+  // iterate over the worklist, and run the (n^2)/2 disambiguations. Pairs
+  // that are already in the same component do not change the points-to sets,
+  // so we do not need to query the alias analysis for them.
+  for (size_t I1 = 0, End = Pointers.size(); I1 != End; ++I1) {
+    for (size_t I2 = I1 + 1; I2 != End; ++I2) {
+      if (findComponent(PointerVertices[I1]) ==
+          findComponent(PointerVertices[I2])) {
+        continue;
+      }
+      switch (AA.alias(Pointers[I1], PointerSizes[I1], Pointers[I2],
+                       PointerSizes[I2])) {
       case llvm::AliasResult::NoAlias:
         break;
       case llvm::AliasResult::MayAlias: // no break
@@ -237,7 +216,7 @@ void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
       case llvm::AliasResult::PartialAlias: // no break
         [[fallthrough]];
       case llvm::AliasResult::MustAlias:
-        boost::add_edge(I1->second, I2->second, PAG);
+        addEdge(PointerVertices[I1], PointerVertices[I2]);
         break;
       default:
         break;
@@ -257,11 +236,20 @@ AliasResult LLVMPointsToGraph::alias(const llvm::Value *V1,
                                      const llvm::Instruction * /*I*/) {
   computePointsToGraph(V1);
   computePointsToGraph(V2);
-  auto PTS = getPointsToSet(V1);
-  if (PTS->contains(V2)) {
-    return AliasResult::MustAlias;
+  return isAlias(V1, V2) ? AliasResult::MustAlias : AliasResult::NoAlias;
+}
+
+bool LLVMPointsToGraph::isAlias(const llvm::Value *V1,
+                                const llvm::Value *V2) const {
+  if (V1 == V2) {
+    return true;
   }
-  return AliasResult::NoAlias;
+  auto It1 = ValueVertexMap.find(V1);
+  auto It2 = ValueVertexMap.find(V2);
+  if (It1 == ValueVertexMap.end() || It2 == ValueVertexMap.end()) {
+    return false;
+  }
+  return findComponent(It1->second) == findComponent(It2->second);
 }
 
 auto LLVMPointsToGraph::getReachableAllocationSites(
@@ -269,12 +257,29 @@ auto LLVMPointsToGraph::getReachableAllocationSites(
     const llvm::Instruction * /*I*/) -> AllocationSiteSetPtrTy {
   computePointsToGraph(V);
   auto AllocSites = std::make_unique<PointsToSetTy>();
-  AllocationSiteDFSVisitor AllocVis(*AllocSites, {});
-  vector<boost::default_color_type> ColorMap(boost::num_vertices(PAG));
-  boost::depth_first_visit(
-      PAG, ValueVertexMap[V], AllocVis,
-      boost::make_iterator_property_map(
-          ColorMap.begin(), boost::get(boost::vertex_index, PAG), ColorMap[0]));
+  auto It = ValueVertexMap.find(V);
+  if (It == ValueVertexMap.end()) {
+    return AllocSites;
+  }
+  foreachInComponent(It->second, [this, &AllocSites](vertex_t Vtx) {
+    const auto *Val = Vertices[Vtx];
+    // check for stack allocation
+    if (llvm::isa<llvm::AllocaInst>(Val)) {
+      PHASAR_LOG_LEVEL(DEBUG, "Found stack allocation: " << llvmIRToString(Val));
+      AllocSites->insert(Val);
+      return;
+    }
+    // check for heap allocation
+    if (const auto *CallSite = llvm::dyn_cast<llvm::CallBase>(Val)) {
+      if (CallSite->getCalledFunction() != nullptr &&
+          HeapAllocatingFunctions.count(
+              CallSite->getCalledFunction()->getName())) {
+        PHASAR_LOG_LEVEL(DEBUG,
+                         "Found heap allocation: " << llvmIRToString(CallSite));
+        AllocSites->insert(Val);
+      }
+    }
+  });
   return AllocSites;
 }
 
@@ -293,19 +298,30 @@ void LLVMPointsToGraph::mergeWith(
     llvm::report_fatal_error(
         "LLVMPointsToSet can only be merged with another LLVMPointsToSet!");
   }
-  AnalyzedFunctions.insert(OtherPTI->AnalyzedFunctions.begin(),
-                           OtherPTI->AnalyzedFunctions.end());
-  using vertex_t = graph_t::vertex_descriptor;
-  using vertex_map_t = std::map<vertex_t, vertex_t>;
-  vertex_map_t OldToNewVertexMapping;
-  boost::associative_property_map<vertex_map_t> VertexMapWrapper(
-      OldToNewVertexMapping);
-  boost::copy_graph(OtherPTI->PAG, PAG, boost::orig_to_copy(VertexMapWrapper));
-  for (const auto &OtherValues : OtherPTI->ValueVertexMap) {
-    auto Search = OldToNewVertexMapping.find(OtherValues.second);
-    if (Search != OldToNewVertexMapping.end()) {
-      ValueVertexMap.insert(make_pair(OtherValues.first, Search->second));
+  for (const auto *F : OtherPTI->AnalyzedFunctions) {
+    if (!AnalyzedFunctions.insert(F)) {
+      continue;
+    }
+    if (auto It = OtherPTI->EscapingParams.find(F);
+        It != OtherPTI->EscapingParams.end()) {
+      EscapingParams[F] = It->second;
     }
+    if (auto It = OtherPTI->EscapingReturns.find(F);
+        It != OtherPTI->EscapingReturns.end()) {
+      EscapingReturns[F] = It->second;
+    }
+  }
+  // Merge the vertices and edges in one batch; the components are joined
+  // in the union-find and the adjacency is rebuilt at most once afterwards
+  std::vector<vertex_t> OldToNewVertexMapping;
+  OldToNewVertexMapping.reserve(OtherPTI->Vertices.size());
+  for (const auto *V : OtherPTI->Vertices) {
+    OldToNewVertexMapping.push_back(getOrCreateVertex(V));
+  }
+  Edges.reserve(Edges.size() + OtherPTI->Edges.size());
+  for (const auto &Edge : OtherPTI->Edges) {
+    addEdge(OldToNewVertexMapping[Edge.Source],
+            OldToNewVertexMapping[Edge.Target], Edge.V);
   }
 }
 
@@ -315,60 +331,56 @@ void LLVMPointsToGraph::introduceAlias(const llvm::Value *V1,
                                        AliasResult /*Kind*/) {
   computePointsToGraph(V1);
   computePointsToGraph(V2);
-  auto Vert1 = ValueVertexMap[V1];
-  auto Vert2 = ValueVertexMap[V2];
-  boost::add_edge(Vert1, Vert2, I, PAG);
+  auto Vert1 = getOrCreateVertex(V1);
+  auto Vert2 = getOrCreateVertex(V2);
+  addEdge(Vert1, Vert2, I);
 }
 
 vector<pair<unsigned, const llvm::Value *>>
 LLVMPointsToGraph::getPointersEscapingThroughParams() {
   vector<pair<unsigned, const llvm::Value *>> EscapingPointers;
-  for (auto VertexIter : boost::make_iterator_range(boost::vertices(PAG))) {
-    if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(PAG[VertexIter].V)) {
-      EscapingPointers.emplace_back(Arg->getArgNo(), Arg);
-    }
+  for (const auto *F : AnalyzedFunctions) {
+    auto Params = getPointersEscapingThroughParamsForFunction(F);
+    EscapingPointers.insert(EscapingPointers.end(), Params.begin(),
+                            Params.end());
   }
   return EscapingPointers;
 }
 
+llvm::ArrayRef<pair<unsigned, const llvm::Value *>>
+LLVMPointsToGraph::getPointersEscapingThroughParamsForFunction(
+    const llvm::Function *F) const {
+  auto It = EscapingParams.find(F);
+  if (It == EscapingParams.end()) {
+    return {};
+  }
+  return It->second;
+}
+
 vector<const llvm::Value *>
 LLVMPointsToGraph::getPointersEscapingThroughReturns() const {
   vector<const llvm::Value *> EscapingPointers;
-  for (auto VertexIter : boost::make_iterator_range(boost::vertices(PAG))) {
-    const auto &Vertex = PAG[VertexIter];
-    for (const auto *const User : Vertex.getUsers()) {
-      if (llvm::isa<llvm::ReturnInst>(User)) {
-        EscapingPointers.push_back(Vertex.V);
-      }
+  for (const auto *F : AnalyzedFunctions) {
+    if (auto It = EscapingReturns.find(F); It != EscapingReturns.end()) {
+      EscapingPointers.insert(EscapingPointers.end(), It->second.begin(),
+                              It->second.end());
     }
   }
   return EscapingPointers;
 }
 
-vector<const llvm::Value *>
+llvm::ArrayRef<const llvm::Value *>
 LLVMPointsToGraph::getPointersEscapingThroughReturnsForFunction(
     const llvm::Function *F) const {
-  vector<const llvm::Value *> EscapingPointers;
-  for (auto VertexIter : boost::make_iterator_range(boost::vertices(PAG))) {
-    const auto &Vertex = PAG[VertexIter];
-    for (const auto *const User : Vertex.getUsers()) {
-      if (const auto *R = llvm::dyn_cast<llvm::ReturnInst>(User)) {
-        if (R->getFunction() == F) {
-          EscapingPointers.push_back(Vertex.V);
-        }
-      }
-    }
+  auto It = EscapingReturns.find(F);
+  if (It == EscapingReturns.end()) {
+    return {};
   }
-  return EscapingPointers;
+  return It->second;
 }
 
 bool LLVMPointsToGraph::containsValue(llvm::Value *V) {
-  for (auto VertexIter : boost::make_iterator_range(boost::vertices(PAG))) {
-    if (PAG[VertexIter].V == V) {
-      return true;
-    }
-  }
-  return false;
+  return ValueVertexMap.count(V);
 }
 
 auto LLVMPointsToGraph::getPointsToSet(const llvm::Value *V,
@@ -377,16 +389,7 @@ auto LLVMPointsToGraph::getPointsToSet(const llvm::Value *V,
   PAMM_GET_INSTANCE;
   INC_COUNTER("[Calls] getPointsToSet", 1, PAMM_SEVERITY_LEVEL::Full);
   START_TIMER("PointsTo-Set Computation", PAMM_SEVERITY_LEVEL::Full);
-  const auto *VF = retrieveFunction(V);
-  computePointsToGraph(VF);
-  // check if the graph contains a corresponding vertex
-  set<vertex_t> ReachableVertices;
-  ReachabilityDFSVisitor Vis(ReachableVertices);
-  vector<boost::default_color_type> ColorMap(boost::num_vertices(PAG));
-  boost::depth_first_visit(
-      PAG, ValueVertexMap.at(V), Vis,
-      boost::make_iterator_property_map(
-          ColorMap.begin(), boost::get(boost::vertex_index, PAG), ColorMap[0]));
+  computePointsToGraph(V);
   auto ResultSet = [this, V] {
     auto &Ret = Cache[V];
 
@@ -397,8 +400,14 @@ auto LLVMPointsToGraph::getPointsToSet(const llvm::Value *V,
     return Ret;
   }();
 
-  for (auto Vertex : ReachableVertices) {
-    ResultSet->insert(PAG[Vertex].V);
+  // Components only grow, so the cached set is up-to-date if its size matches
+  // the size of the component
+  auto It = ValueVertexMap.find(V);
+  if (It != ValueVertexMap.end() &&
+      ResultSet->size() != ComponentSize[findComponent(It->second)]) {
+    foreachInComponent(It->second, [this, &ResultSet](vertex_t Vtx) {
+      ResultSet->insert(Vertices[Vtx]);
+    });
   }
   PAUSE_TIMER("PointsTo-Set Computation", PAMM_SEVERITY_LEVEL::Full);
   ADD_TO_HISTOGRAM("Points-to", ResultSet->size(), 1,
@@ -407,56 +416,57 @@ auto LLVMPointsToGraph::getPointsToSet(const llvm::Value *V,
 }
 
 void LLVMPointsToGraph::print(llvm::raw_ostream &OS) const {
-  for (const auto &Fn : AnalyzedFunctions) {
-    llvm::outs() << "LLVMPointsToGraph for " << Fn->getName() << ":\n";
-    vertex_iterator UI;
-
-    vertex_iterator UIEnd;
-    for (boost::tie(UI, UIEnd) = boost::vertices(PAG); UI != UIEnd; ++UI) {
-      OS << PAG[*UI].getValueAsString() << " <--> ";
-      out_edge_iterator EI;
-
-      out_edge_iterator EIEnd;
-      for (boost::tie(EI, EIEnd) = boost::out_edges(*UI, PAG); EI != EIEnd;
-           ++EI) {
-        OS << PAG[target(*EI, PAG)].getValueAsString() << " ";
-      }
-      OS << '\n';
+  buildAdjacency();
+  OS << "LLVMPointsToGraph for";
+  for (const auto *Fn : AnalyzedFunctions) {
+    OS << ' ' << Fn->getName();
+  }
+  OS << ":\n";
+  for (vertex_t Vtx = 0; Vtx < Vertices.size(); ++Vtx) {
+    OS << llvmIRToString(Vertices[Vtx]) << " <--> ";
+    for (auto I = AdjacencyOffsets[Vtx], End = AdjacencyOffsets[Vtx + 1];
+         I != End; ++I) {
+      const auto &Edge = Edges[AdjacentEdges[I]];
+      auto Adj = Edge.Source == Vtx ? Edge.Target : Edge.Source;
+      OS << llvmIRToString(Vertices[Adj]) << " ";
     }
+    OS << '\n';
   }
 }
 
 void LLVMPointsToGraph::printAsDot(llvm::raw_ostream &OS) const {
-  std::stringstream S;
-  boost::write_graphviz(S, PAG, makePointerVertexOrEdgePrinter(PAG),
-                        makePointerVertexOrEdgePrinter(PAG));
-  OS << S.str();
+  OS << "graph G {\n";
+  for (vertex_t Vtx = 0; Vtx < Vertices.size(); ++Vtx) {
+    OS << Vtx << "[label=\"" << llvmIRToString(Vertices[Vtx]) << "\"];\n";
+  }
+  for (const auto &Edge : Edges) {
+    OS << Edge.Source << "--" << Edge.Target << " [label=\""
+       << Edge.getValueAsString() << "\"];\n";
+  }
+  OS << "}\n";
 }
 
 nlohmann::json LLVMPointsToGraph::getAsJson() const {
+  buildAdjacency();
   nlohmann::json J;
-  vertex_iterator VIv;
-
-  vertex_iterator VIvEnd;
-  out_edge_iterator EI;
-
-  out_edge_iterator EIEnd;
+  auto &PTG = J[PhasarConfig::JsonPointsToGraphID()];
   // iterate all graph vertices
-  for (boost::tie(VIv, VIvEnd) = boost::vertices(PAG); VIv != VIvEnd; ++VIv) {
-    J[PhasarConfig::JsonPointsToGraphID()][PAG[*VIv].getValueAsString()];
-    // iterate all out edges of vertex vi_v
-    for (boost::tie(EI, EIEnd) = boost::out_edges(*VIv, PAG); EI != EIEnd;
-         ++EI) {
-      J[PhasarConfig::JsonPointsToGraphID()][PAG[*VIv].getValueAsString()] +=
-          PAG[boost::target(*EI, PAG)].getValueAsString();
+  for (vertex_t Vtx = 0; Vtx < Vertices.size(); ++Vtx) {
+    auto &Adjacent = PTG[llvmIRToString(Vertices[Vtx])];
+    // iterate all edges of the vertex
+    for (auto I = AdjacencyOffsets[Vtx], End = AdjacencyOffsets[Vtx + 1];
+         I != End; ++I) {
+      const auto &Edge = Edges[AdjacentEdges[I]];
+      auto Adj = Edge.Source == Vtx ? Edge.Target : Edge.Source;
+      Adjacent += llvmIRToString(Vertices[Adj]);
     }
   }
   return J;
 }
 
 void LLVMPointsToGraph::printValueVertexMap() {
-  for (const auto &Entry : ValueVertexMap) {
-    llvm::outs() << Entry.first << " <---> " << Entry.second << '\n';
+  for (vertex_t Vtx = 0; Vtx < Vertices.size(); ++Vtx) {
+    llvm::outs() << Vertices[Vtx] << " <---> " << Vtx << '\n';
   }
 }
 
@@ -464,11 +474,11 @@ bool LLVMPointsToGraph::empty() const { return size() == 0; }
 
 size_t LLVMPointsToGraph::size() const { return getNumVertices(); }
 
-size_t LLVMPointsToGraph::getNumVertices() const {
-  return boost::num_vertices(PAG);
-}
+size_t LLVMPointsToGraph::getNumVertices() const { return Vertices.size(); }
+
+size_t LLVMPointsToGraph::getNumEdges() const { return Edges.size(); }
 
-size_t LLVMPointsToGraph::getNumEdges() const { return boost::num_edges(PAG); }
+size_t LLVMPointsToGraph::getNumComponents() const { return NumComponents; }
 
 void LLVMPointsToGraph::printAsJson(llvm::raw_ostream &OS) const {
   nlohmann::json J = getAsJson();
@@ -31,4 +31,11 @@ const llvm::Function *LLVMPointsToInfo::retrieveFunction(const llvm::Value *V) {
   return nullptr;
 }
 
+auto LLVMPointsToInfo::getPointsToSetInContext(
+    const llvm::Value *V,
+    [[maybe_unused]] llvm::ArrayRef<const llvm::CallBase *> CallString)
+    -> PointsToSetPtrTy {
+  return getPointsToSet(V);
+}
+
 } // namespace psr
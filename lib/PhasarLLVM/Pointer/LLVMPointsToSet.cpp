@@ -14,11 +14,13 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -30,6 +32,7 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -39,6 +42,7 @@
 
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMContextSensitivePointsToQuery.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
@@ -55,9 +59,25 @@ template class DynamicPointsToSetConstPtr<>;
 template class PointsToSetOwner<LLVMPointsToInfo::PointsToSetTy>;
 
 LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB, bool UseLazyEvaluation,
-                                 PointerAnalysisType PATy)
-    : PTA(IRDB, UseLazyEvaluation, PATy) {
+                                 PointerAnalysisType PATy,
+                                 unsigned FieldSensitivityDepth)
+    : PTA(IRDB, UseLazyEvaluation, PATy),
+      FieldSensitivityDepth(FieldSensitivityDepth) {
+  initialize(IRDB, UseLazyEvaluation);
+}
+
+LLVMPointsToSet::LLVMPointsToSet(
+    ProjectIRDB &IRDB,
+    LLVMBasedPointsToAnalysis::AAResultsGetterTy GetAAResults,
+    bool UseLazyEvaluation, unsigned FieldSensitivityDepth)
+    : PTA(std::move(GetAAResults)),
+      FieldSensitivityDepth(FieldSensitivityDepth) {
+  initialize(IRDB, UseLazyEvaluation);
+}
 
+LLVMPointsToSet::~LLVMPointsToSet() = default;
+
+void LLVMPointsToSet::initialize(ProjectIRDB &IRDB, bool UseLazyEvaluation) {
   auto NumGlobals = IRDB.getNumGlobals();
   PointsToSets.reserve(NumGlobals);
   Owner.reserve(NumGlobals);
@@ -169,7 +189,9 @@ void LLVMPointsToSet::computeValuesPointsToSet(const llvm::Value *V) {
                                            // LLVM
               (Inst->getFunction()));
           if (!llvm::isa<llvm::Function>(G) && isInterestingPointer(User)) {
-            mergePointsToSets(User, G);
+            if (!isDistinctField(G->getParent()->getDataLayout(), User, G)) {
+              mergePointsToSets(User, G);
+            }
           } else if (const auto *Store =
                          llvm::dyn_cast<llvm::StoreInst>(User)) {
             if (isInterestingPointer(Store->getValueOperand())) {
@@ -310,6 +332,60 @@ bool LLVMPointsToSet::intraIsReachableAllocationSiteTy(
   return false;
 }
 
+/// Decomposes V into the pointer it is derived from and the constant offset
+/// in bytes that the (at most MaxDepth) GEPs on top of it add. Returns
+/// std::nullopt if any of the GEPs has a non-constant index or if there are
+/// more than MaxDepth GEPs.
+static std::optional<std::pair<const llvm::Value *, int64_t>>
+getConstantAccessPath(const llvm::DataLayout &DL, const llvm::Value *V,
+                      unsigned MaxDepth) {
+  int64_t Offset = 0;
+  unsigned Depth = 0;
+  V = V->stripPointerCasts();
+  while (const auto *GEP = llvm::dyn_cast<llvm::GEPOperator>(V)) {
+    llvm::APInt GEPOffset(DL.getIndexTypeSizeInBits(GEP->getType()), 0);
+    if (Depth == MaxDepth || !GEP->accumulateConstantOffset(DL, GEPOffset)) {
+      return std::nullopt;
+    }
+    Offset += GEPOffset.getSExtValue();
+    ++Depth;
+    V = GEP->getPointerOperand()->stripPointerCasts();
+  }
+  return std::make_pair(V, Offset);
+}
+
+bool LLVMPointsToSet::isDistinctField(const llvm::DataLayout &DL,
+                                      const llvm::Value *V1,
+                                      const llvm::Value *V2) const {
+  if (!FieldSensitivityDepth) {
+    return false;
+  }
+  const llvm::Value *Base = nullptr;
+  // Collects the offsets of V and the members of its points-to set from Base
+  auto CollectOffsets = [&](const llvm::Value *V,
+                            llvm::SmallDenseSet<int64_t, 4> &Offsets) {
+    auto AddOffset = [&](const llvm::Value *Member) {
+      auto Path = getConstantAccessPath(DL, Member, FieldSensitivityDepth);
+      if (!Path || (Base && Path->first != Base)) {
+        return false;
+      }
+      Base = Path->first;
+      Offsets.insert(Path->second);
+      return true;
+    };
+    if (auto It = PointsToSets.find(V); It != PointsToSets.end()) {
+      return llvm::all_of(*It->second, AddOffset);
+    }
+    return AddOffset(V);
+  };
+  llvm::SmallDenseSet<int64_t, 4> Offsets1;
+  llvm::SmallDenseSet<int64_t, 4> Offsets2;
+  return CollectOffsets(V1, Offsets1) && CollectOffsets(V2, Offsets2) &&
+         llvm::none_of(Offsets2, [&Offsets1](int64_t Offset) {
+           return Offsets1.count(Offset);
+         });
+}
+
 static bool mayAlias(llvm::AAResults &AA, const llvm::DataLayout &DL,
                      const llvm::Value *V, const llvm::Value *Rep) {
   assert(V->getType()->isPointerTy());
@@ -338,7 +414,7 @@ void LLVMPointsToSet::addPointer(llvm::AAResults &AA,
   llvm::SmallVector<unsigned> ToMerge;
 
   for (unsigned It = 0, End = Reps.size(); It < End; ++It) {
-    if (mayAlias(AA, DL, V, Reps[It])) {
+    if (!isDistinctField(DL, V, Reps[It]) && mayAlias(AA, DL, V, Reps[It])) {
       ToMerge.push_back(It);
     }
   }
@@ -578,6 +654,28 @@ auto LLVMPointsToSet::getPointsToSet(
   return getEmptyPointsToSet();
 }
 
+auto LLVMPointsToSet::getPointsToSetInContext(
+    const llvm::Value *V, llvm::ArrayRef<const llvm::CallBase *> CallString)
+    -> PointsToSetPtrTy {
+  if (!ContextSensitiveQuery) {
+    ContextSensitiveQuery =
+        std::make_unique<LLVMContextSensitivePointsToQuery>(*this);
+    NumAnalyzedFunctionsOfQuery = AnalyzedFunctions.size();
+  }
+  while (true) {
+    if (NumAnalyzedFunctionsOfQuery != AnalyzedFunctions.size()) {
+      ContextSensitiveQuery->clear();
+      NumAnalyzedFunctionsOfQuery = AnalyzedFunctions.size();
+    }
+    auto PTS = ContextSensitiveQuery->getPointsToSetInContext(V, CallString);
+    // The query itself may have analyzed further functions, so its results
+    // may be based on outdated points-to sets
+    if (NumAnalyzedFunctionsOfQuery == AnalyzedFunctions.size()) {
+      return PTS;
+    }
+  }
+}
+
 auto LLVMPointsToSet::getReachableAllocationSites(
     const llvm::Value *V, bool IntraProcOnly,
     [[maybe_unused]] const llvm::Instruction *I) -> AllocationSiteSetPtrTy {
@@ -649,6 +747,9 @@ void LLVMPointsToSet::mergeWith(const PointsToInfo &PTI) {
     llvm::report_fatal_error(
         "LLVMPointsToSet can only be merged with another LLVMPointsToSet!");
   }
+  if (ContextSensitiveQuery) {
+    ContextSensitiveQuery->clear();
+  }
   // merge analyzed functions
   AnalyzedFunctions.insert(OtherPTI->AnalyzedFunctions.begin(),
                            OtherPTI->AnalyzedFunctions.end());
@@ -693,6 +794,33 @@ void LLVMPointsToSet::introduceAlias(
   computeValuesPointsToSet(V1);
   computeValuesPointsToSet(V2);
   mergePointsToSets(V1, V2);
+  if (ContextSensitiveQuery) {
+    ContextSensitiveQuery->clear();
+  }
+}
+
+void LLVMPointsToSet::analyzeFunction(const llvm::Function *F) {
+  computeFunctionsPointsToSet(
+      const_cast<llvm::Function *> // NOLINT - FIXME when it is fixed in LLVM
+      (F));
+}
+
+auto LLVMPointsToSet::getPointsToSetIfComputed(const llvm::Value *V) const
+    -> std::optional<PointsToSetPtrTy> {
+  if (!isInterestingPointer(V)) {
+    return getEmptyPointsToSet();
+  }
+  if (llvm::isa<llvm::GlobalObject>(V)) {
+    return std::nullopt;
+  }
+  if (const auto *VF = retrieveFunction(V);
+      VF && !VF->isDeclaration() && !AnalyzedFunctions.count(VF)) {
+    return std::nullopt;
+  }
+  if (auto It = PointsToSets.find(V); It != PointsToSets.end()) {
+    return PointsToSetPtrTy(It->second);
+  }
+  return std::nullopt;
 }
 
 nlohmann::json LLVMPointsToSet::getAsJson() const {
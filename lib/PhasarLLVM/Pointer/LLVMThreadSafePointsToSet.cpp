@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <mutex>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMThreadSafePointsToSet.h"
+
+namespace psr {
+
+namespace {
+
+/// The points-to sets a thread has already looked up. There is only one cache
+/// per thread; it is reset when the thread queries a different facade or a
+/// new generation of snapshots has started.
+struct PointsToSetCache {
+  uint64_t OwnerId = 0;
+  uint64_t Generation = 0;
+  llvm::DenseMap<const llvm::Value *, LLVMPointsToInfo::PointsToSetPtrTy> Sets;
+};
+
+PointsToSetCache &getPointsToSetCache(uint64_t OwnerId, uint64_t Generation) {
+  thread_local PointsToSetCache Cache;
+  if (Cache.OwnerId != OwnerId || Cache.Generation != Generation) {
+    Cache.Sets.clear();
+    Cache.OwnerId = OwnerId;
+    Cache.Generation = Generation;
+  }
+  return Cache;
+}
+
+/// The points-to sets only ever grow, so most changes already show in the size
+bool isSameSet(const LLVMPointsToInfo::PointsToSetTy &Snap,
+               const LLVMPointsToInfo::PointsToSetTy &PTS) {
+  return Snap.size() == PTS.size() &&
+         llvm::all_of(PTS, [&Snap](const auto *V) { return Snap.count(V); });
+}
+
+uint64_t getNextFacadeId() {
+  static std::atomic<uint64_t> NextId{1};
+  return NextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+LLVMThreadSafePointsToSet::LLVMThreadSafePointsToSet(LLVMPointsToSet &PT)
+    : PT(PT), Id(getNextFacadeId()) {}
+
+void LLVMThreadSafePointsToSet::freeze(const ProjectIRDB &IRDB) {
+  std::unique_lock Lock(Mtx);
+  for (const auto *M : IRDB.getAllModules()) {
+    for (const auto &F : *M) {
+      if (!F.isDeclaration()) {
+        PT.analyzeFunction(&F);
+      }
+    }
+    for (const auto &G : M->globals()) {
+      FrozenGlobals.try_emplace(&G, PT.getPointsToSet(&G));
+    }
+    for (const auto &F : *M) {
+      FrozenGlobals.try_emplace(&F, PT.getPointsToSet(&F));
+    }
+  }
+  Frozen.store(true, std::memory_order_release);
+  // Let the threads replace their snapshots by the final points-to sets
+  Generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool LLVMThreadSafePointsToSet::isInterProcedural() const {
+  return PT.isInterProcedural();
+}
+
+PointerAnalysisType LLVMThreadSafePointsToSet::getPointerAnalysistype() const {
+  return PT.getPointerAnalysistype();
+}
+
+auto LLVMThreadSafePointsToSet::snapshot(const llvm::Value *V,
+                                         PointsToSetPtrTy PTS)
+    -> PointsToSetPtrTy {
+  if (isFrozen()) {
+    return PTS;
+  }
+  std::lock_guard Lock(SnapshotMtx);
+  auto &Snap = Snapshots[V];
+  auto CurrGeneration = Generation.load(std::memory_order_acquire);
+  if (Snap.Set && Snap.Generation != CurrGeneration &&
+      isSameSet(**Snap.Set, *PTS)) {
+    // The set has not changed in the new generation, so the snapshot of the
+    // previous one still fits
+    Snap.Generation = CurrGeneration;
+  }
+  if (!Snap.Set || Snap.Generation != CurrGeneration) {
+    auto &Set = SnapshotSets.emplace_back(*PTS);
+    Snap.Set = &SnapshotSlots.emplace_back(&Set);
+    Snap.Generation = CurrGeneration;
+  }
+  return PointsToSetPtrTy(Snap.Set);
+}
+
+void LLVMThreadSafePointsToSet::updateGeneration(size_t NumAnalyzedFunctions) {
+  if (PT.getNumAnalyzedFunctions() != NumAnalyzedFunctions) {
+    Generation.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+auto LLVMThreadSafePointsToSet::lookupOrComputePointsToSet(const llvm::Value *V)
+    -> PointsToSetPtrTy {
+  {
+    std::shared_lock Lock(Mtx);
+    if (auto PTS = PT.getPointsToSetIfComputed(V)) {
+      return snapshot(V, *PTS);
+    }
+    if (isFrozen()) {
+      if (auto It = FrozenGlobals.find(V); It != FrozenGlobals.end()) {
+        return It->second;
+      }
+    }
+  }
+  // V's function has not been analyzed, yet, or V is not part of any function
+  std::unique_lock Lock(Mtx);
+  auto NumAnalyzedFunctions = PT.getNumAnalyzedFunctions();
+  auto PTS = PT.getPointsToSet(V);
+  updateGeneration(NumAnalyzedFunctions);
+  return snapshot(V, PTS);
+}
+
+AliasResult
+LLVMThreadSafePointsToSet::alias(const llvm::Value *V1, const llvm::Value *V2,
+                                 [[maybe_unused]] const llvm::Instruction *I) {
+  // if V1 or V2 is not an interesting pointer those values cannot alias
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return AliasResult::NoAlias;
+  }
+  auto PTS = getPointsToSet(V1);
+  // Make sure that V2's function has been analyzed as well
+  (void)getPointsToSet(V2);
+  std::shared_lock Lock(Mtx);
+  return PTS->count(V2) ? AliasResult::MayAlias : AliasResult::NoAlias;
+}
+
+auto LLVMThreadSafePointsToSet::getPointsToSet(
+    const llvm::Value *V, [[maybe_unused]] const llvm::Instruction *I)
+    -> PointsToSetPtrTy {
+  auto &Cache =
+      getPointsToSetCache(Id, Generation.load(std::memory_order_acquire));
+  if (auto It = Cache.Sets.find(V); It != Cache.Sets.end()) {
+    return It->second;
+  }
+  auto PTS = lookupOrComputePointsToSet(V);
+  Cache.Sets.try_emplace(V, PTS);
+  return PTS;
+}
+
+auto LLVMThreadSafePointsToSet::getPointsToSetInContext(
+    const llvm::Value *V, llvm::ArrayRef<const llvm::CallBase *> CallString)
+    -> PointsToSetPtrTy {
+  // The refinement is memoized inside of PT, so it must not run concurrently
+  std::unique_lock Lock(Mtx);
+  auto NumAnalyzedFunctions = PT.getNumAnalyzedFunctions();
+  auto PTS = PT.getPointsToSetInContext(V, CallString);
+  updateGeneration(NumAnalyzedFunctions);
+  // The refined points-to sets never change, but the query falls back to the
+  // context-insensitive points-to set, which does
+  if (PTS == PT.getPointsToSet(V)) {
+    return snapshot(V, PTS);
+  }
+  return PTS;
+}
+
+auto LLVMThreadSafePointsToSet::getReachableAllocationSites(
+    const llvm::Value *V, bool IntraProcOnly, const llvm::Instruction *I)
+    -> AllocationSiteSetPtrTy {
+  std::unique_lock Lock(Mtx);
+  auto NumAnalyzedFunctions = PT.getNumAnalyzedFunctions();
+  auto AllocSites = PT.getReachableAllocationSites(V, IntraProcOnly, I);
+  updateGeneration(NumAnalyzedFunctions);
+  return AllocSites;
+}
+
+bool LLVMThreadSafePointsToSet::isInReachableAllocationSites(
+    const llvm::Value *V, const llvm::Value *PotentialValue, bool IntraProcOnly,
+    const llvm::Instruction *I) {
+  std::unique_lock Lock(Mtx);
+  auto NumAnalyzedFunctions = PT.getNumAnalyzedFunctions();
+  bool Ret =
+      PT.isInReachableAllocationSites(V, PotentialValue, IntraProcOnly, I);
+  updateGeneration(NumAnalyzedFunctions);
+  return Ret;
+}
+
+void LLVMThreadSafePointsToSet::mergeWith(const PointsToInfo &PTI) {
+  if (isFrozen()) {
+    llvm::report_fatal_error(
+        "Cannot merge points-to information into a frozen points-to set!");
+  }
+  std::unique_lock Lock(Mtx);
+  PT.mergeWith(PTI);
+  Generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void LLVMThreadSafePointsToSet::introduceAlias(const llvm::Value *V1,
+                                               const llvm::Value *V2,
+                                               const llvm::Instruction *I,
+                                               AliasResult Kind) {
+  if (isFrozen()) {
+    llvm::report_fatal_error(
+        "Cannot introduce an alias into a frozen points-to set!");
+  }
+  // Subsequent queries see the merged sets, as they start a new generation of
+  // snapshots
+  std::unique_lock Lock(Mtx);
+  PT.introduceAlias(V1, V2, I, Kind);
+  Generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void LLVMThreadSafePointsToSet::print(llvm::raw_ostream &OS) const {
+  std::shared_lock Lock(Mtx);
+  PT.print(OS);
+}
+
+nlohmann::json LLVMThreadSafePointsToSet::getAsJson() const {
+  std::shared_lock Lock(Mtx);
+  return PT.getAsJson();
+}
+
+void LLVMThreadSafePointsToSet::printAsJson(llvm::raw_ostream &OS) const {
+  std::shared_lock Lock(Mtx);
+  PT.printAsJson(OS);
+}
+
+} // namespace psr
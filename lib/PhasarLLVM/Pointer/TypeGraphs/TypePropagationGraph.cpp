@@ -0,0 +1,254 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/Pointer/TypeGraphs/TypePropagationGraph.h"
+
+namespace psr {
+
+static std::string getTypeGraphName(const llvm::StructType *Type) {
+  if (!Type->isLiteral()) {
+    return Type->getName().str();
+  }
+  std::string Name;
+  llvm::raw_string_ostream OS(Name);
+  OS << "literal_" << static_cast<const void *>(Type);
+  return OS.str();
+}
+
+static bool containsTypeId(const llvm::BitVector &Ids,
+                           TypePropagationGraph::TypeId Id) {
+  return Id < Ids.size() && Ids.test(Id);
+}
+
+auto TypePropagationGraph::addType(const llvm::StructType *Type) -> TypeId {
+  if (auto It = TypeIds.find(Type); It != TypeIds.end()) {
+    return It->second;
+  }
+  auto Name = getTypeGraphName(Type);
+  auto [It, Inserted] = NameIds.try_emplace(Name, TypeId(Types.size()));
+  TypeIds[Type] = It->second;
+  if (!Inserted) {
+    return It->second;
+  }
+
+  auto Id = It->second;
+  Types.push_back(Type);
+  Names.push_back(std::move(Name));
+  Successors.emplace_back();
+  Predecessors.emplace_back();
+  Parent.push_back(Id);
+  NextInComponent.push_back(Id);
+  Reachable.emplace_back(Id + 1);
+  Reachable.back().set(Id);
+  ++NumComponents;
+  return Id;
+}
+
+auto TypePropagationGraph::getTypeId(const llvm::StructType *Type) const
+    -> std::optional<TypeId> {
+  if (auto It = TypeIds.find(Type); It != TypeIds.end()) {
+    return It->second;
+  }
+  if (auto It = NameIds.find(getTypeGraphName(Type)); It != NameIds.end()) {
+    return It->second;
+  }
+  return std::nullopt;
+}
+
+bool TypePropagationGraph::insertEdge(TypeId From, TypeId To) {
+  if (!EdgeSet.insert({From, To}).second) {
+    return false;
+  }
+  Successors[From].push_back(To);
+  Predecessors[To].push_back(From);
+  return true;
+}
+
+bool TypePropagationGraph::addEdge(TypeId From, TypeId To) {
+  if (!insertEdge(From, To)) {
+    return false;
+  }
+  ClosureStale = true;
+  return true;
+}
+
+bool TypePropagationGraph::addEdgeAndPropagate(TypeId From, TypeId To) {
+  if (!insertEdge(From, To)) {
+    return false;
+  }
+  auto ToRep = findRepresentative(To);
+  if (findRepresentative(From) == ToRep) {
+    return true;
+  }
+  // If the reachable types are exact, the new edge closes a cycle iff From is
+  // reachable from To. All components that are reachable from To and that
+  // reach From are on such a cycle.
+  if (!ClosureStale && containsTypeId(Reachable[ToRep], From)) {
+    llvm::SmallVector<TypeId, 4> Cycle;
+    for (auto Id : Reachable[ToRep].set_bits()) {
+      if (findRepresentative(Id) == Id &&
+          containsTypeId(Reachable[Id], From)) {
+        Cycle.push_back(Id);
+      }
+    }
+    for (auto Rep : Cycle) {
+      ToRep = mergeComponents(ToRep, Rep);
+    }
+  }
+  propagateToPredecessors(ToRep);
+  return true;
+}
+
+void TypePropagationGraph::propagateToPredecessors(TypeId Id) {
+  llvm::SmallVector<TypeId, 8> Worklist = {findRepresentative(Id)};
+  while (!Worklist.empty()) {
+    auto Curr = Worklist.pop_back_val();
+    foreachInComponent(Curr, [this, Curr, &Worklist](TypeId Member) {
+      for (auto Pred : Predecessors[Member]) {
+        auto PredRep = findRepresentative(Pred);
+        // Only visit predecessors that are missing some of the types
+        if (PredRep != Curr && Reachable[Curr].test(Reachable[PredRep])) {
+          Reachable[PredRep] |= Reachable[Curr];
+          Worklist.push_back(PredRep);
+        }
+      }
+    });
+  }
+}
+
+void TypePropagationGraph::computeClosure() {
+  auto NumTypes = getNumTypes();
+  for (TypeId Id = 0; Id < NumTypes; ++Id) {
+    Parent[Id] = Id;
+    NextInComponent[Id] = Id;
+    Reachable[Id].clear();
+  }
+  NumComponents = NumTypes;
+
+  // Tarjan's algorithm; it finishes the components in reverse topological
+  // order, so the bitsets of all successor components are complete when a
+  // component is finished.
+  static constexpr auto Unvisited = std::numeric_limits<TypeId>::max();
+  std::vector<TypeId> Index(NumTypes, Unvisited);
+  std::vector<TypeId> LowLink(NumTypes);
+  std::vector<bool> OnStack(NumTypes);
+  std::vector<TypeId> Stack;
+  std::vector<std::pair<TypeId, unsigned>> CallStack;
+  TypeId NextIndex = 0;
+
+  auto Visit = [&](TypeId Id) {
+    Index[Id] = LowLink[Id] = NextIndex++;
+    Stack.push_back(Id);
+    OnStack[Id] = true;
+    CallStack.emplace_back(Id, 0);
+  };
+
+  for (TypeId Root = 0; Root < NumTypes; ++Root) {
+    if (Index[Root] != Unvisited) {
+      continue;
+    }
+    Visit(Root);
+    while (!CallStack.empty()) {
+      auto [Curr, SuccIdx] = CallStack.back();
+      if (SuccIdx < Successors[Curr].size()) {
+        ++CallStack.back().second;
+        auto Succ = Successors[Curr][SuccIdx];
+        if (Index[Succ] == Unvisited) {
+          Visit(Succ);
+        } else if (OnStack[Succ]) {
+          LowLink[Curr] = std::min(LowLink[Curr], Index[Succ]);
+        }
+        continue;
+      }
+
+      CallStack.pop_back();
+      if (!CallStack.empty()) {
+        auto &CallerLowLink = LowLink[CallStack.back().first];
+        CallerLowLink = std::min(CallerLowLink, LowLink[Curr]);
+      }
+      if (LowLink[Curr] != Index[Curr]) {
+        continue;
+      }
+
+      llvm::BitVector Types(NumTypes);
+      auto Rep = Curr;
+      TypeId Member;
+      do {
+        Member = Stack.back();
+        Stack.pop_back();
+        OnStack[Member] = false;
+        Types.set(Member);
+        Rep = mergeComponents(Rep, Member);
+      } while (Member != Curr);
+      foreachInComponent(Rep, [this, Rep, &Types](TypeId Member) {
+        for (auto Succ : Successors[Member]) {
+          auto SuccRep = findRepresentative(Succ);
+          if (SuccRep != Rep) {
+            Types |= Reachable[SuccRep];
+          }
+        }
+      });
+      Reachable[Rep] = std::move(Types);
+    }
+  }
+  ClosureStale = false;
+}
+
+std::set<const llvm::StructType *>
+TypePropagationGraph::getReachableTypes(TypeId Id) const {
+  std::set<const llvm::StructType *> Ret;
+  for (auto ReachableId : getReachableTypeIds(Id).set_bits()) {
+    Ret.insert(Types[ReachableId]);
+  }
+  return Ret;
+}
+
+auto TypePropagationGraph::findRepresentative(TypeId Id) const -> TypeId {
+  // path halving
+  while (Parent[Id] != Id) {
+    Parent[Id] = Parent[Parent[Id]];
+    Id = Parent[Id];
+  }
+  return Id;
+}
+
+auto TypePropagationGraph::mergeComponents(TypeId Id1, TypeId Id2) -> TypeId {
+  auto Rep1 = findRepresentative(Id1);
+  auto Rep2 = findRepresentative(Id2);
+  if (Rep1 == Rep2) {
+    return Rep1;
+  }
+  Parent[Rep2] = Rep1;
+  std::swap(NextInComponent[Rep1], NextInComponent[Rep2]);
+  Reachable[Rep1] |= Reachable[Rep2];
+  Reachable[Rep2] = llvm::BitVector();
+  --NumComponents;
+  return Rep1;
+}
+
+void TypePropagationGraph::printAsDot(llvm::raw_ostream &OS) const {
+  OS << "digraph G {\n";
+  for (TypeId Id = 0; Id < getNumTypes(); ++Id) {
+    OS << Id << "[label=\"" << Names[Id] << "\"];\n";
+  }
+  for (TypeId Id = 0; Id < getNumTypes(); ++Id) {
+    for (auto Succ : Successors[Id]) {
+      OS << Id << "->" << Succ << " ;\n";
+    }
+  }
+  OS << "}\n";
+}
+
+} // namespace psr
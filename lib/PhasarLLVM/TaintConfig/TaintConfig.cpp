@@ -510,6 +510,23 @@ TaintCategory TaintConfig::getCategory(const llvm::Value *V) const {
   return TaintCategory::None;
 }
 
+FunctionClass TaintConfig::getTaintRole(const llvm::Function *Fun) const {
+  assert(Fun != nullptr);
+  auto Role = FunctionClass::None;
+  for (const auto &Arg : Fun->args()) {
+    if (SourceValues.count(&Arg)) {
+      Role |= FunctionClass::TaintSource;
+    }
+    if (SinkValues.count(&Arg)) {
+      Role |= FunctionClass::TaintSink;
+    }
+    if (SanitizerValues.count(&Arg)) {
+      Role |= FunctionClass::TaintSanitizer;
+    }
+  }
+  return Role;
+}
+
 void TaintConfig::addSourceValue(const llvm::Value *V) {
   SourceValues.insert(V);
 }
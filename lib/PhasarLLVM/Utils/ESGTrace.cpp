@@ -0,0 +1,424 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/LEB128.h"
+
+#include "phasar/PhasarLLVM/Utils/ESGTrace.h"
+#include "phasar/Utils/IO.h"
+
+namespace psr {
+
+namespace {
+
+constexpr llvm::StringLiteral ESGTraceMagic = "PSRESG";
+
+class ESGTraceReader {
+public:
+  explicit ESGTraceReader(llvm::StringRef Buffer)
+      : Cur(Buffer.bytes_begin()), End(Buffer.bytes_end()) {}
+
+  [[nodiscard]] bool atEnd() const noexcept { return Cur == End; }
+
+  uint8_t readByte() {
+    if (Cur == End) {
+      throw std::runtime_error("Unexpected end of ESG trace");
+    }
+    return *Cur++;
+  }
+
+  uint64_t readInt() {
+    unsigned Len = 0;
+    const char *Error = nullptr;
+    uint64_t Ret = llvm::decodeULEB128(Cur, &Len, End, &Error);
+    if (Error) {
+      throw std::runtime_error(std::string("Malformed ESG trace: ") + Error);
+    }
+    Cur += Len;
+    return Ret;
+  }
+
+  uint32_t readId(size_t Bound) {
+    auto Id = readInt();
+    if (Id >= Bound) {
+      throw std::runtime_error("Malformed ESG trace: reference to id " +
+                               std::to_string(Id) + " before its definition");
+    }
+    return uint32_t(Id);
+  }
+
+  std::string readString() {
+    auto Len = readInt();
+    if (Len > size_t(End - Cur)) {
+      throw std::runtime_error("Unexpected end of ESG trace");
+    }
+    std::string Ret(reinterpret_cast<const char *>(Cur), Len);
+    Cur += Len;
+    return Ret;
+  }
+
+private:
+  const uint8_t *Cur;
+  const uint8_t *End;
+};
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// ESGTraceWriter
+
+ESGTraceWriter::ESGTraceWriter(llvm::raw_ostream &OS) : OS(OS) {
+  OS << ESGTraceMagic;
+  OS << char(Version & 0xFF) << char(Version >> 8);
+}
+
+void ESGTraceWriter::writeString(llvm::StringRef Str) {
+  llvm::encodeULEB128(Str.size(), OS);
+  OS << Str;
+}
+
+uint32_t ESGTraceWriter::addFunction(llvm::StringRef Name) {
+  OS << char(ESGTraceRecordKind::Function);
+  writeString(Name);
+  return NumFunctions++;
+}
+
+uint32_t ESGTraceWriter::addNode(uint32_t FunctionId, llvm::StringRef StmtId,
+                                 llvm::StringRef Label) {
+  assert(FunctionId < NumFunctions && "Undefined function id");
+  OS << char(ESGTraceRecordKind::Node);
+  llvm::encodeULEB128(FunctionId, OS);
+  writeString(StmtId);
+  writeString(Label);
+  return NumNodes++;
+}
+
+uint32_t ESGTraceWriter::addFact(llvm::StringRef Label, bool IsZero) {
+  OS << char(ESGTraceRecordKind::Fact);
+  writeString(Label);
+  OS << char(IsZero);
+  return NumFacts++;
+}
+
+uint32_t ESGTraceWriter::addEdgeFunctionLabel(llvm::StringRef Label) {
+  OS << char(ESGTraceRecordKind::EdgeFunctionLabel);
+  writeString(Label);
+  return NumEdgeFunctionLabels++;
+}
+
+void ESGTraceWriter::addEdge(const ESGTraceEdge &Edge) {
+  assert(Edge.FromNode < NumNodes && Edge.ToNode < NumNodes &&
+         "Undefined node id");
+  assert(Edge.FromFact < NumFacts && Edge.ToFact < NumFacts &&
+         "Undefined fact id");
+  OS << char(ESGTraceRecordKind::Edge);
+  llvm::encodeULEB128(Edge.FromNode, OS);
+  llvm::encodeULEB128(Edge.FromFact, OS);
+  llvm::encodeULEB128(Edge.ToNode, OS);
+  llvm::encodeULEB128(Edge.ToFact, OS);
+  // The label is shifted by one, such that 0 encodes "no label"
+  llvm::encodeULEB128(Edge.EdgeFunctionLabel == ESGTraceEdge::NoLabel
+                          ? 0
+                          : uint64_t(Edge.EdgeFunctionLabel) + 1,
+                      OS);
+  OS << char(Edge.IsInterProcedural);
+  ++NumEdges;
+}
+
+//===----------------------------------------------------------------------===//
+// ESGTrace
+
+ESGTrace ESGTrace::read(llvm::MemoryBufferRef Buffer) {
+  auto Data = Buffer.getBuffer();
+  if (!Data.startswith(ESGTraceMagic) ||
+      Data.size() < ESGTraceMagic.size() + 2) {
+    throw std::runtime_error(Buffer.getBufferIdentifier().str() +
+                             " is not a valid ESG trace");
+  }
+  Data = Data.drop_front(ESGTraceMagic.size());
+  uint16_t Version = uint8_t(Data[0]) | (uint16_t(uint8_t(Data[1])) << 8);
+  if (Version != ESGTraceWriter::Version) {
+    throw std::runtime_error("Unsupported ESG trace version " +
+                             std::to_string(Version));
+  }
+
+  auto Syms = std::make_shared<SymbolTables>();
+  std::vector<ESGTraceEdge> Edges;
+  ESGTraceReader Reader(Data.drop_front(2));
+  while (!Reader.atEnd()) {
+    switch (ESGTraceRecordKind(Reader.readByte())) {
+    case ESGTraceRecordKind::Function:
+      Syms->Functions.push_back({Reader.readString()});
+      break;
+    case ESGTraceRecordKind::Node: {
+      Node N;
+      N.FunctionId = Reader.readId(Syms->Functions.size());
+      N.StmtId = Reader.readString();
+      N.Label = Reader.readString();
+      Syms->Nodes.push_back(std::move(N));
+      break;
+    }
+    case ESGTraceRecordKind::Fact: {
+      Fact F;
+      F.Label = Reader.readString();
+      F.IsZero = Reader.readByte();
+      Syms->Facts.push_back(std::move(F));
+      break;
+    }
+    case ESGTraceRecordKind::EdgeFunctionLabel:
+      Syms->EdgeFunctionLabels.push_back(Reader.readString());
+      break;
+    case ESGTraceRecordKind::Edge: {
+      ESGTraceEdge E;
+      E.FromNode = Reader.readId(Syms->Nodes.size());
+      E.FromFact = Reader.readId(Syms->Facts.size());
+      E.ToNode = Reader.readId(Syms->Nodes.size());
+      E.ToFact = Reader.readId(Syms->Facts.size());
+      if (auto Label = Reader.readId(Syms->EdgeFunctionLabels.size() + 1)) {
+        E.EdgeFunctionLabel = Label - 1;
+      }
+      E.IsInterProcedural = Reader.readByte();
+      Edges.push_back(E);
+      break;
+    }
+    default:
+      throw std::runtime_error("Malformed ESG trace: unknown record kind");
+    }
+  }
+  return {std::move(Syms), std::move(Edges)};
+}
+
+ESGTrace ESGTrace::readFile(const llvm::Twine &Path) {
+  auto Buffer = psr::readFile(Path);
+  return read(*Buffer);
+}
+
+std::vector<uint32_t> ESGTrace::findNodes(llvm::StringRef StmtId) const {
+  std::vector<uint32_t> Ret;
+  for (uint32_t I = 0, E = Syms->Nodes.size(); I < E; ++I) {
+    if (Syms->Nodes[I].StmtId == StmtId) {
+      Ret.push_back(I);
+    }
+  }
+  return Ret;
+}
+
+std::vector<uint32_t> ESGTrace::findFacts(llvm::StringRef LabelPart) const {
+  std::vector<uint32_t> Ret;
+  for (uint32_t I = 0, E = Syms->Facts.size(); I < E; ++I) {
+    if (llvm::StringRef(Syms->Facts[I].Label).contains(LabelPart)) {
+      Ret.push_back(I);
+    }
+  }
+  return Ret;
+}
+
+ESGTrace ESGTrace::filterEdges(
+    llvm::function_ref<bool(const ESGTraceEdge &)> Pred) const {
+  std::vector<ESGTraceEdge> Filtered;
+  std::copy_if(Edges.begin(), Edges.end(), std::back_inserter(Filtered),
+               Pred);
+  return {Syms, std::move(Filtered)};
+}
+
+ESGTrace ESGTrace::sliceFunction(llvm::StringRef FunctionName) const {
+  llvm::BitVector InFunction(Syms->Nodes.size());
+  for (uint32_t I = 0, E = Syms->Nodes.size(); I < E; ++I) {
+    if (Syms->Functions[Syms->Nodes[I].FunctionId].Name == FunctionName) {
+      InFunction.set(I);
+    }
+  }
+  return filterEdges([&InFunction](const ESGTraceEdge &E) {
+    return InFunction.test(E.FromNode) || InFunction.test(E.ToNode);
+  });
+}
+
+ESGTrace ESGTrace::sliceFacts(llvm::ArrayRef<uint32_t> FactIds) const {
+  llvm::DenseSet<uint32_t> Selected(FactIds.begin(), FactIds.end());
+  return filterEdges([&Selected](const ESGTraceEdge &E) {
+    return Selected.count(E.FromFact) || Selected.count(E.ToFact);
+  });
+}
+
+ESGTrace ESGTrace::slicePaths(llvm::ArrayRef<Vertex> From,
+                              llvm::ArrayRef<Vertex> To) const {
+  // Number the ESG vertices densely, so that the reachability sets can be
+  // bit-vectors
+  llvm::DenseMap<std::pair<uint32_t, uint32_t>, uint32_t> VertexIds;
+  auto getVertexId = [&VertexIds](uint32_t Node, uint32_t Fact) {
+    return VertexIds.try_emplace({Node, Fact}, VertexIds.size())
+        .first->second;
+  };
+  std::vector<std::pair<uint32_t, uint32_t>> EdgeVertices;
+  EdgeVertices.reserve(Edges.size());
+  for (const auto &E : Edges) {
+    auto Src = getVertexId(E.FromNode, E.FromFact);
+    auto Dst = getVertexId(E.ToNode, E.ToFact);
+    EdgeVertices.emplace_back(Src, Dst);
+  }
+
+  std::vector<std::vector<uint32_t>> Succs(VertexIds.size());
+  std::vector<std::vector<uint32_t>> Preds(VertexIds.size());
+  for (const auto &[Src, Dst] : EdgeVertices) {
+    Succs[Src].push_back(Dst);
+    Preds[Dst].push_back(Src);
+  }
+
+  auto reach = [&VertexIds](llvm::ArrayRef<Vertex> Roots,
+                            const std::vector<std::vector<uint32_t>> &Adj) {
+    llvm::BitVector Reached(Adj.size());
+    std::vector<uint32_t> WorkList;
+    for (const auto &Root : Roots) {
+      auto It = VertexIds.find({Root.Node, Root.Fact});
+      if (It != VertexIds.end() && !Reached.test(It->second)) {
+        Reached.set(It->second);
+        WorkList.push_back(It->second);
+      }
+    }
+    while (!WorkList.empty()) {
+      auto Curr = WorkList.back();
+      WorkList.pop_back();
+      for (auto Next : Adj[Curr]) {
+        if (!Reached.test(Next)) {
+          Reached.set(Next);
+          WorkList.push_back(Next);
+        }
+      }
+    }
+    return Reached;
+  };
+
+  auto Forward = reach(From, Succs);
+  auto Backward = reach(To, Preds);
+
+  std::vector<ESGTraceEdge> Sliced;
+  for (size_t I = 0, E = Edges.size(); I < E; ++I) {
+    const auto &[Src, Dst] = EdgeVertices[I];
+    if (Forward.test(Src) && Backward.test(Dst)) {
+      Sliced.push_back(Edges[I]);
+    }
+  }
+  return {Syms, std::move(Sliced)};
+}
+
+void ESGTrace::printAsDot(llvm::raw_ostream &OS) const {
+  auto printEscaped = [&OS](llvm::StringRef Str) {
+    for (char C : Str) {
+      if (C == '"' || C == '\\') {
+        OS << '\\';
+      }
+      if (C == '\n') {
+        OS << "\\n";
+        continue;
+      }
+      OS << C;
+    }
+  };
+  auto printVertexId = [&OS](uint32_t Node, uint32_t Fact) {
+    OS << 'v' << Node << '_' << Fact;
+  };
+
+  // Group the vertices that are referenced by the edges by function
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> VerticesPerFunction(
+      Syms->Functions.size());
+  llvm::DenseSet<std::pair<uint32_t, uint32_t>> Seen;
+  for (const auto &E : Edges) {
+    for (auto [Node, Fact] : {std::make_pair(E.FromNode, E.FromFact),
+                              std::make_pair(E.ToNode, E.ToFact)}) {
+      if (Seen.insert({Node, Fact}).second) {
+        VerticesPerFunction[Syms->Nodes[Node].FunctionId].emplace_back(Node,
+                                                                       Fact);
+      }
+    }
+  }
+
+  OS << "digraph ESG {\n";
+  OS << "  node [shape=record, style=rounded]\n";
+  for (uint32_t FunId = 0, E = VerticesPerFunction.size(); FunId < E;
+       ++FunId) {
+    if (VerticesPerFunction[FunId].empty()) {
+      continue;
+    }
+    OS << "  subgraph cluster_" << FunId << " {\n    label=\"";
+    printEscaped(Syms->Functions[FunId].Name);
+    OS << "\"\n";
+    for (auto [Node, Fact] : VerticesPerFunction[FunId]) {
+      OS << "    ";
+      printVertexId(Node, Fact);
+      OS << " [label=\"";
+      printEscaped(Syms->Facts[Fact].IsZero ? "Λ" : Syms->Facts[Fact].Label);
+      OS << " | SID: ";
+      printEscaped(Syms->Nodes[Node].StmtId);
+      OS << "\", tooltip=\"";
+      printEscaped(Syms->Nodes[Node].Label);
+      OS << "\"]\n";
+    }
+    OS << "  }\n";
+  }
+  for (const auto &E : Edges) {
+    OS << "  ";
+    printVertexId(E.FromNode, E.FromFact);
+    OS << " -> ";
+    printVertexId(E.ToNode, E.ToFact);
+    OS << " [";
+    if (E.IsInterProcedural) {
+      OS << "style=dashed";
+    } else {
+      OS << "style=dotted";
+    }
+    if (E.EdgeFunctionLabel != ESGTraceEdge::NoLabel) {
+      OS << ", label=\"";
+      printEscaped(Syms->EdgeFunctionLabels[E.EdgeFunctionLabel]);
+      OS << '"';
+    }
+    OS << "]\n";
+  }
+  OS << "}\n";
+}
+
+nlohmann::json ESGTrace::getAsJson() const {
+  nlohmann::json J;
+  llvm::DenseSet<uint32_t> UsedNodes;
+  llvm::DenseSet<uint32_t> UsedFacts;
+  auto &JEdges = J["Edges"] = nlohmann::json::array();
+  for (const auto &E : Edges) {
+    UsedNodes.insert(E.FromNode);
+    UsedNodes.insert(E.ToNode);
+    UsedFacts.insert(E.FromFact);
+    UsedFacts.insert(E.ToFact);
+    nlohmann::json JEdge = {{"From", {E.FromNode, E.FromFact}},
+                            {"To", {E.ToNode, E.ToFact}},
+                            {"Inter", E.IsInterProcedural}};
+    if (E.EdgeFunctionLabel != ESGTraceEdge::NoLabel) {
+      JEdge["EdgeFunction"] = Syms->EdgeFunctionLabels[E.EdgeFunctionLabel];
+    }
+    JEdges.push_back(std::move(JEdge));
+  }
+  auto &JNodes = J["Nodes"] = nlohmann::json::object();
+  for (auto NodeId : UsedNodes) {
+    const auto &N = Syms->Nodes[NodeId];
+    JNodes[std::to_string(NodeId)] = {
+        {"Function", Syms->Functions[N.FunctionId].Name},
+        {"StmtId", N.StmtId},
+        {"Label", N.Label}};
+  }
+  auto &JFacts = J["Facts"] = nlohmann::json::object();
+  for (auto FactId : UsedFacts) {
+    const auto &F = Syms->Facts[FactId];
+    JFacts[std::to_string(FactId)] = {{"Label", F.Label}, {"Zero", F.IsZero}};
+  }
+  return J;
+}
+
+} // namespace psr
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cassert>
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/CFLAndersAliasAnalysis.h"
+#include "llvm/Analysis/CFLSteensAliasAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/Analysis/TypeBasedAliasAnalysis.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionAnalysisCache.h"
+
+namespace psr {
+
+LLVMFunctionAnalysisCache::LLVMFunctionAnalysisCache(PointerAnalysisType PATy)
+    : PATy(PATy) {
+  // Register the alias analyses before PassBuilder registers its default
+  // AAManager
+  FAM.registerPass([PATy] {
+    llvm::AAManager AA;
+    AA.registerFunctionAnalysis<llvm::BasicAA>();
+    switch (PATy) {
+    case PointerAnalysisType::CFLAnders:
+      AA.registerFunctionAnalysis<llvm::CFLAndersAA>();
+      break;
+    case PointerAnalysisType::CFLSteens:
+      AA.registerFunctionAnalysis<llvm::CFLSteensAA>();
+      break;
+    default:
+      break;
+    }
+    AA.registerFunctionAnalysis<llvm::TypeBasedAA>();
+    return AA;
+  });
+  PB.registerFunctionAnalyses(FAM);
+}
+
+LLVMFunctionAnalysisCache::~LLVMFunctionAnalysisCache() { FAM.clear(); }
+
+template <typename AnalysisT>
+typename AnalysisT::Result &
+LLVMFunctionAnalysisCache::getResult(const llvm::Function *F) {
+  assert(F && !F->isDeclaration() &&
+         "Analysis results are only available for function definitions");
+  std::lock_guard<std::mutex> Lock(Mtx);
+  // The analyses do not change the function
+  return FAM.getResult<AnalysisT>(const_cast<llvm::Function &>(*F)); // NOLINT
+}
+
+llvm::DominatorTree &
+LLVMFunctionAnalysisCache::getDominatorTree(const llvm::Function *F) {
+  return getResult<llvm::DominatorTreeAnalysis>(F);
+}
+
+llvm::PostDominatorTree &
+LLVMFunctionAnalysisCache::getPostDominatorTree(const llvm::Function *F) {
+  return getResult<llvm::PostDominatorTreeAnalysis>(F);
+}
+
+llvm::LoopInfo &
+LLVMFunctionAnalysisCache::getLoopInfo(const llvm::Function *F) {
+  return getResult<llvm::LoopAnalysis>(F);
+}
+
+llvm::AAResults &
+LLVMFunctionAnalysisCache::getAAResults(const llvm::Function *F) {
+  return getResult<llvm::AAManager>(F);
+}
+
+void LLVMFunctionAnalysisCache::invalidate(const llvm::Function &F) {
+  std::lock_guard<std::mutex> Lock(Mtx);
+  FAM.clear(const_cast<llvm::Function &>(F), F.getName()); // NOLINT
+}
+
+void LLVMFunctionAnalysisCache::invalidate(const llvm::Module &M) {
+  std::lock_guard<std::mutex> Lock(Mtx);
+  for (const auto &F : M) {
+    FAM.clear(const_cast<llvm::Function &>(F), F.getName()); // NOLINT
+  }
+}
+
+void LLVMFunctionAnalysisCache::clear() {
+  std::lock_guard<std::mutex> Lock(Mtx);
+  FAM.clear();
+}
+
+} // namespace psr
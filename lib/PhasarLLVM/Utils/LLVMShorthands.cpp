@@ -20,6 +20,7 @@
 #include "phasar/Utils/Utilities.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
@@ -32,14 +33,18 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ModuleSlotTracker.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/StringSaver.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include <array>
 #include <cctype>
 #include <charconv>
 #include <cstdlib>
+#include <mutex>
 #include <optional>
 #include <system_error>
 
@@ -146,70 +151,197 @@ bool matchesSignature(const llvm::FunctionType *FType1,
   return false;
 }
 
-llvm::ModuleSlotTracker &getModuleSlotTrackerFor(const llvm::Value *V) {
-  const auto *M = getModuleFromVal(V);
-  return ModulesToSlotTracker::getSlotTrackerForModule(M);
-}
+namespace {
 
-std::string llvmIRToString(const llvm::Value *V) {
-  if (!V) {
-    return "<null>";
+enum class IRStringKind { Default, Stable, Short };
+constexpr size_t NumIRStringKinds = 3;
+
+/// Prints the ID of V and, if IRNormalizationPass synthesized V, the ID of
+/// the original instruction that V stands for, such that reports on
+/// normalized IR can be related to the original IR.
+void printIDs(llvm::raw_ostream &OS, const llvm::Value *V) {
+  auto Id = getMetaDataID(V);
+  OS << " | ID: " << Id;
+  if (auto OriginId = getOriginalMetaDataID(V); OriginId != Id) {
+    OS << " (for ID: " << OriginId << ')';
   }
+}
 
+std::string renderIRString(const llvm::Value *V, IRStringKind Kind,
+                           llvm::ModuleSlotTracker &MST) {
   std::string IRBuffer;
   llvm::raw_string_ostream RSO(IRBuffer);
-  V->print(RSO, getModuleSlotTrackerFor(V));
-  RSO << " | ID: " << getMetaDataID(V);
-  RSO.flush();
-  boost::trim_left(IRBuffer);
-  return IRBuffer;
+  switch (Kind) {
+  case IRStringKind::Default:
+    V->print(RSO, MST);
+    printIDs(RSO, V);
+    RSO.flush();
+    boost::trim_left(IRBuffer);
+    return IRBuffer;
+  case IRStringKind::Stable: {
+    V->print(RSO, MST);
+    RSO.flush();
+
+    auto IRBufferRef = llvm::StringRef(IRBuffer).ltrim();
+
+    if (auto Meta = IRBufferRef.find_first_of("!#");
+        Meta != llvm::StringRef::npos) {
+      IRBufferRef = IRBufferRef.slice(0, Meta).rtrim();
+
+      assert(!IRBufferRef.empty());
+      IRBufferRef.consume_back(",");
+    }
+
+    std::string Ret = IRBufferRef.str();
+    llvm::raw_string_ostream RetOS(Ret);
+    printIDs(RetOS, V);
+    RetOS.flush();
+    return Ret;
+  }
+  case IRStringKind::Short:
+    if (const auto *I = llvm::dyn_cast<llvm::Instruction>(V);
+        I && !I->getType()->isVoidTy()) {
+      V->printAsOperand(RSO, true, MST);
+    } else if (const auto *F = llvm::dyn_cast<llvm::Function>(V)) {
+      RSO << F->getName();
+    } else {
+      V->print(RSO, MST);
+    }
+    printIDs(RSO, V);
+    RSO.flush();
+    boost::trim_left(IRBuffer);
+    return IRBuffer;
+  }
+  llvm_unreachable("All IRStringKinds should be handled in the switch");
 }
 
-std::string llvmIRToStableString(const llvm::Value *V) {
-  if (!V) {
-    return "<null>";
+/// The function whose slots are needed to print V, if any
+const llvm::Function *getFunctionForSlots(const llvm::Value *V) {
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    return Arg->getParent();
   }
-  std::string IRBuffer;
-  llvm::raw_string_ostream RSO(IRBuffer);
-  V->print(RSO, getModuleSlotTrackerFor(V));
-  RSO.flush();
+  if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
+    return Inst->getFunction();
+  }
+  return nullptr;
+}
+
+/// The slot tracker and the rendered values of a single module
+class ModuleIRStrings {
+public:
+  explicit ModuleIRStrings(const llvm::Module *M) : MST(M) {}
 
-  auto IRBufferRef = llvm::StringRef(IRBuffer).ltrim();
+  llvm::ModuleSlotTracker &getSlotTracker() noexcept { return MST; }
+
+  llvm::StringRef get(const llvm::Value *V, IRStringKind Kind) {
+    auto &Cache = Strings[size_t(Kind)];
+    if (auto It = Cache.find(V); It != Cache.end()) {
+      return It->second;
+    }
+    if (const auto *F = getFunctionForSlots(V);
+        F && RenderedFunctions[size_t(Kind)].insert(F).second) {
+      // The slot tracker has to re-number a function whenever we print a
+      // value of a different function than before, so render all of them at
+      // once.
+      for (const auto &Arg : F->args()) {
+        Cache.try_emplace(&Arg, save(&Arg, Kind));
+      }
+      for (const auto &Inst : llvm::instructions(F)) {
+        Cache.try_emplace(&Inst, save(&Inst, Kind));
+      }
+      if (auto It = Cache.find(V); It != Cache.end()) {
+        return It->second;
+      }
+    }
+    return Cache[V] = save(V, Kind);
+  }
 
-  if (auto Meta = IRBufferRef.find_first_of("!#");
-      Meta != llvm::StringRef::npos) {
-    IRBufferRef = IRBufferRef.slice(0, Meta).rtrim();
+  void clear() {
+    for (auto &Cache : Strings) {
+      Cache.clear();
+    }
+    for (auto &Functions : RenderedFunctions) {
+      Functions.clear();
+    }
+    Alloc.Reset();
+  }
 
-    assert(!IRBufferRef.empty());
-    IRBufferRef.consume_back(",");
+private:
+  llvm::StringRef save(const llvm::Value *V, IRStringKind Kind) {
+    return Saver.save(renderIRString(V, Kind, MST));
   }
 
-  IRBuffer = IRBufferRef.str();
+  llvm::ModuleSlotTracker MST;
+  llvm::BumpPtrAllocator Alloc;
+  llvm::StringSaver Saver{Alloc};
+  std::array<llvm::DenseMap<const llvm::Value *, llvm::StringRef>,
+             NumIRStringKinds>
+      Strings;
+  std::array<llvm::DenseSet<const llvm::Function *>, NumIRStringKinds>
+      RenderedFunctions;
+};
 
-  IRBuffer.append(" | ID: ");
-  IRBuffer.append(getMetaDataID(V));
+llvm::SmallDenseMap<const llvm::Module *, std::unique_ptr<ModuleIRStrings>, 2> &
+getModuleIRStrings() {
+  static llvm::SmallDenseMap<const llvm::Module *,
+                             std::unique_ptr<ModuleIRStrings>, 2>
+      MToIRStrings;
+  return MToIRStrings;
+}
 
-  return IRBuffer;
+/// Guards the cached IR strings, such that IR can be printed from solvers that
+/// run in parallel
+std::mutex &getModuleIRStringsMutex() {
+  static std::mutex Mtx;
+  return Mtx;
 }
 
-std::string llvmIRToShortString(const llvm::Value *V) {
+ModuleIRStrings &getModuleIRStringsFor(const llvm::Module *M) {
+  auto &Ret = getModuleIRStrings()[M];
+  if (M == nullptr && Ret == nullptr) {
+    Ret = std::make_unique<ModuleIRStrings>(M);
+  }
+  assert(Ret != nullptr && "no ModuleSlotTracker instance for module cached");
+  return *Ret;
+}
+
+llvm::StringRef llvmIRToStringRef(const llvm::Value *V, IRStringKind Kind) {
   if (!V) {
     return "<null>";
   }
-  std::string IRBuffer;
-  llvm::raw_string_ostream RSO(IRBuffer);
-  if (const auto *I = llvm::dyn_cast<llvm::Instruction>(V);
-      I && !I->getType()->isVoidTy()) {
-    V->printAsOperand(RSO, true, getModuleSlotTrackerFor(V));
-  } else if (const auto *F = llvm::dyn_cast<llvm::Function>(V)) {
-    RSO << F->getName();
-  } else {
-    V->print(RSO, getModuleSlotTrackerFor(V));
-  }
-  RSO << " | ID: " << getMetaDataID(V);
-  RSO.flush();
-  boost::trim_left(IRBuffer);
-  return IRBuffer;
+  std::lock_guard Lock(getModuleIRStringsMutex());
+  return getModuleIRStringsFor(getModuleFromVal(V)).get(V, Kind);
+}
+
+} // namespace
+
+llvm::ModuleSlotTracker &getModuleSlotTrackerFor(const llvm::Value *V) {
+  const auto *M = getModuleFromVal(V);
+  return ModulesToSlotTracker::getSlotTrackerForModule(M);
+}
+
+std::string llvmIRToString(const llvm::Value *V) {
+  return llvmIRToStringRef(V).str();
+}
+
+std::string llvmIRToStableString(const llvm::Value *V) {
+  return llvmIRToStableStringRef(V).str();
+}
+
+std::string llvmIRToShortString(const llvm::Value *V) {
+  return llvmIRToShortStringRef(V).str();
+}
+
+llvm::StringRef llvmIRToStringRef(const llvm::Value *V) {
+  return llvmIRToStringRef(V, IRStringKind::Default);
+}
+
+llvm::StringRef llvmIRToStableStringRef(const llvm::Value *V) {
+  return llvmIRToStringRef(V, IRStringKind::Stable);
+}
+
+llvm::StringRef llvmIRToShortStringRef(const llvm::Value *V) {
+  return llvmIRToStringRef(V, IRStringKind::Short);
 }
 
 void dumpIRValue(const llvm::Value *V) {
@@ -257,6 +389,18 @@ std::string getMetaDataID(const llvm::Value *V) {
   return "-1";
 }
 
+std::string getOriginalMetaDataID(const llvm::Value *V) {
+  if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
+    if (auto *Metadata =
+            Inst->getMetadata(PhasarConfig::OriginMetaDataKind())) {
+      return llvm::cast<llvm::MDString>(Metadata->getOperand(0))
+          ->getString()
+          .str();
+    }
+  }
+  return getMetaDataID(V);
+}
+
 bool LLVMValueIDLess::operator()(const llvm::Value *Lhs,
                                  const llvm::Value *Rhs) const {
   std::string LhsId = getMetaDataID(Lhs);
@@ -479,19 +623,22 @@ llvm::StringRef getVarAnnotationIntrinsicName(const llvm::CallInst *CallInst) {
 
 llvm::ModuleSlotTracker &
 ModulesToSlotTracker::getSlotTrackerForModule(const llvm::Module *M) {
-  auto &Ret = MToST[M];
-  if (M == nullptr && Ret == nullptr) {
-    Ret = std::make_unique<llvm::ModuleSlotTracker>(M);
-  }
-  assert(Ret != nullptr && "no ModuleSlotTracker instance for module cached");
-  return *Ret;
+  std::lock_guard Lock(getModuleIRStringsMutex());
+  return getModuleIRStringsFor(M).getSlotTracker();
 }
 
 void ModulesToSlotTracker::updateMSTForModule(const llvm::Module *M) {
-  MToST[M] = std::make_unique<llvm::ModuleSlotTracker>(M);
+  std::lock_guard Lock(getModuleIRStringsMutex());
+  getModuleIRStrings()[M] = std::make_unique<ModuleIRStrings>(M);
 }
 void ModulesToSlotTracker::deleteMSTForModule(const llvm::Module *M) {
-  MToST.erase(M);
+  std::lock_guard Lock(getModuleIRStringsMutex());
+  auto &MToIRStrings = getModuleIRStrings();
+  MToIRStrings.erase(M);
+  // Values without a module, e.g. constants, may live in the context of M
+  if (auto It = MToIRStrings.find(nullptr); It != MToIRStrings.end()) {
+    It->second->clear();
+  }
 }
 
 } // namespace psr
@@ -0,0 +1,283 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEExtendedTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEInstInteractionAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDESolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDETaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDETypeStateAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSConstAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSLinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTypeAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CSTDFILEIOTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/IntraMonoFullConstantPropagation.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/IntraMonoSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/InterMonoSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TaintConfig/TaintConfig.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+#include "phasar/PhasarPass/Options.h"
+#include "phasar/PhasarPass/PhasarAnalysis.h"
+
+namespace psr {
+
+llvm::AnalysisKey PhasarAnalysis::Key; // NOLINT
+
+PhasarAnalysis::Result::Result(llvm::Module &M,
+                               const std::vector<std::string> &EntryPoints,
+                               CallGraphAnalysisType CGTy)
+    : Result(M, EntryPoints, CGTy, nullptr) {}
+
+PhasarAnalysis::Result::Result(llvm::Module &M,
+                               const std::vector<std::string> &EntryPoints,
+                               CallGraphAnalysisType CGTy,
+                               llvm::FunctionAnalysisManager &FAM)
+    : Result(M, EntryPoints, CGTy, &FAM) {}
+
+PhasarAnalysis::Result::Result(llvm::Module &M,
+                               const std::vector<std::string> &EntryPoints,
+                               CallGraphAnalysisType CGTy,
+                               llvm::FunctionAnalysisManager *FAM)
+    : FAM(FAM), IRDB(std::make_unique<ProjectIRDB>(
+                    std::vector<llvm::Module *>{&M}, IRDBOptions::WPA)) {
+  // check if the requested entry points exist
+  for (const std::string &EP : EntryPoints) {
+    if (!IRDB->getFunctionDefinition(EP)) {
+      llvm::report_fatal_error(
+          ("psr error: entry point does not exist '" + EP + "'").c_str());
+    }
+    this->EntryPoints.insert(EP);
+  }
+  TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+  if (FAM) {
+    // Reuse the alias analyses the pipeline has already run (or will run
+    // anyway) instead of setting up a separate pass manager for them
+    PT = std::make_unique<LLVMPointsToSet>(
+        *IRDB, [FAM](llvm::Function &F) -> llvm::AAResults & {
+          return FAM->getResult<llvm::AAManager>(F);
+        });
+  } else {
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+  }
+  ICF = std::make_unique<LLVMBasedICFG>(IRDB.get(), CGTy, EntryPoints, TH.get(),
+                                        PT.get());
+}
+
+PhasarAnalysis::Result::Result(Result &&) noexcept = default;
+PhasarAnalysis::Result &
+PhasarAnalysis::Result::operator=(Result &&) noexcept = default;
+PhasarAnalysis::Result::~Result() = default;
+
+llvm::DominatorTree &
+PhasarAnalysis::Result::getDominatorTree(const llvm::Function *F) {
+  if (FAM) {
+    return FAM->getResult<llvm::DominatorTreeAnalysis>(
+        const_cast<llvm::Function &>(*F));
+  }
+  return IRDB->getAnalysisCache().getDominatorTree(F);
+}
+
+void PhasarAnalysis::Result::runDataFlowAnalysis(
+    llvm::StringRef DataFlowAnalysis, bool DumpResults) {
+  auto &DB = *IRDB;
+  auto &H = *TH;
+  auto &I = *ICF;
+  auto &PTS = *PT;
+  if (DataFlowAnalysis == "ifds-solvertest") {
+    IFDSSolverTest IFDSTest(&DB, &H, &I, &PTS, EntryPoints);
+    IFDSSolver LLVMIFDSTestSolver(IFDSTest);
+    LLVMIFDSTestSolver.solve();
+    if (DumpResults) {
+      LLVMIFDSTestSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ide-solvertest") {
+    IDESolverTest IDETest(&DB, &H, &I, &PTS, EntryPoints);
+    IDESolver LLVMIDETestSolver(IDETest);
+    LLVMIDETestSolver.solve();
+    if (DumpResults) {
+      LLVMIDETestSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "intra-mono-solvertest") {
+    IntraMonoSolverTest Intra(&DB, &H, &I, &PTS, EntryPoints);
+    IntraMonoSolver Solver(Intra);
+    Solver.solve();
+    if (DumpResults) {
+      Solver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "inter-mono-solvertest") {
+    InterMonoSolverTest Inter(&DB, &H, &I, &PTS, EntryPoints);
+    InterMonoSolver_P<InterMonoSolverTest, 3> Solver(Inter);
+    Solver.solve();
+    if (DumpResults) {
+      Solver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ifds-const") {
+    IFDSConstAnalysis ConstProblem(&DB, &H, &I, &PTS, EntryPoints);
+    IFDSSolver LLVMConstSolver(ConstProblem);
+    LLVMConstSolver.solve();
+    if (DumpResults) {
+      LLVMConstSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ifds-lca") {
+    IFDSLinearConstantAnalysis LcaProblem(&DB, &H, &I, &PTS, EntryPoints);
+    IFDSSolver LLVMLcaSolver(LcaProblem);
+    LLVMLcaSolver.solve();
+    if (DumpResults) {
+      LLVMLcaSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ifds-taint") {
+    TaintConfig Config(DB);
+    IFDSTaintAnalysis TaintAnalysisProblem(&DB, &H, &I, &PTS, Config,
+                                           EntryPoints);
+    IFDSSolver LLVMTaintSolver(TaintAnalysisProblem);
+    LLVMTaintSolver.solve();
+    if (DumpResults) {
+      LLVMTaintSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ide-xtaint") {
+    TaintConfig Config(DB);
+    IDEExtendedTaintAnalysis<> XTaintProblem(
+        &DB, &H, &I, &PTS, Config, EntryPoints,
+        [this](const llvm::Function *F) -> llvm::DominatorTree & {
+          return getDominatorTree(F);
+        });
+    IDESolver LLVMXTaintSolver(XTaintProblem);
+    LLVMXTaintSolver.solve();
+    if (DumpResults) {
+      LLVMXTaintSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ifds-type") {
+    IFDSTypeAnalysis TypeAnalysisProblem(&DB, &H, &I, &PTS, EntryPoints);
+    IFDSSolver LLVMTypeSolver(TypeAnalysisProblem);
+    LLVMTypeSolver.solve();
+    if (DumpResults) {
+      LLVMTypeSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ifds-uninit") {
+    IFDSUninitializedVariables UninitializedVarProblem(&DB, &H, &I, &PTS,
+                                                       EntryPoints);
+    IFDSSolver LLVMUnivSolver(UninitializedVarProblem);
+    LLVMUnivSolver.solve();
+    if (DumpResults) {
+      LLVMUnivSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ide-lca") {
+    IDELinearConstantAnalysis LcaProblem(&DB, &H, &I, &PTS, EntryPoints);
+    IDESolver LLVMLcaSolver(LcaProblem);
+    LLVMLcaSolver.solve();
+    if (DumpResults) {
+      LLVMLcaSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ide-taint") {
+    IDETaintAnalysis TaintAnalysisProblem(&DB, &H, &I, &PTS, EntryPoints);
+    IDESolver LLVMTaintSolver(TaintAnalysisProblem);
+    LLVMTaintSolver.solve();
+    if (DumpResults) {
+      LLVMTaintSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ide-stdio-ts" ||
+             DataFlowAnalysis == "ide-typestate") {
+    CSTDFILEIOTypeStateDescription FileIODesc;
+    IDETypeStateAnalysis TypeStateProblem(&DB, &H, &I, &PTS, FileIODesc,
+                                          EntryPoints);
+    IDESolver LLVMTypeStateSolver(TypeStateProblem);
+    LLVMTypeStateSolver.solve();
+    if (DumpResults) {
+      LLVMTypeStateSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "ide-iia" ||
+             DataFlowAnalysis == "ide-instinteract") {
+    IDEInstInteractionAnalysis InstInteraction(&DB, &H, &I, &PTS,
+                                               EntryPoints);
+    IDESolver LLVMInstInteractionSolver(InstInteraction);
+    LLVMInstInteractionSolver.solve();
+    if (DumpResults) {
+      LLVMInstInteractionSolver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "intra-mono-fca") {
+    IntraMonoFullConstantPropagation FcaProblem(&DB, &H, &I, &PTS,
+                                                EntryPoints);
+    IntraMonoSolver Solver(FcaProblem);
+    Solver.solve();
+    if (DumpResults) {
+      Solver.dumpResults();
+    }
+  } else if (DataFlowAnalysis == "inter-mono-taint") {
+    TaintConfig Config(DB);
+    InterMonoTaintAnalysis TaintProblem(&DB, &H, &I, &PTS, Config,
+                                        EntryPoints);
+    InterMonoSolver_P<InterMonoTaintAnalysis, 3> Solver(TaintProblem);
+    Solver.solve();
+    if (DumpResults) {
+      Solver.dumpResults();
+    }
+  } else if (DataFlowAnalysis != "none") {
+    llvm::report_fatal_error("psr error: data-flow analysis '" +
+                             DataFlowAnalysis + "' is not supported");
+  }
+}
+
+bool PhasarAnalysis::Result::invalidate(
+    llvm::Module &M, const llvm::PreservedAnalyses &PA,
+    llvm::ModuleAnalysisManager::Invalidator &Inv) {
+  auto PAC = PA.getChecker<PhasarAnalysis>();
+  if (!PAC.preserved() &&
+      !PAC.preservedSet<llvm::AllAnalysesOn<llvm::Module>>()) {
+    return true;
+  }
+  // The points-to information refers to the alias analysis results that are
+  // owned by the FunctionAnalysisManager
+  return FAM &&
+         Inv.invalidate<llvm::FunctionAnalysisManagerModuleProxy>(M, PA);
+}
+
+PhasarAnalysis::Result PhasarAnalysis::run(llvm::Module &M,
+                                           llvm::ModuleAnalysisManager &MAM) {
+  if (EntryPoints.empty()) {
+    llvm::report_fatal_error("psr error: no entry points provided");
+  }
+  CallGraphAnalysisType CGTy = toCallGraphAnalysisType(CallGraphAnalysis);
+  if (CGTy == CallGraphAnalysisType::Invalid) {
+    llvm::report_fatal_error("psr error: call-graph analysis does not exist");
+  }
+  auto &FAM =
+      MAM.getResult<llvm::FunctionAnalysisManagerModuleProxy>(M).getManager();
+  return Result(M, EntryPoints, CGTy, FAM);
+}
+
+llvm::PreservedAnalyses
+PhasarModulePass::run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM) {
+  if (toDataFlowAnalysisType(DataFlowAnalysis) == DataFlowAnalysisType::None) {
+    llvm::report_fatal_error("psr error: data-flow analysis does not exist");
+  }
+  MAM.getResult<PhasarAnalysis>(M).runDataFlowAnalysis(DataFlowAnalysis,
+                                                       DumpResults);
+  // The data-flow analyses do not modify the IR
+  return llvm::PreservedAnalyses::all();
+}
+
+} // namespace psr
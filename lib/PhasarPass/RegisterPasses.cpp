@@ -9,9 +9,13 @@
 
 #include <string>
 
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
 #include "llvm/Support/CommandLine.h"
 
 #include "phasar/PhasarPass/Options.h"
+#include "phasar/PhasarPass/PhasarAnalysis.h"
+#include "phasar/PhasarPass/RegisterPasses.h"
 
 using namespace psr;
 using namespace std;
@@ -70,3 +74,25 @@ static llvm::cl::opt<bool, true>
                    llvm::cl::desc("Dump the analysis results to stdout"),
                    llvm::cl::location(DumpResults), llvm::cl::init(true),
                    llvm::cl::cat(PhASARCategory));
+
+void psr::registerPhasarPasses(llvm::PassBuilder &PB) {
+  PB.registerAnalysisRegistrationCallback(
+      [](llvm::ModuleAnalysisManager &MAM) {
+        MAM.registerPass([] { return PhasarAnalysis(); });
+      });
+  PB.registerPipelineParsingCallback(
+      [](llvm::StringRef Name, llvm::ModulePassManager &MPM,
+         llvm::ArrayRef<llvm::PassBuilder::PipelineElement> /*Pipeline*/) {
+        if (Name == "phasar") {
+          MPM.addPass(PhasarModulePass());
+          return true;
+        }
+        return false;
+      });
+}
+
+extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
+llvmGetPassPluginInfo() {
+  return {LLVM_PLUGIN_API_VERSION, "PhasarPass", "v1",
+          psr::registerPhasarPasses};
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cassert>
+#include <iterator>
+#include <system_error>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "phasar/Utils/SpillFile.h"
+
+namespace psr {
+
+SpillFile::SpillFile(llvm::StringRef Prefix) {
+  int FD = -1;
+  if (auto EC = llvm::sys::fs::createTemporaryFile(Prefix, "bin", FD, Path)) {
+    throw std::system_error(EC);
+  }
+  OS = std::make_unique<llvm::raw_fd_ostream>(FD, /*shouldClose*/ true);
+}
+
+SpillFile::~SpillFile() {
+  OS.reset();
+  llvm::sys::fs::remove(Path);
+}
+
+SpillFile::Slice SpillFile::append(llvm::StringRef Data) {
+  if (Data.empty()) {
+    return {Size, 0};
+  }
+  for (auto It = FreeRanges.begin(), End = FreeRanges.end(); It != End; ++It) {
+    auto [Offset, RangeSize] = *It;
+    if (RangeSize < Data.size()) {
+      continue;
+    }
+    FreeRanges.erase(It);
+    if (RangeSize > Data.size()) {
+      FreeRanges.emplace(Offset + Data.size(), RangeSize - Data.size());
+    }
+    FreeBytes -= Data.size();
+    OS->pwrite(Data.data(), Data.size(), Offset);
+    return {Offset, Data.size()};
+  }
+  Slice S{Size, Data.size()};
+  OS->write(Data.data(), Data.size());
+  Size += Data.size();
+  return S;
+}
+
+void SpillFile::release(Slice S) {
+  if (S.Size == 0) {
+    return;
+  }
+  FreeBytes += S.Size;
+  [[maybe_unused]] auto [It, Inserted] = FreeRanges.emplace(S.Offset, S.Size);
+  assert(Inserted && "Slice released twice");
+  // merge with the following range
+  if (auto Next = std::next(It);
+      Next != FreeRanges.end() && It->first + It->second == Next->first) {
+    It->second += Next->second;
+    FreeRanges.erase(Next);
+  }
+  // merge with the preceding range
+  if (It != FreeRanges.begin()) {
+    auto Prev = std::prev(It);
+    if (Prev->first + Prev->second == It->first) {
+      Prev->second += It->second;
+      FreeRanges.erase(It);
+    }
+  }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> SpillFile::read(Slice S) {
+  // the slice may still reside in the stream's buffer
+  OS->flush();
+  auto Ret = llvm::MemoryBuffer::getFileSlice(Path, S.Size, S.Offset);
+  if (!Ret) {
+    throw std::system_error(Ret.getError());
+  }
+  return std::move(Ret.get());
+}
+
+} // namespace psr
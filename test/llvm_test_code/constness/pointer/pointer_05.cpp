@@ -0,0 +1,8 @@
+/* i | %2 (ID: 1) */
+int main() {
+  int i = 12;
+  int *p = &i;
+  *p = 10;
+  int j = i;
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include <cstdlib>
+#include <cstring>
+
+extern int source();
+extern void sink(int);
+
+struct S {
+  S() : Data(new int(42)) {}
+  ~S() { delete Data; }
+  int *Data;
+};
+
+// Not mangled, so never special member functions
+extern "C" void C1_init() {}
+extern "C" void D2_cleanup() {}
+
+int main() {
+  C1_init();
+  S s;
+  int *Buf = (int *)malloc(sizeof(int));
+  memcpy(Buf, s.Data, sizeof(int));
+  sink(source() + *Buf);
+  free(Buf);
+  D2_cleanup();
+  return 0;
+}
@@ -0,0 +1,7 @@
+int main() {
+  int i = 3;
+  int j = 100 - (2 * (i + 5) - 1);
+  int k = -3 * j + 7;
+  int l = k / 2;
+  return 0;
+}
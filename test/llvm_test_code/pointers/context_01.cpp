@@ -0,0 +1,16 @@
+int *G;
+
+int *id(int *P) { return P; }
+
+int *unused(int *Q) { return Q; }
+
+int main() {
+  int A = 0;
+  int B = 1;
+  G = &A;
+  G = &B;
+  int *PA = id(&A);
+  int *PB = id(&B);
+  *PA = 42;
+  return *PB + *G;
+}
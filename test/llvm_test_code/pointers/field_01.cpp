@@ -0,0 +1,19 @@
+struct Pair {
+  int First;
+  int Second;
+};
+
+int choose(bool Cond) {
+  Pair P;
+  int *Q = Cond ? &P.First : &P.Second;
+  *Q = 1;
+  P.Second = 2;
+  return P.First;
+}
+
+int main() {
+  Pair P;
+  P.First = 1;
+  P.Second = 2;
+  return P.First + P.Second;
+}
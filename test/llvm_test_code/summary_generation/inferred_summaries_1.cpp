@@ -0,0 +1,44 @@
+int Global = 0;
+
+int square(int X) { return X * X; }
+
+void logMessage(const char *Msg) {}
+
+int sum(const int *Arr, int Len) {
+  int S = 0;
+  for (int I = 0; I < Len; ++I) {
+    S += Arr[I];
+  }
+  return S;
+}
+
+void reset(int *P) { *P = 0; }
+
+void callsReset(int *P) { reset(P); }
+
+void setGlobal(int X) { Global = X; }
+
+int *identityPtr(int *P) { return P; }
+
+void store(int **Dst, int *Src) { *Dst = Src; }
+
+void useUninitialized() {
+  int X;
+  int Y = X + 1;
+}
+
+int main() {
+  int A = 42;
+  int B = square(3);
+  logMessage("square computed");
+  int Arr[2] = {1, 2};
+  int S = sum(Arr, 2);
+  int C = 13;
+  callsReset(&C);
+  setGlobal(B);
+  int *P = identityPtr(&A);
+  store(&P, &C);
+  int D = A + 1;
+  useUninitialized();
+  return 0;
+}
@@ -0,0 +1,15 @@
+struct Pair {
+  int First;
+  int Second;
+};
+
+void reset(int *P) { *P = 0; }
+
+int main() {
+  Pair Q = {1, 2};
+  int X = 3;
+  int Y = 4;
+  reset(&Q.Second);
+  reset(&X);
+  return Q.Second + X + Y;
+}
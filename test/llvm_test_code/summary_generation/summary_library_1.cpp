@@ -0,0 +1,18 @@
+extern "C" {
+
+int Counter = 0;
+
+void copyInt(int *Dst, const int *Src) { *Dst = *Src; }
+
+int *first(int *Arr) { return Arr; }
+
+int add(int A, int B) { return A + B; }
+
+void addTo(int *Dst, int V) { *Dst += V; }
+
+void callsCopy(int *Dst, const int *Src) { copyInt(Dst, Src); }
+
+void count() { ++Counter; }
+
+int load(const int *P) { return *P; }
+}
@@ -0,0 +1,12 @@
+extern "C" {
+void copyInt(int *Dst, const int *Src);
+int add(int A, int B);
+}
+
+int main() {
+  int A = 42;
+  int B;
+  copyInt(&B, &A);
+  int C = add(A, 1);
+  return B + C;
+}
@@ -0,0 +1,17 @@
+#include <stdio.h>
+
+// Declares the part of OpenSSL's EVP_KDF API that is used below, such that
+// no OpenSSL headers are required
+typedef struct evp_kdf_st EVP_KDF;
+EVP_KDF *EVP_KDF_fetch(void *libctx, const char *algorithm,
+                       const char *properties);
+void EVP_KDF_free(EVP_KDF *kdf);
+
+int main() {
+  FILE *f = fopen("file.txt", "r");
+  EVP_KDF *kdf = EVP_KDF_fetch(NULL, "hkdf", NULL);
+  fgetc(f);
+  EVP_KDF_free(kdf);
+  fclose(f);
+  return 0;
+}
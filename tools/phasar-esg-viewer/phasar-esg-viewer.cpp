@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/Utils/ESGTrace.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace psr;
+
+namespace cl = llvm::cl;
+
+namespace {
+
+enum class OutputFormat { Dot, Json, Stats };
+
+cl::OptionCategory ViewerCat("phasar-esg-viewer");
+
+cl::opt<std::string> TraceOpt(cl::Positional, cl::desc("<esg-trace>"),
+                              cl::Required, cl::cat(ViewerCat));
+
+cl::opt<std::string> OutputOpt("o", cl::desc("Output file (default: stdout)"),
+                               cl::init("-"), cl::cat(ViewerCat));
+
+cl::opt<OutputFormat> FormatOpt(
+    "format", cl::desc("Output format of the extracted sub-ESG"),
+    cl::values(clEnumValN(OutputFormat::Dot, "dot", "Graphviz DOT graph"),
+               clEnumValN(OutputFormat::Json, "json", "JSON"),
+               clEnumValN(OutputFormat::Stats, "stats",
+                          "Only print the size of the sub-ESG")),
+    cl::init(OutputFormat::Dot), cl::cat(ViewerCat));
+
+cl::opt<std::string> FunctionOpt(
+    "function", cl::desc("Only keep edges within or into the given function"),
+    cl::cat(ViewerCat));
+
+cl::opt<std::string>
+    FactOpt("fact",
+            cl::desc("Only keep edges adjacent to facts whose label contains "
+                     "the given string"),
+            cl::cat(ViewerCat));
+
+cl::opt<std::string> FromStmtOpt(
+    "from-stmt",
+    cl::desc("Only keep edges on paths starting at the given statement-id"),
+    cl::cat(ViewerCat));
+cl::opt<std::string>
+    FromFactOpt("from-fact",
+                cl::desc("Restrict --from-stmt to facts whose label contains "
+                         "the given string"),
+                cl::cat(ViewerCat));
+cl::opt<std::string> ToStmtOpt(
+    "to-stmt",
+    cl::desc("Only keep edges on paths ending at the given statement-id"),
+    cl::cat(ViewerCat));
+cl::opt<std::string>
+    ToFactOpt("to-fact",
+              cl::desc("Restrict --to-stmt to facts whose label contains the "
+                       "given string"),
+              cl::cat(ViewerCat));
+
+std::vector<ESGTrace::Vertex> collectVertices(const ESGTrace &Trace,
+                                              llvm::StringRef StmtId,
+                                              llvm::StringRef FactLabel,
+                                              bool AsSource) {
+  auto Nodes = Trace.findNodes(StmtId);
+  if (Nodes.empty()) {
+    llvm::errs() << "No node with statement-id '" << StmtId
+                 << "' in the ESG trace\n";
+    exit(1);
+  }
+  std::vector<ESGTrace::Vertex> Ret;
+  for (const auto &E : Trace.getEdges()) {
+    auto Node = AsSource ? E.FromNode : E.ToNode;
+    auto Fact = AsSource ? E.FromFact : E.ToFact;
+    if (!llvm::is_contained(Nodes, Node)) {
+      continue;
+    }
+    if (!FactLabel.empty() &&
+        !llvm::StringRef(Trace.getFacts()[Fact].Label).contains(FactLabel)) {
+      continue;
+    }
+    Ret.push_back({Node, Fact});
+  }
+  return Ret;
+}
+
+} // anonymous namespace
+
+int main(int Argc, const char **Argv) {
+  cl::HideUnrelatedOptions(ViewerCat);
+  cl::ParseCommandLineOptions(
+      Argc, Argv,
+      "Extracts sub-graphs from exploded super-graph (ESG) traces that have "
+      "been emitted by phasar-llvm --emit-esg-as-trace\n");
+
+  try {
+    auto Trace = ESGTrace::readFile(TraceOpt);
+
+    if (!FunctionOpt.empty()) {
+      Trace = Trace.sliceFunction(FunctionOpt);
+    }
+    if (!FactOpt.empty()) {
+      Trace = Trace.sliceFacts(Trace.findFacts(FactOpt));
+    }
+    if (!FromStmtOpt.empty() || !ToStmtOpt.empty()) {
+      if (FromStmtOpt.empty() || ToStmtOpt.empty()) {
+        llvm::errs() << "Path queries require both --from-stmt and --to-stmt\n";
+        return 1;
+      }
+      auto From = collectVertices(Trace, FromStmtOpt, FromFactOpt, true);
+      auto To = collectVertices(Trace, ToStmtOpt, ToFactOpt, false);
+      Trace = Trace.slicePaths(From, To);
+    }
+
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(OutputOpt, EC);
+    if (EC) {
+      llvm::errs() << "Failed to open file: " << OutputOpt << '\n'
+                   << EC.message() << '\n';
+      return 1;
+    }
+    switch (FormatOpt) {
+    case OutputFormat::Dot:
+      Trace.printAsDot(OS);
+      break;
+    case OutputFormat::Json:
+      OS << Trace.getAsJson().dump(2) << '\n';
+      break;
+    case OutputFormat::Stats:
+      OS << "Functions: " << Trace.getFunctions().size() << '\n'
+         << "Nodes    : " << Trace.getNodes().size() << '\n'
+         << "Facts    : " << Trace.getFacts().size() << '\n'
+         << "Edges    : " << Trace.getEdges().size() << '\n';
+      break;
+    }
+  } catch (const std::exception &Ex) {
+    llvm::errs() << "Error: " << Ex.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
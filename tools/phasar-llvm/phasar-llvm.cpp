@@ -11,6 +11,7 @@
 #include "phasar/Controller/AnalysisController.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/CallGraphAnalysisType.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
 #include "phasar/PhasarLLVM/Pointer/PointerAnalysisType.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Utils/IO.h"
@@ -23,9 +24,11 @@
 #include "nlohmann/json.hpp"
 
 #include <cstdlib>
+#include <exception>
 #include <filesystem>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace psr;
@@ -108,6 +111,12 @@ cl::opt<PointerAnalysisType> PTATypeOpt(
 cl::alias PTATypeAlias("P", cl::aliasopt(PTATypeOpt),
                        cl::desc("Alias for --pointer-analysis"),
                        cl::cat(PsrCat));
+cl::opt<unsigned> FieldSensitivityDepthOpt(
+    "field-sensitivity-depth",
+    cl::desc("Distinguish the fields of an object in the points-to sets, up "
+             "to the given number of nested constant field accesses (0 "
+             "disables field-sensitivity)"),
+    cl::init(0), cl::cat(PsrCat));
 
 cl::opt<CallGraphAnalysisType> CGTypeOpt(
     "call-graph-analysis", cl::desc("Set the call-graph algorithm to be used"),
@@ -132,6 +141,9 @@ cl::opt<Soundness>
 PSR_OPTION_FLAG(AutoGlobalsOpt, "auto-globals",
                 "Enable automated support for global initializers",
                 cl::init(true));
+PSR_OPTION_FLAG(NormalizeIROpt, "normalize-ir",
+                "Promote non-escaping stack variables to registers, fold "
+                "constants and remove dead instructions before the analysis");
 
 PSR_SHORTLONG_OPTION(
     StatisticsOpt, bool, "S", "statistical-analysis",
@@ -165,6 +177,11 @@ PSR_OPTION_FLAG(EmitGraphicalReportOpt, "emit-graphical-report",
                 "Emit graphical report of solver results", cl::Hidden);
 PSR_OPTION_FLAG(EmitESGAsDotOpt, "emit-esg-as-dot",
                 "Emit the exploded super-graph (ESG) as DOT graph");
+PSR_OPTION_FLAG(EmitESGAsTraceOpt, "emit-esg-as-trace",
+                "Emit the exploded super-graph (ESG) as compact binary trace "
+                "that can be inspected using phasar-esg-viewer (written to "
+                "psr-esg.trace in the output directory, or in the working "
+                "directory if no output directory is given)");
 PSR_OPTION_FLAG(EmitTHAsTextOpt, "emit-th-as-text",
                 "Emit the type hierarchy as text");
 PSR_OPTION_FLAG(EmitTHAsDotOpt, "emit-th-as-dot",
@@ -201,6 +218,39 @@ PSR_OPTION_FLAG(
     "Let the IFDS/IDE Solver record all ESG edges whole solving the dataflow "
     "problem. This can have massive performance impact",
     cl::Hidden);
+PSR_OPTION_FLAG(InferIdentitySummariesOpt, "infer-identity-summaries",
+                "Let the IFDS/IDE Solver skip callees that cannot affect "
+                "pointer-typed dataflow-facts according to a mod/ref "
+                "pre-analysis");
+PSR_OPTION_FLAG(AdaptivePrecisionOpt, "adaptive-precision",
+                "Let the IFDS/IDE Solver coarsen the dataflow-facts of "
+                "functions that exceed the fact limits, trading precision for "
+                "guaranteed completion");
+cl::opt<size_t> MaxFactsPerNodeOpt(
+    "max-facts-per-node",
+    cl::desc("Number of dataflow-facts per instruction after which "
+             "--adaptive-precision coarsens the facts"),
+    cl::init(1000), cl::cat(PsrCat));
+cl::opt<size_t> MaxFactsPerFunctionOpt(
+    "max-facts-per-function",
+    cl::desc("Number of dataflow-facts per function after which "
+             "--adaptive-precision coarsens the facts"),
+    cl::init(100000), cl::cat(PsrCat));
+PSR_OPTION_FLAG(SpillJumpFunctionsOpt, "spill-jump-functions",
+                "Let the IFDS/IDE Solver move the jump functions of the least "
+                "recently used functions to a temporary file, trading time "
+                "for memory");
+cl::opt<size_t> MaxResidentJumpFunctionsOpt(
+    "max-resident-jump-functions",
+    cl::desc("Number of jump functions held in memory after which "
+             "--spill-jump-functions moves them to a temporary file"),
+    cl::init(1000000), cl::cat(PsrCat));
+PSR_OPTION_FLAG(CompressFactClassesOpt, "compress-fact-classes",
+                "Let the IFDS/IDE Solver propagate dataflow-facts that are "
+                "generated together and flow alike as a single fact");
+PSR_OPTION_FLAG(SolveWithBitVectorsOpt, "solve-with-bit-vectors",
+                "Solve analyses that provide a bit-vector solver (currently "
+                "ifds-uninit) with it instead of the IFDS/IDE Solver");
 PSR_OPTION_FLAG(PersistedSummariesOpt, "persisted-summaries",
                 "Let the IFDS/IDE Solver compute persisted procedure summaries "
                 "(Currently not supported)",
@@ -212,6 +262,13 @@ cl::opt<std::string>
                                 "via emit-pta-as-json from the given file"),
                        cl::cat(PsrCat));
 
+cl::opt<std::string> SummaryLibraryOpt(
+    "summary-library",
+    cl::desc("Load precomputed summaries of library functions (e.g. generated "
+             "by phasar-summary-gen) from the given file and use them instead "
+             "of analyzing the summarized callees"),
+    cl::cat(PsrCat));
+
 PSR_SHORTLONG_OPTION(PammOutOpt, std::string, "A", "pamm-out",
                      "Filename for PAMM's gathered data",
                      cl::init("PAMM_data.json"), cl::cat(PsrCat), cl::Hidden);
@@ -334,7 +391,11 @@ int main(int Argc, const char **Argv) {
   validatePTAJsonFile();
 
   // setup IRDB as source code manager
-  ProjectIRDB IRDB(std::vector(ModuleOpt.begin(), ModuleOpt.end()));
+  auto IRDBOpts = IRDBOptions::WPA | IRDBOptions::OWNS;
+  if (NormalizeIROpt) {
+    IRDBOpts |= IRDBOptions::NORMALIZE;
+  }
+  ProjectIRDB IRDB(std::vector(ModuleOpt.begin(), ModuleOpt.end()), IRDBOpts);
   if (StatisticsOpt) {
     llvm::outs() << "Module " << IRDB.getWPAModule()->getName() << ":\n";
     llvm::outs() << "> LLVM IR instructions:\t" << IRDB.getNumInstructions()
@@ -369,6 +430,9 @@ int main(int Argc, const char **Argv) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitESGAsDot;
     SolverConfig.setEmitESG();
   }
+  if (EmitESGAsTraceOpt) {
+    EmitterOptions |= AnalysisControllerEmitterOptions::EmitESGAsTrace;
+  }
   if (EmitTHAsTextOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitTHAsText;
   }
@@ -402,14 +466,33 @@ int main(int Argc, const char **Argv) {
   SolverConfig.setFollowReturnsPastSeeds(FollowReturnPastSeedsOpt);
   SolverConfig.setAutoAddZero(AutoAddZeroOpt);
   SolverConfig.setComputeValues(ComputeValuesOpt);
-  SolverConfig.setRecordEdges(RecordEdgesOpt || EmitESGAsDotOpt);
+  SolverConfig.setRecordEdges(RecordEdgesOpt || EmitESGAsDotOpt ||
+                              EmitESGAsTraceOpt);
   SolverConfig.setComputePersistedSummaries(PersistedSummariesOpt);
+  SolverConfig.setInferIdentitySummaries(InferIdentitySummariesOpt);
+  SolverConfig.setAdaptivePrecision(AdaptivePrecisionOpt);
+  SolverConfig.setFactLimits(MaxFactsPerNodeOpt, MaxFactsPerFunctionOpt);
+  SolverConfig.setSpillJumpFunctions(SpillJumpFunctionsOpt);
+  SolverConfig.setMaxResidentJumpFunctions(MaxResidentJumpFunctionsOpt);
+  SolverConfig.setCompressFactClasses(CompressFactClassesOpt);
+  SolverConfig.setSolveWithBitVectors(SolveWithBitVectorsOpt);
 
   nlohmann::json PrecomputedPointsToSet;
   if (!LoadPTAFromJsonOpt.empty()) {
     PrecomputedPointsToSet = readJsonFile(llvm::StringRef(LoadPTAFromJsonOpt));
   }
 
+  SummaryLibrary LibrarySummaries;
+  if (!SummaryLibraryOpt.empty()) {
+    try {
+      LibrarySummaries = SummaryLibrary::readFile(SummaryLibraryOpt);
+    } catch (const std::exception &Ex) {
+      llvm::errs() << "Cannot load summary library '" << SummaryLibraryOpt
+                   << "': " << Ex.what() << '\n';
+      exit(1);
+    }
+  }
+
   if (EntryOpt.empty()) {
     EntryOpt.push_back("main");
   }
@@ -419,6 +502,7 @@ int main(int Argc, const char **Argv) {
       {AnalysisConfigOpt.getValue()}, PTATypeOpt, CGTypeOpt, SoundnessOpt,
       AutoGlobalsOpt, std::vector(EntryOpt.begin(), EntryOpt.end()),
       StrategyOpt, EmitterOptions, SolverConfig, ProjectIdOpt, OutDirOpt,
-      PrecomputedPointsToSet);
+      PrecomputedPointsToSet, std::move(LibrarySummaries),
+      FieldSensitivityDepthOpt);
   return 0;
 }
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibraryGenerator.h"
+#include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace psr;
+
+namespace cl = llvm::cl;
+
+namespace {
+
+cl::OptionCategory GeneratorCat("phasar-summary-gen");
+
+cl::list<std::string> ModuleOpt(cl::Positional,
+                                cl::desc("<library bitcode or IR files>"),
+                                cl::OneOrMore, cl::cat(GeneratorCat));
+
+cl::opt<std::string> OutputOpt("o", cl::desc("Output file (default: stdout)"),
+                               cl::init("-"), cl::cat(GeneratorCat));
+
+cl::list<std::string> AnalysisOpt(
+    "analysis",
+    cl::desc("Analyses to emit the summaries for (default: ifds-taint, "
+             "ifds-uninit, ide-lca)"),
+    cl::CommaSeparated, cl::cat(GeneratorCat));
+
+cl::opt<std::string>
+    BaseOpt("base",
+            cl::desc("Extend the given summary library instead of starting "
+                     "from an empty one"),
+            cl::cat(GeneratorCat));
+
+} // anonymous namespace
+
+int main(int Argc, const char **Argv) {
+  cl::HideUnrelatedOptions(GeneratorCat);
+  cl::ParseCommandLineOptions(
+      Argc, Argv,
+      "Precomputes function summaries of a library, e.g. libc compiled to "
+      "bitcode, that phasar-llvm loads via --summary-library\n");
+
+  std::vector<std::string> Analyses(AnalysisOpt.begin(), AnalysisOpt.end());
+  if (Analyses.empty()) {
+    Analyses = {"ifds-taint", "ifds-uninit", "ide-lca"};
+  }
+  for (const auto &Analysis : Analyses) {
+    if (toDataFlowAnalysisType(Analysis) == DataFlowAnalysisType::None) {
+      llvm::errs() << "Unknown analysis '" << Analysis << "'\n";
+      return 1;
+    }
+  }
+
+  try {
+    SummaryLibrary Lib =
+        BaseOpt.empty() ? SummaryLibrary() : SummaryLibrary::readFile(BaseOpt);
+
+    ProjectIRDB IRDB(std::vector<std::string>(ModuleOpt.begin(),
+                                              ModuleOpt.end()),
+                     IRDBOptions::WPA);
+    SummaryLibraryGenerator Generator(IRDB);
+    Generator.addTo(Lib, Analyses);
+    llvm::errs() << "Summarized " << Generator.size() << " functions\n";
+
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(OutputOpt, EC);
+    if (EC) {
+      llvm::errs() << "Failed to open file: " << OutputOpt << '\n'
+                   << EC.message() << '\n';
+      return 1;
+    }
+    OS << Lib.getAsJson().dump(2) << '\n';
+  } catch (const std::exception &Ex) {
+    llvm::errs() << "Error: " << Ex.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
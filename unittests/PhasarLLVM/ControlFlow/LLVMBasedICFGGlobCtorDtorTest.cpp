@@ -12,15 +12,19 @@
 #include <algorithm>
 #include <array>
 #include <initializer_list>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/IR/Dominators.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Verifier.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -150,6 +154,114 @@ TEST_F(LLVMBasedICFGGlobCtorDtorTest, DtorTest1) {
                              }));
 }
 
+TEST_F(LLVMBasedICFGGlobCtorDtorTest, ModelDoesNotModifyIR) {
+
+  ProjectIRDB IRDB({PathToLLFiles + "globals_dtor_1_cpp.ll"});
+  auto *M = IRDB.getWPAModule();
+  auto NumFunctions = M->size();
+  auto NumInstructions = IRDB.getNumInstructions();
+
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                     Soundness::Soundy, /*IncludeGlobals*/ true);
+
+  EXPECT_EQ(NumFunctions, M->size());
+  EXPECT_EQ(nullptr, M->getFunction(LLVMBasedICFG::GlobalCRuntimeModelName));
+
+  const auto *GlobalCtor =
+      IRDB.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName);
+  ASSERT_NE(nullptr, GlobalCtor);
+  EXPECT_EQ(IRDB.getSyntheticModule(*M, "main"), GlobalCtor->getParent());
+  EXPECT_TRUE(IRDB.isSyntheticModule(GlobalCtor->getParent()));
+  EXPECT_FALSE(llvm::verifyModule(*GlobalCtor->getParent(), &llvm::errs()));
+  // The model calls main through a declaration, so M's use lists stay intact
+  EXPECT_TRUE(M->getFunction("main")->use_empty());
+  EXPECT_TRUE(IRDB.getAllFunctions().count(GlobalCtor));
+  EXPECT_LT(NumInstructions, IRDB.getNumInstructions());
+
+  // A second ICFG with the same entry points reuses the model
+  LLVMBasedICFG ICFG2(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                      Soundness::Soundy, /*IncludeGlobals*/ true);
+  EXPECT_EQ(GlobalCtor,
+            IRDB.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName));
+  EXPECT_FALSE(ICFG2.getCallersOf(IRDB.getFunction("main")).empty());
+}
+
+TEST_F(LLVMBasedICFGGlobCtorDtorTest, ModelPerEntryPoints) {
+
+  ProjectIRDB IRDB({PathToLLFiles + "globals_dtor_1_cpp.ll"});
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                     Soundness::Soundy, /*IncludeGlobals*/ true);
+  const auto *GlobalCtor =
+      ICFG.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName);
+  ASSERT_NE(nullptr, GlobalCtor);
+  const auto *GlobalCtorInst = &GlobalCtor->front().front();
+  auto GlobalCtorInstId = getMetaDataID(GlobalCtorInst);
+
+  // A second ICFG with other entry points gets a model of its own and leaves
+  // the one of the first ICFG intact
+  LLVMBasedICFG ICFG2(&IRDB, CallGraphAnalysisType::OTF, {"main", "_Z3barv"},
+                      &TH, &PT, Soundness::Soundy, /*IncludeGlobals*/ true);
+  const auto *GlobalCtor2 =
+      ICFG2.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName);
+  ASSERT_NE(nullptr, GlobalCtor2);
+  EXPECT_NE(GlobalCtor, GlobalCtor2);
+  EXPECT_EQ(GlobalCtor,
+            ICFG.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName));
+  EXPECT_FALSE(llvm::verifyModule(*GlobalCtor->getParent(), &llvm::errs()));
+  EXPECT_FALSE(llvm::verifyModule(*GlobalCtor2->getParent(), &llvm::errs()));
+  // The IRDB finds the model that has been built first
+  EXPECT_EQ(GlobalCtor,
+            IRDB.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName));
+
+  EXPECT_EQ(GlobalCtorInst,
+            IRDB.getInstruction(std::stoul(GlobalCtorInstId)));
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  ASSERT_EQ(1U, ICFG.getCallersOf(Main).size());
+  EXPECT_EQ(GlobalCtor, ICFG.getCallersOf(Main).front()->getFunction());
+  ASSERT_EQ(1U, ICFG2.getCallersOf(Main).size());
+  EXPECT_EQ(GlobalCtor2, ICFG2.getCallersOf(Main).front()->getFunction());
+
+  // Only the model of the second ICFG calls bar()
+  const auto *Bar = IRDB.getFunctionDefinition("_Z3barv");
+  ASSERT_NE(nullptr, Bar);
+  auto CalledFromModel = [Bar](const LLVMBasedICFG &ICF,
+                               const llvm::Function *Model) {
+    return llvm::any_of(ICF.getCallersOf(Bar),
+                        [Model](const llvm::Instruction *CS) {
+                          return CS->getFunction() == Model;
+                        });
+  };
+  EXPECT_FALSE(CalledFromModel(ICFG, GlobalCtor));
+  EXPECT_TRUE(CalledFromModel(ICFG2, GlobalCtor2));
+}
+
+TEST_F(LLVMBasedICFGGlobCtorDtorTest, ModelOfNormalizedIR) {
+
+  // Normalization removes instructions and leaves gaps in the IDs, which the
+  // instructions of the model must not fill with IDs that are in use already
+  ProjectIRDB IRDB({PathToLLFiles + "globals_dtor_1_cpp.ll"},
+                   IRDBOptions::WPA | IRDBOptions::NORMALIZE);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                     Soundness::Soundy, /*IncludeGlobals*/ true);
+  ASSERT_NE(nullptr, IRDB.getFunction(LLVMBasedICFG::GlobalCRuntimeModelName));
+
+  std::set<std::size_t> Ids;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      auto Id = ProjectIRDB::getInstructionID(&I);
+      EXPECT_TRUE(Ids.insert(Id).second) << "Duplicate ID " << Id;
+      EXPECT_EQ(&I, IRDB.getInstruction(Id)) << llvmIRToString(&I);
+    }
+  }
+}
+
 TEST_F(LLVMBasedICFGGlobCtorDtorTest, LCATest1) {
 
   ProjectIRDB IRDB({PathToLLFiles + "globals_lca_1_cpp.ll"});
@@ -369,10 +481,21 @@ TEST_F(LLVMBasedICFGGlobCtorDtorTest, LCATest5) {
 
   EXPECT_EQ(42, Solver.resultAt(AfterGlobalInit, Foo));
   EXPECT_EQ(42, Solver.resultAt(AtMainPrintF, Foo));
-  // For whatever reason the analysis computes Top for _this inside the dtor.
-  // However, it correctly considers foo=42 inside __PHASAR_DTOR_CALLER.
-
-  // EXPECT_EQ(43, Solver.resultAt(BeforeDtorPrintF, Foo));
+  // The registered dtor is called on foo itself, so its value binds to _this
+  const auto *Dtor = IRDB.getFunctionDefinition("_Z8Foo_dtorRi");
+  ASSERT_NE(nullptr, Dtor);
+  const llvm::CallBase *DtorPrintF = nullptr;
+  for (const auto &I : llvm::instructions(Dtor)) {
+    if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I);
+        Call && Call->getCalledFunction() &&
+        Call->getCalledFunction()->getName() == "printf") {
+      DtorPrintF = Call;
+      break;
+    }
+  }
+  ASSERT_NE(nullptr, DtorPrintF);
+  EXPECT_EQ(42, Solver.resultAt(DtorPrintF, Dtor->getArg(0)));
+  EXPECT_EQ(42, Solver.resultAt(DtorPrintF, Foo));
 }
 
 int main(int Argc, char **Argv) {
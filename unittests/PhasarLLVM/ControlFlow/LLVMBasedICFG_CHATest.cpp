@@ -5,6 +5,7 @@
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/CHAResolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/CallGraphAnalysisType.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
@@ -15,6 +16,15 @@
 using namespace std;
 using namespace psr;
 
+namespace {
+/// Exposes the cached dispatch tables of the CHAResolver
+class DispatchTableCHAResolver : public CHAResolver {
+public:
+  using CHAResolver::CHAResolver;
+  using CHAResolver::getDispatchTable;
+};
+} // namespace
+
 TEST(LLVMBasedICFG_CHATest, StaticCallSite_1) {
   ProjectIRDB IRDB(
       {unittest::PathToLLTestFiles + "call_graphs/static_callsite_1_c.ll"},
@@ -61,6 +71,38 @@ TEST(LLVMBasedICFG_CHATest, VirtualCallSite_2) {
   }
 }
 
+TEST(LLVMBasedICFG_CHATest, VirtualCallSite_2_DispatchCache) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/virtual_call_2_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  const llvm::Function *F = IRDB.getFunctionDefinition("main");
+  ASSERT_TRUE(F);
+  const auto *CallSite =
+      llvm::dyn_cast<llvm::CallBase>(getNthInstruction(F, 13));
+  ASSERT_TRUE(CallSite);
+  auto VtableIndex = getVFTIndex(CallSite);
+  ASSERT_TRUE(VtableIndex.has_value());
+  const auto *ReceiverTy = getReceiverType(CallSite);
+
+  DispatchTableCHAResolver CachingResolver(IRDB, TH);
+  auto FirstCallees = CachingResolver.resolveVirtualCall(CallSite);
+  auto SecondCallees = CachingResolver.resolveVirtualCall(CallSite);
+  // The second lookup with the same (receiver type, vtable index) pair must
+  // be served by the table that was built by the first one
+  const auto &Table =
+      CachingResolver.getDispatchTable(ReceiverTy, *VtableIndex, CallSite);
+  EXPECT_EQ(&Table, &CachingResolver.getDispatchTable(ReceiverTy,
+                                                      *VtableIndex, CallSite));
+  EXPECT_EQ(2U, Table.size());
+
+  CHAResolver UncachedResolver(IRDB, TH);
+  auto UncachedCallees = UncachedResolver.resolveVirtualCall(CallSite);
+  EXPECT_EQ(2U, UncachedCallees.size());
+  EXPECT_EQ(UncachedCallees, FirstCallees);
+  EXPECT_EQ(UncachedCallees, SecondCallees);
+}
+
 TEST(LLVMBasedICFG_CHATest, VirtualCallSite_9) {
   ProjectIRDB IRDB(
       {unittest::PathToLLTestFiles + "call_graphs/virtual_call_9_cpp.ll"},
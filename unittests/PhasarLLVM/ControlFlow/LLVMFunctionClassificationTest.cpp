@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/FunctionClassification.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedBackwardICFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/SpecialMemberFunctionType.h"
+#include "phasar/PhasarLLVM/TaintConfig/TaintConfig.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+TEST(LLVMFunctionClassificationTest, ClassifiesFunctions) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "control_flow/function_classification_cpp.ll"},
+                   IRDBOptions::WPA);
+  LLVMFunctionClassification FunClasses(IRDB);
+  EXPECT_EQ(IRDB.getNumFunctions(), FunClasses.size());
+
+  const auto *Main = IRDB.getFunction("main");
+  const auto *Malloc = IRDB.getFunction("malloc");
+  const auto *New = IRDB.getFunction("_Znwm");
+  const auto *Memcpy = IRDB.getFunction("llvm.memcpy.p0i8.p0i8.i64");
+  const auto *Ctor = IRDB.getFunction("_ZN1SC2Ev");
+  const auto *Dtor = IRDB.getFunction("_ZN1SD2Ev");
+
+  auto MainAttrs = FunClasses.getAttributes(Main);
+  EXPECT_FALSE(MainAttrs.isDeclaration());
+  EXPECT_FALSE(MainAttrs.isLLVMIntrinsic());
+  EXPECT_FALSE(MainAttrs.isHeapAllocating());
+  EXPECT_FALSE(MainAttrs.isSpecialMemberFunction());
+
+  auto MallocAttrs = FunClasses.getAttributes(Malloc);
+  EXPECT_TRUE(MallocAttrs.isDeclaration());
+  EXPECT_TRUE(MallocAttrs.isHeapAllocating());
+  EXPECT_FALSE(MallocAttrs.isLLVMIntrinsic());
+
+  auto NewAttrs = FunClasses.getAttributes(New);
+  EXPECT_TRUE(NewAttrs.isHeapAllocating());
+  EXPECT_TRUE(NewAttrs.isSpecialFunction());
+
+  auto MemcpyAttrs = FunClasses.getAttributes(Memcpy);
+  EXPECT_TRUE(MemcpyAttrs.isDeclaration());
+  EXPECT_TRUE(MemcpyAttrs.isLLVMIntrinsic());
+  EXPECT_FALSE(MemcpyAttrs.isHeapAllocating());
+
+  EXPECT_EQ(SpecialMemberFunctionType::Constructor,
+            FunClasses.getAttributes(Ctor).SpecialMemberKind);
+  EXPECT_EQ(SpecialMemberFunctionType::Destructor,
+            FunClasses.getAttributes(Dtor).SpecialMemberKind);
+  EXPECT_FALSE(FunClasses.getAttributes(Ctor).isDeclaration());
+}
+
+TEST(LLVMFunctionClassificationTest, CodesAtNameStart) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "control_flow/function_classification_cpp.ll"},
+                   IRDBOptions::WPA);
+  // Names that start with a special member code used to hang the
+  // classification
+  LLVMFunctionClassification FunClasses(IRDB);
+  const auto *Init = IRDB.getFunction("C1_init");
+  const auto *Cleanup = IRDB.getFunction("D2_cleanup");
+  ASSERT_NE(nullptr, Init);
+  ASSERT_NE(nullptr, Cleanup);
+  EXPECT_EQ(SpecialMemberFunctionType::None,
+            FunClasses.getAttributes(Init).SpecialMemberKind);
+  EXPECT_EQ(SpecialMemberFunctionType::None,
+            FunClasses.getAttributes(Cleanup).SpecialMemberKind);
+  EXPECT_EQ(SpecialMemberFunctionType::None,
+            LLVMFunctionClassification::getSpecialMemberFunctionType(Init));
+}
+
+TEST(LLVMFunctionClassificationTest, CodesInSourceNames) {
+  llvm::LLVMContext Ctx;
+  llvm::Module M("codes_in_source_names", Ctx);
+  auto *FTy = llvm::FunctionType::get(llvm::Type::getVoidTy(Ctx), false);
+  auto GetKind = [&](llvm::StringRef Name) {
+    return LLVMFunctionClassification::getSpecialMemberFunctionType(
+        llvm::Function::Create(FTy, llvm::Function::ExternalLinkage, Name,
+                               M));
+  };
+  // The codes of special member functions are only found after the names of
+  // the class and the member, even if the names contain such codes
+  EXPECT_EQ(SpecialMemberFunctionType::Constructor, GetKind("_ZN3FooC2Ev"));
+  EXPECT_EQ(SpecialMemberFunctionType::Constructor, GetKind("_ZN2C1C2Ev"));
+  EXPECT_EQ(SpecialMemberFunctionType::Destructor, GetKind("_ZN6Foo_D2D2Ev"));
+  EXPECT_EQ(SpecialMemberFunctionType::None, GetKind("_ZN2D24sizeEv"));
+}
+
+TEST(LLVMFunctionClassificationTest, ICFGAnswersFromClassification) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "control_flow/function_classification_cpp.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH);
+  const auto *FunClasses = ICFG.getFunctionClassification();
+  ASSERT_NE(nullptr, FunClasses);
+
+  // The precomputed attributes match the ones computed by name, including
+  // the model of the global constructors that is generated into the IRDB
+  LLVMBasedCFG CFG;
+  for (const auto *F : ICFG.getAllFunctions()) {
+    ASSERT_NE(nullptr, FunClasses->lookup(F)) << F->getName().str();
+    EXPECT_EQ(CFG.getFunctionAttributes(F), ICFG.getFunctionAttributes(F))
+        << F->getName().str();
+    EXPECT_EQ(CFG.isHeapAllocatingFunction(F),
+              ICFG.isHeapAllocatingFunction(F));
+    EXPECT_EQ(CFG.getSpecialMemberFunctionType(F),
+              ICFG.getSpecialMemberFunctionType(F));
+  }
+
+  LLVMBasedBackwardICFG BackwardICFG(&ICFG);
+  EXPECT_EQ(FunClasses, BackwardICFG.getFunctionClassification());
+}
+
+TEST(LLVMFunctionClassificationTest, TaintRoles) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "control_flow/function_classification_cpp.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH);
+  const auto *Sink = IRDB.getFunction("_Z4sinki");
+  const auto *Free = IRDB.getFunction("free");
+
+  TaintConfig Config{TaintConfig::TaintDescriptionCallBackTy{},
+                     TaintConfig::TaintDescriptionCallBackTy{}};
+  Config.addSinkValue(Sink->getArg(0));
+  Config.addSanitizerValue(Free->getArg(0));
+  ICFG.setTaintRoles(Config);
+  EXPECT_TRUE(ICFG.hasTaintRolesOf(Config));
+
+  auto SinkAttrs = ICFG.getFunctionAttributes(Sink);
+  EXPECT_TRUE(SinkAttrs.is(FunctionClass::TaintSink));
+  EXPECT_FALSE(SinkAttrs.is(FunctionClass::TaintSource));
+  EXPECT_TRUE(SinkAttrs.isDeclaration());
+  EXPECT_TRUE(
+      ICFG.getFunctionAttributes(Free).is(FunctionClass::TaintSanitizer));
+  EXPECT_FALSE(ICFG.getFunctionAttributes(IRDB.getFunction("main"))
+                   .hasTaintRole());
+
+  ICFG.removeFunctionClasses(FunctionClass::AnyTaintRole);
+  EXPECT_FALSE(ICFG.hasTaintRolesOf(Config));
+  EXPECT_FALSE(ICFG.getFunctionAttributes(Sink).hasTaintRole());
+  EXPECT_TRUE(ICFG.getFunctionAttributes(Sink).isDeclaration());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
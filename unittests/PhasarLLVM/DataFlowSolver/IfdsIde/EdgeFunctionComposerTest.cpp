@@ -100,6 +100,122 @@ TEST(EdgeFunctionComposerTest, HandleEFComposition) {
   EXPECT_FALSE(AddEF1->equal_to(AddEF2));
 }
 
+struct AddEF : EdgeFunction<int>, std::enable_shared_from_this<AddEF> {
+  const int Summand;
+
+  AddEF(int Summand) : Summand(Summand){};
+  int computeTarget(int Source) override { return Source + Summand; };
+  std::shared_ptr<EdgeFunction<int>>
+  composeWith(std::shared_ptr<EdgeFunction<int>> SecondFunction) override;
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> /*OtherFunction*/) override {
+    return std::make_shared<AllBottom<int>>(-1);
+  };
+  bool equal_to(std::shared_ptr<EdgeFunction<int>> Other) const override {
+    if (auto *Add = dynamic_cast<AddEF *>(Other.get())) {
+      return Add->Summand == Summand;
+    }
+    return false;
+  }
+  void print(llvm::raw_ostream &Os,
+             bool /*IsForDebug = false*/) const override {
+    Os << "AddEF_" << Summand;
+  }
+};
+
+/// Composes by extending the flattened sequence and merges adjacent AddEFs
+struct FlatEFC : EdgeFunctionComposer<int> {
+  static inline unsigned NumNormalized = 0; // NOLINT
+
+  FlatEFC(std::shared_ptr<EdgeFunction<int>> F,
+          std::shared_ptr<EdgeFunction<int>> G)
+      : EdgeFunctionComposer<int>(std::move(F), std::move(G), &normalize){};
+
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> /*OtherFunction*/) override {
+    return std::make_shared<AllBottom<int>>(-1);
+  };
+
+protected:
+  static void normalize(SequenceTy &Seq) {
+    ++NumNormalized;
+    SequenceTy Normalized;
+    for (const auto &EF : Seq) {
+      auto *Add = dynamic_cast<AddEF *>(EF.get());
+      auto *Prev = Normalized.empty()
+                       ? nullptr
+                       : dynamic_cast<AddEF *>(Normalized.back().get());
+      if (Add && Prev) {
+        Normalized.back() =
+            std::make_shared<AddEF>(Prev->Summand + Add->Summand);
+      } else {
+        Normalized.push_back(EF);
+      }
+    }
+    Seq = std::move(Normalized);
+  }
+
+  std::shared_ptr<EdgeFunction<int>>
+  makeComposer(std::shared_ptr<EdgeFunction<int>> F,
+               std::shared_ptr<EdgeFunction<int>> G) const override {
+    return std::make_shared<FlatEFC>(std::move(F), std::move(G));
+  }
+};
+
+std::shared_ptr<EdgeFunction<int>>
+AddEF::composeWith(std::shared_ptr<EdgeFunction<int>> SecondFunction) {
+  return std::make_shared<FlatEFC>(this->shared_from_this(), SecondFunction);
+}
+
+TEST(EdgeFunctionComposerTest, HandleFlattenedComposition) {
+  // ((3 + 2) * 2) + 2
+  auto AddEF1 = std::make_shared<AddTwoEF>(++CurrAddTwoEfId);
+  auto AddEF2 = std::make_shared<AddTwoEF>(++CurrAddTwoEfId);
+  auto MulEF = std::make_shared<MulTwoEF>(++CurrMulTwoEfId);
+  auto Id = EdgeIdentity<int>::getInstance();
+  std::shared_ptr<EdgeFunction<int>> ComposedEF =
+      std::make_shared<FlatEFC>(AddEF1, Id);
+  ComposedEF = ComposedEF->composeWith(MulEF);
+  ComposedEF = ComposedEF->composeWith(AddEF2);
+  auto *Composer = dynamic_cast<FlatEFC *>(ComposedEF.get());
+  ASSERT_NE(nullptr, Composer);
+  const auto &Seq = Composer->getSequence();
+  ASSERT_EQ(3U, Seq->size());
+  EXPECT_EQ(AddEF1, (*Seq)[0]);
+  EXPECT_EQ(MulEF, (*Seq)[1]);
+  EXPECT_EQ(AddEF2, (*Seq)[2]);
+  EXPECT_EQ(12, ComposedEF->computeTarget(3));
+  // Identical chains share their sequence
+  auto Nested = std::make_shared<FlatEFC>(
+      AddEF1, std::make_shared<FlatEFC>(MulEF, AddEF2));
+  EXPECT_EQ(Seq, Nested->getSequence());
+  EXPECT_TRUE(Nested->equal_to(ComposedEF));
+  CurrAddTwoEfId = 0;
+  CurrMulTwoEfId = 0;
+}
+
+TEST(EdgeFunctionComposerTest, HandleNormalization) {
+  // ((1 + 1 + 1 + 2) * 2) + 3
+  FlatEFC::NumNormalized = 0;
+  auto MulEF = std::make_shared<MulTwoEF>(++CurrMulTwoEfId);
+  auto ComposedEF = std::make_shared<AddEF>(1)
+                        ->composeWith(std::make_shared<AddEF>(1))
+                        ->composeWith(std::make_shared<AddEF>(2))
+                        ->composeWith(MulEF)
+                        ->composeWith(std::make_shared<AddEF>(3));
+  EXPECT_EQ(13, ComposedEF->computeTarget(1));
+  auto *Composer = dynamic_cast<FlatEFC *>(ComposedEF.get());
+  ASSERT_NE(nullptr, Composer);
+  const auto &Seq = Composer->getSequence();
+  ASSERT_EQ(3U, Seq->size());
+  EXPECT_TRUE((*Seq)[0]->equal_to(std::make_shared<AddEF>(4)));
+  EXPECT_EQ(MulEF, (*Seq)[1]);
+  EXPECT_TRUE((*Seq)[2]->equal_to(std::make_shared<AddEF>(3)));
+  // Each composer is normalized once, on construction
+  EXPECT_EQ(4U, FlatEFC::NumNormalized);
+  CurrMulTwoEfId = 0;
+}
+
 // main function for the test case
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
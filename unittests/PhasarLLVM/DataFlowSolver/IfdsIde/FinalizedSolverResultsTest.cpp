@@ -0,0 +1,99 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FinalizedSolverResults.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class FinalizedSolverResultsTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+}; // Test Fixture
+
+TEST_F(FinalizedSolverResultsTest, MatchesSolverResults) {
+  ProjectIRDB IRDB({PathToLlFiles + "call_01_cpp.ll"}, IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  IDELinearConstantAnalysis LCAProblem(&IRDB, &TH, &ICFG, &PT, {"main"});
+  IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+  LCASolver.solve();
+
+  auto Results = LCASolver.finalizeResults();
+  size_t NumEntries = 0;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      auto Expected = LCASolver.resultsAt(&I);
+      auto Actual = Results.resultsAt(&I);
+      NumEntries += Expected.size();
+      ASSERT_EQ(Expected.size(), Actual.size());
+      for (const auto &[Fact, Value] : Actual) {
+        ASSERT_EQ(1U, Expected.count(Fact));
+        EXPECT_EQ(Expected[Fact], Value);
+        const auto *Found = Results.findResultAt(&I, Fact);
+        ASSERT_NE(nullptr, Found);
+        EXPECT_EQ(Value, *Found);
+      }
+      if (!Actual.empty()) {
+        // The zero fact is always first and can be stripped without copying
+        EXPECT_TRUE(LCAProblem.isZeroValue(Actual.front().first));
+        EXPECT_EQ(Actual.drop_front(), Results.resultsAt(&I, true));
+      }
+    }
+  }
+  EXPECT_EQ(NumEntries, Results.size());
+
+  // Statements are grouped by function in IR order
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *Foo = IRDB.getFunctionDefinition("_Z3fooi");
+  ASSERT_EQ(2U, Results.functions().size());
+  std::vector<const llvm::Instruction *> Stmts;
+  Results.foreachStatementOf(
+      Main, [&Stmts](const llvm::Instruction *Stmt, auto /*Results*/) {
+        Stmts.push_back(Stmt);
+      });
+  ASSERT_FALSE(Stmts.empty());
+  for (size_t I = 1; I < Stmts.size(); ++I) {
+    EXPECT_TRUE(Stmts[I - 1]->comesBefore(Stmts[I]));
+  }
+  EXPECT_EQ(Stmts.size(), Results.statementsOf(Main).size());
+  size_t NumStmts = 0;
+  Results.foreachStatement(
+      [&NumStmts](const auto * /*Stmt*/, auto /*Results*/) { ++NumStmts; });
+  EXPECT_EQ(Results.statements().size(), NumStmts);
+  EXPECT_EQ(Results.statementsOf(Main).size() +
+                Results.statementsOf(Foo).size(),
+            NumStmts);
+
+  // In foo, b holds the value 42 at the return
+  const auto *FooRet = &Foo->back().back();
+  const auto *B = &*std::next(Foo->front().begin());
+  EXPECT_EQ(IDELinearConstantAnalysis::l_t(42), Results.resultAt(FooRet, B));
+
+  // The finalized results outlive the solver's tables
+  LCASolver.releaseSolverTables();
+  EXPECT_TRUE(LCASolver.resultsAt(FooRet).empty());
+  EXPECT_EQ(IDELinearConstantAnalysis::l_t(42), Results.resultAt(FooRet, B));
+  EXPECT_TRUE(Results.holdsAt(FooRet, B));
+  EXPECT_FALSE(Results.holdsAt(&Main->front().front(), B));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/ValueSymbolTable.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFunctionSideEffects.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class LLVMFunctionSideEffectsTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "summary_generation/";
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+
+  void initialize(const std::string &LlvmFilePath) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + LlvmFilePath},
+        IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(IRDB.get(),
+                                           CallGraphAnalysisType::OTF,
+                                           std::vector<std::string>{"main"},
+                                           TH.get(), PT.get());
+  }
+
+  std::unordered_map<const llvm::Value *, IDELinearConstantAnalysis::l_t>
+  solveLCA(bool InferIdentitySummaries,
+           const llvm::Instruction *QueryInst) {
+    IDELinearConstantAnalysis LCAProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                         PT.get(), {"main"});
+    LCAProblem.getIFDSIDESolverConfig().setInferIdentitySummaries(
+        InferIdentitySummaries);
+    IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+    LCASolver.solve();
+    return LCASolver.resultsAt(QueryInst, true);
+  }
+}; // Test Fixture
+
+TEST_F(LLVMFunctionSideEffectsTest, ClassifyFunctions) {
+  initialize("inferred_summaries_1_cpp.ll");
+  LLVMFunctionSideEffects SideEffects(*ICFG);
+
+  auto KindOf = [&](llvm::StringRef Name) {
+    const auto *F = IRDB->getFunctionDefinition(Name);
+    EXPECT_NE(nullptr, F) << Name.str();
+    return F ? SideEffects.getSummaryKind(F) : InferredSummaryKind::None;
+  };
+
+  // square(int)
+  EXPECT_EQ(InferredSummaryKind::Identity, KindOf("_Z6squarei"));
+  // logMessage(const char *)
+  EXPECT_EQ(InferredSummaryKind::Identity, KindOf("_Z10logMessagePKc"));
+  // sum(const int *, int)
+  EXPECT_EQ(InferredSummaryKind::Identity, KindOf("_Z3sumPKii"));
+  // reset(int *)
+  EXPECT_EQ(InferredSummaryKind::KillOnly, KindOf("_Z5resetPi"));
+  // callsReset(int *)
+  EXPECT_EQ(InferredSummaryKind::KillOnly, KindOf("_Z10callsResetPi"));
+  // setGlobal(int)
+  EXPECT_EQ(InferredSummaryKind::None, KindOf("_Z9setGlobali"));
+  // identityPtr(int *)
+  EXPECT_EQ(InferredSummaryKind::None, KindOf("_Z11identityPtrPi"));
+  // store(int **, int *)
+  EXPECT_EQ(InferredSummaryKind::None, KindOf("_Z5storePPiS_"));
+  // useUninitialized()
+  EXPECT_EQ(InferredSummaryKind::Identity, KindOf("_Z16useUninitializedv"));
+  EXPECT_EQ(InferredSummaryKind::None, KindOf("main"));
+}
+
+TEST_F(LLVMFunctionSideEffectsTest, SolverSkipsIrrelevantCallees) {
+  initialize("inferred_summaries_1_cpp.ll");
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Reset = IRDB->getFunctionDefinition("_Z5resetPi");
+  ASSERT_NE(nullptr, Main);
+  ASSERT_NE(nullptr, Reset);
+
+  // Skipping callees must not change the results in the caller
+  const auto *MainExit = getLastInstructionOf(Main);
+  EXPECT_EQ(solveLCA(false, MainExit), solveLCA(true, MainExit));
+
+  // reset() is only reached via callsReset(), which is kill-only
+  const auto *ResetEntry = &Reset->front().front();
+  EXPECT_FALSE(solveLCA(false, ResetEntry).empty());
+  EXPECT_TRUE(solveLCA(true, ResetEntry).empty());
+}
+
+TEST_F(LLVMFunctionSideEffectsTest, ZeroFactEntersSkippableCallees) {
+  initialize("inferred_summaries_1_cpp.ll");
+  const auto *UseUninit = IRDB->getFunctionDefinition("_Z16useUninitializedv");
+  ASSERT_NE(nullptr, UseUninit);
+
+  IFDSUninitializedVariables UninitProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                           PT.get(), {"main"});
+  UninitProblem.getIFDSIDESolverConfig().setInferIdentitySummaries(true);
+  IFDSSolver_P<IFDSUninitializedVariables> UninitSolver(UninitProblem);
+  UninitSolver.solve();
+
+  // useUninitialized() cannot affect its caller, but the use of X within it
+  // still has to be reported
+  bool ReportedInCallee = llvm::any_of(
+      UninitProblem.getAllUndefUses(),
+      [UseUninit](const auto &Use) {
+        return Use.first->getFunction() == UseUninit;
+      });
+  EXPECT_TRUE(ReportedInCallee);
+}
+
+TEST_F(LLVMFunctionSideEffectsTest, WritesThroughDerivedPointers) {
+  initialize("inferred_summaries_2_cpp.ll");
+  LLVMFunctionSideEffects SideEffects(*ICFG);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Reset = IRDB->getFunctionDefinition("_Z5resetPi");
+  ASSERT_NE(nullptr, Main);
+  ASSERT_NE(nullptr, Reset);
+  ASSERT_EQ(InferredSummaryKind::KillOnly, SideEffects.getSummaryKind(Reset));
+  const auto *Q = Main->getValueSymbolTable()->lookup("Q");
+  const auto *X = Main->getValueSymbolTable()->lookup("X");
+  const auto *Y = Main->getValueSymbolTable()->lookup("Y");
+  ASSERT_NE(nullptr, Q);
+  ASSERT_NE(nullptr, X);
+  ASSERT_NE(nullptr, Y);
+  std::vector<const llvm::CallBase *> ResetCalls;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(&I);
+        CS && CS->getCalledFunction() == Reset) {
+      ResetCalls.push_back(CS);
+    }
+  }
+  ASSERT_EQ(2U, ResetCalls.size());
+
+  // reset(&Q.Second) writes into Q through a field GEP
+  EXPECT_EQ(InferredFactEffect::Unknown,
+            SideEffects.getFactEffect(ResetCalls[0], Reset, Q, false));
+  EXPECT_EQ(InferredFactEffect::Preserve,
+            SideEffects.getFactEffect(ResetCalls[0], Reset, X, false));
+  // reset(&X) overwrites X as a whole
+  EXPECT_EQ(InferredFactEffect::Kill,
+            SideEffects.getFactEffect(ResetCalls[1], Reset, X, false));
+  EXPECT_EQ(InferredFactEffect::Preserve,
+            SideEffects.getFactEffect(ResetCalls[1], Reset, Y, false));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,101 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ParallelWholeProgramAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class ParallelWholeProgramAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = unittest::PathToLLTestFiles;
+
+  /// Solves the problem sequentially with all entry points at once and in
+  /// parallel with one partition per entry point, and compares the results.
+  /// Returns the number of partitions.
+  template <typename SolverTy, typename ProblemTy>
+  static size_t
+  compareWithSequential(ProjectIRDB &IRDB,
+                        const std::vector<std::string> &EntryPoints,
+                        const IFDSIDESolverConfig &SolverConfig) {
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    ProblemTy Problem(&IRDB, &TH, &ICFG, &PT,
+                      {EntryPoints.begin(), EntryPoints.end()});
+    Problem.setIFDSIDESolverConfig(SolverConfig);
+    SolverTy Solver(Problem);
+    Solver.solve();
+
+    ParallelWholeProgramAnalysis<SolverTy, ProblemTy> Parallel(
+        SolverConfig, IRDB, EntryPoints, &PT, &ICFG, &TH);
+    Parallel.solve(2);
+
+    size_t NumEntries = 0;
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        auto Expected = Solver.resultsAt(&I);
+        auto Actual = Parallel.resultsAt(&I);
+        NumEntries += Expected.size();
+        EXPECT_EQ(Expected, Actual) << "at " << llvmIRToString(&I);
+      }
+    }
+    EXPECT_NE(0U, NumEntries);
+    // The helper analyses are owned by this function
+    Parallel.releaseAllHelperAnalyses();
+    return Parallel.getNumPartitions();
+  }
+}; // Test Fixture
+
+TEST_F(ParallelWholeProgramAnalysisTest, JoinsLinearConstants) {
+  ProjectIRDB IRDB({PathToLlFiles + "linear_constant/call_11_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  // foo and bar are called with 2 from main, but also are entry points of
+  // their own with unknown arguments, so the results of the partitions have to
+  // be joined
+  auto NumPartitions =
+      compareWithSequential<IDESolver_P<IDELinearConstantAnalysis>,
+                            IDELinearConstantAnalysis>(IRDB, {"__ALL__"},
+                                                       IFDSIDESolverConfig{});
+  // One partition per function definition; the ICFG does not model the
+  // global constructors and destructors
+  size_t NumDefinitions =
+      llvm::count_if(IRDB.getAllFunctions(),
+                     [](const auto *F) { return !F->isDeclaration(); });
+  EXPECT_LE(3U, NumDefinitions);
+  EXPECT_EQ(NumDefinitions, NumPartitions);
+}
+
+TEST_F(ParallelWholeProgramAnalysisTest, MergesIFDSResults) {
+  ProjectIRDB IRDB(
+      {PathToLlFiles + "uninitialized_variables/callnoret_c_dbg.ll"},
+      IRDBOptions::WPA);
+  IFDSIDESolverConfig SolverConfig;
+  SolverConfig.setInferIdentitySummaries(true);
+  auto NumPartitions =
+      compareWithSequential<IFDSSolver_P<IFDSUninitializedVariables>,
+                            IFDSUninitializedVariables>(
+          IRDB, {"addTen", "main"}, SolverConfig);
+  EXPECT_EQ(2U, NumPartitions);
+}
+
+// main
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
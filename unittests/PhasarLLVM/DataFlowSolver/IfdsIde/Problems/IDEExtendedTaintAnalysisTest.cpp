@@ -49,6 +49,8 @@ class IDETaintAnalysisTest : public ::testing::Test {
 protected:
   const std::string PathToLLFiles = unittest::PathToLLTestFiles + "xtaint/";
   const std::set<std::string> EntryPoints = {"main"};
+  IFDSIDESolverConfig SolverConfig;
+  size_t NumCoarsenedFacts = 0;
 
   IDETaintAnalysisTest() = default;
   ~IDETaintAnalysisTest() override = default;
@@ -82,9 +84,11 @@ protected:
 
     IDEExtendedTaintAnalysis<> TaintProblem(&IRDB, &TH, &ICFG, &PT, TC,
                                             EntryPoints);
+    TaintProblem.setIFDSIDESolverConfig(SolverConfig);
 
     IDESolver_P<IDEExtendedTaintAnalysis<>> Solver(TaintProblem);
     Solver.solve();
+    NumCoarsenedFacts = Solver.getNumCoarsenedFacts();
     // Solver.printAnnotatedIR();
     if (DumpResults) {
       Solver.dumpResults();
@@ -181,6 +185,19 @@ TEST_F(IDETaintAnalysisTest, XTaint04) {
   doAnalysis({PathToLLFiles + "xtaint04_cpp.ll"}, Gt, std::monostate{});
 }
 
+TEST_F(IDETaintAnalysisTest, XTaint04_AdaptivePrecision) {
+  map<int, set<string>> Gt;
+
+  // array[1] is coarsened to the whole array, so array[0] leaks as well
+  Gt[13] = {"12"};
+  Gt[17] = {"16"};
+
+  SolverConfig.setAdaptivePrecision();
+  SolverConfig.setFactLimits(1, 1);
+  doAnalysis({PathToLLFiles + "xtaint04_cpp.ll"}, Gt, std::monostate{});
+  EXPECT_GT(NumCoarsenedFacts, 0U);
+}
+
 // XTaint05 is similar to 06, but even harder
 
 TEST_F(IDETaintAnalysisTest, XTaint06) {
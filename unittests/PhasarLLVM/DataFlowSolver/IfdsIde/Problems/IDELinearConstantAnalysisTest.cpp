@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 
+#include "llvm/IR/InstIterator.h"
+
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
@@ -204,6 +206,22 @@ TEST_F(IDELinearConstantAnalysisTest, HandleBasicTest_12) {
   compareResults(Results, GroundTruth);
 }
 
+TEST_F(IDELinearConstantAnalysisTest, HandleBasicTest_13) {
+  auto Results = doAnalysis("basic_13_cpp_dbg.ll");
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 3);
+  GroundTruth.emplace("main", 3, "i", 3);
+  GroundTruth.emplace("main", 3, "j", 85);
+  GroundTruth.emplace("main", 4, "i", 3);
+  GroundTruth.emplace("main", 4, "j", 85);
+  GroundTruth.emplace("main", 4, "k", -248);
+  GroundTruth.emplace("main", 5, "i", 3);
+  GroundTruth.emplace("main", 5, "j", 85);
+  GroundTruth.emplace("main", 5, "k", -248);
+  GroundTruth.emplace("main", 5, "l", -124);
+  compareResults(Results, GroundTruth);
+}
+
 /* ============== BRANCH TESTS ============== */
 TEST_F(IDELinearConstantAnalysisTest, HandleBranchTest_01) {
   auto Results = doAnalysis("branch_01_cpp_dbg.ll");
@@ -814,6 +832,81 @@ TEST_F(IDELinearConstantAnalysisTest, HandleModuloByZero) {
   compareResults(Results, GroundTruth);
 }
 
+TEST_F(IDELinearConstantAnalysisTest, HandleSpilledJumpFunctions) {
+  auto IRFiles = {PathToLlFiles + "call_11_cpp_dbg.ll"};
+  IRDB = std::make_unique<ProjectIRDB>(IRFiles, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  LLVMTypeHierarchy TH(*IRDB);
+  LLVMPointsToSet PT(*IRDB);
+  LLVMBasedICFG ICFG(IRDB.get(), CallGraphAnalysisType::OTF, {"main"}, &TH,
+                     &PT);
+
+  IDELinearConstantAnalysis LCAProblem(IRDB.get(), &TH, &ICFG, &PT, {"main"});
+  IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+  LCASolver.solve();
+
+  // Keeps at most one jump function in memory, such that every partition
+  // but the one currently being extended is spilled
+  IDELinearConstantAnalysis SpillingLCAProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                               {"main"});
+  SpillingLCAProblem.getIFDSIDESolverConfig().setSpillJumpFunctions();
+  SpillingLCAProblem.getIFDSIDESolverConfig().setMaxResidentJumpFunctions(1);
+  IDESolver_P<IDELinearConstantAnalysis> SpillingLCASolver(SpillingLCAProblem);
+  SpillingLCASolver.solve();
+
+  EXPECT_EQ(0U, LCASolver.getNumJumpFunctionSpills());
+  EXPECT_GT(SpillingLCASolver.getNumJumpFunctionSpills(), 0U);
+  EXPECT_GT(SpillingLCASolver.getNumJumpFunctionFaults(), 0U);
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      EXPECT_EQ(LCASolver.resultsAt(&I), SpillingLCASolver.resultsAt(&I))
+          << "At " << llvmIRToShortString(&I);
+    }
+  }
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleFactClasses) {
+  for (const auto *File :
+       {"basic_05_cpp_dbg.ll", "branch_03_cpp_dbg.ll", "while_02_cpp_dbg.ll",
+        "call_07_cpp_dbg.ll", "call_11_cpp_dbg.ll", "recursion_01_cpp_dbg.ll",
+        "global_05_cpp_dbg.ll"}) {
+    SCOPED_TRACE(File);
+    auto IRFiles = {PathToLlFiles + File};
+    IRDB = std::make_unique<ProjectIRDB>(IRFiles, IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    LLVMTypeHierarchy TH(*IRDB);
+    LLVMPointsToSet PT(*IRDB);
+    LLVMBasedICFG ICFG(IRDB.get(), CallGraphAnalysisType::OTF, {"main"}, &TH,
+                       &PT, Soundness::Soundy, /*IncludeGlobals*/ true);
+    std::set<std::string> EntryPoints = {
+        IRDB->getFunctionDefinition(LLVMBasedICFG::GlobalCRuntimeModelName)
+            ? LLVMBasedICFG::GlobalCRuntimeModelName.str()
+            : "main"};
+
+    IDELinearConstantAnalysis LCAProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                         EntryPoints);
+    IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+    LCASolver.solve();
+
+    IDELinearConstantAnalysis FactClassLCAProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                                  EntryPoints);
+    FactClassLCAProblem.getIFDSIDESolverConfig().setCompressFactClasses();
+    IDESolver_P<IDELinearConstantAnalysis> FactClassLCASolver(
+        FactClassLCAProblem);
+    FactClassLCASolver.solve();
+
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(LCASolver.resultsAt(&I), FactClassLCASolver.resultsAt(&I))
+            << "At " << llvmIRToShortString(&I);
+      }
+    }
+    EXPECT_EQ(LCAProblem.getLCAResults(LCASolver.getSolverResults()),
+              FactClassLCAProblem.getLCAResults(
+                  FactClassLCASolver.getSolverResults()));
+  }
+}
+
 // main function for the test case
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
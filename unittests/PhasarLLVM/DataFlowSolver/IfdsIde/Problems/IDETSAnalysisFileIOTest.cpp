@@ -11,10 +11,16 @@
 
 #include "gtest/gtest.h"
 
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/ValueSymbolTable.h"
+
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEMultiTypeStateAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDETypeStateAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CSTDFILEIOTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CompiledTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/OpenSSLEVPKDFDescription.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
@@ -552,6 +558,126 @@ TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_19) {
   compareResults(Gt, Llvmtssolver);
 }
 
+TEST_F(IDETSAnalysisFileIOTest, HandleCompiledDescription) {
+  initialize({PathToLlFiles + "typestate_01_c.ll"});
+  CompiledTypeStateDescription CTSD(*CSTDFILEIODesc, *IRDB);
+  const auto *Fopen = IRDB->getFunction("fopen");
+  const auto *Fclose = IRDB->getFunction("fclose");
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_TRUE(Fopen && Fclose && Main);
+
+  EXPECT_TRUE(CTSD.isFactoryFunction(Fopen));
+  EXPECT_FALSE(CTSD.isConsumingFunction(Fopen));
+  EXPECT_TRUE(CTSD.isConsumingFunction(Fclose));
+  EXPECT_EQ(CTSD.getFunctionInfo(Fclose).ConsumerParamIdx.size(), 1U);
+  EXPECT_EQ(CTSD.getFunctionInfo(Fclose).ConsumerParamIdx.front(), 0);
+  EXPECT_FALSE(CTSD.isAPIFunction(Main));
+
+  const llvm::CallBase *FcloseCall = nullptr;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (const auto *CB = llvm::dyn_cast<llvm::CallBase>(&I);
+        CB && CB->getCalledFunction() == Fclose) {
+      FcloseCall = CB;
+    }
+  }
+  ASSERT_NE(FcloseCall, nullptr);
+
+  auto Close = CTSD.getTransition(FcloseCall, Fclose);
+  EXPECT_EQ(CTSD.getTransition(FcloseCall, Fclose), Close);
+  EXPECT_EQ(CTSD.apply(Close, IOSTATE::OPENED), IOSTATE::CLOSED);
+  // A transition treats TOP like UNINIT
+  EXPECT_EQ(CTSD.apply(Close, IOSTATE::TOP), IOSTATE::ERROR);
+  EXPECT_EQ(CTSD.apply(Close, IOSTATE::BOT), IOSTATE::BOT);
+
+  auto CloseTwice = CTSD.compose(Close, Close);
+  EXPECT_NE(CloseTwice, Close);
+  EXPECT_EQ(CTSD.apply(CloseTwice, IOSTATE::OPENED), IOSTATE::ERROR);
+  EXPECT_EQ(CTSD.apply(CloseTwice, IOSTATE::BOT), IOSTATE::BOT);
+  // Closing a third time does not change the table anymore
+  EXPECT_EQ(CTSD.compose(CloseTwice, Close), CloseTwice);
+}
+
+TEST_F(IDETSAnalysisFileIOTest, HandleMultiTypeState) {
+  initialize({PathToLlFiles + "typestate_19_c.ll"});
+  IDESolver_P<IDETypeStateAnalysis> Llvmtssolver(*TSProblem);
+  Llvmtssolver.solve();
+
+  OpenSSLEVPKDFDescription KDFDesc;
+  IDEMultiTypeStateAnalysis::ConfigurationTy TSDescs = {CSTDFILEIODesc.get(),
+                                                        &KDFDesc};
+  IDEMultiTypeStateAnalysis MultiTSProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                           PT.get(), TSDescs, EntryPoints);
+  IDESolver_P<IDEMultiTypeStateAnalysis> MultiSolver(MultiTSProblem);
+  MultiSolver.solve();
+
+  // The file-io protocol yields the same results as if it was checked alone,
+  // the values of file-io type are of no interest to the KDF protocol.
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      std::map<const llvm::Value *, int> Expected;
+      for (const auto &[Fact, State] : Llvmtssolver.resultsAt(&I, true)) {
+        Expected[Fact] = State;
+      }
+      std::map<const llvm::Value *, int> Results;
+      for (const auto &[Fact, States] : MultiSolver.resultsAt(&I, true)) {
+        ASSERT_EQ(States.size(), 2U);
+        EXPECT_EQ(States[1], KDFDesc.top()) << "At " << llvmIRToShortString(&I);
+        Results[Fact] = States[0];
+      }
+      EXPECT_EQ(Results, Expected) << "At " << llvmIRToShortString(&I);
+    }
+  }
+}
+
+TEST_F(IDETSAnalysisFileIOTest, HandleMultiTypeStateBothProtocols) {
+  initialize({PathToLlFiles + "typestate_20_c.ll"});
+
+  OpenSSLEVPKDFDescription KDFDesc;
+  IDEMultiTypeStateAnalysis::ConfigurationTy TSDescs = {CSTDFILEIODesc.get(),
+                                                        &KDFDesc};
+  IDEMultiTypeStateAnalysis MultiTSProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                           PT.get(), TSDescs, EntryPoints);
+  IDESolver_P<IDEMultiTypeStateAnalysis> MultiSolver(MultiTSProblem);
+  MultiSolver.solve();
+
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *File = Main->getValueSymbolTable()->lookup("f");
+  const auto *KDF = Main->getValueSymbolTable()->lookup("kdf");
+  ASSERT_NE(nullptr, File);
+  ASSERT_NE(nullptr, KDF);
+  const llvm::Instruction *ReadCall = nullptr;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I);
+        Call && Call->getCalledFunction() &&
+        Call->getCalledFunction()->getName() == "fgetc") {
+      ReadCall = Call;
+    }
+  }
+  ASSERT_NE(nullptr, ReadCall);
+  const auto *Ret = Main->back().getTerminator();
+
+  // Both protocols change their states in the same pass; each fact only
+  // moves in the component of the protocol its type belongs to
+  auto ReadResults = MultiSolver.resultsAt(ReadCall, true);
+  ASSERT_EQ(1U, ReadResults.count(File));
+  ASSERT_EQ(1U, ReadResults.count(KDF));
+  ASSERT_EQ(2U, ReadResults[File].size());
+  EXPECT_EQ(IOSTATE::OPENED, ReadResults[File][0]);
+  EXPECT_EQ(KDFDesc.top(), ReadResults[File][1]);
+  ASSERT_EQ(2U, ReadResults[KDF].size());
+  EXPECT_EQ(IOSTATE::TOP, ReadResults[KDF][0]);
+  EXPECT_EQ(OpenSSLEVPKDFDescription::KDF_FETCHED, ReadResults[KDF][1]);
+
+  auto RetResults = MultiSolver.resultsAt(Ret, true);
+  ASSERT_EQ(1U, RetResults.count(File));
+  ASSERT_EQ(1U, RetResults.count(KDF));
+  EXPECT_EQ(IOSTATE::CLOSED, RetResults[File][0]);
+  EXPECT_EQ(KDFDesc.top(), RetResults[File][1]);
+  EXPECT_EQ(IOSTATE::TOP, RetResults[KDF][0]);
+  EXPECT_EQ(OpenSSLEVPKDFDescription::UNINIT, RetResults[KDF][1]);
+}
+
 // main function for the test case
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
@@ -166,6 +166,17 @@ TEST_F(IFDSConstAnalysisTest, HandlePointerTest_04) {
   compareResults({4}, Llvmconstsolver);
 }
 
+TEST_F(IFDSConstAnalysisTest, HandlePointerTest_05_FactClasses) {
+  initialize({PathToLlFiles + "pointer/pointer_05_cpp_dbg.ll"});
+  Constproblem->getIFDSIDESolverConfig().setCompressFactClasses();
+  IFDSSolver_P<IFDSConstAnalysis> Llvmconstsolver(*Constproblem);
+  Llvmconstsolver.solve();
+  // The store through p generates i and the pointer loaded from p at once,
+  // such that they form a single fact class
+  EXPECT_GT(Llvmconstsolver.getNumFactClassMembers(), 0U);
+  compareResults({1}, Llvmconstsolver);
+}
+
 /* ============== GLOBAL TESTS ============== */
 TEST_F(IFDSConstAnalysisTest, HandleGlobalTest_01) {
   initialize({PathToLlFiles + "global/global_01_cpp_m2r_dbg.ll"});
@@ -0,0 +1,102 @@
+#include <memory>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSFieldSensTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TaintConfig/TaintConfig.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+/// Seeds foo() of xtaint04 with the tainted array element array[1] and the
+/// tainted variable that holds foo's parameter
+class ArrayTaintAnalysis : public IFDSFieldSensTaintAnalysis {
+public:
+  using IFDSFieldSensTaintAnalysis::IFDSFieldSensTaintAnalysis;
+
+  InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+    const auto *Array = IRDB->getInstruction(20);
+    const auto *Elem = IRDB->getInstruction(23);
+    const auto *Param = IRDB->getInstruction(19);
+    const auto *Start = IRDB->getInstruction(25);
+    ExtendedValue TaintedElem(Elem);
+    TaintedElem.setMemLocationSeq({Array, Elem});
+    ExtendedValue TaintedParam(Param);
+    TaintedParam.setMemLocationSeq({Param});
+    InitialSeeds<n_t, d_t, l_t> Seeds;
+    Seeds.addSeed(Start, TaintedElem);
+    Seeds.addSeed(Start, TaintedParam);
+    return Seeds;
+  }
+};
+
+} // namespace
+
+/* ============== TEST FIXTURE ============== */
+class IFDSFieldSensTaintAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = unittest::PathToLLTestFiles + "xtaint/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+  std::unique_ptr<TaintConfig> TC;
+
+  void SetUp() override { ValueAnnotationPass::resetValueID(); }
+
+  void initialize(const std::string &IRFile) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(
+        IRDB.get(), CallGraphAnalysisType::OTF,
+        std::vector<std::string>{EntryPoints.begin(), EntryPoints.end()},
+        TH.get(), PT.get());
+    TC = std::make_unique<TaintConfig>(*IRDB);
+  }
+
+  /// Returns the number of facts the solver has coarsened
+  size_t solve(const IFDSIDESolverConfig &SolverConfig) {
+    ArrayTaintAnalysis TaintProblem(IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+                                    *TC, EntryPoints);
+    TaintProblem.setIFDSIDESolverConfig(SolverConfig);
+    IFDSSolver_P<ArrayTaintAnalysis> Solver(TaintProblem);
+    Solver.solve();
+    return Solver.getNumCoarsenedFacts();
+  }
+}; // Test Fixture
+
+TEST_F(IFDSFieldSensTaintAnalysisTest, KeepsFactsByDefault) {
+  initialize("xtaint04_cpp.ll");
+  EXPECT_EQ(0U, solve(IFDSIDESolverConfig{}));
+}
+
+TEST_F(IFDSFieldSensTaintAnalysisTest, CoarsensFactsAdaptively) {
+  initialize("xtaint04_cpp.ll");
+  // The solver configuration of an IFDS problem has to reach the solver, such
+  // that the second fact in foo() makes it coarsen array[1] towards the array
+  IFDSIDESolverConfig SolverConfig;
+  SolverConfig.setAdaptivePrecision();
+  SolverConfig.setFactLimits(1, 1);
+  EXPECT_GT(solve(SolverConfig), 0U);
+}
+
+// main
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -94,6 +94,20 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_01) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_01_TaintRolesOfICFG) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_01_cpp_dbg.ll"});
+  const auto *Sink = IRDB->getFunction("_Z4sinki");
+  ASSERT_NE(nullptr, Sink);
+  TSF->addSinkValue(Sink->getArg(0));
+  ICFG->setTaintRoles(*TSF);
+  ASSERT_TRUE(ICFG->getFunctionAttributes(Sink).is(FunctionClass::TaintSink));
+  IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[13] = set<string>{"12"};
+  compareResults(GroundTruth);
+}
+
 TEST_F(IFDSTaintAnalysisTest, TaintTest_01_m2r) {
   initialize({PathToLlFiles + "dummy_source_sink/taint_01_cpp_m2r_dbg.ll"});
   IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
@@ -384,6 +384,51 @@ TEST_F(IFDSUninitializedVariablesTest, UninitTest_21_SHOULD_LEAK) {
   // 37 => {17}; actual leak
   compareResults(GroundTruth);
 }
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_BitVectors) {
+  initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+  UninitProblem->solveWithBitVectors();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[5] = {"0"};
+  GroundTruth[6] = {"5"};
+  GroundTruth[16] = {"9"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, BitVectorsMatchIFDSSolver) {
+  for (const auto *File :
+       {"binop_uninit_cpp_dbg.ll", "callnoret_c_dbg.ll",
+        "global_variable_cpp_dbg.ll", "return_uninit_cpp_dbg.ll",
+        "sanitizer_cpp_dbg.ll", "uninit_c_dbg.ll",
+        "growing_example_cpp_dbg.ll", "recursion_cpp_dbg.ll",
+        "virtual_call_cpp_dbg.ll"}) {
+    SCOPED_TRACE(File);
+    ValueAnnotationPass::resetValueID();
+    initialize({PathToLlFiles + File});
+    IFDSSolver Solver(*UninitProblem);
+    Solver.solve();
+    auto IFDSUndefUses = UninitProblem->getAllUndefUses();
+
+    UninitProblem->solveWithBitVectors();
+    EXPECT_EQ(IFDSUndefUses, UninitProblem->getAllUndefUses());
+  }
+}
+
+TEST_F(IFDSUninitializedVariablesTest, MissingEntryPointsAreSkipped) {
+  initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+  IFDSUninitializedVariables Problem(IRDB.get(), TH.get(), ICFG.get(),
+                                     PT.get(), {"main", "does_not_exist"});
+  EXPECT_EQ(1U, Problem.initialSeeds().getSeeds().size());
+
+  IFDSSolver Solver(Problem);
+  Solver.solve();
+  auto IFDSUndefUses = Problem.getAllUndefUses();
+  Problem.solveWithBitVectors();
+  EXPECT_EQ(IFDSUndefUses, Problem.getAllUndefUses());
+  EXPECT_FALSE(Problem.getAllUndefUses().empty());
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,137 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SpecialSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibrary.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SummaryLibraryGenerator.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class SummaryLibraryTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "summary_generation/";
+
+  using LibrarySummariesTy =
+      SpecialSummaries<IDELinearConstantAnalysis::d_t,
+                       IDELinearConstantAnalysis::l_t>;
+
+  void TearDown() override {
+    LibrarySummariesTy::getInstance().clearSummaryLibrary();
+  }
+
+  SummaryLibrary generate(const std::string &LlvmFilePath) {
+    ProjectIRDB IRDB({PathToLlFiles + LlvmFilePath}, IRDBOptions::WPA);
+    SummaryLibraryGenerator Generator(IRDB);
+    SummaryLibrary Lib;
+    Generator.addTo(Lib, {"ide-lca"});
+    return Lib;
+  }
+}; // Test Fixture
+
+TEST_F(SummaryLibraryTest, JsonRoundTrip) {
+  SummaryLibrary Lib;
+  FunctionSummary Sum;
+  Sum.Flows.push_back({1, 0, SummaryEdgeKind::Identity});
+  Sum.Flows.push_back({0, SummaryFlow::Return, SummaryEdgeKind::AllBottom});
+  Sum.Flows.push_back({SummaryFlow::Zero, SummaryFlow::Return,
+                       SummaryEdgeKind::AllTop});
+  Sum.Kills.push_back(0);
+  EXPECT_FALSE(Lib.addSummary("ifds-taint", "strcpy", Sum));
+  EXPECT_TRUE(Lib.addSummary("ifds-taint", "strcpy", Sum));
+
+  SummaryLibrary Read(Lib.getAsJson());
+  EXPECT_EQ(1U, Read.size());
+  EXPECT_EQ(std::vector<std::string>{"ifds-taint"}, Read.getAnalyses());
+  const auto *ReadSum = Read.getSummary("ifds-taint", "strcpy");
+  ASSERT_NE(nullptr, ReadSum);
+  EXPECT_EQ(Sum, *ReadSum);
+  EXPECT_EQ(nullptr, Read.getSummary("ide-lca", "strcpy"));
+
+  auto WrongVersion = Lib.getAsJson();
+  WrongVersion["version"] = SummaryLibrary::Version + 1;
+  EXPECT_THROW(SummaryLibrary{WrongVersion}, std::runtime_error);
+  auto Malformed = Lib.getAsJson();
+  Malformed["analyses"]["ifds-taint"]["strcpy"]["flows"][0]["to"] = "param0";
+  EXPECT_THROW(SummaryLibrary{Malformed}, std::runtime_error);
+}
+
+TEST_F(SummaryLibraryTest, GenerateSummaries) {
+  auto Lib = generate("summary_library_1_cpp.ll");
+  auto FlowsOf = [&Lib](llvm::StringRef Name) {
+    const auto *Sum = Lib.getSummary("ide-lca", Name);
+    EXPECT_NE(nullptr, Sum) << Name.str();
+    return Sum ? Sum->Flows : std::vector<SummaryFlow>{};
+  };
+  using Flows = std::vector<SummaryFlow>;
+  constexpr auto Ret = SummaryFlow::Return;
+  constexpr auto Id = SummaryEdgeKind::Identity;
+  constexpr auto Bot = SummaryEdgeKind::AllBottom;
+
+  EXPECT_EQ((Flows{{1, 0, Id}}), FlowsOf("copyInt"));
+  EXPECT_EQ((Flows{{0, Ret, Id}}), FlowsOf("first"));
+  EXPECT_EQ((Flows{{0, Ret, Bot}, {1, Ret, Bot}}), FlowsOf("add"));
+  EXPECT_EQ((Flows{{0, 0, Bot}, {1, 0, Bot}}), FlowsOf("addTo"));
+  EXPECT_EQ((Flows{{1, 0, Id}}), FlowsOf("callsCopy"));
+  EXPECT_EQ((Flows{{0, Ret, Id}}), FlowsOf("load"));
+  // count() modifies a global variable
+  EXPECT_EQ(nullptr, Lib.getSummary("ide-lca", "count"));
+}
+
+TEST_F(SummaryLibraryTest, SolverUsesLibrarySummaries) {
+  auto Lib = generate("summary_library_1_cpp.ll");
+  // Generated summaries never kill facts, but curated ones may: copyInt()
+  // overwrites its destination
+  auto CopyInt = *Lib.getSummary("ide-lca", "copyInt");
+  CopyInt.Kills.push_back(0);
+  EXPECT_TRUE(Lib.addSummary("ide-lca", "copyInt", CopyInt));
+
+  ProjectIRDB IRDB({PathToLlFiles + "summary_library_client_1_cpp.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *B = getNthInstruction(Main, 3);
+  const auto *AddCall = getNthInstruction(Main, 9);
+  const auto *MainExit = getLastInstructionOf(Main);
+
+  auto Solve = [&] {
+    IDELinearConstantAnalysis LCAProblem(&IRDB, &TH, &ICFG, &PT, {"main"});
+    IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+    LCASolver.solve();
+    return LCASolver.resultsAt(MainExit, true);
+  };
+
+  // Without summaries, nothing is known about the declarations
+  auto Results = Solve();
+  EXPECT_EQ(IDELinearConstantAnalysis::l_t(Bottom{}), Results[B]);
+  EXPECT_EQ(0U, Results.count(AddCall));
+
+  EXPECT_EQ(6U, LibrarySummariesTy::getInstance().loadSummaryLibrary(
+                    Lib, "ide-lca"));
+  Results = Solve();
+  EXPECT_EQ(IDELinearConstantAnalysis::l_t(42), Results[B]);
+  // add() computes a value that is not tracked by the summary
+  ASSERT_EQ(1U, Results.count(AddCall));
+  EXPECT_EQ(IDELinearConstantAnalysis::l_t(Bottom{}), Results[AddCall]);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
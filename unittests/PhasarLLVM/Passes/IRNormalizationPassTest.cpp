@@ -0,0 +1,105 @@
+#include <map>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class IRNormalizationPassTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = unittest::PathToLLTestFiles;
+
+  /// Maps the names of the local variables of F to the IDs of their allocas.
+  static std::map<std::string, std::size_t>
+  getVariableIDs(const llvm::Function &F) {
+    std::map<std::string, std::size_t> VariableIDs;
+    for (const auto &I : llvm::instructions(F)) {
+      if (const auto *Declare = llvm::dyn_cast<llvm::DbgDeclareInst>(&I)) {
+        VariableIDs[Declare->getVariable()->getName().str()] =
+            ProjectIRDB::getInstructionID(
+                llvm::cast<llvm::Instruction>(Declare->getAddress()));
+      }
+    }
+    return VariableIDs;
+  }
+}; // Test Fixture
+
+TEST_F(IRNormalizationPassTest, PromotesLoopVariables) {
+  const std::string File = PathToLlFiles + "linear_constant/for_01_cpp_dbg.ll";
+  // Annotate both modules with the same IDs
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB OrigIRDB({File}, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({File}, IRDBOptions::WPA | IRDBOptions::NORMALIZE);
+
+  const auto *OrigMain = OrigIRDB.getFunctionDefinition("main");
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, OrigMain);
+  ASSERT_NE(nullptr, Main);
+  auto VariableIDs = getVariableIDs(*OrigMain);
+  ASSERT_EQ(1U, VariableIDs.count("a"));
+  ASSERT_EQ(1U, VariableIDs.count("i"));
+
+  EXPECT_TRUE(IRDB.getAllocaInstructions().empty());
+  EXPECT_LT(IRDB.getNumInstructions(), OrigIRDB.getNumInstructions());
+
+  std::set<std::size_t> PhiOrigins;
+  std::set<std::size_t> DbgValueOrigins;
+  for (const auto &I : llvm::instructions(Main)) {
+    EXPECT_FALSE(llvm::isa<llvm::AllocaInst>(I) ||
+                 llvm::isa<llvm::LoadInst>(I) || llvm::isa<llvm::StoreInst>(I))
+        << llvmIRToString(&I);
+    // Every instruction is annotated and can be looked up by its ID
+    EXPECT_EQ(&I, IRDB.getInstruction(ProjectIRDB::getInstructionID(&I)));
+    if (llvm::isa<llvm::PHINode>(I)) {
+      PhiOrigins.insert(ProjectIRDB::getOriginalInstructionID(&I));
+      // Reports refer to the original instruction as well
+      EXPECT_NE(std::string::npos,
+                llvmIRToString(&I).find(
+                    "(for ID: " + getOriginalMetaDataID(&I) + ")"));
+    } else if (llvm::isa<llvm::DbgValueInst>(I)) {
+      DbgValueOrigins.insert(ProjectIRDB::getOriginalInstructionID(&I));
+    } else {
+      // The instructions that remain keep their IDs
+      auto Id = ProjectIRDB::getInstructionID(&I);
+      EXPECT_EQ(Id, ProjectIRDB::getOriginalInstructionID(&I));
+      ASSERT_NE(nullptr, OrigIRDB.getInstruction(Id));
+      EXPECT_EQ(I.getOpcode(), OrigIRDB.getInstruction(Id)->getOpcode());
+    }
+  }
+  std::set<std::size_t> ExpectedOrigins = {VariableIDs["a"],
+                                           VariableIDs["i"]};
+  EXPECT_EQ(ExpectedOrigins, PhiOrigins);
+  EXPECT_EQ(ExpectedOrigins, DbgValueOrigins);
+}
+
+TEST_F(IRNormalizationPassTest, KeepsIRWithoutOption) {
+  ProjectIRDB IRDB({PathToLlFiles + "linear_constant/for_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  EXPECT_EQ(3U, IRDB.getAllocaInstructions().size());
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      EXPECT_EQ(ProjectIRDB::getInstructionID(&I),
+                ProjectIRDB::getOriginalInstructionID(&I));
+    }
+  }
+}
+
+// main
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
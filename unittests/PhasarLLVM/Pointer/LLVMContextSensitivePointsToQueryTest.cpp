@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/ValueSymbolTable.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMContextSensitivePointsToQuery.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+const llvm::Value *lookup(const llvm::Function *F, llvm::StringRef Name) {
+  return F->getValueSymbolTable()->lookup(Name);
+}
+
+const llvm::LoadInst *getFirstLoadFrom(const llvm::Value *Ptr) {
+  for (const auto *User : Ptr->users()) {
+    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(User)) {
+      return Load;
+    }
+  }
+  return nullptr;
+}
+
+class LLVMContextSensitivePointsToQueryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ValueAnnotationPass::resetValueID();
+    IRDB = std::make_unique<ProjectIRDB>(std::vector<std::string>{
+        unittest::PathToLLTestFiles + "pointers/context_01_cpp.ll"});
+    Main = IRDB->getFunctionDefinition("main");
+    Id = IRDB->getFunctionDefinition("_Z2idPi");
+    ASSERT_TRUE(Main && Id);
+    A = lookup(Main, "A");
+    B = lookup(Main, "B");
+    CallA = llvm::dyn_cast_or_null<llvm::CallBase>(lookup(Main, "call"));
+    CallB = llvm::dyn_cast_or_null<llvm::CallBase>(lookup(Main, "call1"));
+    P = lookup(Id, "P");
+    ASSERT_TRUE(A && B && CallA && CallB && P);
+  }
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  const llvm::Function *Main{};
+  const llvm::Function *Id{};
+  const llvm::Value *A{};
+  const llvm::Value *B{};
+  const llvm::CallBase *CallA{};
+  const llvm::CallBase *CallB{};
+  const llvm::Value *P{};
+};
+
+} // namespace
+
+TEST_F(LLVMContextSensitivePointsToQueryTest, AllocationSitesOfArgument) {
+  using AllocationSiteSetTy =
+      LLVMContextSensitivePointsToQuery::AllocationSiteSetTy;
+  constexpr auto EmptyContext = LLVMContextSensitivePointsToQuery::EmptyContext;
+
+  LLVMPointsToSet PT(*IRDB, false);
+  LLVMContextSensitivePointsToQuery Query(PT);
+
+  const auto *SitesA = Query.getAllocationSitesInContext(P, {CallA});
+  ASSERT_NE(nullptr, SitesA);
+  EXPECT_EQ(AllocationSiteSetTy({{A, EmptyContext}}), *SitesA);
+
+  const auto *SitesB = Query.getAllocationSitesInContext(P, {CallB});
+  ASSERT_NE(nullptr, SitesB);
+  EXPECT_EQ(AllocationSiteSetTy({{B, EmptyContext}}), *SitesB);
+
+  // Without a context, P may point to the arguments of all callers
+  const auto *Sites = Query.getAllocationSitesInContext(P, {});
+  ASSERT_NE(nullptr, Sites);
+  EXPECT_TRUE(Sites->count({A, EmptyContext}));
+  EXPECT_TRUE(Sites->count({B, EmptyContext}));
+}
+
+TEST_F(LLVMContextSensitivePointsToQueryTest, RefinesReturnedPointer) {
+  LLVMPointsToSet PT(*IRDB, false);
+  const auto *LoadPA = getFirstLoadFrom(lookup(Main, "PA"));
+  ASSERT_NE(nullptr, LoadPA);
+
+  auto InsensitivePTS = PT.getPointsToSet(LoadPA);
+  EXPECT_TRUE(InsensitivePTS->count(A));
+  EXPECT_TRUE(InsensitivePTS->count(B));
+
+  auto PTS = PT.getPointsToSetInContext(LoadPA, {});
+  EXPECT_TRUE(PTS->count(LoadPA));
+  EXPECT_TRUE(PTS->count(A));
+  EXPECT_TRUE(PTS->count(CallA));
+  EXPECT_FALSE(PTS->count(B));
+  EXPECT_FALSE(PTS->count(CallB));
+  EXPECT_FALSE(PTS->count(IRDB->getGlobalVariableDefinition("G")));
+  // The value loaded from G may point to A
+  EXPECT_TRUE(PTS->count(getFirstLoadFrom(IRDB->getGlobalVariableDefinition(
+      "G"))));
+  // The results are memoized
+  EXPECT_EQ(PTS, PT.getPointsToSetInContext(LoadPA, {}));
+}
+
+TEST_F(LLVMContextSensitivePointsToQueryTest, KeepsSetsAliveOnChanges) {
+  LLVMPointsToSet PT(*IRDB, false);
+  const auto *LoadPA = getFirstLoadFrom(lookup(Main, "PA"));
+  ASSERT_NE(nullptr, LoadPA);
+
+  auto PTS = PT.getPointsToSetInContext(LoadPA, {});
+  auto Expected = *PTS;
+  // Forgets the memoized results, but the handed-out set stays alive
+  PT.introduceAlias(LoadPA, B);
+  auto NewPTS = PT.getPointsToSetInContext(LoadPA, {});
+  EXPECT_NE(PTS.get(), NewPTS.get());
+  EXPECT_EQ(Expected, *PTS);
+}
+
+TEST_F(LLVMContextSensitivePointsToQueryTest, LazyModeForgetsOutdatedSets) {
+  LLVMPointsToSet PT(*IRDB);
+  const auto *LoadPA = getFirstLoadFrom(lookup(Main, "PA"));
+  const auto *Unused = IRDB->getFunctionDefinition("_Z6unusedPi");
+  ASSERT_NE(nullptr, LoadPA);
+  ASSERT_NE(nullptr, Unused);
+
+  auto PTS = PT.getPointsToSetInContext(LoadPA, {});
+  EXPECT_EQ(PTS, PT.getPointsToSetInContext(LoadPA, {}));
+
+  // Lazily analyzing another function may extend the points-to sets, so the
+  // memoized results must not be reused
+  ASSERT_FALSE(PT.isAnalyzed(Unused));
+  (void)PT.getPointsToSet(Unused->getArg(0));
+  ASSERT_TRUE(PT.isAnalyzed(Unused));
+  auto NewPTS = PT.getPointsToSetInContext(LoadPA, {});
+  EXPECT_NE(PTS.get(), NewPTS.get());
+
+  LLVMPointsToSet EagerPT(*IRDB, false);
+  EXPECT_EQ(*EagerPT.getPointsToSetInContext(LoadPA, {}), *NewPTS);
+}
+
+TEST_F(LLVMContextSensitivePointsToQueryTest, FallsBackIfBudgetIsExceeded) {
+  LLVMPointsToSet PT(*IRDB, false);
+  LLVMContextSensitivePointsToQuery Query(PT, 2, 1);
+  const auto *LoadPA = getFirstLoadFrom(lookup(Main, "PA"));
+  ASSERT_NE(nullptr, LoadPA);
+
+  EXPECT_EQ(nullptr, Query.getAllocationSitesInContext(LoadPA, {}));
+  EXPECT_EQ(PT.getPointsToSet(LoadPA),
+            Query.getPointsToSetInContext(LoadPA, {}));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToGraph.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+const llvm::Value *getValue(const llvm::Function *F, llvm::StringRef Name) {
+  for (const auto &Arg : F->args()) {
+    if (Arg.getName() == Name) {
+      return &Arg;
+    }
+  }
+  for (const auto &I : llvm::instructions(F)) {
+    if (I.getName() == Name) {
+      return &I;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+TEST(LLVMPointsToGraph, ComponentsArePointsToSets) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  LLVMPointsToGraph PTG(IRDB, false);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *I = getValue(Main, "i");
+  const auto *P = getValue(Main, "p");
+  ASSERT_NE(nullptr, I);
+  ASSERT_NE(nullptr, P);
+
+  auto PtsI = PTG.getPointsToSet(I);
+  EXPECT_TRUE(PtsI->count(I));
+  // Two distinct stack allocations never alias
+  EXPECT_FALSE(PTG.isAlias(I, P));
+  EXPECT_EQ(AliasResult::NoAlias, PTG.alias(I, P));
+
+  // The points-to set of a value is exactly its connected component
+  for (const auto &Inst : llvm::instructions(Main)) {
+    if (!PTG.containsValue(const_cast<llvm::Instruction *>(&Inst))) {
+      continue;
+    }
+    auto Pts = PTG.getPointsToSet(&Inst);
+    EXPECT_EQ(PtsI->count(&Inst) != 0, PTG.isAlias(I, &Inst));
+    for (const auto *Alias : *Pts) {
+      EXPECT_TRUE(PTG.isAlias(&Inst, Alias));
+    }
+  }
+  EXPECT_LE(PTG.getNumComponents(), PTG.getNumVertices());
+
+  // Introducing an alias merges the components and updates the cached sets
+  auto NumComponents = PTG.getNumComponents();
+  PTG.introduceAlias(I, P, nullptr);
+  EXPECT_TRUE(PTG.isAlias(I, P));
+  EXPECT_EQ(NumComponents - 1, PTG.getNumComponents());
+  EXPECT_TRUE(PTG.getPointsToSet(I)->count(P));
+  EXPECT_TRUE(PTG.getPointsToSet(P)->count(I));
+}
+
+TEST(LLVMPointsToGraph, MergeAndEscapes) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *SetInteger = IRDB.getFunctionDefinition("_Z10setIntegerPi");
+  const auto *X = getValue(SetInteger, "x");
+  ASSERT_NE(nullptr, X);
+
+  LLVMPointsToGraph MainPTG(IRDB, false);
+  MainPTG.getPointsToSet(getValue(Main, "i"));
+  LLVMPointsToGraph CalleePTG(IRDB, false);
+  CalleePTG.getPointsToSet(X);
+
+  auto Params = CalleePTG.getPointersEscapingThroughParamsForFunction(SetInteger);
+  ASSERT_EQ(1U, Params.size());
+  EXPECT_EQ(0U, Params.front().first);
+  EXPECT_EQ(X, Params.front().second);
+  EXPECT_TRUE(
+      CalleePTG.getPointersEscapingThroughReturnsForFunction(SetInteger)
+          .empty());
+  EXPECT_TRUE(MainPTG.getPointersEscapingThroughParams().empty());
+
+  auto NumVertices = MainPTG.getNumVertices() + CalleePTG.getNumVertices();
+  auto NumEdges = MainPTG.getNumEdges() + CalleePTG.getNumEdges();
+  auto NumComponents =
+      MainPTG.getNumComponents() + CalleePTG.getNumComponents();
+  MainPTG.mergeWith(CalleePTG);
+  EXPECT_EQ(NumVertices, MainPTG.getNumVertices());
+  EXPECT_EQ(NumEdges, MainPTG.getNumEdges());
+  EXPECT_EQ(NumComponents, MainPTG.getNumComponents());
+  EXPECT_EQ(1U, MainPTG.getPointersEscapingThroughParams().size());
+
+  // Connect the actual and the formal parameter of the call
+  const llvm::Instruction *Call = nullptr;
+  for (const auto &Inst : llvm::instructions(Main)) {
+    if (llvm::isa<llvm::CallBase>(Inst)) {
+      Call = &Inst;
+    }
+  }
+  ASSERT_NE(nullptr, Call);
+  const auto *Arg = llvm::cast<llvm::CallBase>(Call)->getArgOperand(0);
+  MainPTG.introduceAlias(Arg, X, Call);
+  EXPECT_TRUE(MainPTG.isAlias(Arg, X));
+  for (const auto *Alias : *MainPTG.getPointsToSet(Arg)) {
+    EXPECT_TRUE(MainPTG.getPointsToSet(X)->count(Alias));
+  }
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
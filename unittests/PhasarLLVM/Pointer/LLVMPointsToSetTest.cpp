@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include "llvm/IR/ValueSymbolTable.h"
+
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
@@ -62,6 +64,42 @@ TEST(LLVMPointsToSet, Global_01) {
   llvm::outs() << '\n';
 }
 
+TEST(LLVMPointsToSet, FieldSensitive_01) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/field_01_cpp.ll"});
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *P = Main->getValueSymbolTable()->lookup("P");
+  const auto *First = Main->getValueSymbolTable()->lookup("First");
+  const auto *Second = Main->getValueSymbolTable()->lookup("Second");
+  const auto *Second2 = Main->getValueSymbolTable()->lookup("Second2");
+  ASSERT_TRUE(P && First && Second && Second2);
+
+  LLVMPointsToSet FieldInsensitivePTS(IRDB, false);
+  EXPECT_FALSE(FieldInsensitivePTS.isFieldSensitive());
+  EXPECT_TRUE(FieldInsensitivePTS.getPointsToSet(First)->count(Second));
+
+  LLVMPointsToSet FieldSensitivePTS(IRDB, false,
+                                    PointerAnalysisType::CFLAnders, 1);
+  EXPECT_TRUE(FieldSensitivePTS.isFieldSensitive());
+  // The first field starts at the same address as the enclosing object
+  EXPECT_TRUE(FieldSensitivePTS.getPointsToSet(First)->count(P));
+  EXPECT_FALSE(FieldSensitivePTS.getPointsToSet(First)->count(Second));
+  EXPECT_FALSE(FieldSensitivePTS.getPointsToSet(P)->count(Second));
+  EXPECT_TRUE(FieldSensitivePTS.getPointsToSet(Second)->count(Second2));
+  EXPECT_EQ(AliasResult::NoAlias, FieldSensitivePTS.alias(First, Second));
+
+  // Q may point to either field, so both fields must end up in Q's set, no
+  // matter in which order the pointers are added
+  const auto *Choose = IRDB.getFunctionDefinition("_Z6chooseb");
+  const auto *Q = Choose->getValueSymbolTable()->lookup("cond");
+  const auto *ChosenFirst = Choose->getValueSymbolTable()->lookup("First");
+  const auto *ChosenSecond = Choose->getValueSymbolTable()->lookup("Second1");
+  ASSERT_TRUE(Q && ChosenFirst && ChosenSecond);
+  EXPECT_TRUE(FieldSensitivePTS.getPointsToSet(Q)->count(ChosenFirst));
+  EXPECT_TRUE(FieldSensitivePTS.getPointsToSet(Q)->count(ChosenSecond));
+  EXPECT_NE(AliasResult::NoAlias, FieldSensitivePTS.alias(Q, ChosenSecond));
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
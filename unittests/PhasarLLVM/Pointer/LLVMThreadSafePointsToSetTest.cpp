@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMThreadSafePointsToSet.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+std::vector<const llvm::Value *> getAllValues(const ProjectIRDB &IRDB) {
+  std::vector<const llvm::Value *> Values;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    Values.push_back(F);
+    for (const auto &Arg : F->args()) {
+      Values.push_back(&Arg);
+    }
+    for (const auto &I : llvm::instructions(F)) {
+      Values.push_back(&I);
+    }
+  }
+  return Values;
+}
+
+void queryConcurrently(LLVMThreadSafePointsToSet &SafePT,
+                       const std::vector<const llvm::Value *> &Values) {
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T < 4; ++T) {
+    Threads.emplace_back([&SafePT, &Values, T] {
+      // Start at different values, such that the threads compete for the
+      // lazy computations
+      for (size_t Idx = 0; Idx < Values.size(); ++Idx) {
+        const auto *V = Values[(Idx + T * 7) % Values.size()];
+        auto PTS = SafePT.getPointsToSet(V);
+        // A lazy computation may have extended the set in between
+        auto NextPTS = SafePT.getPointsToSet(V);
+        for (const auto *Alias : *PTS) {
+          EXPECT_TRUE(NextPTS->count(Alias));
+        }
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+}
+
+void expectSamePointsToSets(LLVMThreadSafePointsToSet &SafePT,
+                            LLVMPointsToSet &Expected,
+                            const std::vector<const llvm::Value *> &Values) {
+  for (const auto *V : Values) {
+    const auto &PTS = *SafePT.getPointsToSet(V);
+    const auto &ExpectedPTS = *Expected.getPointsToSet(V);
+    EXPECT_EQ(ExpectedPTS.size(), PTS.size());
+    for (const auto *Alias : ExpectedPTS) {
+      EXPECT_TRUE(PTS.count(Alias));
+    }
+  }
+}
+
+} // namespace
+
+TEST(LLVMThreadSafePointsToSet, LazyConcurrentQueries) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  auto Values = getAllValues(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMThreadSafePointsToSet SafePT(PT);
+  EXPECT_FALSE(SafePT.isFrozen());
+
+  queryConcurrently(SafePT, Values);
+  for (const auto *F : IRDB.getAllFunctions()) {
+    if (!F->isDeclaration()) {
+      EXPECT_TRUE(PT.isAnalyzed(F));
+    }
+  }
+
+  LLVMPointsToSet Expected(IRDB, false);
+  expectSamePointsToSets(SafePT, Expected, Values);
+}
+
+TEST(LLVMThreadSafePointsToSet, LazySnapshots) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  LLVMPointsToSet PT(IRDB);
+  LLVMThreadSafePointsToSet SafePT(PT);
+  const auto *V1 = IRDB.getInstruction(5);
+  const auto *V2 = IRDB.getInstruction(6);
+  ASSERT_EQ(AliasResult::NoAlias, SafePT.alias(V1, V2));
+
+  // A handle from lazy mode is not affected by later changes, but subsequent
+  // queries see them
+  auto PTS = SafePT.getPointsToSet(V1);
+  auto Size = PTS->size();
+  SafePT.introduceAlias(V1, V2);
+  EXPECT_EQ(Size, PTS->size());
+  EXPECT_FALSE(PTS->count(V2));
+  EXPECT_TRUE(SafePT.getPointsToSet(V1)->count(V2));
+  EXPECT_EQ(AliasResult::MayAlias, SafePT.alias(V1, V2));
+}
+
+TEST(LLVMThreadSafePointsToSet, LazySnapshotsInContext) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  LLVMPointsToSet PT(IRDB);
+  LLVMThreadSafePointsToSet SafePT(PT);
+  const auto *V1 = IRDB.getInstruction(5);
+  const auto *V2 = IRDB.getInstruction(6);
+  ASSERT_EQ(AliasResult::NoAlias, SafePT.alias(V1, V2));
+
+  // Also a context-insensitive fallback is handed out as snapshot
+  auto PTS = SafePT.getPointsToSetInContext(V1, {});
+  auto Expected = *PTS;
+  SafePT.introduceAlias(V1, V2);
+  EXPECT_EQ(Expected, *PTS);
+  EXPECT_TRUE(SafePT.getPointsToSet(V1)->count(V2));
+}
+
+TEST(LLVMThreadSafePointsToSet, LazySnapshotsAreReused) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  LLVMPointsToSet PT(IRDB);
+  LLVMThreadSafePointsToSet SafePT(PT);
+  const auto *V1 = IRDB.getInstruction(5);
+  const auto *V2 = IRDB.getInstruction(6);
+  ASSERT_EQ(AliasResult::NoAlias, SafePT.alias(V1, V2));
+  auto PTS = SafePT.getPointsToSet(V1);
+
+  // Merging nothing starts a new generation, but does not change any set, so
+  // no new snapshot is taken
+  LLVMPointsToSet Empty(IRDB);
+  SafePT.mergeWith(Empty);
+  EXPECT_EQ(PTS, SafePT.getPointsToSet(V1));
+
+  SafePT.introduceAlias(V1, V2);
+  EXPECT_NE(PTS, SafePT.getPointsToSet(V1));
+}
+
+TEST(LLVMThreadSafePointsToSet, FrozenConcurrentQueries) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  auto Values = getAllValues(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMThreadSafePointsToSet SafePT(PT);
+  SafePT.freeze(IRDB);
+  EXPECT_TRUE(SafePT.isFrozen());
+
+  // All function-local points-to sets are available without computing
+  for (const auto *V : Values) {
+    if (!llvm::isa<llvm::GlobalObject>(V)) {
+      EXPECT_TRUE(PT.getPointsToSetIfComputed(V).has_value());
+    }
+  }
+  queryConcurrently(SafePT, Values);
+  for (const auto *V : Values) {
+    EXPECT_EQ(SafePT.getPointsToSet(V), PT.getPointsToSet(V));
+  }
+
+  LLVMPointsToSet Expected(IRDB, false);
+  expectSamePointsToSets(SafePT, Expected, Values);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
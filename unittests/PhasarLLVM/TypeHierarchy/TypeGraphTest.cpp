@@ -7,8 +7,6 @@
 
 #include "gtest/gtest.h"
 
-#include "boost/graph/isomorphism.hpp"
-
 #include "TestConfig.h"
 
 #include "llvm/Support/ManagedStatic.h"
@@ -26,23 +24,23 @@ TEST(TypeGraphTest, AddType) {
   unsigned int NbStruct = 0;
 
   CachedTypeGraph Tg;
-  CachedTypeGraph::graph_t G;
 
   for (auto *StructType : M->getIdentifiedStructTypes()) {
     ASSERT_TRUE(StructType != nullptr);
 
     auto Node = Tg.addType(StructType);
 
-    ASSERT_TRUE(Tg.G[Node].Name == StructType->getName().str());
-    ASSERT_TRUE(Tg.G[Node].BaseType == StructType);
-    ASSERT_TRUE(Tg.G[Node].Types.size() == 1);
-    ASSERT_TRUE(Tg.G[Node].Types.count(StructType));
-
-    boost::add_vertex(G);
-
-    ASSERT_TRUE(boost::isomorphism(G, Tg.G));
+    ASSERT_TRUE(Tg.G.getTypeName(Node) == StructType->getName());
+    ASSERT_TRUE(Tg.G.getType(Node) == StructType);
+    ASSERT_TRUE(Tg.getTypes(StructType).size() == 1);
+    ASSERT_TRUE(Tg.getTypes(StructType).count(StructType));
+    // Adding a type twice does not create a new vertex
+    ASSERT_TRUE(Tg.addType(StructType) == Node);
 
     ++NbStruct;
+
+    ASSERT_TRUE(Tg.G.getNumTypes() == NbStruct);
+    ASSERT_TRUE(Tg.G.getNumEdges() == 0);
   }
 
   ASSERT_TRUE(NbStruct >= 2);
@@ -67,9 +65,6 @@ TEST(TypeGraphTest, ReverseTypePropagation) {
 
   CachedTypeGraph Tg;
 
-  // Isomorphism to assure that the TypeGraph have the wanted structure
-  CachedTypeGraph::graph_t G;
-
   for (auto *StructType : M->getIdentifiedStructTypes()) {
     if (StructType) {
       switch (NbStruct) {
@@ -110,12 +105,6 @@ TEST(TypeGraphTest, ReverseTypePropagation) {
   ASSERT_TRUE(StructD != nullptr);
   ASSERT_TRUE(StructE != nullptr);
 
-  auto VertexA = boost::add_vertex(G);
-  auto VertexB = boost::add_vertex(G);
-  auto VertexC = boost::add_vertex(G);
-  auto VertexD = boost::add_vertex(G);
-  auto VertexE = boost::add_vertex(G);
-
   auto NodeA = Tg.addType(StructA);
   auto NodeB = Tg.addType(StructB);
   auto NodeC = Tg.addType(StructC);
@@ -127,71 +116,46 @@ TEST(TypeGraphTest, ReverseTypePropagation) {
   Tg.addLinkWithoutReversePropagation(StructC, StructD);
   Tg.addLinkWithoutReversePropagation(StructE, StructB);
 
-  boost::add_edge(VertexA, VertexB, G);
-  boost::add_edge(VertexB, VertexC, G);
-  boost::add_edge(VertexC, VertexD, G);
-  boost::add_edge(VertexE, VertexB, G);
-
-  ASSERT_TRUE(boost::isomorphism(G, Tg.G));
-
-  auto TgEdges = boost::edges(Tg.G);
-
-  int NumberEdge = 0;
-
-  TgEdges = boost::edges(Tg.G);
-  for (auto It = TgEdges.first; It != TgEdges.second; ++It) {
-    ++NumberEdge;
-
-    auto Src = boost::source(*It, Tg.G);
-    auto Target = boost::target(*It, Tg.G);
-
-    ASSERT_TRUE(NumberEdge <= 4);
-
-    ASSERT_TRUE(Src == NodeA || Src == NodeB || Src == NodeC || Src == NodeE);
-    if (Src == NodeA) {
-      ASSERT_TRUE(Target == NodeB);
-    } else if (Src == NodeB) {
-      ASSERT_TRUE(Target == NodeC);
-    } else if (Src == NodeC) {
-      ASSERT_TRUE(Target == NodeD);
-    } else if (Src == NodeE) {
-      ASSERT_TRUE(Target == NodeB);
-    }
-  }
-
-  ASSERT_TRUE(NumberEdge == 4);
-  NumberEdge = 0; // NOLINT Avoid stupid mistakes
+  ASSERT_TRUE(Tg.G.getNumTypes() == 5);
+  ASSERT_TRUE(Tg.G.getNumEdges() == 4);
+  ASSERT_TRUE(Tg.G.hasEdge(NodeA, NodeB));
+  ASSERT_TRUE(Tg.G.hasEdge(NodeB, NodeC));
+  ASSERT_TRUE(Tg.G.hasEdge(NodeC, NodeD));
+  ASSERT_TRUE(Tg.G.hasEdge(NodeE, NodeB));
+  ASSERT_FALSE(Tg.G.hasEdge(NodeB, NodeA));
+  ASSERT_TRUE(Tg.G.successors(NodeB).size() == 1);
+  ASSERT_TRUE(Tg.G.predecessors(NodeB).size() == 2);
 
   // Check that the type are coherent in the graph
-  ASSERT_TRUE(Tg.G[VertexA].Types.count(StructA));
-  ASSERT_TRUE(Tg.G[VertexA].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexB].Types.count(StructB));
-  ASSERT_TRUE(Tg.G[VertexB].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexC].Types.count(StructC));
-  ASSERT_TRUE(Tg.G[VertexC].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexD].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexD].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexE].Types.count(StructE));
-  ASSERT_TRUE(Tg.G[VertexE].Types.size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructA).count(StructA));
+  ASSERT_TRUE(Tg.getTypes(StructA).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructB).count(StructB));
+  ASSERT_TRUE(Tg.getTypes(StructB).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructC).count(StructC));
+  ASSERT_TRUE(Tg.getTypes(StructC).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructD).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructD).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructE).count(StructE));
+  ASSERT_TRUE(Tg.getTypes(StructE).size() == 1);
 
   Tg.reverseTypePropagation(StructC);
 
   // Check that the type are coherent in the graph
-  ASSERT_TRUE(Tg.G[VertexA].Types.count(StructA) &&
-              Tg.G[VertexA].Types.count(StructB) &&
-              Tg.G[VertexA].Types.count(StructC));
-  ASSERT_TRUE(Tg.G[VertexA].Types.size() == 3);
-  ASSERT_TRUE(Tg.G[VertexB].Types.count(StructB) &&
-              Tg.G[VertexB].Types.count(StructC));
-  ASSERT_TRUE(Tg.G[VertexB].Types.size() == 2);
-  ASSERT_TRUE(Tg.G[VertexC].Types.count(StructC));
-  ASSERT_TRUE(Tg.G[VertexC].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexD].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexD].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexE].Types.count(StructE) &&
-              Tg.G[VertexE].Types.count(StructB) &&
-              Tg.G[VertexE].Types.count(StructC));
-  ASSERT_TRUE(Tg.G[VertexE].Types.size() == 3);
+  ASSERT_TRUE(Tg.getTypes(StructA).count(StructA) &&
+              Tg.getTypes(StructA).count(StructB) &&
+              Tg.getTypes(StructA).count(StructC));
+  ASSERT_TRUE(Tg.getTypes(StructA).size() == 3);
+  ASSERT_TRUE(Tg.getTypes(StructB).count(StructB) &&
+              Tg.getTypes(StructB).count(StructC));
+  ASSERT_TRUE(Tg.getTypes(StructB).size() == 2);
+  ASSERT_TRUE(Tg.getTypes(StructC).count(StructC));
+  ASSERT_TRUE(Tg.getTypes(StructC).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructD).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructD).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructE).count(StructE) &&
+              Tg.getTypes(StructE).count(StructB) &&
+              Tg.getTypes(StructE).count(StructC));
+  ASSERT_TRUE(Tg.getTypes(StructE).size() == 3);
 }
 
 TEST(TypeGraphTest, AddLinkSimple) {
@@ -205,7 +169,6 @@ TEST(TypeGraphTest, AddLinkSimple) {
   llvm::StructType *StructB = nullptr;
 
   CachedTypeGraph Tg;
-  CachedTypeGraph::graph_t G;
 
   for (auto *StructType : M->getIdentifiedStructTypes()) {
     if (StructType) {
@@ -233,34 +196,21 @@ TEST(TypeGraphTest, AddLinkSimple) {
 
   auto NodeA = Tg.addType(StructA);
   auto NodeB = Tg.addType(StructB);
-  Tg.addLink(StructA, StructB);
-
-  auto VertexA = boost::add_vertex(G);
-  auto VertexB = boost::add_vertex(G);
-
-  boost::add_edge(VertexA, VertexB, G);
-
-  ASSERT_TRUE(boost::isomorphism(G, Tg.G));
-
-  auto P = edges(Tg.G);
-
-  auto Begin = P.first;
-  auto End = P.second;
-
-  int NumberEdge = 0;
-
-  for (auto It = Begin; It != End; ++It) {
-    ++NumberEdge;
-
-    auto Src = boost::source(*It, Tg.G);
-    auto Target = boost::target(*It, Tg.G);
-
-    ASSERT_TRUE(NumberEdge == 1);
-    ASSERT_TRUE(Src == NodeA);
-    ASSERT_TRUE(Target == NodeB);
-  }
-
-  ASSERT_TRUE(NumberEdge == 1);
+  ASSERT_TRUE(Tg.addLink(StructA, StructB));
+  // The link is already in the graph
+  ASSERT_FALSE(Tg.addLink(StructA, StructB));
+
+  ASSERT_TRUE(Tg.G.getNumTypes() == 2);
+  ASSERT_TRUE(Tg.G.getNumEdges() == 1);
+  ASSERT_TRUE(Tg.G.hasEdge(NodeA, NodeB));
+  ASSERT_FALSE(Tg.G.hasEdge(NodeB, NodeA));
+
+  // The types are propagated when the link is added
+  ASSERT_TRUE(Tg.getTypes(StructA).count(StructA) &&
+              Tg.getTypes(StructA).count(StructB));
+  ASSERT_TRUE(Tg.getTypes(StructA).size() == 2);
+  ASSERT_TRUE(Tg.getTypes(StructB).count(StructB));
+  ASSERT_TRUE(Tg.getTypes(StructB).size() == 1);
 }
 
 TEST(TypeGraphTest, TypeAggregation) {
@@ -278,9 +228,6 @@ TEST(TypeGraphTest, TypeAggregation) {
 
   CachedTypeGraph Tg;
 
-  // Isomorphism to assure that the TypeGraph have the wanted structure
-  CachedTypeGraph::graph_t G;
-
   for (auto *StructType : M->getIdentifiedStructTypes()) {
     if (StructType) {
       switch (NbStruct) {
@@ -321,12 +268,6 @@ TEST(TypeGraphTest, TypeAggregation) {
   ASSERT_TRUE(StructD != nullptr);
   ASSERT_TRUE(StructE != nullptr);
 
-  auto VertexA = boost::add_vertex(G);
-  auto VertexB = boost::add_vertex(G);
-  auto VertexC = boost::add_vertex(G);
-  auto VertexD = boost::add_vertex(G);
-  auto VertexE = boost::add_vertex(G);
-
   auto NodeA = Tg.addType(StructA);
   auto NodeB = Tg.addType(StructB);
   auto NodeC = Tg.addType(StructC);
@@ -338,75 +279,136 @@ TEST(TypeGraphTest, TypeAggregation) {
   Tg.addLinkWithoutReversePropagation(StructC, StructD);
   Tg.addLinkWithoutReversePropagation(StructE, StructB);
 
-  boost::add_edge(VertexA, VertexB, G);
-  boost::add_edge(VertexB, VertexC, G);
-  boost::add_edge(VertexC, VertexD, G);
-  boost::add_edge(VertexE, VertexB, G);
-
-  ASSERT_TRUE(boost::isomorphism(G, Tg.G));
+  ASSERT_TRUE(Tg.G.getNumTypes() == 5);
+  ASSERT_TRUE(Tg.G.getNumEdges() == 4);
+  ASSERT_TRUE(Tg.G.hasEdge(NodeA, NodeB));
+  ASSERT_TRUE(Tg.G.hasEdge(NodeB, NodeC));
+  ASSERT_TRUE(Tg.G.hasEdge(NodeC, NodeD));
+  ASSERT_TRUE(Tg.G.hasEdge(NodeE, NodeB));
+  ASSERT_FALSE(Tg.G.hasEdge(NodeB, NodeA));
+  ASSERT_TRUE(Tg.G.successors(NodeB).size() == 1);
+  ASSERT_TRUE(Tg.G.predecessors(NodeB).size() == 2);
 
-  auto TgEdges = boost::edges(Tg.G);
+  // Check that the type are coherent in the graph
+  ASSERT_TRUE(Tg.getTypes(StructA).count(StructA));
+  ASSERT_TRUE(Tg.getTypes(StructA).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructB).count(StructB));
+  ASSERT_TRUE(Tg.getTypes(StructB).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructC).count(StructC));
+  ASSERT_TRUE(Tg.getTypes(StructC).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructD).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructD).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructE).count(StructE));
+  ASSERT_TRUE(Tg.getTypes(StructE).size() == 1);
 
-  int NumberEdge = 0;
+  Tg.aggregateTypes();
 
-  TgEdges = boost::edges(Tg.G);
-  for (auto It = TgEdges.first; It != TgEdges.second; ++It) {
-    ++NumberEdge;
+  // Check that the type are coherent in the graph
+  ASSERT_TRUE(Tg.getTypes(StructA).count(StructA) &&
+              Tg.getTypes(StructA).count(StructB) &&
+              Tg.getTypes(StructA).count(StructC) &&
+              Tg.getTypes(StructA).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructA).size() == 4);
+  ASSERT_TRUE(Tg.getTypes(StructB).count(StructB) &&
+              Tg.getTypes(StructB).count(StructC) &&
+              Tg.getTypes(StructB).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructB).size() == 3);
+  ASSERT_TRUE(Tg.getTypes(StructC).count(StructC) &&
+              Tg.getTypes(StructC).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructC).size() == 2);
+  ASSERT_TRUE(Tg.getTypes(StructD).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructD).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructE).count(StructE) &&
+              Tg.getTypes(StructE).count(StructB) &&
+              Tg.getTypes(StructE).count(StructC) &&
+              Tg.getTypes(StructE).count(StructD));
+  ASSERT_TRUE(Tg.getTypes(StructE).size() == 4);
+}
 
-    auto Src = boost::source(*It, Tg.G);
-    auto Target = boost::target(*It, Tg.G);
+TEST(TypeGraphTest, AddLinkWithRecursion) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "basic/seven_structs_cpp.ll"});
+  llvm::Module *M = IRDB.getModule(unittest::PathToLLTestFiles +
+                                   "basic/seven_structs_cpp.ll");
 
-    ASSERT_TRUE(NumberEdge <= 4);
+  std::vector<llvm::StructType *> Structs = M->getIdentifiedStructTypes();
+  ASSERT_TRUE(Structs.size() == 7);
+  auto *StructA = Structs[0];
+  auto *StructB = Structs[1];
+  auto *StructC = Structs[2];
+  auto *StructD = Structs[3];
+  auto *StructE = Structs[4];
 
-    ASSERT_TRUE(Src == NodeA || Src == NodeB || Src == NodeC || Src == NodeE);
-    if (Src == NodeA) {
-      ASSERT_TRUE(Target == NodeB);
-    } else if (Src == NodeB) {
-      ASSERT_TRUE(Target == NodeC);
-    } else if (Src == NodeC) {
-      ASSERT_TRUE(Target == NodeD);
-    } else if (Src == NodeE) {
-      ASSERT_TRUE(Target == NodeB);
-    }
-  }
+  CachedTypeGraph Tg;
 
-  ASSERT_TRUE(NumberEdge == 4);
-  NumberEdge = 0; // NOLINT Avoid stupid mistakes
+  ASSERT_TRUE(Tg.addLink(StructE, StructA));
+  ASSERT_TRUE(Tg.addLink(StructA, StructB));
+  ASSERT_TRUE(Tg.addLink(StructB, StructC));
+  ASSERT_TRUE(Tg.G.getNumComponents() == 4);
 
-  // Check that the type are coherent in the graph
-  ASSERT_TRUE(Tg.G[VertexA].Types.count(StructA));
-  ASSERT_TRUE(Tg.G[VertexA].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexB].Types.count(StructB));
-  ASSERT_TRUE(Tg.G[VertexB].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexC].Types.count(StructC));
-  ASSERT_TRUE(Tg.G[VertexC].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexD].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexD].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexE].Types.count(StructE));
-  ASSERT_TRUE(Tg.G[VertexE].Types.size() == 1);
+  // Closes the cycle A -> B -> C -> A, which is collapsed into a single
+  // component
+  ASSERT_TRUE(Tg.addLink(StructC, StructA));
+  ASSERT_TRUE(Tg.G.getNumComponents() == 2);
+  ASSERT_TRUE(Tg.G.getNumEdges() == 4);
+  auto NodeA = Tg.addType(StructA);
+  ASSERT_TRUE(Tg.G.findRepresentative(Tg.addType(StructB)) ==
+              Tg.G.findRepresentative(NodeA));
+  ASSERT_TRUE(Tg.G.findRepresentative(Tg.addType(StructC)) ==
+              Tg.G.findRepresentative(NodeA));
+  ASSERT_TRUE(Tg.G.findRepresentative(Tg.addType(StructE)) !=
+              Tg.G.findRepresentative(NodeA));
+
+  std::set<const llvm::StructType *> Cycle = {StructA, StructB, StructC};
+  ASSERT_TRUE(Tg.getTypes(StructA) == Cycle);
+  ASSERT_TRUE(Tg.getTypes(StructB) == Cycle);
+  ASSERT_TRUE(Tg.getTypes(StructC) == Cycle);
+  ASSERT_TRUE(Tg.getTypes(StructE).size() == 4);
+
+  // Links out of the cycle reach all of its members and their predecessors
+  ASSERT_TRUE(Tg.addLink(StructB, StructD));
+  for (const auto *Struct : {StructA, StructB, StructC, StructE}) {
+    ASSERT_TRUE(Tg.getTypes(Struct).count(StructD));
+  }
+  ASSERT_TRUE(Tg.getTypes(StructD).size() == 1);
+  ASSERT_TRUE(Tg.getTypes(StructE).size() == 5);
 
+  // A full recomputation yields the same types
+  std::vector<std::set<const llvm::StructType *>> Expected;
+  for (const auto *Struct : Structs) {
+    Expected.push_back(Tg.getTypes(Struct));
+  }
   Tg.aggregateTypes();
+  ASSERT_TRUE(Tg.G.getNumComponents() == 5);
+  for (size_t I = 0; I < Structs.size(); ++I) {
+    ASSERT_TRUE(Tg.getTypes(Structs[I]) == Expected[I]);
+  }
+}
 
-  // Check that the type are coherent in the graph
-  ASSERT_TRUE(Tg.G[VertexA].Types.count(StructA) &&
-              Tg.G[VertexA].Types.count(StructB) &&
-              Tg.G[VertexA].Types.count(StructC) &&
-              Tg.G[VertexA].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexA].Types.size() == 4);
-  ASSERT_TRUE(Tg.G[VertexB].Types.count(StructB) &&
-              Tg.G[VertexB].Types.count(StructC) &&
-              Tg.G[VertexB].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexB].Types.size() == 3);
-  ASSERT_TRUE(Tg.G[VertexC].Types.count(StructC) &&
-              Tg.G[VertexC].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexC].Types.size() == 2);
-  ASSERT_TRUE(Tg.G[VertexD].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexD].Types.size() == 1);
-  ASSERT_TRUE(Tg.G[VertexE].Types.count(StructE) &&
-              Tg.G[VertexE].Types.count(StructB) &&
-              Tg.G[VertexE].Types.count(StructC) &&
-              Tg.G[VertexE].Types.count(StructD));
-  ASSERT_TRUE(Tg.G[VertexE].Types.size() == 4);
+TEST(TypeGraphTest, LazyTypeGraph) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "basic/seven_structs_cpp.ll"});
+  llvm::Module *M = IRDB.getModule(unittest::PathToLLTestFiles +
+                                   "basic/seven_structs_cpp.ll");
+
+  std::vector<llvm::StructType *> Structs = M->getIdentifiedStructTypes();
+  ASSERT_TRUE(Structs.size() == 7);
+
+  CachedTypeGraph Cached;
+  LazyTypeGraph Lazy;
+  const std::pair<unsigned, unsigned> Links[] = {
+      {0, 1}, {1, 2}, {2, 3}, {4, 1}, {3, 1}, {5, 6}, {6, 5}, {0, 5}};
+  for (auto [From, To] : Links) {
+    ASSERT_TRUE(Cached.addLink(Structs[From], Structs[To]));
+    ASSERT_TRUE(Lazy.addLink(Structs[From], Structs[To]));
+    // Both graphs agree after every link
+    for (const auto *Struct : Structs) {
+      ASSERT_TRUE(Cached.getTypes(Struct) == Lazy.getTypes(Struct));
+    }
+  }
+  ASSERT_TRUE(Lazy.getTypes(Structs[0]).size() == 6);
+  ASSERT_TRUE(Lazy.getTypes(Structs[4]).size() == 4);
+  ASSERT_TRUE(Lazy.getTypeIds(Structs[0]).count() == 6);
 }
 } // namespace psr
 
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "llvm/Support/MemoryBufferRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/Utils/ESGTrace.h"
+
+using namespace psr;
+
+namespace {
+
+// Builds the ESG of
+//
+//   foo:  1 -> 2 -> 3   (fact a flows from 1 to 3, b is generated at 2)
+//   bar:  4 -> 5        (a is passed to bar at 2)
+std::string createTrace() {
+  std::string Buffer;
+  llvm::raw_string_ostream OS(Buffer);
+  ESGTraceWriter Writer(OS);
+  auto Foo = Writer.addFunction("foo");
+  auto Bar = Writer.addFunction("bar");
+  auto N1 = Writer.addNode(Foo, "1", "%a = alloca i32");
+  auto N2 = Writer.addNode(Foo, "2", "call void @bar(i32* %a)");
+  auto N3 = Writer.addNode(Foo, "3", "ret void");
+  auto N4 = Writer.addNode(Bar, "4", "%0 = load i32, i32* %p");
+  auto N5 = Writer.addNode(Bar, "5", "ret void");
+  auto Zero = Writer.addFact("zero", true);
+  auto A = Writer.addFact("%a = alloca i32");
+  auto B = Writer.addFact("%b = alloca i32");
+  auto Id = Writer.addEdgeFunctionLabel("EdgeIdentity");
+
+  Writer.addEdge({N1, Zero, N2, Zero, Id, false});
+  Writer.addEdge({N1, Zero, N2, A, ESGTraceEdge::NoLabel, false});
+  Writer.addEdge({N2, A, N3, A, Id, false});
+  Writer.addEdge({N2, Zero, N3, B, ESGTraceEdge::NoLabel, false});
+  Writer.addEdge({N2, A, N4, A, ESGTraceEdge::NoLabel, true});
+  Writer.addEdge({N4, A, N5, A, Id, false});
+  EXPECT_EQ(6, Writer.getNumEdges());
+  OS.flush();
+  return Buffer;
+}
+
+ESGTrace readTrace(const std::string &Buffer) {
+  return ESGTrace::read(llvm::MemoryBufferRef(Buffer, "test"));
+}
+
+} // namespace
+
+TEST(ESGTraceTest, RoundTrip) {
+  auto Trace = readTrace(createTrace());
+  ASSERT_EQ(2, Trace.getFunctions().size());
+  ASSERT_EQ(5, Trace.getNodes().size());
+  ASSERT_EQ(3, Trace.getFacts().size());
+  ASSERT_EQ(1, Trace.getEdgeFunctionLabels().size());
+  ASSERT_EQ(6, Trace.getEdges().size());
+
+  EXPECT_EQ("bar", Trace.getFunctions()[1].Name);
+  EXPECT_EQ(1, Trace.getNodes()[4].FunctionId);
+  EXPECT_EQ("5", Trace.getNodes()[4].StmtId);
+  EXPECT_TRUE(Trace.getFacts()[0].IsZero);
+  EXPECT_FALSE(Trace.getFacts()[1].IsZero);
+
+  const auto &Inter = Trace.getEdges()[4];
+  EXPECT_TRUE(Inter.IsInterProcedural);
+  EXPECT_EQ(ESGTraceEdge::NoLabel, Inter.EdgeFunctionLabel);
+  EXPECT_EQ(0, Trace.getEdges()[0].EdgeFunctionLabel);
+}
+
+TEST(ESGTraceTest, SliceFunction) {
+  auto Trace = readTrace(createTrace()).sliceFunction("bar");
+  // The call edge into bar and the edge within bar
+  EXPECT_EQ(2, Trace.getEdges().size());
+}
+
+TEST(ESGTraceTest, SliceFacts) {
+  auto Trace = readTrace(createTrace());
+  auto Facts = Trace.findFacts("%b");
+  ASSERT_EQ(1, Facts.size());
+  EXPECT_EQ(1, Trace.sliceFacts(Facts).getEdges().size());
+}
+
+TEST(ESGTraceTest, SlicePaths) {
+  auto Trace = readTrace(createTrace());
+  auto From = Trace.findNodes("1");
+  auto To = Trace.findNodes("5");
+  ASSERT_EQ(1, From.size());
+  ASSERT_EQ(1, To.size());
+  // zero@1 -> a@2 -> a@4 -> a@5
+  auto Sliced = Trace.slicePaths({{From[0], 0}}, {{To[0], 1}});
+  EXPECT_EQ(3, Sliced.getEdges().size());
+  // There is no path from b to anything
+  auto Empty = Trace.slicePaths({{From[0], 2}}, {{To[0], 1}});
+  EXPECT_TRUE(Empty.getEdges().empty());
+}
+
+TEST(ESGTraceTest, Render) {
+  auto Trace = readTrace(createTrace()).sliceFunction("bar");
+  std::string Dot;
+  llvm::raw_string_ostream OS(Dot);
+  Trace.printAsDot(OS);
+  OS.flush();
+  EXPECT_NE(std::string::npos, Dot.find("cluster_1"));
+  EXPECT_NE(std::string::npos, Dot.find("EdgeIdentity"));
+
+  auto J = Trace.getAsJson();
+  EXPECT_EQ(2, J["Edges"].size());
+  EXPECT_EQ(3, J["Nodes"].size());
+  EXPECT_EQ(1, J["Facts"].size());
+}
+
+TEST(ESGTraceTest, Malformed) {
+  EXPECT_THROW(readTrace("not a trace"), std::runtime_error);
+  auto Buffer = createTrace();
+  Buffer.resize(Buffer.size() - 3);
+  EXPECT_THROW(readTrace(Buffer), std::runtime_error);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
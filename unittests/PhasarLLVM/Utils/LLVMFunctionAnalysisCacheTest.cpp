@@ -0,0 +1,128 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionAnalysisCache.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class LLVMFunctionAnalysisCacheTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = unittest::PathToLLTestFiles;
+}; // Test Fixture
+
+TEST_F(LLVMFunctionAnalysisCacheTest, ComputesAnalysesOnce) {
+  ProjectIRDB IRDB({PathToLlFiles + "linear_constant/for_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  auto &Cache = IRDB.getAnalysisCache();
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+
+  auto &DT = Cache.getDominatorTree(Main);
+  EXPECT_EQ(&DT, &Cache.getDominatorTree(Main));
+  EXPECT_EQ(&DT, &IRDB.getAnalysisCache().getDominatorTreeGetter()(Main));
+  const auto &Entry = Main->getEntryBlock();
+  const auto *Exit = Main->back().getTerminator();
+  EXPECT_TRUE(DT.dominates(&Entry, Exit->getParent()));
+
+  auto &PDT = Cache.getPostDominatorTree(Main);
+  EXPECT_EQ(&PDT, &Cache.getPostDominatorTree(Main));
+  EXPECT_TRUE(PDT.dominates(Exit->getParent(), &Entry));
+
+  // The for loop
+  auto &LI = Cache.getLoopInfo(Main);
+  EXPECT_EQ(&LI, &Cache.getLoopInfo(Main));
+  EXPECT_EQ(1, std::distance(LI.begin(), LI.end()));
+  EXPECT_EQ(nullptr, LI.getLoopFor(&Entry));
+
+  auto &AA = Cache.getAAResults(Main);
+  EXPECT_EQ(&AA, &Cache.getAAResults(Main));
+  std::vector<const llvm::AllocaInst *> Allocas;
+  for (const auto &I : Entry) {
+    if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      Allocas.push_back(Alloca);
+    }
+  }
+  ASSERT_EQ(3U, Allocas.size());
+  EXPECT_EQ(llvm::AliasResult::NoAlias, AA.alias(Allocas[1], Allocas[2]));
+  EXPECT_EQ(llvm::AliasResult::MustAlias, AA.alias(Allocas[1], Allocas[1]));
+}
+
+TEST_F(LLVMFunctionAnalysisCacheTest, RecomputesInvalidatedAnalyses) {
+  ProjectIRDB IRDB({PathToLlFiles + "linear_constant/for_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  auto &Cache = IRDB.getAnalysisCache();
+  auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  EXPECT_EQ(1U, Cache.getLoopInfo(Main).getTopLevelLoops().size());
+
+  // Remove the back edge of the loop
+  auto *Latch = Cache.getLoopInfo(Main).getTopLevelLoops()[0]->getLoopLatch();
+  ASSERT_NE(nullptr, Latch);
+  auto *Exit = &Main->back();
+  llvm::cast<llvm::BranchInst>(Latch->getTerminator())->setSuccessor(0, Exit);
+  Cache.invalidate(*Main);
+
+  EXPECT_TRUE(Cache.getLoopInfo(Main).empty());
+  EXPECT_FALSE(Cache.getDominatorTree(Main).dominates(Latch, Exit));
+  EXPECT_EQ(Exit, Cache.getPostDominatorTree(Main).getRoot());
+}
+
+TEST_F(LLVMFunctionAnalysisCacheTest, PointsToAnalysisFollowsInvalidation) {
+  ProjectIRDB IRDB({PathToLlFiles + "linear_constant/for_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  auto &Cache = IRDB.getAnalysisCache();
+  auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  LLVMBasedPointsToAnalysis PTA(IRDB, /*UseLazyEvaluation*/ true,
+                                Cache.getPointerAnalysisType());
+  EXPECT_EQ(&Cache.getAAResults(Main), PTA.getAAResults(Main));
+
+  // The points-to analysis must not hold on to the dropped results
+  Cache.invalidate(*Main);
+  EXPECT_EQ(&Cache.getAAResults(Main), PTA.getAAResults(Main));
+  Cache.clear();
+  EXPECT_EQ(&Cache.getAAResults(Main), PTA.getAAResults(Main));
+}
+
+TEST_F(LLVMFunctionAnalysisCacheTest, SharesResultsAmongThreads) {
+  ProjectIRDB IRDB({PathToLlFiles + "linear_constant/for_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  std::vector<const llvm::DominatorTree *> DTs(4);
+  std::vector<const llvm::LoopInfo *> LIs(DTs.size());
+  std::vector<std::thread> Threads;
+  for (size_t I = 0; I < DTs.size(); ++I) {
+    Threads.emplace_back([&IRDB, &DT = DTs[I], &LI = LIs[I], Main] {
+      DT = &IRDB.getAnalysisCache().getDominatorTree(Main);
+      LI = &IRDB.getAnalysisCache().getLoopInfo(Main);
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  for (size_t I = 0; I < DTs.size(); ++I) {
+    EXPECT_EQ(DTs[0], DTs[I]);
+    EXPECT_EQ(LIs[0], LIs[I]);
+  }
+}
+
+// main
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarPass/Options.h"
+#include "phasar/PhasarPass/PhasarAnalysis.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class PhasarAnalysisTest : public ::testing::Test {
+protected:
+  llvm::LLVMContext Ctx;
+  std::unique_ptr<llvm::Module> M;
+  // The analysis managers are destroyed before the module they refer to
+  llvm::LoopAnalysisManager LAM;
+  llvm::FunctionAnalysisManager FAM;
+  llvm::CGSCCAnalysisManager CGAM;
+  llvm::ModuleAnalysisManager MAM;
+  llvm::PassBuilder PB;
+
+  void SetUp() override {
+    llvm::SMDiagnostic Diag;
+    M = llvm::parseIRFile(unittest::PathToLLTestFiles +
+                              "linear_constant/basic_01_cpp.ll",
+                          Diag, Ctx);
+    ASSERT_NE(nullptr, M);
+
+    psr::EntryPoints = {"main"};
+    psr::CallGraphAnalysis = "OTF";
+    psr::DumpResults = false;
+
+    FAM.registerPass([this] { return PB.buildDefaultAAPipeline(); });
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    MAM.registerPass([] { return PhasarAnalysis(); });
+  }
+}; // Test Fixture
+
+TEST_F(PhasarAnalysisTest, ResultIsCachedInModuleAnalysisManager) {
+  auto &Result = MAM.getResult<PhasarAnalysis>(*M);
+  EXPECT_EQ(&Result, MAM.getCachedResult<PhasarAnalysis>(*M));
+  EXPECT_EQ(&Result, &MAM.getResult<PhasarAnalysis>(*M));
+  EXPECT_EQ(std::set<std::string>{"main"}, Result.getEntryPoints());
+
+  auto *Main = M->getFunction("main");
+  ASSERT_NE(nullptr, Main);
+  EXPECT_EQ(Main, Result.getProjectIRDB().getFunctionDefinition("main"));
+  EXPECT_NE(nullptr, Result.getICFG().getFunction("main"));
+
+  // The dominator trees come from the FunctionAnalysisManager
+  auto &DT = Result.getDominatorTree(Main);
+  EXPECT_EQ(&DT, FAM.getCachedResult<llvm::DominatorTreeAnalysis>(*Main));
+
+  Result.runDataFlowAnalysis("ide-lca", false);
+}
+
+TEST_F(PhasarAnalysisTest, ResultIsInvalidatedUnlessPreserved) {
+  MAM.getResult<PhasarAnalysis>(*M);
+  MAM.invalidate(*M, llvm::PreservedAnalyses::all());
+  EXPECT_NE(nullptr, MAM.getCachedResult<PhasarAnalysis>(*M));
+
+  MAM.invalidate(*M, llvm::PreservedAnalyses::none());
+  EXPECT_EQ(nullptr, MAM.getCachedResult<PhasarAnalysis>(*M));
+}
+
+TEST_F(PhasarAnalysisTest, ModulePassReusesCachedResult) {
+  auto *Cached = &MAM.getResult<PhasarAnalysis>(*M);
+
+  psr::DataFlowAnalysis = "ide-lca";
+  llvm::ModulePassManager MPM;
+  MPM.addPass(PhasarModulePass());
+  auto PA = MPM.run(*M, MAM);
+
+  EXPECT_TRUE(PA.areAllPreserved());
+  EXPECT_EQ(Cached, MAM.getCachedResult<PhasarAnalysis>(*M));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
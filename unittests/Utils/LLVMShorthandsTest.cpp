@@ -1,7 +1,9 @@
 #include "gtest/gtest.h"
 
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
@@ -43,6 +45,46 @@ TEST(LLVMGetterTest, HandlesLLVMTermInstruction) {
   ASSERT_EQ(getNthTermInstruction(F, 5), nullptr);
 }
 
+TEST(LLVMShorthandsTest, CachesIRStrings) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "linear_constant/call_01_cpp.ll"});
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *Callee = IRDB.getFunctionDefinition("_Z3fooi");
+  ASSERT_NE(nullptr, Main);
+  ASSERT_NE(nullptr, Callee);
+
+  // Interleave the functions, such that the slot tracker has to switch
+  std::vector<const llvm::Value *> Values;
+  for (const auto &Arg : Callee->args()) {
+    Values.push_back(&Arg);
+  }
+  for (const auto &I : llvm::instructions(Main)) {
+    Values.push_back(&I);
+    Values.push_back(Callee->getEntryBlock().getTerminator());
+  }
+
+  llvm::ModuleSlotTracker MST(Main->getParent());
+  for (const auto *V : Values) {
+    std::string Expected;
+    llvm::raw_string_ostream OS(Expected);
+    V->print(OS, MST);
+    OS << " | ID: " << getMetaDataID(V);
+    OS.flush();
+
+    auto IRString = llvmIRToStringRef(V);
+    EXPECT_EQ(llvm::StringRef(Expected).ltrim(), IRString);
+    EXPECT_EQ(IRString, llvmIRToString(V));
+    // The string is rendered only once
+    EXPECT_EQ(IRString.data(), llvmIRToStringRef(V).data());
+
+    auto StableString = llvmIRToStableStringRef(V);
+    EXPECT_EQ(StableString, llvmIRToStableString(V));
+    EXPECT_EQ(llvm::StringRef::npos, StableString.find('!'));
+    EXPECT_EQ(llvmIRToShortString(V), llvmIRToShortStringRef(V));
+  }
+  EXPECT_EQ("<null>", llvmIRToStringRef(nullptr));
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
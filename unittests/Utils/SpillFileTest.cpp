@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "phasar/Utils/SpillFile.h"
+
+using namespace psr;
+
+TEST(SpillFile, AppendAndRead) {
+  SpillFile File("phasar-spill-test");
+  std::vector<SpillFile::Slice> Slices;
+  std::vector<std::string> Data;
+  for (int I = 0; I < 100; ++I) {
+    Data.push_back(std::string(I, static_cast<char>('a' + I % 26)));
+    Slices.push_back(File.append(Data.back()));
+  }
+  EXPECT_EQ(99U * 100U / 2U, File.size());
+  // read in reverse order, interleaved with further appends
+  for (int I = 99; I >= 0; --I) {
+    auto Buffer = File.read(Slices[I]);
+    EXPECT_EQ(Data[I], Buffer->getBuffer());
+    File.append("x");
+  }
+}
+
+TEST(SpillFile, SpillSameEntriesRepeatedly) {
+  SpillFile File("phasar-spill-test");
+  std::vector<std::string> Data;
+  std::vector<SpillFile::Slice> Slices;
+  for (int I = 0; I < 10; ++I) {
+    Data.push_back(std::string(10 + I, static_cast<char>('a' + I)));
+    Slices.push_back(File.append(Data.back()));
+  }
+  const auto Size = File.size();
+  // re-spilling an entry reuses the range of its previous slice
+  for (int Round = 0; Round < 100; ++Round) {
+    for (size_t I = 0; I < Data.size(); ++I) {
+      File.release(Slices[I]);
+      Slices[I] = File.append(Data[I]);
+    }
+    EXPECT_EQ(Size, File.size());
+    EXPECT_EQ(0U, File.getNumFreeBytes());
+  }
+  for (size_t I = 0; I < Data.size(); ++I) {
+    EXPECT_EQ(Data[I], File.read(Slices[I])->getBuffer());
+  }
+}
+
+TEST(SpillFile, MergesReleasedSlices) {
+  SpillFile File("phasar-spill-test");
+  auto A = File.append("aaaa");
+  auto B = File.append("bbbb");
+  auto C = File.append("cccc");
+  File.release(A);
+  File.release(C);
+  File.release(B);
+  EXPECT_EQ(12U, File.getNumFreeBytes());
+  // fits only into the merged range of all three slices
+  auto D = File.append("dddddddddd");
+  EXPECT_EQ(0U, D.Offset);
+  EXPECT_EQ(12U, File.size());
+  EXPECT_EQ(2U, File.getNumFreeBytes());
+  EXPECT_EQ("dddddddddd", File.read(D)->getBuffer());
+  // does not fit into the remaining two bytes
+  auto E = File.append("eee");
+  EXPECT_EQ(12U, E.Offset);
+  EXPECT_EQ(15U, File.size());
+}
+
+TEST(SpillFile, RemovesFile) {
+  std::string Path;
+  {
+    SpillFile File("phasar-spill-test");
+    File.append("data");
+    Path = File.getPath().str();
+    EXPECT_TRUE(llvm::sys::fs::exists(Path));
+  }
+  EXPECT_FALSE(llvm::sys::fs::exists(Path));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}